@@ -104,6 +104,8 @@ class PublishSocket;
 class ReplyCallback;
 class ReplySocket;
 class RequestSocket;
+class RouterCallback;
+class RouterSocket;
 class SubscribeSocket;
 }  // namespace opentxs::network::zeromq
 
@@ -219,6 +221,8 @@ using OTZMQPublishSocket = Pimpl<network::zeromq::PublishSocket>;
 using OTZMQReplyCallback = Pimpl<network::zeromq::ReplyCallback>;
 using OTZMQReplySocket = Pimpl<network::zeromq::ReplySocket>;
 using OTZMQRequestSocket = Pimpl<network::zeromq::RequestSocket>;
+using OTZMQRouterCallback = Pimpl<network::zeromq::RouterCallback>;
+using OTZMQRouterSocket = Pimpl<network::zeromq::RouterSocket>;
 using OTZMQSubscribeSocket = Pimpl<network::zeromq::SubscribeSocket>;
 using OTUIContactList = Pimpl<ui::ContactList>;
 using OTUIContactListItem = Pimpl<ui::ContactListItem>;
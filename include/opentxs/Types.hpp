@@ -458,6 +458,7 @@ enum class SocketType : std::uint8_t {
     Reply = 2,
     Publish = 3,
     Subscribe = 4,
+    Router = 5,
 };
 
 enum class RemoteBoxType : std::int8_t {
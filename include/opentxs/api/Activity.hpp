@@ -181,6 +181,29 @@ public:
         const Identifier& nymID,
         const Identifier& threadID) const;
 
+    /**   Load one page of an activity thread
+     *
+     *    Pages hold consecutive items. Loading a single page avoids
+     *    serializing the whole thread.
+     *
+     *    \param[in] nymID the identifier of the nym who owns the thread
+     *    \param[in] threadID the thread to load
+     *    \param[in] page the page to load, where page 0 holds the oldest
+     *                    items
+     */
+    std::shared_ptr<proto::StorageThread> Thread(
+        const Identifier& nymID,
+        const Identifier& threadID,
+        const std::size_t page) const;
+
+    /**   Return the number of pages in an activity thread
+     *
+     *    \param[in] nymID the identifier of the nym who owns the thread
+     *    \param[in] threadID the thread
+     */
+    std::size_t ThreadPages(const Identifier& nymID, const Identifier& threadID)
+        const;
+
     /**   Obtain a list of thread ids for the specified nym
      *
      *    \param[in] nym the identifier of the nym
@@ -50,6 +50,9 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -74,6 +77,15 @@ public:
         const Identifier& accountID,
         const std::string& label = "",
         const BIP44Chain chain = EXTERNAL_CHAIN) const;
+    /** Allocates count consecutive addresses, saving the account once
+     *
+     *  \returns the new addresses in index order, or nothing on failure */
+    std::vector<std::unique_ptr<proto::Bip44Address>> AllocateAddresses(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const std::uint32_t count,
+        const std::string& label = "",
+        const BIP44Chain chain = EXTERNAL_CHAIN) const;
     bool AssignAddress(
         const Identifier& nymID,
         const Identifier& accountID,
@@ -108,6 +120,15 @@ public:
 private:
     typedef std::map<Identifier, std::mutex> IDLock;
 
+    /** Extended public key of one chain of an account */
+    struct ChainKey {
+        OTData public_key_;
+        OTData chain_code_;
+    };
+
+    /** Indexed by account ID and chain */
+    typedef std::map<std::pair<std::string, BIP44Chain>, ChainKey> ChainKeys;
+
     friend class implementation::Native;
 
     const Activity& activity_;
@@ -117,6 +138,8 @@ private:
     mutable std::mutex lock_;
     mutable IDLock nym_lock_;
     mutable IDLock account_lock_;
+    mutable std::mutex chain_key_lock_;
+    mutable ChainKeys chain_keys_;
     proto::Bip44Address& add_address(
         const std::uint32_t index,
         proto::Bip44Account& account,
@@ -128,6 +151,11 @@ private:
         const proto::Bip44Account& account,
         const BIP44Chain chain,
         const std::uint32_t index) const;
+    bool chain_key(
+        const proto::Bip44Account& account,
+        const BIP44Chain chain,
+        OTData& publicKey,
+        OTData& chainCode) const;
     proto::Bip44Address& find_address(
         const std::uint32_t index,
         const BIP44Chain chain,
@@ -170,6 +170,11 @@ public:
         const std::string& nymId,
         const std::string& threadId,
         std::shared_ptr<proto::StorageThread>& thread) const = 0;
+    virtual bool Load(
+        const std::string& nymId,
+        const std::string& threadId,
+        const std::size_t page,
+        std::shared_ptr<proto::StorageThread>& thread) const = 0;
     virtual bool Load(
         const std::string& id,
         std::shared_ptr<proto::UnitDefinition>& contract,
@@ -277,6 +282,9 @@ public:
     virtual std::string ThreadAlias(
         const std::string& nymID,
         const std::string& threadID) const = 0;
+    virtual std::size_t ThreadPages(
+        const std::string& nymID,
+        const std::string& threadID) const = 0;
     virtual std::string UnitDefinitionAlias(const std::string& id) const = 0;
     virtual ObjectList UnitDefinitionList() const = 0;
     virtual std::size_t UnreadCount(
@@ -47,6 +47,8 @@
 #include <cstdint>
 #include <ctime>
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -240,6 +242,15 @@ public:
         String& theOutput,
         int32_t nTokenIndex) = 0;
 
+    // Signs each token as SignToken would, writing one signature per token
+    // to output. Returns one result per token. Implementations may spread
+    // the work across cores.
+    EXPORT virtual std::vector<bool> SignTokens(
+        const Nym& theNotary,
+        const std::vector<Token*>& tokens,
+        std::vector<String>& output,
+        int32_t nTokenIndex);
+
     // step 4: (unblind coin is in Token)
 
     // Lucre step 5: mint verifies token when it is redeemed by merchant.
@@ -247,6 +258,11 @@ public:
         const Nym& theNotary,
         String& theCleartextToken,
         int64_t lDenomination) = 0;
+    // Verifies each pair of cleartext token and denomination as VerifyToken
+    // would. Returns one result per token.
+    EXPORT virtual std::vector<bool> VerifyTokens(
+        const Nym& theNotary,
+        std::vector<std::pair<String, int64_t>>& tokens);
 };
 }  // namespace opentxs
 #endif  // OT_CASH
@@ -47,11 +47,20 @@
 #include "opentxs/core/String.hpp"
 
 #include <stdint.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Bank;
 
 namespace opentxs
 {
 
 class Nym;
+class SecureBuffer;
 class Token;
 
 // SUBCLASSES OF OTMINT FOR EACH DIGITAL CASH ALGORITHM.
@@ -61,6 +70,28 @@ class MintLucre : public Mint
 private:  // Private prevents erroneous use by other classes.
     typedef Mint ot_super;
     friend class Mint;  // for the factory.
+    // Unit tests
+    friend class MintLucreTest;
+
+    // The private bank of each denomination, unsealed, together with the ID
+    // of the nym that opened it. Dropped when the mint is released or
+    // reloaded, when a denomination is replaced, and once the tokens of this
+    // series have expired.
+    mutable std::mutex bank_lock_;
+    std::map<
+        int64_t,
+        std::pair<std::string, std::shared_ptr<const SecureBuffer>>>
+        banks_;
+
+    std::shared_ptr<const SecureBuffer> unsealed_bank(
+        const Nym& theNotary,
+        int64_t lDenomination);
+    bool sign_token(
+        Bank& bank,
+        Token& theToken,
+        String& theOutput,
+        int32_t nTokenIndex);
+
 protected:
     MintLucre();
     EXPORT MintLucre(
@@ -86,6 +117,16 @@ public:
         const Nym& theNotary,
         String& theCleartextToken,
         int64_t lDenomination) override;
+    EXPORT std::vector<bool> SignTokens(
+        const Nym& theNotary,
+        const std::vector<Token*>& tokens,
+        std::vector<String>& output,
+        int32_t nTokenIndex) override;
+    EXPORT std::vector<bool> VerifyTokens(
+        const Nym& theNotary,
+        std::vector<std::pair<String, int64_t>>& tokens) override;
+
+    void Release() override;
 
     EXPORT virtual ~MintLucre();
 };
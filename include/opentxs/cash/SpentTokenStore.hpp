@@ -0,0 +1,175 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CASH_SPENTTOKENSTORE_HPP
+#define OPENTXS_CASH_SPENTTOKENSTORE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#if OT_CASH
+#include "opentxs/Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+
+class Identifier;
+
+/** Durable set of spent token hashes for one instrument definition and mint
+ *  series.
+ *
+ *  Hashes are appended to a single log file and indexed in memory by a 64 bit
+ *  fingerprint, with a blocked Bloom filter in front of the index so that the
+ *  common case (a token which has never been spent) is answered without
+ *  probing the index or touching the disk. A fingerprint match is confirmed
+ *  against the log before a token is reported as spent.
+ *
+ *  Remove() appends a tombstone for each token, which is a record whose
+ *  checksum is inverted. Tombstones are only used to withdraw tokens
+ *  recorded by a transaction that could not complete.
+ *
+ *  The log is replayed when the store is opened. A torn record at the end of
+ *  the log, left behind by a crash during an append, is truncated. */
+class SpentTokenStore
+{
+public:
+    /** Returns the store for the given series, opening it on first use.
+     *
+     *  When the log does not exist yet but a legacy spent/<unit>.<series>/
+     *  folder does, the tokens recorded there are imported before the store
+     *  is returned. Returns nullptr if the store can not be opened. */
+    EXPORT static std::shared_ptr<SpentTokenStore> Get(
+        const Identifier& unitID,
+        const std::int32_t series);
+    /** Imports every legacy spent/<unit>.<series>/ folder found under
+     *  spentFolder which has not already been converted to a log. Returns
+     *  the number of folders which failed to import. */
+    EXPORT static std::size_t Migrate(const std::string& spentFolder);
+
+    EXPORT SpentTokenStore(
+        const std::string& path,
+        const bool sync = true,
+        const std::size_t keySize = 20);
+
+    /** Returns true if the token was spent, and also if the store can not
+     *  answer, since the token must not be accepted in either case. */
+    EXPORT bool Contains(const Identifier& token) const;
+    EXPORT bool IsValid() const;
+    EXPORT std::size_t Size() const;
+
+    /** Rewrites the log without duplicate or damaged records */
+    EXPORT bool Compact();
+    /** Records every token file in a legacy spent folder. The folder itself is
+     *  left untouched. */
+    EXPORT bool Import(const std::string& folder, std::size_t& imported);
+    /** Returns false if the token was already spent or can not be recorded */
+    EXPORT bool Insert(const Identifier& token);
+    /** Check and insert for a whole purse with a single write and sync.
+     *
+     *  An element of the output is true if the corresponding token was not
+     *  spent before and has now been recorded. A token which appears more
+     *  than once in the input is accepted at its first position only. */
+    EXPORT std::vector<bool> Insert(const std::vector<Identifier>& tokens);
+    /** Withdraws tokens which this caller recorded with Insert() but whose
+     *  transaction then failed. Returns false if the tombstones can not be
+     *  written, in which case the tokens remain spent. */
+    EXPORT bool Remove(const std::vector<Identifier>& tokens);
+
+    EXPORT ~SpentTokenStore();
+
+private:
+    const std::string path_;
+    const bool sync_{true};
+    std::size_t key_size_{0};
+    std::size_t record_size_{0};
+    mutable std::mutex lock_;
+    int fd_{-1};
+    std::uint64_t records_{0};
+    std::uint64_t damaged_{0};
+    std::size_t count_{0};
+    std::vector<std::uint64_t> fingerprints_;
+    std::vector<std::uint32_t> positions_;
+    std::vector<std::uint64_t> bloom_;
+
+    static std::uint32_t checksum(const std::uint8_t* key, std::size_t size);
+    static bool convert(const std::string& folder, const std::string& path);
+    static std::uint64_t fingerprint(const std::uint8_t* key);
+    static std::uint64_t mix(std::uint64_t value);
+    static std::size_t slots_for(const std::size_t count);
+
+    void add(const Lock& lock, const std::uint64_t fp, const std::uint32_t pos);
+    bool bloom_contains(const Lock& lock, const std::uint64_t fp) const;
+    void bloom_insert(const Lock& lock, const std::uint64_t fp);
+    bool confirm(
+        const Lock& lock,
+        const std::uint32_t position,
+        const std::uint8_t* key) const;
+    bool contains(
+        const Lock& lock,
+        const std::uint8_t* key,
+        const std::uint64_t fp) const;
+    void erase(
+        const Lock& lock,
+        const std::uint8_t* key,
+        const std::uint64_t fp);
+    bool init(const Lock& lock, const std::size_t keySize);
+    bool live(
+        const Lock& lock,
+        const std::uint64_t fp,
+        const std::uint32_t position) const;
+    bool replay(const Lock& lock, const std::uint64_t fileSize);
+    void resize(const Lock& lock, const std::size_t slots);
+    bool sync_directory() const;
+    bool valid_key(const Identifier& token) const;
+    bool write(const Lock& lock, const std::string& records);
+
+    SpentTokenStore() = delete;
+    SpentTokenStore(const SpentTokenStore&) = delete;
+    SpentTokenStore(SpentTokenStore&&) = delete;
+    SpentTokenStore& operator=(const SpentTokenStore&) = delete;
+    SpentTokenStore& operator=(SpentTokenStore&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OT_CASH
+#endif  // OPENTXS_CASH_SPENTTOKENSTORE_HPP
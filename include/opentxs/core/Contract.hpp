@@ -41,6 +41,7 @@
 
 #include "opentxs/Forward.hpp"
 
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Nym.hpp"
@@ -410,7 +411,28 @@ public:
         const OTSignature& theSignature,
         const proto::HashType hashType,
         const OTPasswordData* pPWData = nullptr) const;
+    /** Appends every key and signature pair that VerifySignature(theNym) would
+     *  try, so several contracts can go through CryptoAsymmetric::VerifyBatch
+     *  together. The contract verifies if any of its checks pass. The signed
+     *  text and decoded signatures are stored in data, which must outlive
+     *  checks. */
+    EXPORT void SignatureChecks(
+        const Nym& theNym,
+        std::list<OTData>& data,
+        SignatureBatch& checks) const;
     EXPORT const Nym* GetContractPublicNym() const;
+
+private:
+    /** The signatures theNym may have made. Signatures with metadata record
+     *  a character of the signer's ID, which rules out the others. */
+    listOfSignatures nym_signatures(const Nym& theNym) const;
+    /** The keys to try for theSignature: theNym's keys of type keyType ('S'
+     *  or 'A') which match it, then the nym's default key of that type. Keys
+     *  whose metadata rules them out are left out. */
+    listOfAsymmetricKeys signature_keys(
+        const Nym& theNym,
+        const OTSignature& theSignature,
+        const char keyType) const;
 };
 }  // namespace opentxs
 #endif  // OPENTXS_CORE_CONTRACT_HPP
@@ -41,32 +41,52 @@
 
 #include "opentxs/Forward.hpp"
 
-#include "opentxs/core/Data_imp.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
 /** An Identifier is basically a 256 bit hash value. This class makes it easy to
- * convert IDs back and forth to strings. */
+ * convert IDs back and forth to strings.
+ *
+ * The digest is held inline, so copying an Identifier never allocates, and
+ * comparisons work on the binary form. The base58 string form is computed
+ * on first use and cached until the Identifier is modified. */
 namespace opentxs
 {
-class Identifier : virtual public implementation::Data
+class Identifier : virtual public opentxs::Data
 {
-private:
-    typedef opentxs::implementation::Data ot_super;
+public:
+    /** Largest digest which fits in an Identifier */
+    static const std::size_t MaxSize{64};
 
+private:
     static const ID DefaultType{ID::BLAKE2B};
     static const size_t MinimumSize{10};
 
     ID type_{DefaultType};
+    std::uint8_t size_{0};
+    std::array<std::uint8_t, MaxSize> data_{};
+    std::size_t position_{0};
+    mutable std::shared_ptr<const std::string> string_{nullptr};
 
     static proto::HashType IDToHashType(const ID type);
     static OTData path_to_data(
         const proto::ContactItemType type,
         const proto::HDPath& path);
 
+    Identifier* clone() const override;
+    /** Identifiers which are both empty compare equal regardless of type */
+    int compare(const Identifier& rhs) const;
+    void invalidate();
+
 public:
     EXPORT friend std::ostream& operator<<(std::ostream& os, const String& obj);
     EXPORT static bool validateID(const std::string& strPurportedID);
@@ -87,33 +107,63 @@ public:
     EXPORT Identifier& operator=(const Identifier& rhs);
     EXPORT Identifier& operator=(Identifier&& rhs);
 
-    using ot_super::operator==;
+    EXPORT bool operator==(const opentxs::Data& rhs) const override;
     EXPORT bool operator==(const Identifier& s2) const;
-    using ot_super::operator!=;
+    EXPORT bool operator!=(const opentxs::Data& rhs) const override;
     EXPORT bool operator!=(const Identifier& s2) const;
     EXPORT bool operator>(const Identifier& s2) const;
     EXPORT bool operator<(const Identifier& s2) const;
     EXPORT bool operator<=(const Identifier& s2) const;
     EXPORT bool operator>=(const Identifier& s2) const;
 
+    EXPORT std::string asHex() const override;
+    EXPORT bool empty() const override;
+    EXPORT const void* GetPointer() const override;
+    EXPORT std::size_t GetSize() const override;
     EXPORT void GetString(String& theStr) const;
+    /** Consistent with operator== */
+    EXPORT std::size_t Hash() const;
+    EXPORT bool IsEmpty() const override;
+    /** theStr will contain pretty hex string after call. */
+    EXPORT const ID& Type() const { return type_; }
 
+    EXPORT Identifier& operator+=(const opentxs::Data& rhs) override;
+    EXPORT void Assign(const opentxs::Data& source) override;
+    EXPORT void Assign(const void* data, const std::size_t& size) override;
     EXPORT bool CalculateDigest(
         const opentxs::Data& dataInput,
         const ID type = DefaultType);
     EXPORT bool CalculateDigest(
         const String& strInput,
         const ID type = DefaultType);
+    EXPORT void Concatenate(const void* data, const std::size_t& size) override;
+    EXPORT std::size_t OTfread(std::uint8_t* data, const std::size_t& size)
+        override;
+    EXPORT bool Randomize(const std::size_t& size) override;
+    EXPORT void Release() override;
+    EXPORT void reset() override;
     /** If someone passes in the pretty string of alphanumeric digits, convert
      * it to the actual binary hash and set it internally. */
     EXPORT void SetString(const std::string& encoded);
     EXPORT void SetString(const String& encoded);
-    using ot_super::swap;
-    void swap(Identifier&& rhs);
-    /** theStr will contain pretty hex string after call. */
-    EXPORT const ID& Type() const { return type_; }
+    EXPORT void SetSize(const std::size_t& size) override;
+    EXPORT void swap(opentxs::Data&& rhs) override;
+    EXPORT void swap(Identifier& rhs);
+    EXPORT void swap(Identifier&& rhs);
+    EXPORT void zeroMemory() override;
 
     EXPORT virtual ~Identifier() = default;
 };
 }  // namespace opentxs
+
+namespace std
+{
+template <>
+struct hash<opentxs::Identifier> {
+    std::size_t operator()(const opentxs::Identifier& id) const
+    {
+        return id.Hash();
+    }
+};
+}  // namespace std
 #endif  // OPENTXS_CORE_OTIDENTIFIER_HPP
@@ -48,6 +48,7 @@
 #include <cstdint>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace opentxs
 {
@@ -81,8 +82,37 @@ private:  // Private prevents erroneous use by other classes.
         String strInput);
 
 private:
+    // The keys a transaction was indexed under when it was added, so it can
+    // be unindexed the same way.
+    struct TransactionKeys {
+        int64_t reference_{0};
+        int64_t request_{0};
+        OTTransaction::transactionType type_{OTTransaction::error_state};
+    };
+
+    typedef std::vector<OTTransaction*> vecOfTransactions;
+    typedef std::map<int64_t, TransactionKeys> mapOfTransactionKeys;
+    typedef std::map<int64_t, std::set<int64_t>> mapOfNumbers;
+    typedef std::map<OTTransaction::transactionType, std::set<int64_t>>
+        mapOfTypes;
+
     mapOfTransactions m_mapTransactions;  // a ledger contains a map of
                                           // transactions.
+    // Same order as m_mapTransactions, for lookups by position. Rebuilt on
+    // the next lookup after anything other than an append.
+    mutable vecOfTransactions m_vecTransactions;
+    mutable bool m_bPositionsDirty{false};
+    // Transaction numbers by reference number, request number and type.
+    mapOfTransactionKeys m_mapTransactionKeys;
+    mapOfNumbers m_mapReferenceIndex;
+    mapOfNumbers m_mapRequestIndex;
+    mapOfTypes m_mapTypeIndex;
+
+    vecOfTransactions::const_iterator find_position(
+        int64_t lTransactionNum) const;
+    void index_transaction(OTTransaction& theTransaction);
+    const vecOfTransactions& positions() const;
+    void unindex_transaction(int64_t lTransactionNum);
 
 protected:
     // return -1 if error, 0 if nothing, and 1 if the node was processed.
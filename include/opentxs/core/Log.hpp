@@ -42,13 +42,16 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/BoundedQueue.hpp"
 #include "opentxs/core/String.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <deque>
 #include <iostream>
 #include <mutex>
+#include <string>
 #include <thread>
 
 #if defined(unix) || defined(__unix__) || defined(__unix) ||                   \
@@ -96,19 +99,26 @@ OTLOG_IMPORT extern OTLogStream otLog3;  // logs using OTLog::vOutput(3)
 OTLOG_IMPORT extern OTLogStream otLog4;  // logs using OTLog::vOutput(4)
 OTLOG_IMPORT extern OTLogStream otLog5;  // logs using OTLog::vOutput(5)
 
+/** Each thread formats into its own line buffer, so streams are not locked.
+ *  Streams above the current log level are kept in a failed state, which
+ *  makes operator<< return before formatting anything. */
 class OTLogStream : public std::ostream, std::streambuf
 {
 private:
     int logLevel{0};
-    int next{0};
-    char* pBuffer{nullptr};
-    std::recursive_mutex lock_;
+
+    std::string& buffer();
+    void emit(std::string& line);
 
 public:
     explicit OTLogStream(int _logLevel);
     ~OTLogStream();
 
+    /** Enable or disable the stream according to nLogLevel */
+    void SetLogLevel(std::int32_t nLogLevel);
+
     virtual int overflow(int c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
 };
 
 class Log
@@ -127,14 +137,30 @@ private:
     String m_strLogFilePath{""};
     dequeOfStrings logDeque{};
     std::recursive_mutex lock_;
+    // Lines waiting for the writer thread, which owns the log file.
+    BoundedQueue<std::string> queue_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> queued_{0};
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::thread writer_;
 
     /** For things that represent internal inconsistency in the code. Normally
      * should NEVER happen even with bad input from user. (Don't call this
      * directly. Use the above #defined macro instead.) */
     static Assert::fpt_Assert_sz_n_sz(logAssert);
     static bool CheckLogger(Log* pLogger);
+    static void update_streams();
+    static bool write_direct(const String& strOutput);
+    static bool write_line(const String& strOutput, bool bDroppable);
+
+    void flush();
+    void start_writer();
+    void stop_writer();
+    void write_thread();
 
     Log(const api::Settings& config);
+    ~Log();
     Log() = delete;
     Log(const Log&) = delete;
     Log(Log&&) = delete;
@@ -177,6 +203,9 @@ public:
     // OTLog Functions:
     //
 
+    /** Writes to stderr, and to the log file if enabled. Once the logger is
+     * initialized this hands the line to a writer thread, waiting for room if
+     * the queue is full. */
     EXPORT static bool LogToFile(const String& strOutput);
 
     /** We keep 1024 logs in memory, to make them available via the API. */
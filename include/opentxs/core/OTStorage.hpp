@@ -464,6 +464,13 @@ protected:
         const std::string& twoStr = "",
         const std::string& threeStr = "") = 0;
 
+    virtual bool onAppendPlainString(
+        const std::string& theBuffer,
+        const std::string& strFolder,
+        const std::string& oneStr = "",
+        const std::string& twoStr = "",
+        const std::string& threeStr = "") = 0;
+
     virtual bool onEraseValueByKey(
         const std::string& strFolder,
         const std::string& oneStr = "",
@@ -538,6 +545,14 @@ public:
         const std::string& twoStr = "",
         const std::string& threeStr = "");
 
+    // Adds to the end of the existing value, creating it if necessary.
+    EXPORT bool AppendPlainString(
+        const std::string& strContents,
+        const std::string& strFolder,
+        const std::string& oneStr = "",
+        const std::string& twoStr = "",
+        const std::string& threeStr = "");
+
     // Store/Retrieve an object. (Storable.)
 
     EXPORT bool StoreObject(
@@ -662,6 +677,13 @@ EXPORT std::string QueryPlainString(
     const std::string& twoStr = "",
     const std::string& threeStr = "");
 
+EXPORT bool AppendPlainString(
+    const std::string& strContents,
+    const std::string& strFolder,
+    const std::string& oneStr = "",
+    const std::string& twoStr = "",
+    const std::string& threeStr = "");
+
 // Store/Retrieve an object. (Storable.)
 //
 EXPORT bool StoreObject(
@@ -1666,6 +1688,13 @@ protected:
         const std::string& twoStr = "",
         const std::string& threeStr = "") override;
 
+    bool onAppendPlainString(
+        const std::string& theBuffer,
+        const std::string& strFolder,
+        const std::string& oneStr = "",
+        const std::string& twoStr = "",
+        const std::string& threeStr = "") override;
+
     bool onEraseValueByKey(
         const std::string& strFolder,
         const std::string& oneStr = "",
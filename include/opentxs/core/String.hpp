@@ -89,6 +89,7 @@ public:
 
     EXPORT String();
     EXPORT String(const String& value);
+    EXPORT String(String&& value);
     EXPORT explicit String(const OTASCIIArmor& value);
     EXPORT explicit String(const OTSignature& value);
     EXPORT explicit String(const Contract& value);
@@ -167,8 +168,11 @@ public:
     /** For a straight-across, exact-size copy of bytes. Source not expected to
      * be null-terminated. */
     EXPORT bool MemSet(const char* mem, uint32_t size);
+    /** Appends in place. The buffer grows geometrically, so repeated appends
+     * take amortized constant time per character. */
     EXPORT void Concatenate(const char* arg, ...) ATTR_PRINTF(2, 3);
     void Concatenate(const String& data);
+    EXPORT void Concatenate(const std::string& data);
     void Truncate(uint32_t index);
     EXPORT void Format(const char* fmt, ...) ATTR_PRINTF(2, 3);
     void ConvertToUpperCase() const;
@@ -196,10 +200,18 @@ private:
      * function ASSUMES the new_string pointer is good. */
     void LowLevelSet(const char* data, uint32_t enforcedMaxLength);
 
+    void append(const char* data, uint32_t size);
+    void deallocate();
+    /** Makes room for size characters plus the null terminator, keeping the
+     * current contents. */
+    void reserve(uint32_t size);
+
 protected:
     uint32_t length_;
     uint32_t position_;
-    char* data_;
+    uint32_t capacity_;  // not counting the null terminator
+    char* data_;  // either small_ or allocated, or nullptr if empty
+    char small_[16];
 };
 }  // namespace opentxs
 #endif  // OPENTXS_CORE_OTSTRING_HPP
@@ -46,6 +46,12 @@
 #include "opentxs/core/util/Timer.hpp"
 #include "opentxs/core/Contract.hpp"
 
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
 namespace opentxs
 {
 
@@ -57,12 +63,35 @@ class Nym;
 typedef std::map<int64_t, OTCronItem*> mapOfCronItems;
 /** multimapOfCronItems: Mapped to date the item was added to Cron. */
 typedef std::multimap<time64_t, OTCronItem*> multimapOfCronItems;
+/** Transaction numbers ordered by the time they are next due for processing.
+ */
+typedef std::set<std::pair<time64_t, int64_t>> setOfCronDeadlines;
+/** The time each scheduled transaction number is due. */
+typedef std::map<int64_t, time64_t> mapOfCronDeadlines;
 /** Mapped (uniquely) to market ID. */
 typedef std::map<std::string, OTMarket*> mapOfMarkets;
+/** Cron items mapped by each opening and closing number they contain. */
+typedef std::map<int64_t, OTCronItem*> mapOfCronItemNumbers;
+/** Where a cron item was indexed: its position on the multimap, and the
+ * numbers under which it appears in mapOfCronItemNumbers. */
+struct CronItemIndex {
+    multimapOfCronItems::iterator position_;
+    std::set<int64_t> numbers_;
+};
+/** Mapped (uniquely) to transaction number. */
+typedef std::map<int64_t, CronItemIndex> mapOfCronItemIndexes;
+/** Transaction numbers of the cron items belonging to each Nym ID. */
+typedef std::map<std::string, std::set<int64_t>> mapOfNymCronItems;
+/** The market holding each offer, by transaction number. */
+typedef std::map<int64_t, OTMarket*> mapOfOfferMarkets;
 /** Cron stores a bunch of these on this list, which the server refreshes from
  * time to time. */
 typedef std::list<int64_t> listOfLongNumbers;
 
+/** Cron items read from the cron file, with the date each was added, which
+ * have not been verified yet. */
+typedef std::list<std::pair<time64_t, OTCronItem*>> listOfPendingCronItems;
+
 /** OTCron has a list of OTCronItems. (Really subclasses of that such as OTTrade
  * and OTAgreement.) */
 class OTCron : public Contract
@@ -76,10 +105,23 @@ private:
     // Cron Items are found on both lists.
     mapOfCronItems m_mapCronItems;
     multimapOfCronItems m_multimapCronItems;
+    // Every item on the lists above is scheduled here, so each round only
+    // visits the items which are due.
+    setOfCronDeadlines m_setDeadlines;
+    mapOfCronDeadlines m_mapDeadlines;
+    // Secondary indexes, maintained by AddCronItem, RemoveCronItem and the
+    // markets, so that lookups never scan every item.
+    mapOfCronItemNumbers m_mapItemNumbers;
+    mapOfCronItemIndexes m_mapItemIndexes;
+    mapOfNymCronItems m_mapNymItems;
+    mapOfOfferMarkets m_mapOfferMarkets;
     // Always store this in any object that's associated with a specific server.
     Identifier m_NOTARY_ID;
     // I can't put receipts in people's inboxes without a supply of these.
     listOfLongNumbers m_listTransactionNumbers;
+    // Filled by ProcessXMLNode so that LoadCron can verify the signatures on
+    // every cron item in one batch before adding them.
+    listOfPendingCronItems m_listPendingItems;
     // I don't want to start Cron processing until everything else is all loaded
     //  up and ready to go.
     bool m_bIsActivated{false};
@@ -93,8 +135,15 @@ private:
     // Int. The maximum number of cron items any given Nym can have
     // active at the same time.
     static int32_t __cron_max_items_per_nym;
+    // Int. The number of changes a market records in its journal before it
+    // writes a new signed copy of itself.
+    static int32_t __market_checkpoint_interval;
 
-    static Timer tCron;
+    bool add_pending_items();
+    void index(OTCronItem& theItem, multimapOfCronItems::iterator position);
+    void schedule(const int64_t lTransactionNum, const time64_t tDue);
+    void unindex(OTCronItem& theItem);
+    void unschedule(const int64_t lTransactionNum);
 
 public:
     static int32_t GetCronMsBetweenProcess()
@@ -116,6 +165,14 @@ public:
     {
         __cron_max_items_per_nym = nMax;
     }
+    static int32_t GetMarketCheckpointInterval()
+    {
+        return __market_checkpoint_interval;
+    }
+    static void SetMarketCheckpointInterval(int32_t nInterval)
+    {
+        __market_checkpoint_interval = nInterval;
+    }
     inline bool IsActivated() const { return m_bIsActivated; }
     inline bool ActivateCron()
     {
@@ -137,6 +194,9 @@ public:
     EXPORT mapOfCronItems::iterator FindItemOnMap(int64_t lTransactionNum);
     EXPORT multimapOfCronItems::iterator FindItemOnMultimap(
         int64_t lTransactionNum);
+    /** Process the item on the next round, for example because a market
+     * event has changed its state. */
+    EXPORT void WakeCronItem(int64_t lTransactionNum);
     // MARKETS
     bool AddMarket(OTMarket& theMarket, bool bSaveMarketFile = true);
     bool RemoveMarket(const Identifier& MARKET_ID);  // if returns false,
@@ -154,6 +214,9 @@ public:
         OTASCIIArmor& ascOutput,
         const Identifier& NYM_ID,
         int32_t& nOfferCount);
+    /** Called by a market whenever an offer is placed on it or taken off. */
+    void OfferAdded(const int64_t lTransactionNum, OTMarket& theMarket);
+    void OfferRemoved(const int64_t lTransactionNum);
     // TRANSACTION NUMBERS
     /**The server starts out putting a bunch of numbers in here so Cron can use
      * them. Then the internal trades and payment plans get numbers from here as
@@ -173,7 +236,9 @@ public:
      * finished.) */
     EXPORT void ProcessCronItems();
 
-    int64_t computeTimeout();
+    /** Milliseconds until the next cron item is due. Never more than
+     * GetCronMsBetweenProcess(). */
+    int64_t computeTimeout() const;
 
     inline void SetNotaryID(const Identifier& NOTARY_ID)
     {
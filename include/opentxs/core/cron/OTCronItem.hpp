@@ -163,7 +163,8 @@ public:
     void HookRemovalFromCron(Nym* pRemover, int64_t newTransactionNo);
 
     inline bool IsFlaggedForRemoval() const { return m_bRemovalFlag; }
-    inline void FlagForRemoval() { m_bRemovalFlag = true; }
+    // Also wakes the item so that Cron removes it on the next round.
+    void FlagForRemoval();
     inline void SetCronPointer(OTCron& theCron) { m_pCron = &theCron; }
 
     EXPORT static OTCronItem* NewCronItem(const String& strCronItem);
@@ -207,6 +208,9 @@ public:
     {
         return m_PROCESS_INTERVAL;
     }
+    // The earliest time at which ProcessCron() could do anything other than
+    // return early. OTCron schedules the item for this time.
+    virtual time64_t GetNextProcessDate() const;
 
     inline OTCron* GetCron() const { return m_pCron; }
     void setServerNym(Nym* serverNym) { serverNym_ = serverNym; }
@@ -0,0 +1,106 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRYPTO_ARMORCODEC_HPP
+#define OPENTXS_CORE_CRYPTO_ARMORCODEC_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace opentxs
+{
+/** Single pass codec for the OTASCIIArmor format
+ *
+ *  Encode deflates the input and base64 encodes each block of compressed
+ *  output as soon as zlib produces it, writing straight into an output
+ *  string which is sized once from deflateBound. Decode runs the same
+ *  pipeline in reverse, feeding each block of decoded base64 to inflate.
+ *
+ *  Line breaks are inserted every 72 characters when requested. Decoding
+ *  skips any character outside the base64 alphabet and stops at the first
+ *  '=', so armor produced by earlier versions is read unchanged.
+ */
+class ArmorCodec
+{
+public:
+    /** zlib level used for armor which is stored or signed */
+    static const std::int32_t BestCompression{9};
+    /** zlib level used for armor which only crosses the network */
+    static const std::int32_t FastCompression{1};
+    static const std::size_t LineWidth{72};
+
+    /** Maximum number of base64 characters needed for size input bytes */
+    EXPORT static std::size_t EncodedSize(
+        const std::size_t size,
+        const bool lineBreaks);
+
+    /** Base64 encode without compression */
+    EXPORT static void Base64Encode(
+        const void* input,
+        const std::size_t size,
+        const bool lineBreaks,
+        std::string& output);
+    /** Base64 decode without decompression
+     *
+     *  Returns false if the input contains no base64 data */
+    EXPORT static bool Base64Decode(
+        const char* input,
+        const std::size_t size,
+        std::string& output);
+
+    /** Compress at the specified zlib level, then base64 encode */
+    EXPORT static bool Encode(
+        const void* input,
+        const std::size_t size,
+        const std::int32_t level,
+        const bool lineBreaks,
+        std::string& output);
+    /** Base64 decode, then decompress */
+    EXPORT static bool Decode(
+        const char* input,
+        const std::size_t size,
+        std::string& output);
+
+private:
+    ArmorCodec() = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_ARMORCODEC_HPP
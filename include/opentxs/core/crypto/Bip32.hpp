@@ -73,7 +73,30 @@ public:
         const EcdsaCurve& curve,
         const OTPassword& seed,
         proto::HDPath& path) const = 0;
+    /** Compressed public key and chain code of the node at path */
+    virtual bool GetPublicNode(
+        const EcdsaCurve& curve,
+        const OTPassword& seed,
+        proto::HDPath& path,
+        Data& publicKey,
+        Data& chainCode) const = 0;
+    /** Public key of a non-hardened child, derived without any private key */
+    virtual bool PublicChild(
+        const EcdsaCurve& curve,
+        const Data& publicKey,
+        const Data& chainCode,
+        const std::uint32_t index,
+        Data& child) const = 0;
 
+    /** Extended public key of an account's external or internal chain.
+     *
+     *  PublicChild() on it yields the same public keys as AccountChildKey()
+     *  without decrypting the seed again. */
+    bool AccountChainKey(
+        const proto::HDPath& path,
+        const BIP44Chain internal,
+        Data& publicKey,
+        Data& chainCode) const;
     serializedAsymmetricKey AccountChildKey(
         const proto::HDPath& path,
         const BIP44Chain internal,
@@ -46,6 +46,7 @@
 #include "opentxs/Types.hpp"
 
 #include <set>
+#include <vector>
 
 namespace opentxs
 {
@@ -55,15 +56,51 @@ class Data;
 class OTPassword;
 class OTPasswordData;
 class OTSignature;
+class VerificationCache;
 
 typedef std::multimap<std::string, OTAsymmetricKey*> mapOfAsymmetricKeys;
 
+/** One signature for CryptoAsymmetric::VerifyBatch. Nothing is copied, so the
+ *  referenced objects must outlive the call. */
+struct SignatureCheck {
+    const Data& plaintext_;
+    const OTAsymmetricKey& key_;
+    const Data& signature_;
+    const proto::HashType hashType_;
+};
+
+typedef std::vector<SignatureCheck> SignatureBatch;
+
 class CryptoAsymmetric
 {
 
+private:
+    static bool verification_fingerprint(
+        const Data& plaintext,
+        const OTAsymmetricKey& theKey,
+        const Data& signature,
+        const proto::HashType hashType,
+        std::string& output);
+
 public:
     static proto::AsymmetricKeyType CurveToKeyType(const EcdsaCurve& curve);
     static EcdsaCurve KeyTypeToCurve(const proto::AsymmetricKeyType& type);
+    /** Successful verifications shared by every engine */
+    EXPORT static VerificationCache& SignatureCache();
+    /** Verifies every item in batch, spread over several threads when the
+     *  batch is large enough. Each item is checked by its own key's engine.
+     *
+     *  \returns one result per item, in the same order as batch */
+    EXPORT static std::vector<bool> VerifyBatch(const SignatureBatch& batch);
+
+    /** Verify(), skipped if the same signature was already verified for the
+     *  same public key and message digest */
+    bool CachedVerify(
+        const Data& plaintext,
+        const OTAsymmetricKey& theKey,
+        const Data& signature,
+        const proto::HashType hashType,
+        const OTPasswordData* pPWData = nullptr) const;
 
     bool SignContract(
         const String& strContractUnsigned,
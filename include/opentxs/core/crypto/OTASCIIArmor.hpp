@@ -44,6 +44,7 @@
 #include "opentxs/core/String.hpp"
 
 #include <stdint.h>
+#include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -176,13 +177,15 @@ public:
 
     EXPORT bool GetString(String& theData, bool bLineBreaks = true) const;
     EXPORT bool SetString(const String& theData, bool bLineBreaks = true);
+    /** Compress at the specified zlib level. Use
+     *  ArmorCodec::FastCompression for messages which are only sent over
+     *  the network. */
+    EXPORT bool SetString(
+        const String& theData,
+        bool bLineBreaks,
+        std::int32_t compressionLevel);
 
 private:
-    std::string compress_string(
-        const std::string& str,
-        int32_t compressionlevel) const;
-    std::string decompress_string(const std::string& str) const;
-
     static std::unique_ptr<OTDB::OTPacker> s_pPacker;
 };
 
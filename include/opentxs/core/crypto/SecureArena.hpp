@@ -0,0 +1,165 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#ifndef OPENTXS_CORE_CRYPTO_SECUREARENA_HPP
+#define OPENTXS_CORE_CRYPTO_SECUREARENA_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace opentxs
+{
+/** Process-wide pool of page-locked memory for secrets
+ *
+ *  Memory is reserved in chunks which are locked into RAM once, when the
+ *  chunk is created, and are never returned to the system. Each chunk is cut
+ *  into slots of a single size class. Freed slots are zeroed before they go
+ *  back on their free list, so every slot handed out by Allocate() starts
+ *  out zeroed.
+ *
+ *  Requests larger than the biggest size class get their own locked mapping
+ *  which is zeroed, unlocked and unmapped again by Free().
+ */
+class SecureArena
+{
+public:
+    struct Statistics {
+        /** Number of chunks reserved so far */
+        std::size_t chunks_{0};
+        /** Bytes of chunks and large allocations locked into RAM */
+        std::size_t locked_bytes_{0};
+        /** Bytes which could not be locked, usually due to RLIMIT_MEMLOCK */
+        std::size_t unlocked_bytes_{0};
+        std::size_t slots_in_use_{0};
+        /** Sum of the size classes of the slots in use */
+        std::size_t slot_bytes_in_use_{0};
+        std::size_t large_in_use_{0};
+        std::uint64_t allocations_{0};
+        std::uint64_t frees_{0};
+    };
+
+    EXPORT static SecureArena& Get();
+    /** Slot size used for a request of the given size, or zero if the
+     *  request will get its own mapping */
+    EXPORT static std::size_t SlotSize(const std::size_t size);
+
+    /** Returns zeroed, locked memory aligned to at least 64 bytes */
+    EXPORT void* Allocate(const std::size_t size);
+    /** size must be the value passed to Allocate() */
+    EXPORT void Free(void* memory, const std::size_t size);
+    EXPORT Statistics Stats() const;
+
+private:
+    mutable std::mutex lock_;
+    std::map<std::size_t, std::vector<void*>> free_;
+    /** Large allocations and whether they are locked */
+    std::map<void*, bool> large_;
+    Statistics stats_;
+
+    static void* map(const std::size_t size, bool& locked);
+    static void unmap(void* memory, const std::size_t size, const bool locked);
+
+    bool add_chunk(const std::size_t slotSize);
+
+    SecureArena();
+    ~SecureArena() = delete;
+    SecureArena(const SecureArena&) = delete;
+    SecureArena(SecureArena&&) = delete;
+    SecureArena& operator=(const SecureArena&) = delete;
+    SecureArena& operator=(SecureArena&&) = delete;
+};
+
+/** Scratch buffer for secrets which returns its slot when it goes out of
+ *  scope */
+class SecureBuffer
+{
+public:
+    explicit SecureBuffer(const std::size_t size)
+        : size_(size)
+        , data_(static_cast<std::uint8_t*>(SecureArena::Get().Allocate(size)))
+    {
+    }
+
+    std::uint8_t* data() { return data_; }
+    const std::uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    ~SecureBuffer() { SecureArena::Get().Free(data_, size_); }
+
+private:
+    const std::size_t size_{0};
+    std::uint8_t* data_{nullptr};
+
+    SecureBuffer() = delete;
+    SecureBuffer(const SecureBuffer&) = delete;
+    SecureBuffer(SecureBuffer&&) = delete;
+    SecureBuffer& operator=(const SecureBuffer&) = delete;
+    SecureBuffer& operator=(SecureBuffer&&) = delete;
+};
+
+template <class T>
+struct SecureDelete {
+    void operator()(T* object) const
+    {
+        if (nullptr == object) { return; }
+
+        object->~T();
+        SecureArena::Get().Free(object, sizeof(T));
+    }
+};
+
+/** Owner of an object constructed in the arena by MakeSecure() */
+template <class T>
+using SecurePointer = std::unique_ptr<T, SecureDelete<T>>;
+
+template <class T, class... Args>
+SecurePointer<T> MakeSecure(Args&&... args)
+{
+    void* memory = SecureArena::Get().Allocate(sizeof(T));
+
+    return SecurePointer<T>(new (memory) T(std::forward<Args>(args)...));
+}
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_SECUREARENA_HPP
@@ -51,6 +51,7 @@
 #include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/CryptoEncoding.hpp"
 #include "opentxs/core/crypto/Ecdsa.hpp"
+#include "opentxs/core/crypto/SecureArena.hpp"
 #include "opentxs/Types.hpp"
 
 extern "C" {
@@ -122,20 +123,20 @@ private:
 
     static std::string CurveName(const EcdsaCurve& curve);
 
-    static std::unique_ptr<HDNode> InstantiateHDNode(
+    static SecurePointer<HDNode> InstantiateHDNode(
         const EcdsaCurve& curve,
         const OTPassword& seed);
-    static std::unique_ptr<HDNode> InstantiateHDNode(const EcdsaCurve& curve);
-    static std::unique_ptr<HDNode> GetChild(
+    static SecurePointer<HDNode> InstantiateHDNode(const EcdsaCurve& curve);
+    static SecurePointer<HDNode> GetChild(
         const HDNode& parent,
         const uint32_t index,
         const DerivationMode privateVersion);
 
-    std::unique_ptr<HDNode> DeriveChild(
+    SecurePointer<HDNode> DeriveChild(
         const EcdsaCurve& curve,
         const OTPassword& seed,
         proto::HDPath& path) const;
-    std::unique_ptr<HDNode> SerializedToHDNode(
+    SecurePointer<HDNode> SerializedToHDNode(
         const proto::AsymmetricKey& serialized) const;
     serializedAsymmetricKey HDNodeToSerialized(
         const proto::AsymmetricKeyType& type,
@@ -169,6 +170,18 @@ public:
         const EcdsaCurve& curve,
         const OTPassword& seed,
         proto::HDPath& path) const override;
+    bool GetPublicNode(
+        const EcdsaCurve& curve,
+        const OTPassword& seed,
+        proto::HDPath& path,
+        Data& publicKey,
+        Data& chainCode) const override;
+    bool PublicChild(
+        const EcdsaCurve& curve,
+        const Data& publicKey,
+        const Data& chainCode,
+        const std::uint32_t index,
+        Data& child) const override;
     bool RandomKeypair(OTPassword& privateKey, Data& publicKey) const override;
     std::string SeedToFingerprint(
         const EcdsaCurve& curve,
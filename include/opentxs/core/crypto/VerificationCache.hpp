@@ -0,0 +1,91 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRYPTO_VERIFICATIONCACHE_HPP
+#define OPENTXS_CORE_CRYPTO_VERIFICATIONCACHE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace opentxs
+{
+/** Bounded record of signatures which have already been verified
+ *
+ *  Entries are opaque fingerprints built by the caller from the public key,
+ *  the message digest and the signature bytes. Only successful verifications
+ *  are ever added, so a hit means the exact same signature was previously
+ *  checked against the exact same key and digest. When the cache is full the
+ *  oldest entry is evicted.
+ */
+class VerificationCache
+{
+public:
+    EXPORT explicit VerificationCache(const std::size_t capacity);
+
+    EXPORT void Add(const std::string& fingerprint);
+    std::size_t Capacity() const { return capacity_; }
+    /** Returns true if fingerprint is present, and updates the counters */
+    EXPORT bool Check(const std::string& fingerprint) const;
+    EXPORT void Clear();
+    std::uint64_t Hits() const { return hits_.load(); }
+    std::uint64_t Misses() const { return misses_.load(); }
+    EXPORT std::size_t Size() const;
+
+    ~VerificationCache() = default;
+
+private:
+    const std::size_t capacity_{0};
+    mutable std::mutex lock_;
+    std::unordered_set<std::string> entries_;
+    std::deque<const std::string*> order_;
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+
+    VerificationCache() = delete;
+    VerificationCache(const VerificationCache&) = delete;
+    VerificationCache& operator=(const VerificationCache&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_VERIFICATIONCACHE_HPP
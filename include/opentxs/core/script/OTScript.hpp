@@ -59,6 +59,7 @@ namespace opentxs
 
 class OTParty;
 class OTPartyAccount;
+class OTScriptable;
 class String;
 class OTVariable;
 
@@ -92,6 +93,9 @@ protected:
                                        // references them.
     mapOfVariables m_mapVariables;  // no need to clean this up. Script doesn't
                                     // own the variables, just references them.
+    OTScriptable* m_pContext{nullptr};  // The scriptable whose native calls
+                                        // this script dispatches to. Not
+                                        // owned.
 
     // List
     // Construction -- Destruction
@@ -114,6 +118,18 @@ public:
         m_str_display_filename = str_display_filename;
     }
 
+    // Native calls which are registered once for a pooled interpreter can't
+    // bind the object they operate on, so they look it up here at call time.
+    OTScriptable* GetContext() const { return m_pContext; }
+    void SetContext(OTScriptable* pContext) { m_pContext = pContext; }
+
+    // Records the current interpreter state (normally right after the native
+    // calls have been registered) as the state Reset() returns to.
+    virtual void SaveBaseline() {}
+    // Forgets the script, parties, accounts, variables and context of the
+    // last execution so the interpreter can be reused for another one.
+    EXPORT virtual void Reset();
+
     // The same OTSmartContract that loads all the clauses (scripts) will
     // also load all the parties, so it will call this function whenever before
     // it
@@ -141,6 +157,9 @@ public:
     // respective parties.
 
     virtual bool ExecuteScript(OTVariable* pReturnVar = nullptr);
+
+private:
+    void unregister_variables();
 };
 
 EXPORT std::shared_ptr<OTScript> OTScriptFactory(
@@ -44,6 +44,8 @@
 #if OT_SCRIPT_CHAI
 #include "opentxs/core/script/OTScript.hpp"
 
+#include <memory>
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4702)  // warning C4702: unreachable code
@@ -75,7 +77,17 @@ public:
     virtual ~OTScriptChai();
 
     bool ExecuteScript(OTVariable* pReturnVar = nullptr) override;
+    void Reset() override;
+    void SaveBaseline() override;
+
     chaiscript::ChaiScript* const chai_{nullptr};
+
+private:
+    struct Baseline;
+
+    // Set by SaveBaseline(). Reset() returns the engine to this state, and
+    // scripts run after that are parsed once and their syntax trees kept.
+    std::unique_ptr<Baseline> baseline_{nullptr};
 };
 }  // namespace opentxs
 #endif  // OT_SCRIPT_CHAI
@@ -0,0 +1,112 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_SCRIPT_OTSCRIPTPOOL_HPP
+#define OPENTXS_CORE_SCRIPT_OTSCRIPTPOOL_HPP
+
+#include "opentxs/Forward.hpp"
+#include "opentxs/Types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+
+class OTScript;
+
+/** Reusable interpreters for one script language
+ *
+ *  Creating an interpreter and registering native calls with it costs far
+ *  more than running a typical clause. The pool runs the initializer once on
+ *  each interpreter it creates, saves that state as the interpreter's
+ *  baseline, and hands interpreters out through shared pointers. When the
+ *  last copy of a pointer is released the interpreter is reset and returned
+ *  to the pool, which keeps at most maxIdle of them.
+ *
+ *  A borrowed interpreter must only be used by one thread at a time.
+ */
+class OTScriptPool
+{
+public:
+    typedef std::function<void(OTScript&)> Initializer;
+
+    EXPORT OTScriptPool(
+        const std::string& language,
+        const Initializer& initializer,
+        const std::size_t maxIdle);
+
+    /** Returns nullptr if the language is not available */
+    EXPORT std::shared_ptr<OTScript> Get();
+
+    /** Number of interpreters created so far */
+    std::size_t Created() const { return created_.load(); }
+    /** Number of interpreters waiting to be reused */
+    EXPORT std::size_t Idle() const;
+
+    EXPORT ~OTScriptPool() = default;
+
+private:
+    struct Inventory {
+        std::mutex lock_;
+        std::vector<std::shared_ptr<OTScript>> scripts_;
+    };
+
+    const std::string language_;
+    const Initializer initializer_;
+    const std::size_t max_idle_{0};
+    std::atomic<std::size_t> created_{0};
+    // Shared with the deleters of outstanding pointers, which may outlive
+    // the pool.
+    std::shared_ptr<Inventory> idle_;
+
+    std::shared_ptr<OTScript> create();
+
+    OTScriptPool() = delete;
+    OTScriptPool(const OTScriptPool&) = delete;
+    OTScriptPool(OTScriptPool&&) = delete;
+    OTScriptPool& operator=(const OTScriptPool&) = delete;
+    OTScriptPool& operator=(OTScriptPool&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_SCRIPT_OTSCRIPTPOOL_HPP
@@ -64,6 +64,7 @@ class Nym;
 class NumList;
 class OTParty;
 class OTScript;
+class OTScriptPool;
 class OTStash;
 
 typedef std::map<std::string, Account*> mapOfAccounts;
@@ -137,6 +138,9 @@ private:
         const Identifier& RECIPIENT_ACCT_ID,
         const Identifier& RECIPIENT_NYM_ID);
 
+    // Interpreters for ExecuteClauses, one pool per script language.
+    static OTScriptPool& clause_pool(const std::string& language);
+
 protected:
     void onActivate() override;  // called by
                                  // OTCronItem::HookActivationOnCron().
@@ -369,6 +373,10 @@ public:
     // (Calls the parent FYI)
     //
     void RegisterOTNativeCallsWithScript(OTScript& theScript) override;
+    // Registers the same calls with an interpreter that will be reused for
+    // many contracts. Each call operates on the contract which is the
+    // script's context at the time it is made.
+    static void RegisterPooledNativeCalls(OTScript& theScript);
 
     // Low-level.
 
@@ -47,13 +47,16 @@
 #include "opentxs/Forward.hpp"
 
 #include "opentxs/core/cron/OTCron.hpp"
+#include "opentxs/core/trade/OfferBook.hpp"
 #include "opentxs/core/trade/OTOffer.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/OTStorage.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
 
@@ -75,11 +78,10 @@ class TradeListMarket;
 #define MAX_MARKET_QUERY_DEPTH                                                 \
     50  // todo add this to the ini file. (Now that we actually have one.)
 
-// Multiple offers, mapped by price limit.
-// Using multi-map since there will be more than one offer for each single
-// price.
-// (Map would only allow a single item on the map for each price.)
-typedef std::multimap<int64_t, OTOffer*> mapOfOffers;
+// Offers grouped by price limit, best price first. Buyers pay the most first,
+// sellers ask the least first.
+typedef OfferBook<OTOffer, std::greater<int64_t>> bookOfBids;
+typedef OfferBook<OTOffer, std::less<int64_t>> bookOfAsks;
 
 // The same offers are also mapped (uniquely) to transaction number.
 typedef std::map<int64_t, OTOffer*> mapOfOffersTrnsNum;
@@ -94,8 +96,8 @@ private:
 
     OTDB::TradeListMarket* m_pTradeList{nullptr};
 
-    mapOfOffers m_mapBids;  // The buyers, ordered by price limit
-    mapOfOffers m_mapAsks;  // The sellers, ordered by price limit
+    bookOfBids m_bookBids;  // The buyers, ordered by price limit
+    bookOfAsks m_bookAsks;  // The sellers, ordered by price limit
 
     mapOfOffersTrnsNum m_mapOffers;  // All of the offers on a single list,
                                      // ordered by transaction number.
@@ -121,6 +123,13 @@ private:
     int64_t m_lLastSalePrice{0};
     std::string m_strLastSaleDate;
 
+    // Changes since the last signed copy of the market are appended to a
+    // journal. Each record is chained to the hash of the record before it,
+    // starting from the hash stored in the signed copy, and each hash is
+    // signed by the server nym.
+    std::string m_strJournalHash;
+    int32_t m_nJournalRecords{0};
+
     // The server stores a map of markets, one for each unique combination of
     // instrument definitions.
     // That's what this market class represents: one instrument definition being
@@ -141,6 +150,28 @@ private:
     // two are technically
     // interchangeable.
 
+    static std::string encode_offer(OTOffer& theOffer);
+    static std::string journal_hash(
+        const std::string& strPrevious,
+        const std::string& strRecord);
+    static std::string single_line(std::string input);
+
+    void add_trade_data(
+        const int64_t& lTransactionNum,
+        const time64_t& tDate,
+        const int64_t& lPrice,
+        const int64_t& lAmount);
+    bool append_journal(const std::string& strRecord);
+    bool apply_journal(const std::string& strRecord);
+    bool reload_offer(
+        const int64_t& lTransactionNum,
+        const std::string& strEncoded);
+    OTOffer* remove_offer(const int64_t& lTransactionNum);
+    bool replay_journal(const std::string& strMarketID);
+    std::string sign_journal(const std::string& strHash) const;
+    bool verify_journal(
+        const std::string& strHash,
+        const std::string& strSignature) const;
     void cleanup_four_accounts(
         Account* p1,
         Account* p2,
@@ -170,6 +201,9 @@ public:
         bool bSaveFile = true,
         time64_t tDateAddedToMarket = OT_TIME_ZERO);
     bool RemoveOffer(const int64_t& lTransactionNum);
+    // Records a new version of an offer that is already on the market, such
+    // as after the server signs it.
+    bool SaveOffer(OTOffer& theOffer);
     // returns general information about offers on the market
     EXPORT bool GetOfferList(
         OTASCIIArmor& ascOutput,
@@ -184,6 +218,11 @@ public:
         const Identifier& NYM_ID,
         OTDB::OfferListNym& theOutputList,
         int32_t& nNymOfferCount);
+    // Adds a single offer, if it belongs to NYM_ID.
+    bool GetNym_OfferData(
+        const Identifier& NYM_ID,
+        OTOffer& theOffer,
+        OTDB::OfferListNym& theOutputList);
 
     // Assumes a few things: Offer is part of Trade, and both have been
     // proven already to be a part of this market.
@@ -200,8 +239,8 @@ public:
     int64_t GetHighestBidPrice();
     int64_t GetLowestAskPrice();
 
-    mapOfOffers::size_type GetBidCount() { return m_mapBids.size(); }
-    mapOfOffers::size_type GetAskCount() { return m_mapAsks.size(); }
+    std::size_t GetBidCount() { return m_bookBids.size(); }
+    std::size_t GetAskCount() { return m_bookAsks.size(); }
     void SetInstrumentDefinitionID(const Identifier& INSTRUMENT_DEFINITION_ID)
     {
         m_INSTRUMENT_DEFINITION_ID = INSTRUMENT_DEFINITION_ID;
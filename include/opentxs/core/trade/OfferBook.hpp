@@ -0,0 +1,226 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_TRADE_OFFERBOOK_HPP
+#define OPENTXS_CORE_TRADE_OFFERBOOK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace opentxs
+{
+/** One side of an order book
+ *
+ *  Offers are grouped into price levels ordered best price first according
+ *  to Compare. Each level is a FIFO queue, so iterating the book visits
+ *  offers in the order they should be matched.
+ *
+ *  The book keeps a handle to the level and queue position of every offer,
+ *  keyed by transaction number, so removing an offer does not require a
+ *  search.
+ */
+template <class T, class Compare>
+class OfferBook
+{
+private:
+    typedef std::list<T*> Level;
+    typedef std::map<std::int64_t, Level, Compare> Levels;
+
+    struct Handle {
+        typename Levels::iterator level_;
+        typename Level::iterator position_;
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T* const* pointer;
+        typedef T* const& reference;
+
+        const_iterator() = default;
+
+        std::int64_t Price() const { return level_->first; }
+
+        reference operator*() const { return *position_; }
+        pointer operator->() const { return &(*position_); }
+
+        const_iterator& operator++()
+        {
+            ++position_;
+
+            if (level_->second.end() == position_) {
+                ++level_;
+
+                if (end_ != level_) { position_ = level_->second.begin(); }
+            }
+
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto output = *this;
+            ++(*this);
+
+            return output;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            if (level_ != rhs.level_) { return false; }
+
+            return (end_ == level_) || (position_ == rhs.position_);
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return false == (*this == rhs);
+        }
+
+    private:
+        friend class OfferBook;
+
+        typename Levels::const_iterator level_{};
+        typename Levels::const_iterator end_{};
+        typename Level::const_iterator position_{};
+
+        const_iterator(
+            typename Levels::const_iterator level,
+            typename Levels::const_iterator end)
+            : level_(level)
+            , end_(end)
+            , position_()
+        {
+            if (end_ != level_) { position_ = level_->second.begin(); }
+        }
+    };
+
+    /** Appends the offer to the end of the queue for its price level
+     *
+     *  Returns false if an offer with the same transaction number is already
+     *  in the book.
+     */
+    bool Add(const std::int64_t number, const std::int64_t price, T& offer)
+    {
+        if (1 == handles_.count(number)) { return false; }
+
+        auto level = levels_.emplace(price, Level{}).first;
+        auto position = level->second.insert(level->second.end(), &offer);
+        handles_.emplace(number, Handle{level, position});
+
+        return true;
+    }
+
+    /** Returns end() if there are no offers in the book
+     *
+     *  If skipZero is true, the level holding market orders (which have no
+     *  price limit) is passed over.
+     */
+    const_iterator Best(const bool skipZero = false) const
+    {
+        auto level = levels_.begin();
+
+        if (skipZero && (levels_.end() != level) && (0 == level->first)) {
+            ++level;
+        }
+
+        return const_iterator(level, levels_.end());
+    }
+
+    /** Returns 0 if the book is empty */
+    std::int64_t BestPrice(const bool skipZero = false) const
+    {
+        const auto best = Best(skipZero);
+
+        if (end() == best) { return 0; }
+
+        return best.Price();
+    }
+
+    void clear()
+    {
+        handles_.clear();
+        levels_.clear();
+    }
+
+    bool empty() const { return handles_.empty(); }
+
+    /** Returns the removed offer, or nullptr if it was not in the book */
+    T* Remove(const std::int64_t number)
+    {
+        auto it = handles_.find(number);
+
+        if (handles_.end() == it) { return nullptr; }
+
+        auto& handle = it->second;
+        auto* output = *handle.position_;
+        handle.level_->second.erase(handle.position_);
+
+        if (handle.level_->second.empty()) { levels_.erase(handle.level_); }
+
+        handles_.erase(it);
+
+        return output;
+    }
+
+    std::size_t size() const { return handles_.size(); }
+
+    const_iterator begin() const
+    {
+        return const_iterator(levels_.begin(), levels_.end());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(levels_.end(), levels_.end());
+    }
+
+private:
+    Levels levels_{};
+    std::unordered_map<std::int64_t, Handle> handles_{};
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_TRADE_OFFERBOOK_HPP
@@ -0,0 +1,155 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_BOUNDEDQUEUE_HPP
+#define OPENTXS_CORE_BOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace opentxs
+{
+/** Fixed size, lock-free, multiple producer, single consumer queue
+ *
+ *  Each slot carries a sequence number which tells producers whether the
+ *  slot is free for the current lap around the ring and tells the consumer
+ *  whether it has been filled. Producers claim slots with a compare and swap
+ *  on the head; Push() fails instead of waiting when the queue is full, so
+ *  the caller decides what to do with the item.
+ *
+ *  Pop() must only ever be called from one thread at a time.
+ */
+template <class T>
+class BoundedQueue
+{
+public:
+    /** capacity is rounded up to a power of two */
+    explicit BoundedQueue(std::size_t capacity)
+        : mask_(round_up(capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+    {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t Capacity() const { return mask_ + 1; }
+
+    /** Only exact when no Push() or Pop() is running. */
+    bool Empty() const
+    {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    bool Pop(T& item)
+    {
+        const std::size_t position = tail_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[position & mask_];
+        const std::size_t sequence =
+            cell.sequence_.load(std::memory_order_acquire);
+
+        if (sequence != position + 1) { return false; }
+
+        item = std::move(cell.item_);
+        cell.sequence_.store(position + mask_ + 1, std::memory_order_release);
+        tail_.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool Push(T&& item)
+    {
+        std::size_t position = head_.load(std::memory_order_relaxed);
+
+        while (true) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence =
+                cell.sequence_.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) -
+                                    static_cast<std::intptr_t>(position);
+
+            if (0 == difference) {
+                if (head_.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    cell.item_ = std::move(item);
+                    cell.sequence_.store(
+                        position + 1, std::memory_order_release);
+
+                    return true;
+                }
+            } else if (0 > difference) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence_{0};
+        T item_{};
+    };
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+
+    static std::size_t round_up(std::size_t capacity)
+    {
+        std::size_t output{2};
+
+        while (output < capacity) { output <<= 1; }
+
+        return output;
+    }
+
+    BoundedQueue() = delete;
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue(BoundedQueue&&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(BoundedQueue&&) = delete;
+};
+}  // namespace opentxs
+
+#endif  // OPENTXS_CORE_BOUNDEDQUEUE_HPP
@@ -0,0 +1,102 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#ifndef OPENTXS_CORE_UTIL_EXECUTOR_HPP
+#define OPENTXS_CORE_UTIL_EXECUTOR_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opentxs
+{
+/** Fixed size pool of worker threads with a timer queue
+ *
+ *  Tasks passed to Post() run on the next free worker. Tasks passed to
+ *  PostAfter() are held until their deadline and then run like any other
+ *  task, so a waiting task never occupies a thread. Tasks which are still
+ *  queued when the executor is stopped are discarded without running.
+ */
+class Executor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+
+    /** A thread count of zero means one per core */
+    EXPORT explicit Executor(const std::size_t threads);
+
+    EXPORT void Post(Task&& task) const;
+    EXPORT void PostAfter(const Clock::duration& delay, Task&& task) const;
+    /** Number of tasks waiting for a worker or for their deadline */
+    EXPORT std::size_t Queued() const;
+    /** Wait for running tasks to finish and join the workers
+     *
+     *  Must not be called from inside a task.
+     */
+    EXPORT void Stop() const;
+    std::size_t Threads() const { return threads_; }
+
+    EXPORT ~Executor();
+
+private:
+    const std::size_t threads_{0};
+    mutable std::mutex lock_;
+    mutable std::condition_variable wake_;
+    mutable bool running_{true};
+    mutable std::deque<Task> ready_;
+    mutable std::multimap<Clock::time_point, Task> timers_;
+    mutable std::vector<std::thread> workers_;
+
+    void worker() const;
+
+    Executor() = delete;
+    Executor(const Executor&) = delete;
+    Executor(Executor&&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    Executor& operator=(Executor&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_UTIL_EXECUTOR_HPP
@@ -0,0 +1,140 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_PARALLELFOR_HPP
+#define OPENTXS_CORE_PARALLELFOR_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/util/Executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace opentxs
+{
+/** Workers shared by every ParallelFor call, one per core */
+EXPORT const Executor& ParallelExecutor();
+
+/** Calls function(i) for every i in [0, count)
+ *
+ *  Indices are handed out one at a time from a shared counter to the calling
+ *  thread plus enough ParallelExecutor() workers to give each at least
+ *  perThread indices, up to the hardware thread count. Small jobs therefore
+ *  run entirely on the calling thread. Returns once every call has finished.
+ *
+ *  The calling thread keeps claiming indices until none are left, so a job
+ *  completes even if every worker is busy, and calls may be nested.
+ *
+ *  function must be safe to call concurrently for different indices.
+ */
+template <class F>
+void ParallelFor(
+    const std::size_t count,
+    const std::size_t perThread,
+    const F& function)
+{
+    const std::size_t hardware =
+        std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t batch = std::max<std::size_t>(1, perThread);
+    const std::size_t threads =
+        std::min(hardware, (count + batch - 1) / batch);
+
+    if (1 >= threads) {
+        for (std::size_t i = 0; i < count; ++i) { function(i); }
+
+        return;
+    }
+
+    // Kept alive by the workers, which may only get to run after every
+    // index has been claimed and this function has returned. function is
+    // not touched after that point.
+    struct Job {
+        const std::size_t count_;
+        const F& function_;
+        std::atomic<std::size_t> next_;
+        std::mutex lock_;
+        std::condition_variable done_;
+        std::size_t finished_;
+
+        Job(const std::size_t count, const F& function)
+            : count_(count)
+            , function_(function)
+            , next_(0)
+            , lock_()
+            , done_()
+            , finished_(0)
+        {
+        }
+
+        void run()
+        {
+            std::size_t finished{0};
+
+            for (auto i = next_++; i < count_; i = next_++) {
+                function_(i);
+                ++finished;
+            }
+
+            if (0 == finished) { return; }
+
+            std::lock_guard<std::mutex> lock(lock_);
+            finished_ += finished;
+
+            if (count_ == finished_) { done_.notify_all(); }
+        }
+    };
+
+    auto job = std::make_shared<Job>(count, function);
+    const auto& executor = ParallelExecutor();
+
+    for (std::size_t i = 1; i < threads; ++i) {
+        executor.Post([job]() -> void { job->run(); });
+    }
+
+    job->run();
+    std::unique_lock<std::mutex> lock(job->lock_);
+    job->done_.wait(lock, [&]() -> bool { return count == job->finished_; });
+}
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_PARALLELFOR_HPP
@@ -0,0 +1,91 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#ifndef OPENTXS_CORE_UTIL_SCHEDULEDTASK_HPP
+#define OPENTXS_CORE_UTIL_SCHEDULEDTASK_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/util/Executor.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace opentxs
+{
+/** Job which runs repeatedly on an Executor without owning a thread
+ *
+ *  Each pass returns how long to wait before the next one. Trigger() starts
+ *  a pass as soon as a worker is free instead of waiting for that timer. If
+ *  a pass is already running, another one follows as soon as it returns, so
+ *  passes never overlap and no trigger is lost.
+ */
+class ScheduledTask
+{
+public:
+    using Duration = Executor::Clock::duration;
+    using Pass = std::function<Duration()>;
+
+    /** A pass which returns this only runs again when triggered */
+    static Duration Idle() { return Duration::max(); }
+
+    /** The first pass is triggered by the constructor */
+    EXPORT ScheduledTask(const Executor& executor, Pass&& pass);
+
+    EXPORT std::uint64_t Passes() const;
+    EXPORT void Trigger() const;
+
+    /** Waits for a running pass to return. Must not be called from a pass. */
+    EXPORT ~ScheduledTask();
+
+private:
+    struct State;
+
+    std::shared_ptr<State> state_;
+
+    static void run(const std::shared_ptr<State>& state);
+    static void trigger(const std::shared_ptr<State>& state);
+
+    ScheduledTask() = delete;
+    ScheduledTask(const ScheduledTask&) = delete;
+    ScheduledTask(ScheduledTask&&) = delete;
+    ScheduledTask& operator=(const ScheduledTask&) = delete;
+    ScheduledTask& operator=(ScheduledTask&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_UTIL_SCHEDULEDTASK_HPP
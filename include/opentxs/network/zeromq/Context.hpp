@@ -78,6 +78,10 @@ public:
         const ReplyCallback& callback) const = 0;
     EXPORT virtual Pimpl<network::zeromq::RequestSocket> RequestSocket()
         const = 0;
+#ifndef SWIG
+    EXPORT virtual Pimpl<network::zeromq::RouterSocket> RouterSocket(
+        const RouterCallback& callback) const = 0;
+#endif  // SWIG
     EXPORT virtual Pimpl<network::zeromq::SubscribeSocket> SubscribeSocket(
         const ListenCallback& callback) const = 0;
 
@@ -0,0 +1,97 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_ROUTERCALLBACK_HPP
+#define OPENTXS_NETWORK_ZEROMQ_ROUTERCALLBACK_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <functional>
+
+#ifdef SWIG
+// clang-format off
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator+=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator==;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator!=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator<;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator<=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator>;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>::operator>=;
+%template(OTZMQRouterCallback) opentxs::Pimpl<opentxs::network::zeromq::RouterCallback>;
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::RouterCallback::Factory.*";
+%rename(ZMQRouterCallback) opentxs::network::zeromq::RouterCallback;
+// clang-format on
+#endif  // SWIG
+
+namespace opentxs
+{
+namespace network
+{
+namespace zeromq
+{
+class RouterCallback
+{
+public:
+    using ReceiveCallback =
+        std::function<void(const Data& connection, const Message& message)>;
+
+    EXPORT static OTZMQRouterCallback Factory(ReceiveCallback callback);
+
+    EXPORT virtual void Process(
+        const Data& connection,
+        const Message& message) const = 0;
+
+    EXPORT virtual ~RouterCallback() = default;
+
+protected:
+    RouterCallback() = default;
+
+private:
+    friend OTZMQRouterCallback;
+
+    virtual RouterCallback* clone() const = 0;
+
+    RouterCallback(const RouterCallback&) = delete;
+    RouterCallback(RouterCallback&&) = default;
+    RouterCallback& operator=(const RouterCallback&) = delete;
+    RouterCallback& operator=(RouterCallback&&) = default;
+};
+}  // namespace zeromq
+}  // namespace network
+}  // namespace opentxs
+#endif  // OPENTXS_NETWORK_ZEROMQ_ROUTERCALLBACK_HPP
@@ -0,0 +1,90 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_ROUTERSOCKET_HPP
+#define OPENTXS_NETWORK_ZEROMQ_ROUTERSOCKET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/network/zeromq/Socket.hpp"
+
+#include <string>
+
+namespace opentxs
+{
+namespace network
+{
+namespace zeromq
+{
+/** Asynchronous counterpart to ReplySocket
+ *
+ *  Incoming requests are delivered to the callback along with an opaque
+ *  connection identifier. Replies may be sent later, from any thread, in any
+ *  order, by passing that identifier to Send().
+ */
+class RouterSocket : virtual public Socket
+{
+public:
+    EXPORT static OTZMQRouterSocket Factory(
+        const Context& context,
+        const RouterCallback& callback);
+
+    /** Queues a reply to the peer identified by connection */
+    EXPORT virtual bool Send(const Data& connection, const std::string& reply)
+        const = 0;
+    EXPORT virtual bool SetCurve(const OTPassword& key) const = 0;
+
+    EXPORT virtual ~RouterSocket() = default;
+
+protected:
+    EXPORT RouterSocket() = default;
+
+private:
+    friend OTZMQRouterSocket;
+
+    virtual RouterSocket* clone() const = 0;
+
+    RouterSocket(const RouterSocket&) = delete;
+    RouterSocket(RouterSocket&&) = default;
+    RouterSocket& operator=(const RouterSocket&) = delete;
+    RouterSocket& operator=(RouterSocket&&) = default;
+};
+}  // namespace zeromq
+}  // namespace network
+}  // namespace opentxs
+#endif  // OPENTXS_NETWORK_ZEROMQ_ROUTERSOCKET_HPP
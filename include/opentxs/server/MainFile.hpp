@@ -41,6 +41,7 @@
 
 #include "opentxs/Forward.hpp"
 
+#include <mutex>
 #include <string>
 
 namespace opentxs
@@ -87,6 +88,9 @@ private:
     const opentxs::api::Crypto& crypto_;
     const opentxs::api::client::Wallet& wallet_;
     std::string version_;
+    // Saves are serialized so that an older snapshot of the transaction
+    // number ceiling can't overwrite a newer one.
+    std::mutex save_lock_;
 
     MainFile() = delete;
     MainFile(const MainFile&) = delete;
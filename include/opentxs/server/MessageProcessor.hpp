@@ -41,20 +41,49 @@
 
 #include "opentxs/Forward.hpp"
 
-#include "opentxs/core/Lockable.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/network/zeromq/Socket.hpp"
+#include "opentxs/Types.hpp"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace opentxs
 {
 namespace server
 {
-class MessageProcessor : Lockable
+/** Receives client requests and dispatches them to a pool of workers
+ *
+ *  Requests are partitioned by nym ID so that requests from different nyms
+ *  are processed in parallel while requests from the same nym are processed
+ *  in the order they were received.
+ *
+ *  Decoding requests and serializing replies happens outside of any lock.
+ *  Requests whose effects are limited to known nyms and accounts hold
+ *  state_lock_ in shared mode plus a lock for each of those nym and account
+ *  IDs, so requests for different nyms run in parallel. These include:
+ *
+ *  - getTransactionNumbers and processNymbox
+ *  - transfers
+ *  - processInbox requests which only accept receipts
+ *  - the commands which read a nym's or account's state
+ *
+ *  Every other command, and cron, may touch state which belongs to anyone,
+ *  so it holds state_lock_ exclusively.
+ *
+ *  Cron runs on its own thread, which sleeps until the next cron item is due
+ *  or until an exclusive command may have changed the schedule.
+ */
+class MessageProcessor
 {
 public:
     EXPORT explicit MessageProcessor(
@@ -69,16 +98,66 @@ public:
     EXPORT ~MessageProcessor();
 
 private:
+    struct Job {
+        OTData connection_;
+        std::string raw_{};
+        std::unique_ptr<Message> request_{nullptr};
+
+        Job(const Data& connection, std::string&& raw);
+        Job(Job&&) = default;
+        Job& operator=(Job&&) = default;
+    };
+
+    struct Worker {
+        std::mutex lock_{};
+        std::condition_variable cv_{};
+        std::deque<Job> queue_{};
+        std::unique_ptr<std::thread> thread_{nullptr};
+    };
+
+    struct KeyLock {
+        std::mutex lock_{};
+        std::size_t users_{0};
+    };
+
     Server& server_;
     const Flag& running_;
     [[maybe_unused]] const network::zeromq::Context& context_;
-    OTZMQReplyCallback reply_socket_callback_;
-    OTZMQReplySocket reply_socket_;
+    // Declared before the socket so that it is destroyed after the socket
+    // has stopped delivering messages to receive()
+    std::vector<std::unique_ptr<Worker>> workers_;
+    OTZMQRouterCallback frontend_callback_;
+    OTZMQRouterSocket frontend_socket_;
+    std::shared_mutex state_lock_;
+    // Nym and account locks, which exist only while in use
+    std::mutex keys_lock_;
+    std::map<std::string, std::unique_ptr<KeyLock>> keys_;
+    std::mutex cron_lock_;
+    std::condition_variable cron_cv_;
+    bool cron_wake_{false};
     std::unique_ptr<std::thread> thread_{nullptr};
 
-    bool processMessage(const std::string& messageString, std::string& reply);
-    OTZMQMessage processSocket(const network::zeromq::Message& incoming);
+    static bool request_keys(
+        const Message& request,
+        std::set<std::string>& keys);
+    static bool transaction_keys(
+        const Message& request,
+        std::set<std::string>& keys);
+
+    bool decode_request(const std::string& messageString, Message& request)
+        const;
+    void dispatch(const std::size_t index, Job&& job);
+    void lock_keys(const std::set<std::string>& keys);
+    void process_request(const Message& request, Message& reply);
+    void process_job(const std::size_t index, Job& job);
+    void receive(
+        const Data& connection,
+        const network::zeromq::Message& incoming);
     void run();
+    bool serialize_reply(const Message& message, std::string& reply) const;
+    void unlock_keys(const std::set<std::string>& keys);
+    void wake_cron();
+    void work(const std::size_t index);
 };
 }  // namespace server
 }  // namespace opentxs
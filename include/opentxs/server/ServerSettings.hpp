@@ -74,6 +74,20 @@ struct ServerSettings {
         __heartbeat_ms_between_beats = value;
     }
 
+    static std::int32_t GetWorkerThreads() { return __worker_threads; }
+
+    static void SetWorkerThreads(int32_t value) { __worker_threads = value; }
+
+    static std::int64_t GetTransactionNumberBlock()
+    {
+        return __transaction_number_block;
+    }
+
+    static void SetTransactionNumberBlock(int64_t value)
+    {
+        __transaction_number_block = value;
+    }
+
     static const std::string& GetOverrideNymID() { return __override_nym_id; }
 
     static void SetOverrideNymID(const std::string& id)
@@ -85,6 +99,10 @@ struct ServerSettings {
 
     static std::int32_t __heartbeat_no_requests;
     static std::int32_t __heartbeat_ms_between_beats;
+    // Number of threads processing client requests. 0 means one per core.
+    static std::int32_t __worker_threads;
+    // Transaction numbers reserved per main file save.
+    static std::int64_t __transaction_number_block;
 
     // The Nym who's allowed to do certain commands even if they are turned off.
     static std::string __override_nym_id;
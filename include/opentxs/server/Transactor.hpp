@@ -44,9 +44,11 @@
 #include "opentxs/core/AccountList.hpp"
 #include "opentxs/Types.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace opentxs
@@ -79,11 +81,26 @@ public:
 
     TransactionNumber transactionNumber() const { return transactionNumber_; }
 
+    /** Sets the last issued transaction number after loading the main file
+     *
+     *  The main file records the ceiling of the most recently reserved block
+     *  rather than the last issued number, so any numbers which were reserved
+     *  but not issued before a restart are skipped.
+     */
     void transactionNumber(TransactionNumber value)
     {
         transactionNumber_ = value;
+        reservedNumber_ = value;
+        ceiling_ = value;
     }
 
+    /** The transaction number ceiling to write to the main file
+     *
+     *  This is raised before the main file is saved, and may be ahead of
+     *  the numbers which can be issued until that save has succeeded.
+     */
+    TransactionNumber ceiling() const { return ceiling_; }
+
     bool addBasketAccountID(
         const Identifier& basketId,
         const Identifier& basketAccountId,
@@ -120,7 +137,14 @@ private:
     typedef std::map<std::string, std::string> BasketsMap;
 
     // This stores the last VALID AND ISSUED transaction number.
-    TransactionNumber transactionNumber_;
+    std::atomic<TransactionNumber> transactionNumber_;
+    // Numbers up to and including this one may be issued without saving the
+    // main file. Only raised once a main file holding it has been saved.
+    std::atomic<TransactionNumber> reservedNumber_;
+    // The ceiling written by every main file save. Never lowered, so a save
+    // which fails only causes numbers to be skipped.
+    std::atomic<TransactionNumber> ceiling_;
+    std::mutex reserve_lock_;
     // maps basketId with basketAccountId
     BasketsMap idToBasketMap_;
     // basket issuer account ID, which is *different* on each server, using the
@@ -131,6 +155,8 @@ private:
     AccountList voucherAccounts_;
 
     Server* server_;  // TODO: remove later when feasible
+
+    bool reserve(const TransactionNumber number);
 };
 }  // namespace server
 }  // namespace opentxs
@@ -48,7 +48,12 @@
 #include "opentxs/Types.hpp"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace opentxs
 {
@@ -99,9 +104,19 @@ public:
 
     virtual void Cleanup() = 0;
 
-    virtual ~Plugin() = default;
+    virtual ~Plugin();
 
 protected:
+    struct PendingWrite {
+        bool isTransaction_{false};
+        std::string key_{};
+        std::string value_{};
+        bool bucket_{false};
+        std::promise<bool>* promise_{nullptr};
+    };
+
+    using WriteBatch = std::vector<PendingWrite>;
+
     const StorageConfig& config_;
     const Random& random_;
 
@@ -119,11 +134,27 @@ protected:
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const = 0;
+    // Every write in the batch must have its promise satisfied before
+    // returning. Drivers override this to share transactions and fsyncs
+    // between the queued writes.
+    virtual void store_batch(const WriteBatch& batch) const;
+    // Must be called by the most derived driver before any state used by
+    // store() or store_batch() is destroyed
+    void stop_writers() const;
 
 private:
     const api::storage::Storage& storage_;
     const Digest& digest_;
     const Flag& current_bucket_;
+    mutable std::mutex write_lock_;
+    mutable std::condition_variable write_ready_;
+    mutable std::condition_variable write_space_;
+    mutable std::deque<PendingWrite> write_queue_;
+    mutable std::vector<std::thread> writers_;
+    mutable bool writers_stopped_{false};
+
+    void start_writers(const Lock& lock) const;
+    void write_worker() const;
 
     Plugin(const Plugin&) = delete;
     Plugin(Plugin&&) = delete;
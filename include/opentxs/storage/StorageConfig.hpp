@@ -68,6 +68,8 @@ public:
     std::int64_t gc_interval_ =
         C::duration_cast<C::seconds>(C::hours(1)).count();
     std::string path_{};
+    std::int64_t write_queue_size_{1024};
+    std::int64_t write_threads_{1};
     InsertCB dht_callback_{};
 
 #if OT_STORAGE_SQLITE
@@ -84,6 +86,9 @@ public:
     std::string fs_root_file_ = "root";
     std::string fs_backup_directory_{""};
     std::string fs_encrypted_backup_directory_{""};
+    // Milliseconds an unsynced write may wait for a group commit. Zero
+    // syncs every write individually.
+    std::int64_t fs_commit_window_{0};
 #endif
 
 #ifdef OT_STORAGE_SQLITE
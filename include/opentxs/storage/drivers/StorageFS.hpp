@@ -49,6 +49,9 @@
 #include <boost/iostreams/stream.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
 
 namespace opentxs
 {
@@ -92,10 +95,26 @@ private:
     typedef boost::iostreams::stream<boost::iostreams::file_descriptor_sink>
         File;
 
+    // Group commit is disabled when the window is zero
+    const std::chrono::milliseconds commit_window_;
+    mutable std::mutex directory_lock_;
+    mutable std::set<std::string> directories_;
+    mutable std::mutex pending_lock_;
+    mutable std::set<std::string> pending_files_;
+    mutable std::set<std::string> pending_directories_;
+    mutable std::chrono::steady_clock::time_point pending_since_;
+
     virtual std::string calculate_path(
         const std::string& key,
         const bool bucket,
         std::string& directory) const = 0;
+    bool flush(const Lock& lock) const;
+    void flush_expired() const;
+    bool group_commit() const { return 0 < commit_window_.count(); }
+    void mark_pending(
+        const std::string& directory,
+        const std::string& filename) const;
+    bool prepare_directory(const std::string& directory) const;
     virtual std::string prepare_read(const std::string& input) const;
     virtual std::string prepare_write(const std::string& input) const;
     std::string read_file(const std::string& filename) const;
@@ -106,12 +125,25 @@ private:
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const override;
+    void store_batch(const WriteBatch& batch) const override;
     bool sync(File& file) const;
     bool sync(int fd) const;
+    bool sync(const std::set<std::string>& directories) const;
+    bool sync(const std::string& path, const int flags) const;
+    bool sync_file(const std::string& filename) const;
     bool write_file(
         const std::string& directory,
         const std::string& filename,
         const std::string& contents) const;
+    bool write_file(
+        const std::string& filename,
+        const std::string& contents,
+        const bool syncFile) const;
+    bool write_object(
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::set<std::string>& directories) const;
 
     void Cleanup_StorageFS();
     void Init_StorageFS();
@@ -50,8 +50,9 @@ extern "C" {
 }
 
 #include <atomic>
+#include <cstdint>
+#include <map>
 #include <mutex>
-#include <sstream>
 #include <tuple>
 #include <vector>
 
@@ -81,41 +82,57 @@ public:
 private:
     typedef Plugin ot_super;
 
+    enum class Query : std::uint8_t {
+        Select = 0,
+        Upsert = 1,
+    };
+
+    using StatementKey = std::pair<std::string, Query>;
+
     friend class StorageMultiplex;
+    // Unit tests
+    friend class StorageSqlite3Test;
 
     std::string folder_;
     mutable std::mutex transaction_lock_;
     mutable OTFlag transaction_bucket_;
     mutable std::vector<std::pair<const std::string, const std::string>>
         pending_;
+    // Serializes all use of db_ and of the cached statements
+    mutable std::mutex statement_lock_;
+    mutable std::map<StatementKey, sqlite3_stmt*> statements_;
     sqlite3* db_{nullptr};
 
-    std::string bind_key(
-        const std::string& source,
-        const std::string& key,
-        const std::size_t start) const;
-    void commit(std::stringstream& sql) const;
     bool commit_transaction(const std::string& rootHash) const;
-    bool Create(const std::string& tablename) const;
+    bool Create(const Lock& lock, const std::string& tablename) const;
+    bool exec(const Lock& lock, const std::string& sql) const;
+    void finalize(const Lock& lock, const std::string& tablename) const;
     std::string GetTableName(const bool bucket) const;
     bool Select(
         const std::string& key,
         const std::string& tablename,
         std::string& value) const;
     bool Purge(const std::string& tablename) const;
-    void set_data(std::stringstream& sql) const;
-    void set_root(const std::string& rootHash, std::stringstream& sql) const;
-    void start_transaction(std::stringstream& sql) const;
+    sqlite3_stmt* statement(
+        const Lock& lock,
+        const std::string& tablename,
+        const Query type) const;
     void store(
         const bool isTransaction,
         const std::string& key,
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const override;
+    void store_batch(const WriteBatch& batch) const override;
     bool Upsert(
         const std::string& key,
         const std::string& tablename,
         const std::string& value) const;
+    bool upsert(
+        const Lock& lock,
+        const std::string& key,
+        const std::string& tablename,
+        const std::string& value) const;
 
     void Init_StorageSqlite3();
 
@@ -55,6 +55,8 @@ class Mailbox : public Node
 {
 private:
     friend class Nym;
+    // Unit tests
+    friend class ThreadTest;
 
     void init(const std::string& hash) override;
     bool save(const std::unique_lock<std::mutex>& lock) const override;
@@ -49,6 +49,9 @@
 #include <list>
 #include <map>
 #include <set>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace opentxs
 {
@@ -58,12 +61,24 @@ namespace storage
 class Mailbox;
 class Threads;
 
+/** Items are stored in pages of consecutive items, each serialized as its
+ *  own StorageThread. The thread root is an index of page hashes, so adding
+ *  an item or changing its read state only rewrites the affected page and
+ *  the index. */
 class Thread : public Node
 {
 private:
     friend class Threads;
+    // Unit tests
+    friend class ThreadTest;
     typedef std::tuple<std::size_t, std::int64_t, std::string> SortKey;
-    typedef std::map<SortKey, const proto::StorageThreadItem*> SortedItems;
+
+    struct Page {
+        std::string hash_{};
+        std::set<SortKey> keys_{};
+        std::size_t unread_{0};
+        bool dirty_{true};
+    };
 
     std::string id_;
     std::string alias_;
@@ -71,15 +86,31 @@ private:
     Mailbox& mail_inbox_;
     Mailbox& mail_outbox_;
     std::map<std::string, proto::StorageThreadItem> items_;
+    // Never empty, so that the participants are stored even when there are no
+    // items
+    mutable std::vector<Page> pages_;
+    std::size_t unread_{0};
 
     // It's important to use a sorted container for this so the thread ID can be
     // calculated deterministically
     std::set<std::string> participants_;
 
+    static SortKey sort_key(const proto::StorageThreadItem& item);
+
+    void dirty_all(const Lock& lock);
+    void erase(const Lock& lock, const proto::StorageThreadItem& item);
+    std::vector<Page>::iterator find_page(const Lock& lock, const SortKey& key);
     void init(const std::string& hash) override;
+    void init_index(const Lock& lock, const proto::StorageNymList& index);
+    void init_items(const Lock& lock, const proto::StorageThread& serialized);
+    void insert(const Lock& lock, const proto::StorageThreadItem& item);
     bool save(const Lock& lock) const override;
     proto::StorageThread serialize(const Lock& lock) const;
-    SortedItems sort(const Lock& lock) const;
+    proto::StorageThread serialize(const Lock& lock, const Page& page) const;
+    void set_unread(
+        const Lock& lock,
+        proto::StorageThreadItem& item,
+        const bool unread);
     void upgrade(const Lock& lock);
 
     Thread(
@@ -106,7 +137,11 @@ public:
     bool Check(const std::string& id) const;
     std::string ID() const;
     proto::StorageThread Items() const;
+    /** Returns the items in one page, oldest page first. The result is empty
+     *  if the page does not exist. */
+    proto::StorageThread Items(const std::size_t page) const;
     bool Migrate(const opentxs::api::storage::Driver& to) const override;
+    std::size_t Pages() const;
     std::size_t UnreadCount() const;
 
     bool Add(
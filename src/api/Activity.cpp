@@ -457,54 +457,90 @@ std::shared_ptr<proto::StorageThread> Activity::Thread(
     return output;
 }
 
+std::shared_ptr<proto::StorageThread> Activity::Thread(
+    const Identifier& nymID,
+    const Identifier& threadID,
+    const std::size_t page) const
+{
+    std::shared_ptr<proto::StorageThread> output;
+    storage_.Load(String(nymID).Get(), String(threadID).Get(), page, output);
+
+    return output;
+}
+
 void Activity::thread_preload_thread(
     const std::string nymID,
     const std::string threadID,
     const std::size_t start,
     const std::size_t count) const
 {
-    std::shared_ptr<proto::StorageThread> thread{};
-    const bool loaded = storage_.Load(nymID, threadID, thread);
+    const auto pages = storage_.ThreadPages(nymID, threadID);
 
-    if (false == loaded) {
+    if (0 == pages) {
         otErr << OT_METHOD << __FUNCTION__ << ": Unable to load thread "
               << threadID << " for nym " << nymID << std::endl;
 
         return;
     }
 
-    const std::size_t size = thread->item_size();
+    // Walk back from the newest page so that only the pages holding the
+    // requested items are loaded
+    std::size_t skipped{0};
     std::size_t cached{0};
 
-    if (start > size) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Error: start larger than size "
-              << "(" << std::to_string(start) << "/" << std::to_string(size)
-              << ")" << std::endl;
+    for (auto page = pages; (page > 0) && (cached < count); --page) {
+        std::shared_ptr<proto::StorageThread> thread{};
 
-        return;
-    }
+        if (false == storage_.Load(nymID, threadID, page - 1, thread)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Unable to load page "
+                  << std::to_string(page - 1) << " of thread " << threadID
+                  << " for nym " << nymID << std::endl;
 
-    for (auto i = (size - start); i > 0; --i) {
-        if (cached >= count) {
-            break;
+            return;
         }
 
-        const auto& item = thread->item(i - 1);
-        const auto& box = static_cast<StorageBox>(item.box());
-
-        switch (box) {
-            case StorageBox::MAILINBOX:
-            case StorageBox::MAILOUTBOX: {
-                otErr << OT_METHOD << __FUNCTION__ << ": Preloading item "
-                      << item.id() << " in thread " << threadID << std::endl;
-                MailText(Identifier(nymID), Identifier(item.id()), box);
-                ++cached;
-            } break;
-            default: {
+        for (std::size_t i = thread->item_size(); i > 0; --i) {
+            if (cached >= count) {
+                break;
+            }
+
+            if (skipped < start) {
+                ++skipped;
+
                 continue;
             }
+
+            const auto& item = thread->item(i - 1);
+            const auto& box = static_cast<StorageBox>(item.box());
+
+            switch (box) {
+                case StorageBox::MAILINBOX:
+                case StorageBox::MAILOUTBOX: {
+                    otErr << OT_METHOD << __FUNCTION__ << ": Preloading item "
+                          << item.id() << " in thread " << threadID
+                          << std::endl;
+                    MailText(Identifier(nymID), Identifier(item.id()), box);
+                    ++cached;
+                } break;
+                default: {
+                    continue;
+                }
+            }
         }
     }
+
+    if (skipped < start) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Error: start larger than size "
+              << "(" << std::to_string(start) << "/" << std::to_string(skipped)
+              << ")" << std::endl;
+    }
+}
+
+std::size_t Activity::ThreadPages(
+    const Identifier& nymID,
+    const Identifier& threadID) const
+{
+    return storage_.ThreadPages(String(nymID).Get(), String(threadID).Get());
 }
 
 ObjectList Activity::Threads(const Identifier& nym, const bool unreadOnly) const
@@ -39,6 +39,7 @@
 #include "opentxs/stdafx.hpp"
 
 #include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/network/ZMQ.hpp"
 #include "opentxs/api/Activity.hpp"
 #include "opentxs/api/ContactManager.hpp"
 #include "opentxs/api/Settings.hpp"
@@ -152,7 +153,8 @@ void Api::Init()
         config_,
         *this,
         wallet_,
-        crypto_.Encode()));
+        crypto_.Encode(),
+        zmq_));
 
     OT_ASSERT(sync_);
 
@@ -46,9 +46,7 @@
 #include "opentxs/api/crypto/Encode.hpp"
 #include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/api/Activity.hpp"
-#include "opentxs/core/crypto/AsymmetricKeySecp256k1.hpp"
 #include "opentxs/core/crypto/Bip32.hpp"
-#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/String.hpp"
@@ -92,6 +90,8 @@ Blockchain::Blockchain(
     , lock_()
     , nym_lock_()
     , account_lock_()
+    , chain_key_lock_()
+    , chain_keys_()
 {
 }
 
@@ -192,12 +192,30 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
     const Identifier& accountID,
     const std::string& label,
     const BIP44Chain chain) const
+{
+    auto allocated = AllocateAddresses(nymID, accountID, 1, label, chain);
+
+    if (allocated.empty()) { return {}; }
+
+    return std::move(allocated.front());
+}
+
+std::vector<std::unique_ptr<proto::Bip44Address>> Blockchain::
+    AllocateAddresses(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const std::uint32_t count,
+        const std::string& label,
+        const BIP44Chain chain) const
 {
     LOCK_ACCOUNT()
 
     const std::string sNymID = String(nymID).Get();
     const std::string sAccountID = String(accountID).Get();
-    std::unique_ptr<proto::Bip44Address> output{nullptr};
+    std::vector<std::unique_ptr<proto::Bip44Address>> output{};
+
+    if (0 == count) { return output; }
+
     auto account = load_account(accountLock, sNymID, sAccountID);
 
     if (false == bool(account)) {
@@ -208,25 +226,39 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
     }
 
     const auto& type = account->type();
-    const auto index =
+    const std::uint32_t first =
         chain ? account->internalindex() : account->externalindex();
 
-    if (MAX_INDEX == index) {
+    if ((MAX_INDEX < first) || (count > (MAX_INDEX - first))) {
         otErr << OT_METHOD << __FUNCTION__ << ": Account is full." << std::endl;
 
         return output;
     }
 
-    auto& newAddress = add_address(index, *account, chain);
-    newAddress.set_version(BLOCKCHAIN_VERSION);
-    newAddress.set_index(index);
-    newAddress.set_address(calculate_address(*account, chain, index));
+    std::vector<std::string> addresses{};
+
+    for (std::uint32_t index = first; index < (first + count); ++index) {
+        addresses.emplace_back(calculate_address(*account, chain, index));
+
+        if (addresses.back().empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Unable to calculate address " << index << "."
+                  << std::endl;
 
-    OT_ASSERT(false == newAddress.address().empty());
+            return output;
+        }
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        auto& newAddress = add_address(first + i, *account, chain);
+        newAddress.set_version(BLOCKCHAIN_VERSION);
+        newAddress.set_index(first + i);
+        newAddress.set_address(addresses[i]);
+        newAddress.set_label(label);
+        otErr << OT_METHOD << __FUNCTION__ << ": Address "
+              << newAddress.address() << " allocated." << std::endl;
+    }
 
-    otErr << OT_METHOD << __FUNCTION__ << ": Address " << newAddress.address()
-          << " allocated." << std::endl;
-    newAddress.set_label(label);
     const auto saved = storage_.Store(sNymID, type, *account);
 
     if (false == saved) {
@@ -236,7 +268,10 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
         return output;
     }
 
-    output.reset(new proto::Bip44Address(newAddress));
+    for (std::uint32_t i = 0; i < count; ++i) {
+        output.emplace_back(new proto::Bip44Address(
+            find_address(first + i, chain, *account)));
+    }
 
     return output;
 }
@@ -338,41 +373,25 @@ std::string Blockchain::calculate_address(
     const BIP44Chain chain,
     const std::uint32_t index) const
 {
-    const auto& path = account.path();
-    auto fingerprint = path.root();
-    auto serialized = crypto_.BIP32().AccountChildKey(path, chain, index);
+    auto chainKey = Data::Factory();
+    auto chainCode = Data::Factory();
 
-    if (false == bool(serialized)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to derive key."
-              << std::endl;
-
-        return {};
-    }
-
-    std::unique_ptr<OTAsymmetricKey> key{nullptr};
-    std::unique_ptr<AsymmetricKeySecp256k1> ecKey{nullptr};
-    key.reset(OTAsymmetricKey::KeyFactory(*serialized));
-
-    if (false == bool(key)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to instantiate key."
-              << std::endl;
-
-        return {};
-    }
-
-    ecKey.reset(dynamic_cast<AsymmetricKeySecp256k1*>(key.release()));
-
-    if (false == bool(ecKey)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Incorrect key type."
-              << std::endl;
+    if (false == chain_key(account, chain, chainKey, chainCode)) {
 
         return {};
     }
 
+    // Address keys are non-hardened children of the chain key, so only the
+    // public half is needed.
     auto pubkey = Data::Factory();
 
-    if (false == ecKey->GetPublicKey(pubkey)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to extract public key."
+    if (false == crypto_.BIP32().PublicChild(
+                     EcdsaCurve::SECP256K1,
+                     chainKey,
+                     chainCode,
+                     index,
+                     pubkey)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to derive key."
               << std::endl;
 
         return {};
@@ -415,15 +434,54 @@ std::string Blockchain::calculate_address(
     return crypto_.Encode().IdentifierEncode(preimage);
 }
 
+bool Blockchain::chain_key(
+    const proto::Bip44Account& account,
+    const BIP44Chain chain,
+    OTData& publicKey,
+    OTData& chainCode) const
+{
+    Lock lock(chain_key_lock_);
+    const auto id = std::make_pair(account.id(), chain);
+    auto it = chain_keys_.find(id);
+
+    if (chain_keys_.end() == it) {
+        // Only this step needs the seed.
+        auto key = Data::Factory();
+        auto code = Data::Factory();
+
+        if (false ==
+            crypto_.BIP32().AccountChainKey(account.path(), chain, key, code)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Unable to derive chain key." << std::endl;
+
+            return false;
+        }
+
+        it = chain_keys_.emplace(id, ChainKey{key, code}).first;
+    }
+
+    publicKey = it->second.public_key_;
+    chainCode = it->second.chain_code_;
+
+    return true;
+}
+
 proto::Bip44Address& Blockchain::find_address(
     const std::uint32_t index,
     const BIP44Chain chain,
     proto::Bip44Account& account) const
 {
-    // TODO: determine if we can prove the addresses were inserted in index
-    // order. Then we don't need to do a linear search here.
-    // Perhaps opentxs-proto should fail validation for improperly sorted
-    // Bip44Accounts
+    // add_address appends addresses in index order, so an address is normally
+    // found at the position equal to its index. Only fall back to a linear
+    // search if the account was not built that way.
+    auto& addresses = chain ? *account.mutable_internaladdress()
+                            : *account.mutable_externaladdress();
+
+    if ((index < static_cast<std::uint32_t>(addresses.size())) &&
+        (addresses.Get(index).index() == index)) {
+
+        return *addresses.Mutable(index);
+    }
 
     if (chain) {
         for (auto& address : *account.mutable_internaladdress()) {
@@ -698,6 +698,18 @@ void Native::Init_Storage()
         String(config.path_),
         config.path_,
         notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "write_queue_size",
+        config.write_queue_size_,
+        config.write_queue_size_,
+        notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "write_threads",
+        config.write_threads_,
+        config.write_threads_,
+        notUsed);
 #if OT_STORAGE_FS
     Config().CheckSet_str(
         STORAGE_CONFIG_KEY,
@@ -717,6 +729,12 @@ void Native::Init_Storage()
         String(config.fs_root_file_),
         config.fs_root_file_,
         notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "fs_commit_window",
+        config.fs_commit_window_,
+        config.fs_commit_window_,
+        notUsed);
     Config().CheckSet_str(
         STORAGE_CONFIG_KEY,
         STORAGE_CONFIG_FS_BACKUP_DIRECTORY_KEY,
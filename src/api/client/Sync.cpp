@@ -42,6 +42,7 @@
 #include "opentxs/api/client/ServerAction.hpp"
 #include "opentxs/api/client/Wallet.hpp"
 #include "opentxs/api/crypto/Encode.hpp"
+#include "opentxs/api/network/ZMQ.hpp"
 #include "opentxs/api/Api.hpp"
 #include "opentxs/api/ContactManager.hpp"
 #include "opentxs/api/Settings.hpp"
@@ -63,15 +64,26 @@
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/ext/OTPayment.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/ListenCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/SubscribeSocket.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <vector>
 
 #include "Sync.hpp"
 
 #define CONTACT_REFRESH_DAYS 1
 #define CONTRACT_DOWNLOAD_SECONDS 10
 #define MAIN_LOOP_SECONDS 5
+#define MAX_BACKOFF_SECONDS 300
 #define NYM_REGISTRATION_SECONDS 10
+#define SERVER_TIMEOUT_SECONDS 10
+#define SYNC_PASS_SECONDS 10
+#define SYNC_THREADS 4
+#define SYNC_THREADS_KEY "sync_threads"
 
 #define SHUTDOWN()                                                             \
     {                                                                          \
@@ -83,6 +95,14 @@
         Log::Sleep(std::chrono::milliseconds(50));                             \
     }
 
+#define END_PASS()                                                             \
+    {                                                                          \
+        if (!running_) {                                                       \
+                                                                               \
+            return ScheduledTask::Idle();                                      \
+        }                                                                      \
+    }
+
 #define CHECK_NYM(a)                                                           \
     {                                                                          \
         if (a.empty()) {                                                       \
@@ -184,7 +204,8 @@ Sync::Sync(
     const api::Settings& config,
     const api::Api& api,
     const api::client::Wallet& wallet,
-    const api::crypto::Encode& encoding)
+    const api::crypto::Encode& encoding,
+    const api::network::ZMQ& zmq)
     : api_lock_(apiLock)
     , running_(running)
     , ot_api_(otapi)
@@ -195,18 +216,32 @@ Sync::Sync(
     , server_action_(api.ServerAction())
     , wallet_(wallet)
     , encoding_(encoding)
+    , zmq_(zmq)
     , introduction_server_lock_()
     , nym_fetch_lock_()
     , task_status_lock_()
+    , server_state_lock_()
     , refresh_counter_(0)
-    , operations_()
+    , executor_(executor_threads())
     , server_nym_fetch_()
     , missing_nyms_()
     , missing_servers_()
     , state_machines_()
+    , server_states_()
     , introduction_server_id_()
     , task_status_()
+    , contact_update_callback_(
+          opentxs::network::zeromq::ListenCallback::Factory(
+              [this](const opentxs::network::zeromq::Message& message)
+                  -> void { this->wake_contact(message); }))
+    , contact_update_subscriber_(
+          zmq.Context().SubscribeSocket(contact_update_callback_.get()))
 {
+    // A local nym which gains a server claim may unblock queued work
+    const auto listening = contact_update_subscriber_->Start(
+        opentxs::network::zeromq::Socket::ContactUpdateEndpoint);
+
+    OT_ASSERT(listening)
 }
 
 std::pair<bool, std::size_t> Sync::accept_incoming(
@@ -363,6 +398,14 @@ void Sync::add_task(const Identifier& taskID, const ThreadStatus status) const
     task_status_[taskID] = status;
 }
 
+void Sync::back_off(StateMachine& machine, const std::chrono::seconds base)
+    const
+{
+    machine.backoff_ = std::min(
+        std::max(base, 2 * machine.backoff_),
+        std::chrono::seconds(MAX_BACKOFF_SECONDS));
+}
+
 Depositability Sync::can_deposit(
     const OTPayment& payment,
     const Identifier& recipient,
@@ -737,6 +780,7 @@ Identifier Sync::DepositPayment(
             const auto taskID(random_id());
 
             return start_task(
+                {recipientNymID, serverID},
                 taskID,
                 queue.deposit_payment_.Push(taskID, {accountIDHint, payment}));
         } break;
@@ -852,6 +896,18 @@ bool Sync::download_nymbox(
     return finish_task(taskID, success);
 }
 
+std::size_t Sync::executor_threads() const
+{
+    std::int64_t threads{0};
+    bool notUsed{false};
+    config_.CheckSet_long(
+        MASTER_SECTION, SYNC_THREADS_KEY, SYNC_THREADS, threads, notUsed);
+
+    if (0 > threads) { threads = 0; }
+
+    return static_cast<std::size_t>(threads);
+}
+
 bool Sync::extract_payment_data(
     const OTPayment& payment,
     Identifier& nymID,
@@ -944,7 +1000,11 @@ Identifier Sync::FindNym(const Identifier& nymID) const
 
     const auto taskID(random_id());
 
-    return start_task(taskID, missing_nyms_.Push(taskID, nymID));
+    const auto output =
+        start_task(taskID, missing_nyms_.Push(taskID, nymID));
+    wake_all();
+
+    return output;
 }
 
 Identifier Sync::FindNym(
@@ -956,7 +1016,10 @@ Identifier Sync::FindNym(
     auto& serverQueue = get_nym_fetch(serverIDHint);
     const auto taskID(random_id());
 
-    return start_task(taskID, serverQueue.Push(taskID, nymID));
+    const auto output = start_task(taskID, serverQueue.Push(taskID, nymID));
+    wake_server(serverIDHint);
+
+    return output;
 }
 
 Identifier Sync::FindServer(const Identifier& serverID) const
@@ -965,7 +1028,11 @@ Identifier Sync::FindServer(const Identifier& serverID) const
 
     const auto taskID(random_id());
 
-    return start_task(taskID, missing_servers_.Push(taskID, serverID));
+    const auto output =
+        start_task(taskID, missing_servers_.Push(taskID, serverID));
+    wake_all();
+
+    return output;
 }
 
 bool Sync::finish_task(const Identifier& taskID, const bool success) const
@@ -1047,15 +1114,23 @@ UniqueQueue<Identifier>& Sync::get_nym_fetch(const Identifier& serverID) const
 Sync::OperationQueue& Sync::get_operations(const ContextID& id) const
 {
     Lock lock(lock_);
-    auto& queue = operations_[id];
-    auto& thread = state_machines_[id];
+    auto& machine = state_machines_[id];
 
-    if (false == bool(thread)) {
-        thread.reset(new std::thread(
-            [id, &queue, this]() { state_machine(id, queue); }));
+    if (false == bool(machine.task_)) {
+        machine.task_.reset(new ScheduledTask(
+            executor_, [id, &machine, this]() -> ScheduledTask::Duration {
+                return pass(id, machine);
+            }));
     }
 
-    return queue;
+    return machine.queue_;
+}
+
+Sync::ServerState& Sync::get_server_state(const Identifier& serverID) const
+{
+    Lock lock(server_state_lock_);
+
+    return server_states_[serverID];
 }
 
 Identifier Sync::import_default_introduction_server(const Lock& lock) const
@@ -1092,6 +1167,38 @@ void Sync::load_introduction_server(const Lock& lock) const
         new Identifier(get_introduction_server(lock)));
 }
 
+bool Sync::lock_server(
+    const ContextID& id,
+    ServerState& server,
+    ScheduledTask::Duration& wait) const
+{
+    Lock lock(server.lock_);
+    const auto now = Executor::Clock::now();
+
+    if (now < server.retry_) {
+        wait = server.retry_ - now;
+
+        return false;
+    }
+
+    if (server.busy_) {
+        auto& waiting = server.waiting_;
+
+        if (waiting.end() == std::find(waiting.begin(), waiting.end(), id)) {
+            waiting.push_back(id);
+        }
+
+        // unlock_server() triggers this context when its turn comes
+        wait = ScheduledTask::Idle();
+
+        return false;
+    }
+
+    server.busy_ = true;
+
+    return true;
+}
+
 bool Sync::message_nym(
     const Identifier& taskID,
     const Identifier& nymID,
@@ -1155,7 +1262,27 @@ Identifier Sync::MessageContact(
     const auto taskID(random_id());
 
     return start_task(
-        taskID, queue.send_message_.Push(taskID, {recipientNymID, message}));
+        {senderNymID, serverID},
+        taskID,
+        queue.send_message_.Push(taskID, {recipientNymID, message}));
+}
+
+ScheduledTask::Duration Sync::pass(
+    const ContextID& id,
+    StateMachine& machine) const
+{
+    END_PASS()
+
+    const auto& serverID = id.second;
+    auto& server = get_server_state(serverID);
+    ScheduledTask::Duration wait{};
+
+    if (false == lock_server(id, server, wait)) { return wait; }
+
+    const auto output = state_machine(id, machine);
+    unlock_server(serverID, server);
+
+    return output;
 }
 
 bool Sync::publish_server_registration(
@@ -1188,6 +1315,7 @@ void Sync::Refresh() const
     SHUTDOWN()
 
     refresh_contacts();
+    wake_all();
     ++refresh_counter_;
 }
 
@@ -1441,7 +1569,10 @@ Identifier Sync::schedule_download_nymbox(
     auto& queue = get_operations({localNymID, serverID});
     const auto taskID(random_id());
 
-    return start_task(taskID, queue.download_nymbox_.Push(taskID, true));
+    return start_task(
+        {localNymID, serverID},
+        taskID,
+        queue.download_nymbox_.Push(taskID, true));
 }
 
 Identifier Sync::schedule_register_account(
@@ -1455,7 +1586,10 @@ Identifier Sync::schedule_register_account(
     auto& queue = get_operations({localNymID, serverID});
     const auto taskID(random_id());
 
-    return start_task(taskID, queue.register_account_.Push(taskID, unitID));
+    return start_task(
+        {localNymID, serverID},
+        taskID,
+        queue.register_account_.Push(taskID, unitID));
 }
 
 Identifier Sync::ScheduleDownloadAccount(
@@ -1469,7 +1603,10 @@ Identifier Sync::ScheduleDownloadAccount(
     auto& queue = get_operations({localNymID, serverID});
     const auto taskID(random_id());
 
-    return start_task(taskID, queue.download_account_.Push(taskID, accountID));
+    return start_task(
+        {localNymID, serverID},
+        taskID,
+        queue.download_account_.Push(taskID, accountID));
 }
 
 Identifier Sync::ScheduleDownloadContract(
@@ -1484,7 +1621,9 @@ Identifier Sync::ScheduleDownloadContract(
     const auto taskID(random_id());
 
     return start_task(
-        taskID, queue.download_contract_.Push(taskID, contractID));
+        {localNymID, serverID},
+        taskID,
+        queue.download_contract_.Push(taskID, contractID));
 }
 
 Identifier Sync::ScheduleDownloadNym(
@@ -1498,7 +1637,10 @@ Identifier Sync::ScheduleDownloadNym(
     auto& queue = get_operations({localNymID, serverID});
     const auto taskID(random_id());
 
-    return start_task(taskID, queue.check_nym_.Push(taskID, targetNymID));
+    return start_task(
+        {localNymID, serverID},
+        taskID,
+        queue.check_nym_.Push(taskID, targetNymID));
 }
 
 Identifier Sync::ScheduleDownloadNymbox(
@@ -1518,7 +1660,8 @@ Identifier Sync::ScheduleRegisterNym(
     auto& queue = get_operations({localNymID, serverID});
     const auto taskID(random_id());
 
-    return start_task(taskID, queue.register_nym_.Push(taskID, true));
+    return start_task(
+        {localNymID, serverID}, taskID, queue.register_nym_.Push(taskID, true));
 }
 
 void Sync::set_contact(const Identifier& nymID, const Identifier& serverID)
@@ -1572,7 +1715,19 @@ void Sync::start_introduction_server(const Identifier& nymID) const
 
     auto& queue = get_operations({nymID, serverID});
     const auto taskID(random_id());
-    start_task(taskID, queue.download_nymbox_.Push(taskID, true));
+    start_task(
+        {nymID, serverID}, taskID, queue.download_nymbox_.Push(taskID, true));
+}
+
+Identifier Sync::start_task(
+    const ContextID& id,
+    const Identifier& taskID,
+    const bool success) const
+{
+    const auto output = start_task(taskID, success);
+    wake(id);
+
+    return output;
 }
 
 Identifier Sync::start_task(const Identifier& taskID, bool success) const
@@ -1597,45 +1752,50 @@ void Sync::StartIntroductionServer(const Identifier& localNymID) const
     start_introduction_server(localNymID);
 }
 
-void Sync::state_machine(const ContextID id, OperationQueue& queue) const
+ScheduledTask::Duration Sync::state_machine(
+    const ContextID& id,
+    StateMachine& machine) const
 {
     const auto & [ nymID, serverID ] = id;
+    auto& queue = machine.queue_;
+
+    END_PASS()
 
     // Make sure the server contract is available
-    while (running_) {
-        if (check_server_contract(serverID)) {
-            otInfo << OT_METHOD << __FUNCTION__ << ": Server contract "
-                   << String(serverID) << " exists." << std::endl;
+    if (StateMachine::Stage::CONTRACT == machine.stage_) {
+        if (false == check_server_contract(serverID)) {
+            back_off(machine, std::chrono::seconds(CONTRACT_DOWNLOAD_SECONDS));
 
-            break;
+            return machine.backoff_;
         }
 
-        Log::Sleep(std::chrono::seconds(CONTRACT_DOWNLOAD_SECONDS));
+        otInfo << OT_METHOD << __FUNCTION__ << ": Server contract "
+               << String(serverID) << " exists." << std::endl;
+        machine.stage_ = StateMachine::Stage::REGISTRATION;
+        machine.backoff_ = std::chrono::seconds(0);
     }
 
-    SHUTDOWN()
-
-    std::shared_ptr<const ServerContext> context{nullptr};
+    END_PASS()
 
     // Make sure the nym has registered for the first time on the server
-    while (running_) {
-        if (check_registration(nymID, serverID, context)) {
-            otInfo << OT_METHOD << __FUNCTION__ << ": Nym " << String(nymID)
-                   << " has registered on server " << String(serverID)
-                   << " at least once." << std::endl;
+    if (StateMachine::Stage::REGISTRATION == machine.stage_) {
+        if (false == check_registration(nymID, serverID, machine.context_)) {
+            back_off(machine, std::chrono::seconds(NYM_REGISTRATION_SECONDS));
 
-            break;
+            return machine.backoff_;
         }
 
-        Log::Sleep(std::chrono::seconds(NYM_REGISTRATION_SECONDS));
+        otInfo << OT_METHOD << __FUNCTION__ << ": Nym " << String(nymID)
+               << " has registered on server " << String(serverID)
+               << " at least once." << std::endl;
+        machine.stage_ = StateMachine::Stage::OPERATIONS;
+        machine.backoff_ = std::chrono::seconds(0);
     }
 
-    SHUTDOWN()
-    OT_ASSERT(context)
+    END_PASS()
+    OT_ASSERT(machine.context_)
 
-    bool queueValue{false};
     bool needAdmin{false};
-    bool registerNym{false};
     bool registerNymQueued{false};
     bool downloadNymbox{false};
     Identifier taskID{};
@@ -1648,258 +1808,271 @@ void Sync::state_machine(const ContextID id, OperationQueue& queue) const
     MessageTask message;
     DepositPaymentTask deposit;
     UniqueQueue<DepositPaymentTask> depositPaymentRetry;
+    // Queued work left over when the budget runs out waits for the next pass
+    const auto deadline =
+        Executor::Clock::now() + std::chrono::seconds(SYNC_PASS_SECONDS);
+    auto expired = [&deadline]() -> bool {
+        return Executor::Clock::now() > deadline;
+    };
 
-    // Primary loop
-    while (running_) {
-        SHUTDOWN()
+    // If the local nym has updated since the last registernym operation,
+    // schedule a registernym
+    check_nym_revision(*machine.context_, queue);
 
-        // If the local nym has updated since the last registernym operation,
-        // schedule a registernym
-        check_nym_revision(*context, queue);
+    END_PASS()
 
-        SHUTDOWN()
-
-        // Register the nym, if scheduled. Keep trying until success
-        registerNym |= queueValue;
-        registerNymQueued = queue.register_nym_.Pop(taskID, queueValue);
+    // Register the nym, if scheduled. Keep trying until success
+    machine.register_nym_ |= machine.queue_value_;
+    registerNymQueued = queue.register_nym_.Pop(taskID, machine.queue_value_);
 
-        if (registerNymQueued || registerNym) {
-            registerNym |= !register_nym(taskID, nymID, serverID);
-        }
+    if (registerNymQueued || machine.register_nym_) {
+        machine.register_nym_ |= !register_nym(taskID, nymID, serverID);
+    }
 
-        SHUTDOWN()
+    END_PASS()
 
-        // If this server was added by a pairing operation that included
-        // a server password then request admin permissions on the server
-        needAdmin =
-            context->HaveAdminPassword() && (false == context->isAdmin());
+    // If this server was added by a pairing operation that included
+    // a server password then request admin permissions on the server
+    needAdmin = machine.context_->HaveAdminPassword() &&
+                (false == machine.context_->isAdmin());
 
-        if (needAdmin) {
-            serverPassword.setPassword(context->AdminPassword());
-            get_admin(nymID, serverID, serverPassword);
-        }
+    if (needAdmin) {
+        serverPassword.setPassword(machine.context_->AdminPassword());
+        get_admin(nymID, serverID, serverPassword);
+    }
 
-        SHUTDOWN()
+    END_PASS()
 
-        // This is a list of servers for which we do not have a contract.
-        // We ask all known servers on which we are registered to try to find
-        // the contracts.
-        const auto servers = missing_servers_.Copy();
+    // This is a list of servers for which we do not have a contract.
+    // We ask all known servers on which we are registered to try to find
+    // the contracts.
+    const auto servers = missing_servers_.Copy();
 
-        for (const auto & [ targetID, taskID ] : servers) {
-            SHUTDOWN()
+    for (const auto & [ targetID, taskID ] : servers) {
+        END_PASS()
 
-            if (targetID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty serverID get in here?"
-                      << std::endl;
+        if (expired()) { break; }
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__
-                       << ": Searching for server contract for "
-                       << String(targetID) << std::endl;
-            }
+        if (targetID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty serverID get in here?"
+                  << std::endl;
 
-            const auto& notUsed[[maybe_unused]] = taskID;
-            find_server(nymID, serverID, targetID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__
+                   << ": Searching for server contract for "
+                   << String(targetID) << std::endl;
         }
 
-        // This is a list of contracts (server and unit definition) which a
-        // user of this class has requested we download from this server.
-        while (queue.download_contract_.Pop(taskID, contractID)) {
-            SHUTDOWN()
+        const auto& notUsed[[maybe_unused]] = taskID;
+        find_server(nymID, serverID, targetID);
+    }
 
-            if (contractID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty contract ID get in here?"
-                      << std::endl;
+    // This is a list of contracts (server and unit definition) which a
+    // user of this class has requested we download from this server.
+    while ((false == expired()) &&
+           queue.download_contract_.Pop(taskID, contractID)) {
+        END_PASS()
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__
-                       << ": Searching for unit definition contract for "
-                       << String(contractID) << std::endl;
-            }
+        if (contractID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty contract ID get in here?"
+                  << std::endl;
 
-            download_contract(taskID, nymID, serverID, contractID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__
+                   << ": Searching for unit definition contract for "
+                   << String(contractID) << std::endl;
         }
 
-        // This is a list of nyms for which we do not have credentials..
-        // We ask all known servers on which we are registered to try to find
-        // their credentials.
-        const auto nyms = missing_nyms_.Copy();
+        download_contract(taskID, nymID, serverID, contractID);
+    }
 
-        for (const auto & [ targetID, taskID ] : nyms) {
-            SHUTDOWN()
+    // This is a list of nyms for which we do not have credentials..
+    // We ask all known servers on which we are registered to try to find
+    // their credentials.
+    const auto nyms = missing_nyms_.Copy();
 
-            if (targetID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty nymID get in here?" << std::endl;
+    for (const auto & [ targetID, taskID ] : nyms) {
+        END_PASS()
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__ << ": Searching for nym "
-                       << String(targetID) << std::endl;
-            }
+        if (expired()) { break; }
+
+        if (targetID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty nymID get in here?" << std::endl;
 
-            const auto& notUsed[[maybe_unused]] = taskID;
-            find_nym(nymID, serverID, targetID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__ << ": Searching for nym "
+                   << String(targetID) << std::endl;
         }
 
-        // This is a list of nyms which haven't been updated in a while and
-        // are known or suspected to be available on this server
-        auto& nymQueue = get_nym_fetch(serverID);
+        const auto& notUsed[[maybe_unused]] = taskID;
+        find_nym(nymID, serverID, targetID);
+    }
 
-        while (nymQueue.Pop(taskID, targetNymID)) {
-            SHUTDOWN()
+    // This is a list of nyms which haven't been updated in a while and
+    // are known or suspected to be available on this server
+    auto& nymQueue = get_nym_fetch(serverID);
 
-            if (targetNymID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty nymID get in here?" << std::endl;
+    while ((false == expired()) && nymQueue.Pop(taskID, targetNymID)) {
+        END_PASS()
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__ << ": Refreshing nym "
-                       << String(targetNymID) << std::endl;
-            }
+        if (targetNymID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty nymID get in here?" << std::endl;
 
-            download_nym(taskID, nymID, serverID, targetNymID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__ << ": Refreshing nym "
+                   << String(targetNymID) << std::endl;
         }
 
-        // This is a list of nyms which a user of this class has requested we
-        // download from this server.
-        while (queue.check_nym_.Pop(taskID, targetNymID)) {
-            SHUTDOWN()
+        download_nym(taskID, nymID, serverID, targetNymID);
+    }
 
-            if (targetNymID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty nymID get in here?" << std::endl;
+    // This is a list of nyms which a user of this class has requested we
+    // download from this server.
+    while ((false == expired()) && queue.check_nym_.Pop(taskID, targetNymID)) {
+        END_PASS()
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__ << ": Searching for nym "
-                       << String(targetNymID) << std::endl;
-            }
+        if (targetNymID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty nymID get in here?" << std::endl;
 
-            download_nym(taskID, nymID, serverID, targetNymID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__ << ": Searching for nym "
+                   << String(targetNymID) << std::endl;
         }
 
-        // This is a list of messages which need to be delivered to a nym
-        // on this server
-        while (queue.send_message_.Pop(taskID, message)) {
-            SHUTDOWN()
+        download_nym(taskID, nymID, serverID, targetNymID);
+    }
 
-            const auto & [ recipientID, text ] = message;
+    // This is a list of messages which need to be delivered to a nym
+    // on this server
+    while ((false == expired()) && queue.send_message_.Pop(taskID, message)) {
+        END_PASS()
 
-            if (recipientID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty recipient nymID get in here?"
-                      << std::endl;
+        const auto & [ recipientID, text ] = message;
 
-                continue;
-            }
+        if (recipientID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty recipient nymID get in here?"
+                  << std::endl;
 
-            message_nym(taskID, nymID, serverID, recipientID, text);
+            continue;
         }
 
-        // Download the nymbox, if this operation has been scheduled
-        if (queue.download_nymbox_.Pop(taskID, downloadNymbox)) {
-            otWarn << OT_METHOD << __FUNCTION__ << ": Downloading nymbox for "
-                   << String(nymID) << " on " << String(serverID) << std::endl;
-            registerNym |= !download_nymbox(taskID, nymID, serverID);
-        }
+        message_nym(taskID, nymID, serverID, recipientID, text);
+    }
 
-        SHUTDOWN()
+    // Download the nymbox, if this operation has been scheduled
+    if ((false == expired()) &&
+        queue.download_nymbox_.Pop(taskID, downloadNymbox)) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Downloading nymbox for "
+               << String(nymID) << " on " << String(serverID) << std::endl;
+        machine.register_nym_ |= !download_nymbox(taskID, nymID, serverID);
+    }
 
-        // Download any accounts which have been scheduled for download
-        while (queue.download_account_.Pop(taskID, accountID)) {
-            SHUTDOWN()
+    END_PASS()
 
-            if (accountID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty account ID get in here?"
-                      << std::endl;
+    // Download any accounts which have been scheduled for download
+    while ((false == expired()) &&
+           queue.download_account_.Pop(taskID, accountID)) {
+        END_PASS()
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__ << ": Downloading account "
-                       << String(accountID) << " for " << String(nymID)
-                       << " on " << String(serverID) << std::endl;
-            }
+        if (accountID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty account ID get in here?"
+                  << std::endl;
 
-            registerNym |=
-                !download_account(taskID, nymID, serverID, accountID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__ << ": Downloading account "
+                   << String(accountID) << " for " << String(nymID)
+                   << " on " << String(serverID) << std::endl;
         }
 
-        SHUTDOWN()
+        machine.register_nym_ |=
+            !download_account(taskID, nymID, serverID, accountID);
+    }
 
-        // Register any accounts which have been scheduled for creation
-        while (queue.register_account_.Pop(taskID, unitID)) {
-            SHUTDOWN()
+    END_PASS()
 
-            if (unitID.empty()) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": How did an empty unit ID get in here?" << std::endl;
+    // Register any accounts which have been scheduled for creation
+    while ((false == expired()) &&
+           queue.register_account_.Pop(taskID, unitID)) {
+        END_PASS()
 
-                continue;
-            } else {
-                otWarn << OT_METHOD << __FUNCTION__ << ": Creating account for "
-                       << String(unitID) << " on " << String(serverID)
-                       << std::endl;
-            }
+        if (unitID.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": How did an empty unit ID get in here?" << std::endl;
 
-            registerNym |= !register_account(taskID, nymID, serverID, unitID);
+            continue;
+        } else {
+            otWarn << OT_METHOD << __FUNCTION__ << ": Creating account for "
+                   << String(unitID) << " on " << String(serverID)
+                   << std::endl;
         }
 
-        SHUTDOWN()
+        machine.register_nym_ |=
+            !register_account(taskID, nymID, serverID, unitID);
+    }
 
-        // Deposit any queued payments
-        while (queue.deposit_payment_.Pop(taskID, deposit)) {
-            auto & [ accountIDHint, payment ] = deposit;
+    END_PASS()
 
-            SHUTDOWN()
-            OT_ASSERT(payment)
-
-            const auto status =
-                can_deposit(*payment, nymID, accountIDHint, nullID, accountID);
-
-            switch (status) {
-                case Depositability::READY: {
-                    registerNym |= !deposit_cheque(
-                        taskID,
-                        nymID,
-                        serverID,
-                        accountID,
-                        payment,
-                        depositPaymentRetry);
-                } break;
-                case Depositability::NOT_REGISTERED:
-                case Depositability::NO_ACCOUNT: {
-                    otWarn << OT_METHOD << __FUNCTION__
-                           << ": Temporary failure trying to deposit payment"
-                           << std::endl;
-                    depositPaymentRetry.Push(taskID, deposit);
-                } break;
-                default: {
-                    otErr << OT_METHOD << __FUNCTION__
-                          << ": Permanent failure trying to deposit payment"
-                          << std::endl;
-                }
-            }
-        }
+    // Deposit any queued payments
+    while ((false == expired()) &&
+           queue.deposit_payment_.Pop(taskID, deposit)) {
+        auto & [ accountIDHint, payment ] = deposit;
 
-        // Requeue all payments which will be retried
-        while (depositPaymentRetry.Pop(taskID, deposit)) {
-            SHUTDOWN()
+        END_PASS()
+        OT_ASSERT(payment)
+
+        const auto status =
+            can_deposit(*payment, nymID, accountIDHint, nullID, accountID);
 
-            queue.deposit_payment_.Push(taskID, deposit);
+        switch (status) {
+            case Depositability::READY: {
+                machine.register_nym_ |= !deposit_cheque(
+                    taskID,
+                    nymID,
+                    serverID,
+                    accountID,
+                    payment,
+                    depositPaymentRetry);
+            } break;
+            case Depositability::NOT_REGISTERED:
+            case Depositability::NO_ACCOUNT: {
+                otWarn << OT_METHOD << __FUNCTION__
+                       << ": Temporary failure trying to deposit payment"
+                       << std::endl;
+                depositPaymentRetry.Push(taskID, deposit);
+            } break;
+            default: {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Permanent failure trying to deposit payment"
+                      << std::endl;
+            }
         }
+    }
 
-        SHUTDOWN()
+    // Requeue all payments which will be retried
+    while (depositPaymentRetry.Pop(taskID, deposit)) {
+        END_PASS()
 
-        Log::Sleep(std::chrono::seconds(MAIN_LOOP_SECONDS));
+        queue.deposit_payment_.Push(taskID, deposit);
     }
+
+    END_PASS()
+
+    if (expired()) { return ScheduledTask::Duration::zero(); }
+
+    return std::chrono::seconds(MAIN_LOOP_SECONDS);
 }
 
 ThreadStatus Sync::Status(const Identifier& taskID) const
@@ -1929,6 +2102,41 @@ ThreadStatus Sync::Status(const Identifier& taskID) const
     return output;
 }
 
+void Sync::unlock_server(const Identifier& serverID, ServerState& server)
+    const
+{
+    const auto status = zmq_.Status(String(serverID).Get());
+    std::deque<ContextID> next{};
+    Lock lock(server.lock_);
+    server.busy_ = false;
+
+    if (ConnectionState::STALLED == status) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Server " << String(serverID)
+               << " is not responding." << std::endl;
+        server.backoff_ = std::min(
+            std::max(
+                std::chrono::seconds(SERVER_TIMEOUT_SECONDS),
+                2 * server.backoff_),
+            std::chrono::seconds(MAX_BACKOFF_SECONDS));
+        server.retry_ = Executor::Clock::now() + server.backoff_;
+        // Every waiting context needs a timer for the retry
+        next.swap(server.waiting_);
+    } else {
+        if (ConnectionState::ACTIVE == status) {
+            server.backoff_ = std::chrono::seconds(0);
+        }
+
+        if (false == server.waiting_.empty()) {
+            next.push_back(server.waiting_.front());
+            server.waiting_.pop_front();
+        }
+    }
+
+    lock.unlock();
+
+    for (const auto& id : next) { wake(id); }
+}
+
 void Sync::update_task(const Identifier& taskID, const ThreadStatus status)
     const
 {
@@ -2024,16 +2232,75 @@ Depositability Sync::valid_recipient(
     return Depositability::WRONG_RECIPIENT;
 }
 
-Sync::~Sync()
+void Sync::wake(const ContextID& id) const
+{
+    Lock lock(lock_);
+    auto it = state_machines_.find(id);
+
+    if (state_machines_.end() == it) { return; }
+
+    auto& task = it->second.task_;
+
+    if (task) { task->Trigger(); }
+}
+
+void Sync::wake_all() const
 {
-    for (auto & [ id, thread ] : state_machines_) {
+    Lock lock(lock_);
+
+    for (auto & [ id, machine ] : state_machines_) {
         const auto& notUsed[[maybe_unused]] = id;
 
-        OT_ASSERT(thread)
+        if (machine.task_) { machine.task_->Trigger(); }
+    }
+}
+
+void Sync::wake_contact(
+    const opentxs::network::zeromq::Message& message) const
+{
+    const Identifier contactID{std::string(message)};
+    const auto contact = contacts_.Contact(contactID);
+
+    if (false == bool(contact)) { return; }
+
+    const auto nyms = contact->Nyms(true);
+    Lock lock(lock_);
+
+    for (auto & [ id, machine ] : state_machines_) {
+        const auto& nymID = id.first;
+        const bool affected =
+            (nyms.end() != std::find(nyms.begin(), nyms.end(), nymID));
+
+        if (affected && machine.task_) { machine.task_->Trigger(); }
+    }
+}
+
+void Sync::wake_server(const Identifier& serverID) const
+{
+    Lock lock(lock_);
+
+    for (auto & [ id, machine ] : state_machines_) {
+        if ((serverID == id.second) && machine.task_) {
+            machine.task_->Trigger();
+        }
+    }
+}
+
+Sync::~Sync()
+{
+    std::vector<std::unique_ptr<ScheduledTask>> tasks{};
 
-        if (thread->joinable()) {
-            thread->join();
+    {
+        Lock lock(lock_);
+
+        for (auto & [ id, machine ] : state_machines_) {
+            const auto& notUsed[[maybe_unused]] = id;
+            tasks.emplace_back(std::move(machine.task_));
         }
     }
+
+    // Waits for running passes, which may need lock_, to return
+    tasks.clear();
+    executor_.Stop();
 }
 }  // namespace opentxs::api::implementation
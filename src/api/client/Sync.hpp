@@ -45,11 +45,14 @@
 #include "opentxs/core/Lockable.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/UniqueQueue.hpp"
+#include "opentxs/core/util/Executor.hpp"
+#include "opentxs/core/util/ScheduledTask.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <map>
-#include <thread>
 #include <tuple>
 
 namespace opentxs::api::client::implementation
@@ -143,6 +146,38 @@ private:
         UniqueQueue<MessageTask> send_message_;
     };
 
+    /** Per-context state which outlives a single state machine pass */
+    struct StateMachine {
+        enum class Stage : std::uint8_t {
+            CONTRACT = 0,
+            REGISTRATION = 1,
+            OPERATIONS = 2,
+        };
+
+        OperationQueue queue_{};
+        Stage stage_{Stage::CONTRACT};
+        std::chrono::seconds backoff_{0};
+        std::shared_ptr<const ServerContext> context_{nullptr};
+        bool queue_value_{false};
+        bool register_nym_{false};
+        std::unique_ptr<ScheduledTask> task_{nullptr};
+    };
+
+    /** Network state shared by every context on one server
+     *
+     *  Requests to a server are serialized by its connection, so only one
+     *  pass at a time may use it. Passes which find it busy wait in line
+     *  without holding a worker. After a request times out every context
+     *  leaves the server alone until retry_.
+     */
+    struct ServerState {
+        std::mutex lock_{};
+        bool busy_{false};
+        std::deque<ContextID> waiting_{};
+        std::chrono::seconds backoff_{0};
+        Executor::Clock::time_point retry_{};
+    };
+
     std::recursive_mutex& api_lock_;
     const Flag& running_;
     const OT_API& ot_api_;
@@ -153,17 +188,22 @@ private:
     const api::client::ServerAction& server_action_;
     const api::client::Wallet& wallet_;
     const api::crypto::Encode& encoding_;
+    const api::network::ZMQ& zmq_;
     mutable std::mutex introduction_server_lock_{};
     mutable std::mutex nym_fetch_lock_{};
     mutable std::mutex task_status_lock_{};
+    mutable std::mutex server_state_lock_{};
     mutable std::atomic<std::uint64_t> refresh_counter_{0};
-    mutable std::map<ContextID, OperationQueue> operations_;
+    Executor executor_;
     mutable std::map<Identifier, UniqueQueue<Identifier>> server_nym_fetch_;
     UniqueQueue<Identifier> missing_nyms_;
     UniqueQueue<Identifier> missing_servers_;
-    mutable std::map<ContextID, std::unique_ptr<std::thread>> state_machines_;
+    mutable std::map<ContextID, StateMachine> state_machines_;
+    mutable std::map<Identifier, ServerState> server_states_;
     mutable std::unique_ptr<Identifier> introduction_server_id_;
     mutable std::map<Identifier, ThreadStatus> task_status_;
+    OTZMQListenCallback contact_update_callback_;
+    OTZMQSubscribeSocket contact_update_subscriber_;
 
     std::pair<bool, std::size_t> accept_incoming(
         const rLock& lock,
@@ -171,6 +211,8 @@ private:
         const Identifier& accountID,
         ServerContext& context) const;
     void add_task(const Identifier& taskID, const ThreadStatus status) const;
+    void back_off(StateMachine& machine, const std::chrono::seconds base)
+        const;
     Depositability can_deposit(
         const OTPayment& payment,
         const Identifier& recipient,
@@ -215,6 +257,7 @@ private:
         const Identifier& taskID,
         const Identifier& nymID,
         const Identifier& serverID) const;
+    std::size_t executor_threads() const;
     bool extract_payment_data(
         const OTPayment& payment,
         Identifier& nymID,
@@ -236,8 +279,13 @@ private:
     Identifier get_introduction_server(const Lock& lock) const;
     UniqueQueue<Identifier>& get_nym_fetch(const Identifier& serverID) const;
     OperationQueue& get_operations(const ContextID& id) const;
+    ServerState& get_server_state(const Identifier& serverID) const;
     Identifier import_default_introduction_server(const Lock& lock) const;
     void load_introduction_server(const Lock& lock) const;
+    bool lock_server(
+        const ContextID& id,
+        ServerState& server,
+        ScheduledTask::Duration& wait) const;
     bool message_nym(
         const Identifier& taskID,
         const Identifier& nymID,
@@ -248,6 +296,8 @@ private:
         const Identifier& nymID,
         const Identifier& serverID,
         const bool forcePrimary) const;
+    ScheduledTask::Duration pass(const ContextID& id, StateMachine& machine)
+        const;
     Identifier random_id() const;
     void refresh_accounts() const;
     void refresh_contacts() const;
@@ -271,8 +321,15 @@ private:
     Identifier set_introduction_server(
         const Lock& lock,
         const ServerContract& contract) const;
+    Identifier start_task(
+        const ContextID& id,
+        const Identifier& taskID,
+        const bool success) const;
     Identifier start_task(const Identifier& taskID, bool success) const;
-    void state_machine(const ContextID id, OperationQueue& queue) const;
+    ScheduledTask::Duration state_machine(
+        const ContextID& id,
+        StateMachine& machine) const;
+    void unlock_server(const Identifier& serverID, ServerState& server) const;
     void update_task(const Identifier& taskID, const ThreadStatus status) const;
     void start_introduction_server(const Identifier& nymID) const;
     Depositability valid_account(
@@ -286,6 +343,11 @@ private:
         const OTPayment& payment,
         const Identifier& specifiedNymID,
         const Identifier& recipient) const;
+    void wake(const ContextID& id) const;
+    void wake_all() const;
+    void wake_contact(
+        const opentxs::network::zeromq::Message& message) const;
+    void wake_server(const Identifier& serverID) const;
 
     Sync(
         std::recursive_mutex& apiLock,
@@ -296,7 +358,8 @@ private:
         const api::Settings& config,
         const api::Api& api,
         const api::client::Wallet& wallet,
-        const api::crypto::Encode& encoding);
+        const api::crypto::Encode& encoding,
+        const api::network::ZMQ& zmq);
     Sync() = delete;
     Sync(const Sync&) = delete;
     Sync(Sync&&) = delete;
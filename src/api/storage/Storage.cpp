@@ -502,6 +502,34 @@ bool Storage::Load(
     return bool(thread);
 }
 
+bool Storage::Load(
+    const std::string& nymId,
+    const std::string& threadId,
+    const std::size_t page,
+    std::shared_ptr<proto::StorageThread>& thread) const
+{
+    const bool exists =
+        Root().Tree().NymNode().Nym(nymId).Threads().Exists(threadId);
+
+    if (!exists) {
+        return false;
+    }
+
+    const auto& node =
+        Root().Tree().NymNode().Nym(nymId).Threads().Thread(threadId);
+
+    if (page >= node.Pages()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Thread " << threadId
+              << " has no page " << page << std::endl;
+
+        return false;
+    }
+
+    thread.reset(new proto::StorageThread(node.Items(page)));
+
+    return bool(thread);
+}
+
 bool Storage::Load(
     const std::string& id,
     std::shared_ptr<proto::UnitDefinition>& contract,
@@ -1518,6 +1546,26 @@ std::string Storage::ThreadAlias(
         .Alias();
 }
 
+std::size_t Storage::ThreadPages(
+    const std::string& nymID,
+    const std::string& threadID) const
+{
+    const bool exists =
+        Root().Tree().NymNode().Nym(nymID).Threads().Exists(threadID);
+
+    if (!exists) {
+        return 0;
+    }
+
+    return Root()
+        .Tree()
+        .NymNode()
+        .Nym(nymID)
+        .Threads()
+        .Thread(threadID)
+        .Pages();
+}
+
 std::string Storage::UnitDefinitionAlias(const std::string& id) const
 {
     return Root().Tree().UnitNode().Alias(id);
@@ -192,6 +192,11 @@ public:
         const std::string& nymId,
         const std::string& threadId,
         std::shared_ptr<proto::StorageThread>& thread) const override;
+    bool Load(
+        const std::string& nymId,
+        const std::string& threadId,
+        const std::size_t page,
+        std::shared_ptr<proto::StorageThread>& thread) const override;
     bool Load(
         const std::string& id,
         std::shared_ptr<proto::UnitDefinition>& contract,
@@ -294,6 +299,9 @@ public:
     std::string ThreadAlias(
         const std::string& nymID,
         const std::string& threadID) const override;
+    std::size_t ThreadPages(
+        const std::string& nymID,
+        const std::string& threadID) const override;
     std::string UnitDefinitionAlias(const std::string& id) const override;
     ObjectList UnitDefinitionList() const override;
     std::size_t UnreadCount(
@@ -63,6 +63,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -624,7 +625,7 @@ void Mint::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // return -1 if error, 0 if nothing, and 1 if the node was processed.
@@ -882,4 +883,38 @@ void Mint::GenerateNewMint(
     }
 }
 
+std::vector<bool> Mint::SignTokens(
+    const Nym& theNotary,
+    const std::vector<Token*>& tokens,
+    std::vector<String>& output,
+    int32_t nTokenIndex)
+{
+    std::vector<bool> signedTokens(tokens.size(), false);
+    output.clear();
+    output.resize(tokens.size());
+
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        OT_ASSERT(nullptr != tokens[i]);
+
+        signedTokens[i] =
+            SignToken(theNotary, *tokens[i], output[i], nTokenIndex);
+    }
+
+    return signedTokens;
+}
+
+std::vector<bool> Mint::VerifyTokens(
+    const Nym& theNotary,
+    std::vector<std::pair<String, int64_t>>& tokens)
+{
+    std::vector<bool> verified(tokens.size(), false);
+
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        auto& token = tokens[i];
+        verified[i] = VerifyToken(theNotary, token.first, token.second);
+    }
+
+    return verified;
+}
+
 }  // namespace opentxs
@@ -49,7 +49,10 @@
 #endif
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
+#include "opentxs/core/crypto/SecureArena.hpp"
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
 
@@ -58,12 +61,21 @@
 #include <openssl/ossl_typ.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <utility>
+#include <vector>
 
 #ifdef __APPLE__
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 
+#define OT_MINT_BATCH_PER_THREAD 4
+
 namespace opentxs
 {
 
@@ -91,6 +103,64 @@ MintLucre::MintLucre(
 
 MintLucre::~MintLucre() {}
 
+void MintLucre::Release()
+{
+    {
+        Lock lock(bank_lock_);
+        banks_.clear();
+    }
+
+    ot_super::Release();
+}
+
+// Opening the envelope which seals a private bank is an asymmetric
+// decryption, so each denomination is opened once and kept in locked memory
+// for as long as tokens of this series can still be valid.
+std::shared_ptr<const SecureBuffer> MintLucre::unsealed_bank(
+    const Nym& theNotary,
+    int64_t lDenomination)
+{
+    const std::string notary = String(theNotary.ID()).Get();
+    const bool expired =
+        (0 < m_VALID_TO) && (OTTimeGetCurrentTime() > m_VALID_TO);
+
+    {
+        Lock lock(bank_lock_);
+
+        if (expired) { banks_.clear(); }
+
+        auto it = banks_.find(lDenomination);
+
+        if ((banks_.end() != it) && (notary == it->second.first)) {
+            return it->second.second;
+        }
+    }
+
+    OTASCIIArmor thePrivate;
+    GetPrivate(thePrivate, lDenomination);
+
+    // The Mint private info is encrypted in m_mapPrivate[lDenomination].
+    // So I need to extract that first before I can use it.
+    OTEnvelope theEnvelope(thePrivate);
+
+    String strContents;  // output from opening the envelope.
+    // Decrypt the Envelope into strContents
+    if (!theEnvelope.Open(theNotary, strContents)) return {};
+
+    if (0 == strContents.GetLength()) { return {}; }
+
+    auto output = std::make_shared<SecureBuffer>(strContents.GetLength());
+    std::memcpy(output->data(), strContents.Get(), output->size());
+    strContents.zeroMemory();
+
+    if (false == expired) {
+        Lock lock(bank_lock_);
+        banks_[lDenomination] = {notary, output};
+    }
+
+    return output;
+}
+
 // The mint has a different key pair for each denomination.
 // Pass the actual denomination such as 5, 10, 20, 50, 100...
 bool MintLucre::AddDenomination(
@@ -183,6 +253,11 @@ bool MintLucre::AddDenomination(
         m_mapPublic[lDenomination] = pPublic;
         m_mapPrivate[lDenomination] = pPrivate;
 
+        {
+            Lock lock(bank_lock_);
+            banks_.erase(lDenomination);
+        }
+
         // Grab the Server Nym ID and save it with this Mint
         theNotary.GetIdentifier(m_ServerNymID);
         m_nDenominationCount++;
@@ -195,6 +270,103 @@ bool MintLucre::AddDenomination(
 
 #if OT_CRYPTO_USING_OPENSSL
 
+namespace
+{
+std::unique_ptr<Bank> load_bank(const SecureBuffer& privateBank)
+{
+    OpenSSL_BIO bio = BIO_new(BIO_s_mem());
+    BIO_write(
+        bio, privateBank.data(), static_cast<int>(privateBank.size()));
+
+    return std::unique_ptr<Bank>(new Bank(bio));
+}
+
+/** Banks for the workers of one batch
+ *
+ *  A Lucre bank keeps its own BN_CTX, so a bank can only be used by one
+ *  thread at a time. Workers borrow a bank for each token, which means no
+ *  more banks are loaded per denomination than there are workers.
+ */
+class BankShelf
+{
+public:
+    typedef std::map<int64_t, std::shared_ptr<const SecureBuffer>> Keys;
+
+    std::unique_ptr<Bank> Borrow(const int64_t denomination)
+    {
+        {
+            Lock lock(lock_);
+            auto& idle = idle_[denomination];
+
+            if (false == idle.empty()) {
+                auto output = std::move(idle.back());
+                idle.pop_back();
+
+                return output;
+            }
+        }
+
+        const auto key = keys_.find(denomination);
+
+        if ((keys_.end() == key) || (false == bool(key->second))) {
+            return {};
+        }
+
+        return load_bank(*key->second);
+    }
+
+    void Return(const int64_t denomination, std::unique_ptr<Bank>&& bank)
+    {
+        Lock lock(lock_);
+        idle_[denomination].emplace_back(std::move(bank));
+    }
+
+    explicit BankShelf(const Keys& keys)
+        : keys_(keys)
+        , lock_()
+        , idle_()
+    {
+    }
+
+private:
+    const Keys& keys_;
+    std::mutex lock_;
+    std::map<int64_t, std::vector<std::unique_ptr<Bank>>> idle_;
+};
+
+bool verify_coin(Bank& bank, String& theCleartextToken)
+{
+    OpenSSL_BIO bioCoin = BIO_new(BIO_s_mem());  // input
+
+    // --- copy theCleartextToken to bioCoin so lucre can load it
+    BIO_puts(bioCoin, theCleartextToken.Get());
+
+    Coin coin(bioCoin);
+
+    // Here's the boolean output: coin is verified!
+    //
+    // (Done): When a token is redeemed, need to store it in the spent token
+    // database. Right now I can verify the token, but unless I check it
+    // against a database, then even though the signature verifies, it
+    // doesn't stop people from redeeming the same token again and again and
+    // again.
+    //
+    // (done): also need to make sure issuer has double-entries for total
+    // amount outstanding.
+    //
+    // UPDATE: These are both done now.  The Spent Token database is
+    // implemented in the transaction server, (not OTLib proper) and the same
+    // server also now keeps a cash account to match all cash withdrawals.
+    // (Meaning, if 10,000 clams total have been withdrawn by various users,
+    // then the server actually has a clam account containing 10,000 clams.
+    // As the cash comes in for redemption, the server debits it from this
+    // account again before sending it to its final destination. This way the
+    // server tracks total outstanding amount, as an additional level of
+    // security after the blind signature itself.)
+    return bank.Verify(coin);
+}
+}  // namespace
+
 // Lucre step 3: the mint signs the token
 //
 bool MintLucre::SignToken(
@@ -203,31 +375,29 @@ bool MintLucre::SignToken(
     String& theOutput,
     int32_t nTokenIndex)
 {
-    bool bReturnValue = false;
-
     LucreDumper setDumper;
 
-    OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());       // input
-    OpenSSL_BIO bioRequest = BIO_new(BIO_s_mem());    // input
-    OpenSSL_BIO bioSignature = BIO_new(BIO_s_mem());  // output
+    const auto privateBank =
+        unsealed_bank(theNotary, theToken.GetDenomination());
 
-    OTASCIIArmor thePrivate;
-    GetPrivate(thePrivate, theToken.GetDenomination());
+    if (false == bool(privateBank)) { return false; }
 
-    // The Mint private info is encrypted in
-    // m_mapPrivates[theToken.GetDenomination()].
-    // So I need to extract that first before I can use it.
-    OTEnvelope theEnvelope(thePrivate);
+    // Instantiate the Bank with its private key
+    auto bank = load_bank(*privateBank);
 
-    String strContents;  // output from opening the envelope.
-    // Decrypt the Envelope into strContents
-    if (!theEnvelope.Open(theNotary, strContents)) return false;
+    return sign_token(*bank, theToken, theOutput, nTokenIndex);
+}
 
-    // copy strContents to a BIO
-    BIO_puts(bioBank, strContents.Get());
+bool MintLucre::sign_token(
+    Bank& bank,
+    Token& theToken,
+    String& theOutput,
+    int32_t nTokenIndex)
+{
+    bool bReturnValue = false;
 
-    // Instantiate the Bank with its private key
-    Bank bank(bioBank);
+    OpenSSL_BIO bioRequest = BIO_new(BIO_s_mem());    // input
+    OpenSSL_BIO bioSignature = BIO_new(BIO_s_mem());  // output
 
     // I need the request. the prototoken.
     OTASCIIArmor ascPrototoken;
@@ -282,10 +452,6 @@ bool MintLucre::SignToken(
                 // it, though.)
                 theToken.SetSpendable(ascPrototoken);
 
-                // Base64-encode the signature contents into
-                // theToken.m_Signature.
-                String strSignature(sig_buf);
-
                 // Here we pass the signature back to the caller.
                 // He will probably set it onto the token.
                 theOutput.Set(sig_buf, sig_len);
@@ -304,6 +470,52 @@ bool MintLucre::SignToken(
     return bReturnValue;
 }
 
+// The blind signatures are independent of each other, so after each
+// denomination has been unsealed once on this thread they are computed in
+// parallel.
+std::vector<bool> MintLucre::SignTokens(
+    const Nym& theNotary,
+    const std::vector<Token*>& tokens,
+    std::vector<String>& output,
+    int32_t nTokenIndex)
+{
+    LucreDumper setDumper;
+    BankShelf::Keys keys;
+    // std::vector<bool> packs its elements, so the workers write to bytes.
+    std::vector<std::uint8_t> signedTokens(tokens.size(), 0);
+    output.clear();
+    output.resize(tokens.size());
+
+    for (const auto& token : tokens) {
+        OT_ASSERT(nullptr != token);
+
+        const auto denomination = token->GetDenomination();
+
+        if (0 == keys.count(denomination)) {
+            keys[denomination] = unsealed_bank(theNotary, denomination);
+        }
+    }
+
+    BankShelf shelf(keys);
+
+    ParallelFor(
+        tokens.size(),
+        OT_MINT_BATCH_PER_THREAD,
+        [&](const std::size_t i) -> void {
+            auto& token = *tokens[i];
+            const auto denomination = token.GetDenomination();
+            auto bank = shelf.Borrow(denomination);
+
+            if (false == bool(bank)) { return; }
+
+            signedTokens[i] =
+                sign_token(*bank, token, output[i], nTokenIndex);
+            shelf.Return(denomination, std::move(bank));
+        });
+
+    return std::vector<bool>(signedTokens.begin(), signedTokens.end());
+}
+
 // Lucre step 5: mint verifies token when it is redeemed by merchant.
 // This function is called by OTToken::VerifyToken.
 // That's the one you should be calling, most likely, not this one.
@@ -312,63 +524,49 @@ bool MintLucre::VerifyToken(
     String& theCleartextToken,
     int64_t lDenomination)
 {
-    bool bReturnValue = false;
     LucreDumper setDumper;
 
-    OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());  // input
-    OpenSSL_BIO bioCoin = BIO_new(BIO_s_mem());  // input
+    const auto privateBank = unsealed_bank(theNotary, lDenomination);
 
-    // --- copy theCleartextToken to bioCoin so lucre can load it
-    BIO_puts(bioCoin, theCleartextToken.Get());
+    if (false == bool(privateBank)) { return false; }
 
-    // --- The Mint private info is encrypted in m_mapPrivate[lDenomination].
-    // So I need to extract that first before I can use it.
-    OTASCIIArmor theArmor;
-    GetPrivate(theArmor, lDenomination);
-    OTEnvelope theEnvelope(theArmor);
+    auto bank = load_bank(*privateBank);
 
-    String strContents;  // will contain output from opening the envelope.
-    // Decrypt the Envelope into strContents
-    if (theEnvelope.Open(theNotary, strContents)) {
-        // copy strContents to a BIO
-        BIO_puts(bioBank, strContents.Get());
+    return verify_coin(*bank, theCleartextToken);
+}
 
-        // ---- Now the bank and coin bios are both ready to go...
+std::vector<bool> MintLucre::VerifyTokens(
+    const Nym& theNotary,
+    std::vector<std::pair<String, int64_t>>& tokens)
+{
+    LucreDumper setDumper;
+    BankShelf::Keys keys;
+    std::vector<std::uint8_t> verified(tokens.size(), 0);
 
-        Bank bank(bioBank);
-        Coin coin(bioCoin);
+    for (const auto& token : tokens) {
+        const auto denomination = token.second;
 
-        if (bank.Verify(coin))  // Here's the boolean output: coin is verified!
-        {
-            bReturnValue = true;
-
-            // (Done): When a token is redeemed, need to store it in the spent
-            // token database.
-            // Right now I can verify the token, but unless I check it against a
-            // database, then
-            // even though the signature verifies, it doesn't stop people from
-            // redeeming the same
-            // token again and again and again.
-            //
-            // (done): also need to make sure issuer has double-entries for
-            // total amount outstanding.
-            //
-            // UPDATE: These are both done now.  The Spent Token database is
-            // implemented in the transaction server,
-            // (not OTLib proper) and the same server also now keeps a cash
-            // account to match all cash withdrawals.
-            // (Meaning, if 10,000 clams total have been withdrawn by various
-            // users, then the server actually has
-            // a clam account containing 10,000 clams. As the cash comes in for
-            // redemption, the server debits it from
-            // this account again before sending it to its final destination.
-            // This way the server tracks total outstanding
-            // amount, as an additional level of security after the blind
-            // signature itself.)
+        if (0 == keys.count(denomination)) {
+            keys[denomination] = unsealed_bank(theNotary, denomination);
         }
     }
 
-    return bReturnValue;
+    BankShelf shelf(keys);
+
+    ParallelFor(
+        tokens.size(),
+        OT_MINT_BATCH_PER_THREAD,
+        [&](const std::size_t i) -> void {
+            auto& token = tokens[i];
+            auto bank = shelf.Borrow(token.second);
+
+            if (false == bool(bank)) { return; }
+
+            verified[i] = verify_coin(*bank, token.first);
+            shelf.Return(token.second, std::move(bank));
+        });
+
+    return std::vector<bool>(verified.begin(), verified.end());
 }
 #endif  // OT_CRYPTO_USING_OPENSSL
 #endif  // OT_CASH_USING_LUCRE
@@ -972,7 +972,7 @@ void Purse::UpdateContents()  // Before transmission or serialization, this is
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 int32_t Purse::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
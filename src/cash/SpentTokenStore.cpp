@@ -0,0 +1,1047 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/cash/SpentTokenStore.hpp"
+
+#if OT_CASH
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTDataFolder.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/OTPaths.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <unordered_set>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+#define OT_SPENT_MAGIC "OTSPENT1"
+#define OT_SPENT_MAGIC_SIZE 8
+#define OT_SPENT_HEADER_SIZE 16
+#define OT_SPENT_CHECKSUM_SIZE 4
+#define OT_SPENT_MIN_KEY_SIZE 8
+#define OT_SPENT_MIN_SLOTS 1024
+#define OT_SPENT_SLOTS_PER_BLOOM_BLOCK 64
+#define OT_SPENT_BLOOM_BLOCK_WORDS 8
+#define OT_SPENT_BLOOM_HASHES 6
+#define OT_SPENT_BLOOM_SEED 0x9e3779b97f4a7c15ULL
+#define OT_SPENT_REPLAY_RECORDS 65536
+#define OT_SPENT_IMPORT_BATCH 4096
+#define OT_SPENT_LOG_EXTENSION ".log"
+#define OT_SPENT_IMPORT_EXTENSION ".import"
+#define OT_SPENT_COMPACT_EXTENSION ".compact"
+
+#define OT_METHOD "opentxs::SpentTokenStore::"
+
+namespace opentxs
+{
+namespace
+{
+bool read_all(
+    const int fd,
+    std::uint8_t* data,
+    const std::size_t size,
+    const std::uint64_t offset)
+{
+    std::size_t done{0};
+
+    while (done < size) {
+        const auto read = ::pread(fd, data + done, size - done, offset + done);
+
+        if (0 > read) {
+            if (EINTR == errno) { continue; }
+
+            return false;
+        }
+
+        if (0 == read) { return false; }
+
+        done += read;
+    }
+
+    return true;
+}
+
+bool write_all(
+    const int fd,
+    const std::uint8_t* data,
+    const std::size_t size,
+    const std::uint64_t offset)
+{
+    std::size_t done{0};
+
+    while (done < size) {
+        const auto written =
+            ::pwrite(fd, data + done, size - done, offset + done);
+
+        if (0 > written) {
+            if (EINTR == errno) { continue; }
+
+            return false;
+        }
+
+        done += written;
+    }
+
+    return true;
+}
+
+bool sync_fd(const int fd)
+{
+#if defined(__APPLE__)
+    // This is a Mac OS X system which does not implement
+    // fsync as such.
+    return 0 == ::fcntl(fd, F_FULLFSYNC);
+#else
+    return 0 == ::fsync(fd);
+#endif
+}
+
+void put_u32(std::uint8_t* out, const std::uint32_t value)
+{
+    for (std::size_t i = 0; i < 4; ++i) { out[i] = (value >> (8 * i)) & 0xff; }
+}
+
+std::uint32_t get_u32(const std::uint8_t* in)
+{
+    std::uint32_t output{0};
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        output |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    }
+
+    return output;
+}
+
+std::string header(const std::size_t keySize)
+{
+    std::string output(OT_SPENT_HEADER_SIZE, '\0');
+    std::memcpy(&output[0], OT_SPENT_MAGIC, OT_SPENT_MAGIC_SIZE);
+    put_u32(
+        reinterpret_cast<std::uint8_t*>(&output[OT_SPENT_MAGIC_SIZE]),
+        keySize);
+
+    return output;
+}
+}  // namespace
+
+SpentTokenStore::SpentTokenStore(
+    const std::string& path,
+    const bool sync,
+    const std::size_t keySize)
+    : path_(path)
+    , sync_(sync)
+    , key_size_(0)
+    , record_size_(0)
+    , lock_()
+    , fd_(-1)
+    , records_(0)
+    , damaged_(0)
+    , count_(0)
+    , fingerprints_()
+    , positions_()
+    , bloom_()
+{
+    Lock lock(lock_);
+
+    if (false == init(lock, keySize)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open " << path_
+              << std::endl;
+
+        if (-1 != fd_) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+}
+
+void SpentTokenStore::add(
+    const Lock& lock,
+    const std::uint64_t fp,
+    const std::uint32_t pos)
+{
+    OT_ASSERT(0 != fp)
+
+    if ((count_ + 1) * 10 > fingerprints_.size() * 7) {
+        resize(lock, fingerprints_.size() * 2);
+    }
+
+    const auto mask = fingerprints_.size() - 1;
+    auto slot = mix(fp) & mask;
+
+    while (0 != fingerprints_[slot]) { slot = (slot + 1) & mask; }
+
+    fingerprints_[slot] = fp;
+    positions_[slot] = pos;
+    bloom_insert(lock, fp);
+    ++count_;
+}
+
+bool SpentTokenStore::bloom_contains(const Lock&, const std::uint64_t fp)
+    const
+{
+    const auto hash = mix(fp ^ OT_SPENT_BLOOM_SEED);
+    const auto blocks = bloom_.size() / OT_SPENT_BLOOM_BLOCK_WORDS;
+    const auto* block =
+        &bloom_[(hash & (blocks - 1)) * OT_SPENT_BLOOM_BLOCK_WORDS];
+    auto bits = mix(hash);
+
+    for (std::size_t i = 0; i < OT_SPENT_BLOOM_HASHES; ++i, bits >>= 9) {
+        const auto bit = bits & 511;
+
+        if (0 == (block[bit >> 6] & (1ULL << (bit & 63)))) { return false; }
+    }
+
+    return true;
+}
+
+void SpentTokenStore::bloom_insert(const Lock&, const std::uint64_t fp)
+{
+    const auto hash = mix(fp ^ OT_SPENT_BLOOM_SEED);
+    const auto blocks = bloom_.size() / OT_SPENT_BLOOM_BLOCK_WORDS;
+    auto* block = &bloom_[(hash & (blocks - 1)) * OT_SPENT_BLOOM_BLOCK_WORDS];
+    auto bits = mix(hash);
+
+    for (std::size_t i = 0; i < OT_SPENT_BLOOM_HASHES; ++i, bits >>= 9) {
+        const auto bit = bits & 511;
+        block[bit >> 6] |= (1ULL << (bit & 63));
+    }
+}
+
+std::uint32_t SpentTokenStore::checksum(
+    const std::uint8_t* key,
+    std::size_t size)
+{
+    // FNV-1a
+    std::uint32_t output{2166136261u};
+
+    for (std::size_t i = 0; i < size; ++i) {
+        output ^= key[i];
+        output *= 16777619u;
+    }
+
+    return output;
+}
+
+bool SpentTokenStore::Compact()
+{
+    Lock lock(lock_);
+
+    if (-1 == fd_) { return false; }
+
+    const std::string temp = path_ + OT_SPENT_COMPACT_EXTENSION;
+    const int out =
+        ::open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+
+    if (-1 == out) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to create " << temp
+              << std::endl;
+
+        return false;
+    }
+
+    auto fail = [&]() -> bool {
+        ::close(out);
+        std::remove(temp.c_str());
+
+        return false;
+    };
+    const auto head = header(key_size_);
+
+    if (false == write_all(
+                     out,
+                     reinterpret_cast<const std::uint8_t*>(head.data()),
+                     head.size(),
+                     0)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write " << temp
+              << std::endl;
+
+        return fail();
+    }
+
+    std::vector<std::uint64_t> kept{};
+    kept.reserve(count_);
+    std::vector<std::uint8_t> buffer(OT_SPENT_REPLAY_RECORDS * record_size_);
+    std::vector<std::uint8_t> output{};
+    output.reserve(buffer.size());
+    std::uint64_t position{0};
+
+    while (position < records_) {
+        const auto chunk = std::min<std::uint64_t>(
+            OT_SPENT_REPLAY_RECORDS, records_ - position);
+        const auto offset = OT_SPENT_HEADER_SIZE + position * record_size_;
+
+        if (false ==
+            read_all(fd_, buffer.data(), chunk * record_size_, offset)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to read "
+                  << path_ << std::endl;
+
+            return fail();
+        }
+
+        output.clear();
+
+        for (std::uint64_t i = 0; i < chunk; ++i) {
+            const auto* record = &buffer[i * record_size_];
+
+            if (checksum(record, key_size_) != get_u32(record + key_size_)) {
+                continue;
+            }
+
+            const auto fp = fingerprint(record);
+
+            if (false == live(lock, fp, position + i)) { continue; }
+
+            output.insert(output.end(), record, record + record_size_);
+            kept.push_back(fp);
+        }
+
+        const auto written = kept.size() * record_size_ - output.size();
+
+        if (false == write_all(
+                         out,
+                         output.data(),
+                         output.size(),
+                         OT_SPENT_HEADER_SIZE + written)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to write "
+                  << temp << std::endl;
+
+            return fail();
+        }
+
+        position += chunk;
+    }
+
+    OT_ASSERT(kept.size() == count_)
+
+    if (false == sync_fd(out)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync " << temp
+              << std::endl;
+
+        return fail();
+    }
+
+    if (0 != std::rename(temp.c_str(), path_.c_str())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to replace " << path_
+              << std::endl;
+
+        return fail();
+    }
+
+    sync_directory();
+    ::close(fd_);
+    fd_ = out;
+    records_ = kept.size();
+    damaged_ = 0;
+    count_ = 0;
+    fingerprints_.clear();
+    positions_.clear();
+    resize(lock, slots_for(kept.size()));
+
+    for (std::size_t i = 0; i < kept.size(); ++i) { add(lock, kept[i], i); }
+
+    return true;
+}
+
+bool SpentTokenStore::confirm(
+    const Lock&,
+    const std::uint32_t position,
+    const std::uint8_t* key) const
+{
+    std::array<std::uint8_t, Identifier::MaxSize + OT_SPENT_CHECKSUM_SIZE>
+        record{};
+    const auto offset =
+        OT_SPENT_HEADER_SIZE + std::uint64_t(position) * record_size_;
+
+    if (false == read_all(fd_, record.data(), record_size_, offset)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to read record "
+              << position << " from " << path_ << std::endl;
+
+        // Fail closed: an unreadable record is treated as a match.
+        return true;
+    }
+
+    return 0 == std::memcmp(record.data(), key, key_size_);
+}
+
+bool SpentTokenStore::Contains(const Identifier& token) const
+{
+    // Fail closed: a token which can not be looked up is treated as spent.
+    if (false == valid_key(token)) { return true; }
+
+    const auto* key = static_cast<const std::uint8_t*>(token.GetPointer());
+    Lock lock(lock_);
+
+    if (-1 == fd_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << path_
+              << " is not open." << std::endl;
+
+        return true;
+    }
+
+    return contains(lock, key, fingerprint(key));
+}
+
+bool SpentTokenStore::contains(
+    const Lock& lock,
+    const std::uint8_t* key,
+    const std::uint64_t fp) const
+{
+    if (false == bloom_contains(lock, fp)) { return false; }
+
+    const auto mask = fingerprints_.size() - 1;
+
+    for (auto slot = mix(fp) & mask; 0 != fingerprints_[slot];
+         slot = (slot + 1) & mask) {
+        if ((fp == fingerprints_[slot]) &&
+            confirm(lock, positions_[slot], key)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SpentTokenStore::convert(
+    const std::string& folder,
+    const std::string& path)
+{
+    const std::string temp = path + OT_SPENT_IMPORT_EXTENSION;
+    std::remove(temp.c_str());
+    std::size_t imported{0};
+
+    {
+        SpentTokenStore store(temp);
+
+        if (false == store.IsValid()) { return false; }
+
+        if (false == store.Import(folder, imported)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to import "
+                  << folder << std::endl;
+
+            return false;
+        }
+    }
+
+    // The log only appears under its final name once the import is complete
+    if (0 != std::rename(temp.c_str(), path.c_str())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to rename " << temp
+              << std::endl;
+
+        return false;
+    }
+
+    otWarn << OT_METHOD << __FUNCTION__ << ": Imported " << imported
+           << " spent tokens from " << folder << std::endl;
+
+    return true;
+}
+
+void SpentTokenStore::erase(
+    const Lock& lock,
+    const std::uint8_t* key,
+    const std::uint64_t fp)
+{
+    const auto mask = fingerprints_.size() - 1;
+    auto hole = mix(fp) & mask;
+
+    for (; 0 != fingerprints_[hole]; hole = (hole + 1) & mask) {
+        if ((fp == fingerprints_[hole]) &&
+            confirm(lock, positions_[hole], key)) {
+            break;
+        }
+    }
+
+    if (0 == fingerprints_[hole]) { return; }
+
+    // Shift the rest of the probe sequence back so that no entry ends up
+    // after an empty slot which is between it and its home slot. The Bloom
+    // filter is left alone, since a stale bit only costs an index probe.
+    for (auto next = (hole + 1) & mask; 0 != fingerprints_[next];
+         next = (next + 1) & mask) {
+        const auto home = mix(fingerprints_[next]) & mask;
+
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            fingerprints_[hole] = fingerprints_[next];
+            positions_[hole] = positions_[next];
+            hole = next;
+        }
+    }
+
+    fingerprints_[hole] = 0;
+    positions_[hole] = 0;
+    --count_;
+}
+
+std::uint64_t SpentTokenStore::fingerprint(const std::uint8_t* key)
+{
+    std::uint64_t output{0};
+    std::memcpy(&output, key, sizeof(output));
+
+    // Zero marks an empty slot in the index
+    return (0 == output) ? 1 : output;
+}
+
+std::shared_ptr<SpentTokenStore> SpentTokenStore::Get(
+    const Identifier& unitID,
+    const std::int32_t series)
+{
+    static std::mutex lock{};
+    static std::map<std::string, std::shared_ptr<SpentTokenStore>> stores{};
+
+    const std::string name =
+        String(unitID).Get() + std::string(".") + std::to_string(series);
+    Lock registryLock(lock);
+    auto it = stores.find(name);
+
+    if (stores.end() != it) { return it->second; }
+
+    String folder{""};
+    bool created{false};
+    const auto haveFolder = OTPaths::AppendFolder(
+        folder, OTDataFolder::Get(), OTFolders::Spent());
+
+    OT_ASSERT(haveFolder)
+
+    if (false == OTPaths::BuildFolderPath(folder, created)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to create " << folder
+              << std::endl;
+
+        return nullptr;
+    }
+
+    const std::string legacy = folder.Get() + name;
+    const std::string path = legacy + OT_SPENT_LOG_EXTENSION;
+
+    if ((false == boost::filesystem::exists(path)) &&
+        boost::filesystem::is_directory(legacy)) {
+        if (false == convert(legacy, path)) { return nullptr; }
+    }
+
+    auto store = std::make_shared<SpentTokenStore>(path);
+
+    if (false == store->IsValid()) { return nullptr; }
+
+    stores.emplace(name, store);
+
+    return store;
+}
+
+bool SpentTokenStore::Import(const std::string& folder, std::size_t& imported)
+{
+    imported = 0;
+    boost::system::error_code ec{};
+
+    if (false == boost::filesystem::is_directory(folder, ec)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << folder
+              << " is not a directory." << std::endl;
+
+        return false;
+    }
+
+    std::vector<Identifier> batch{};
+    batch.reserve(OT_SPENT_IMPORT_BATCH);
+
+    auto flush = [&]() -> bool {
+        const auto added = Insert(batch);
+
+        if (false == IsValid()) { return false; }
+
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            if (added[i]) {
+                ++imported;
+            } else if (false == Contains(batch[i])) {
+                return false;
+            }
+        }
+
+        batch.clear();
+
+        return true;
+    };
+
+    boost::filesystem::directory_iterator it(folder, ec), end{};
+
+    for (; (false == bool(ec)) && (end != it); it.increment(ec)) {
+        if (false == boost::filesystem::is_regular_file(it->status())) {
+            continue;
+        }
+
+        const auto filename = it->path().filename().string();
+        const Identifier token(filename);
+
+        if (token.GetSize() != key_size_) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Skipping " << filename
+                  << " (not a spent token hash)." << std::endl;
+
+            continue;
+        }
+
+        batch.push_back(token);
+
+        if (OT_SPENT_IMPORT_BATCH == batch.size()) {
+            if (false == flush()) { return false; }
+        }
+    }
+
+    if (ec) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to list " << folder
+              << ": " << ec.message() << std::endl;
+
+        return false;
+    }
+
+    return flush();
+}
+
+bool SpentTokenStore::init(const Lock& lock, const std::size_t keySize)
+{
+    if ((OT_SPENT_MIN_KEY_SIZE > keySize) || (Identifier::MaxSize < keySize)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid key size " << keySize
+              << std::endl;
+
+        return false;
+    }
+
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+
+    if (-1 == fd_) { return false; }
+
+    struct stat info {
+    };
+
+    if (0 != ::fstat(fd_, &info)) { return false; }
+
+    std::uint64_t size = info.st_size;
+
+    if (OT_SPENT_HEADER_SIZE > size) {
+        // New log, or one whose header was never made durable
+        const auto head = header(keySize);
+
+        if (0 != ::ftruncate(fd_, 0)) { return false; }
+
+        if (false == write_all(
+                         fd_,
+                         reinterpret_cast<const std::uint8_t*>(head.data()),
+                         head.size(),
+                         0)) {
+            return false;
+        }
+
+        if (sync_ && (false == (sync_fd(fd_) && sync_directory()))) {
+            return false;
+        }
+
+        size = head.size();
+    }
+
+    std::array<std::uint8_t, OT_SPENT_HEADER_SIZE> head{};
+
+    if (false == read_all(fd_, head.data(), head.size(), 0)) { return false; }
+
+    if (0 != std::memcmp(head.data(), OT_SPENT_MAGIC, OT_SPENT_MAGIC_SIZE)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << path_
+              << " is not a spent token log." << std::endl;
+
+        return false;
+    }
+
+    key_size_ = get_u32(head.data() + OT_SPENT_MAGIC_SIZE);
+
+    if ((OT_SPENT_MIN_KEY_SIZE > key_size_) ||
+        (Identifier::MaxSize < key_size_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << path_
+              << " has an invalid key size." << std::endl;
+
+        return false;
+    }
+
+    record_size_ = key_size_ + OT_SPENT_CHECKSUM_SIZE;
+
+    return replay(lock, size);
+}
+
+bool SpentTokenStore::Insert(const Identifier& token)
+{
+    return Insert(std::vector<Identifier>{token}).front();
+}
+
+std::vector<bool> SpentTokenStore::Insert(
+    const std::vector<Identifier>& tokens)
+{
+    std::vector<bool> output(tokens.size(), false);
+    std::vector<std::size_t> accepted{};
+    std::vector<std::uint64_t> fingerprints{};
+    std::unordered_set<std::string> batch{};
+    std::string records{};
+    std::array<std::uint8_t, OT_SPENT_CHECKSUM_SIZE> check{};
+    Lock lock(lock_);
+
+    if (-1 == fd_) { return output; }
+
+    records.reserve(tokens.size() * record_size_);
+
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const auto& token = tokens[i];
+
+        if (false == valid_key(token)) { continue; }
+
+        const auto* key = static_cast<const std::uint8_t*>(token.GetPointer());
+        const auto fp = fingerprint(key);
+
+        if (contains(lock, key, fp)) { continue; }
+
+        std::string value(reinterpret_cast<const char*>(key), key_size_);
+
+        if (false == batch.insert(value).second) { continue; }
+
+        put_u32(check.data(), checksum(key, key_size_));
+        records.append(value);
+        records.append(reinterpret_cast<const char*>(check.data()), 4);
+        accepted.push_back(i);
+        fingerprints.push_back(fp);
+    }
+
+    if (accepted.empty()) { return output; }
+
+    if (std::numeric_limits<std::uint32_t>::max() - records_ <
+        accepted.size()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << path_ << " is full."
+              << std::endl;
+
+        return output;
+    }
+
+    if (false == write(lock, records)) { return output; }
+
+    for (std::size_t i = 0; i < accepted.size(); ++i) {
+        add(lock, fingerprints[i], records_ + i);
+        output[accepted[i]] = true;
+    }
+
+    records_ += accepted.size();
+
+    return output;
+}
+
+bool SpentTokenStore::IsValid() const
+{
+    Lock lock(lock_);
+
+    return -1 != fd_;
+}
+
+bool SpentTokenStore::live(
+    const Lock&,
+    const std::uint64_t fp,
+    const std::uint32_t position) const
+{
+    const auto mask = fingerprints_.size() - 1;
+
+    for (auto slot = mix(fp) & mask; 0 != fingerprints_[slot];
+         slot = (slot + 1) & mask) {
+        if ((fp == fingerprints_[slot]) && (position == positions_[slot])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::size_t SpentTokenStore::Migrate(const std::string& spentFolder)
+{
+    std::size_t output{0};
+    boost::system::error_code ec{};
+    boost::filesystem::directory_iterator it(spentFolder, ec), end{};
+
+    for (; (false == bool(ec)) && (end != it); it.increment(ec)) {
+        if (false == boost::filesystem::is_directory(it->status())) {
+            continue;
+        }
+
+        const auto folder = it->path().string();
+        const auto path = folder + OT_SPENT_LOG_EXTENSION;
+
+        if (boost::filesystem::exists(path)) { continue; }
+
+        if (false == convert(folder, path)) { ++output; }
+    }
+
+    if (ec) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to list "
+              << spentFolder << ": " << ec.message() << std::endl;
+        ++output;
+    }
+
+    return output;
+}
+
+std::uint64_t SpentTokenStore::mix(std::uint64_t value)
+{
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+
+    return value;
+}
+
+bool SpentTokenStore::Remove(const std::vector<Identifier>& tokens)
+{
+    std::vector<const std::uint8_t*> removed{};
+    std::string records{};
+    std::array<std::uint8_t, OT_SPENT_CHECKSUM_SIZE> check{};
+    Lock lock(lock_);
+
+    if (-1 == fd_) { return false; }
+
+    for (const auto& token : tokens) {
+        if (false == valid_key(token)) { continue; }
+
+        const auto* key = static_cast<const std::uint8_t*>(token.GetPointer());
+
+        if (false == contains(lock, key, fingerprint(key))) { continue; }
+
+        put_u32(check.data(), ~checksum(key, key_size_));
+        records.append(reinterpret_cast<const char*>(key), key_size_);
+        records.append(reinterpret_cast<const char*>(check.data()), 4);
+        removed.push_back(key);
+    }
+
+    if (removed.empty()) { return true; }
+
+    if (std::numeric_limits<std::uint32_t>::max() - records_ <
+        removed.size()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << path_ << " is full."
+              << std::endl;
+
+        return false;
+    }
+
+    if (false == write(lock, records)) { return false; }
+
+    for (const auto& key : removed) { erase(lock, key, fingerprint(key)); }
+
+    records_ += removed.size();
+
+    return true;
+}
+
+bool SpentTokenStore::replay(const Lock& lock, const std::uint64_t fileSize)
+{
+    const auto body = fileSize - OT_SPENT_HEADER_SIZE;
+    const auto total = body / record_size_;
+
+    if (std::numeric_limits<std::uint32_t>::max() < total) { return false; }
+
+    resize(lock, slots_for(total));
+    std::vector<std::uint8_t> buffer(OT_SPENT_REPLAY_RECORDS * record_size_);
+
+    while (records_ < total) {
+        const auto chunk =
+            std::min<std::uint64_t>(OT_SPENT_REPLAY_RECORDS, total - records_);
+        const auto offset = OT_SPENT_HEADER_SIZE + records_ * record_size_;
+
+        if (false ==
+            read_all(fd_, buffer.data(), chunk * record_size_, offset)) {
+            return false;
+        }
+
+        for (std::uint64_t i = 0; i < chunk; ++i) {
+            const auto* record = &buffer[i * record_size_];
+            const auto check = checksum(record, key_size_);
+            const auto stored = get_u32(record + key_size_);
+            const auto fp = fingerprint(record);
+
+            if (check == stored) {
+                // A token recorded twice keeps its first position
+                if (false == contains(lock, record, fp)) {
+                    add(lock, fp, records_ + i);
+                }
+            } else if (~check == stored) {
+                erase(lock, record, fp);
+            } else {
+                ++damaged_;
+            }
+        }
+
+        records_ += chunk;
+    }
+
+    if (0 < damaged_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Skipped " << damaged_
+              << " damaged records in " << path_ << std::endl;
+    }
+
+    if (0 != body % record_size_) {
+        otWarn << OT_METHOD << __FUNCTION__
+               << ": Truncating incomplete record at the end of " << path_
+               << std::endl;
+
+        const auto end = OT_SPENT_HEADER_SIZE + total * record_size_;
+
+        if (0 != ::ftruncate(fd_, end)) { return false; }
+
+        if (sync_ && (false == sync_fd(fd_))) { return false; }
+    }
+
+    return true;
+}
+
+void SpentTokenStore::resize(const Lock& lock, const std::size_t slots)
+{
+    OT_ASSERT(0 == (slots & (slots - 1)))
+    OT_ASSERT(OT_SPENT_MIN_SLOTS <= slots)
+
+    std::vector<std::uint64_t> fingerprints(slots, 0);
+    std::vector<std::uint32_t> positions(slots, 0);
+    fingerprints_.swap(fingerprints);
+    positions_.swap(positions);
+    bloom_.assign(
+        slots / OT_SPENT_SLOTS_PER_BLOOM_BLOCK * OT_SPENT_BLOOM_BLOCK_WORDS, 0);
+    const auto mask = slots - 1;
+
+    for (std::size_t i = 0; i < fingerprints.size(); ++i) {
+        const auto fp = fingerprints[i];
+
+        if (0 == fp) { continue; }
+
+        auto slot = mix(fp) & mask;
+
+        while (0 != fingerprints_[slot]) { slot = (slot + 1) & mask; }
+
+        fingerprints_[slot] = fp;
+        positions_[slot] = positions[i];
+        bloom_insert(lock, fp);
+    }
+}
+
+std::size_t SpentTokenStore::Size() const
+{
+    Lock lock(lock_);
+
+    return count_;
+}
+
+std::size_t SpentTokenStore::slots_for(const std::size_t count)
+{
+    std::size_t output{OT_SPENT_MIN_SLOTS};
+
+    while (output * 7 < count * 10) { output <<= 1; }
+
+    return output;
+}
+
+bool SpentTokenStore::sync_directory() const
+{
+    auto parent = boost::filesystem::path(path_).parent_path();
+
+    if (parent.empty()) { parent = "."; }
+
+    const int fd = ::open(parent.string().c_str(), O_DIRECTORY | O_RDONLY);
+
+    if (-1 == fd) { return false; }
+
+    const bool output = sync_fd(fd);
+    ::close(fd);
+
+    return output;
+}
+
+bool SpentTokenStore::valid_key(const Identifier& token) const
+{
+    if (token.GetSize() != key_size_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Wrong token hash size ("
+              << token.GetSize() << " instead of " << key_size_ << ")."
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool SpentTokenStore::write(const Lock&, const std::string& records)
+{
+    const auto offset = OT_SPENT_HEADER_SIZE + records_ * record_size_;
+    const bool written = write_all(
+        fd_,
+        reinterpret_cast<const std::uint8_t*>(records.data()),
+        records.size(),
+        offset);
+
+    if (written && ((false == sync_) || sync_fd(fd_))) { return true; }
+
+    otErr << OT_METHOD << __FUNCTION__ << ": Failed to append to " << path_
+          << std::endl;
+
+    // Leave no partial records behind for the next append to land after
+    if (0 != ::ftruncate(fd_, offset)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to truncate " << path_
+              << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    return false;
+}
+
+SpentTokenStore::~SpentTokenStore()
+{
+    if (-1 != fd_) { ::close(fd_); }
+}
+}  // namespace opentxs
+#endif  // OT_CASH
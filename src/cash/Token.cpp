@@ -42,6 +42,7 @@
 
 #include "opentxs/cash/Mint.hpp"
 #include "opentxs/cash/Purse.hpp"
+#include "opentxs/cash/SpentTokenStore.hpp"
 #if OT_CASH_USING_LUCRE
 #include "opentxs/cash/TokenLucre.hpp"
 #endif
@@ -50,7 +51,6 @@
 #include "opentxs/core/Instrument.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
-#include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
@@ -58,7 +58,6 @@
 #include "opentxs/core/crypto/OTNymOrSymmetricKey.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
-#include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/util/Tag.hpp"
 
 #include <irrxml/irrXML.hpp>
@@ -472,26 +471,23 @@ Token* Token::TokenFactory(String strInput)
 //
 bool Token::IsTokenAlreadySpent(String& theCleartextToken)
 {
-    String strInstrumentDefinitionID(GetInstrumentDefinitionID());
+    auto store =
+        SpentTokenStore::Get(GetInstrumentDefinitionID(), GetSeries());
 
-    // Calculate the filename (a hash of the Lucre cleartext token ID)
+    if (false == bool(store)) {
+        otErr << "Token::IsTokenAlreadySpent: Unable to open the spent token "
+                 "store for series "
+              << GetSeries() << "\n";
+        return true;  // all errors must return true in this function.
+    }
+
+    // The store is keyed on a hash of the Lucre cleartext token ID
     Identifier theTokenHash;
     theTokenHash.CalculateDigest(theCleartextToken);
 
-    // Grab the new hash into a string (for use as a filename)
-    String strTokenHash(theTokenHash);
-
-    String strAssetFolder;
-    strAssetFolder.Format(
-        "%s.%d", strInstrumentDefinitionID.Get(), GetSeries());
-
-    bool bTokenIsPresent = OTDB::Exists(
-        OTFolders::Spent().Get(), strAssetFolder.Get(), strTokenHash.Get());
-
-    if (bTokenIsPresent) {
+    if (store->Contains(theTokenHash)) {
         otOut << "\nToken::IsTokenAlreadySpent: Token was already spent: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
+              << String(theTokenHash) << "\n";
         return true;  // all errors must return true in this function.
                       // But this is not an error. Token really WAS already
     }                 // spent, and this true is for real. The others are just
@@ -506,62 +502,29 @@ bool Token::IsTokenAlreadySpent(String& theCleartextToken)
 
 bool Token::RecordTokenAsSpent(String& theCleartextToken)
 {
-    String strInstrumentDefinitionID(GetInstrumentDefinitionID());
-
-    // Calculate the filename (a hash of the Lucre cleartext token ID)
-    Identifier theTokenHash;
-    theTokenHash.CalculateDigest(theCleartextToken);
-
-    // Grab the new hash into a string (for use as a filename)
-    String strTokenHash(theTokenHash);
+    auto store =
+        SpentTokenStore::Get(GetInstrumentDefinitionID(), GetSeries());
 
-    String strAssetFolder;
-    strAssetFolder.Format(
-        "%s.%d", strInstrumentDefinitionID.Get(), GetSeries());
-
-    // See if the spent token file ALREADY EXISTS...
-    bool bTokenIsPresent = OTDB::Exists(
-        OTFolders::Spent().Get(), strAssetFolder.Get(), strTokenHash.Get());
-
-    // If so, we're trying to record a token that was already recorded...
-    if (bTokenIsPresent) {
-        otErr << "Token::RecordTokenAsSpent: Trying to record token as spent,"
-                 " but it was already recorded: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
+    if (false == bool(store)) {
+        otErr << "Token::RecordTokenAsSpent: Unable to open the spent token "
+                 "store for series "
+              << GetSeries() << "\n";
         return false;
     }
 
-    // FINISHED:
-    //
-    // We actually save the token itself into the file, which is named based
-    // on a hash of the Lucre data.
-    // The success of that operation is also now the success of this one.
-
-    String strFinal;
-    OTASCIIArmor ascTemp(m_strRawFile);
-
-    if (false ==
-        ascTemp.WriteArmoredString(strFinal, m_strContractType.Get())) {
-        otErr << "Token::RecordTokenAsSpent: Error recording token as "
-                 "spent (failed writing armored string):\n"
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-        return false;
-    }
+    // The store is keyed on a hash of the Lucre cleartext token ID
+    Identifier theTokenHash;
+    theTokenHash.CalculateDigest(theCleartextToken);
 
-    const bool bSaved = OTDB::StorePlainString(
-        strFinal.Get(),
-        OTFolders::Spent().Get(),
-        strAssetFolder.Get(),
-        strTokenHash.Get());
-    if (!bSaved) {
-        otErr << "Token::RecordTokenAsSpent: Error saving file: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
+    // Fails if the token was already recorded, or if it could not be written
+    if (false == store->Insert(theTokenHash)) {
+        otErr << "Token::RecordTokenAsSpent: Failed to record token as "
+                 "spent: "
+              << String(theTokenHash) << "\n";
+        return false;
     }
 
-    return bSaved;
+    return true;
 }
 
 // OTSymmetricKey:
@@ -779,7 +742,7 @@ void Token::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // return -1 if error, 0 if nothing, and 1 if the node was processed.
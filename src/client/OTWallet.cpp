@@ -977,7 +977,7 @@ bool OTWallet::save_contract(const Lock& lock, String& strContract)
     std::string str_result;
     tag.output(str_result);
 
-    strContract.Concatenate("%s", str_result.c_str());
+    strContract.Concatenate(str_result);
 
     return true;
 }
@@ -730,7 +730,7 @@ void Account::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // return -1 if error, 0 if nothing, and 1 if the node was processed.
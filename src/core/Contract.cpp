@@ -59,9 +59,11 @@
 #include "opentxs/core/String.hpp"
 
 #include <stdint.h>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <irrxml/irrXML.hpp>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -553,27 +555,7 @@ bool Contract::VerifySigAuthent(
     const Nym& theNym,
     const OTPasswordData* pPWData) const
 {
-    String strNymID;
-    theNym.GetIdentifier(strNymID);
-    char cNymID = '0';
-    uint32_t uIndex = 3;
-    const bool bNymID = strNymID.At(uIndex, cNymID);
-
-    for (auto& it : m_listSignatures) {
-        OTSignature* pSig = it;
-        OT_ASSERT(nullptr != pSig);
-
-        if (bNymID && pSig->getMetaData().HasMetadata()) {
-            // If the signature has metadata, then it knows the fourth character
-            // of the NymID that signed it. We know the fourth character of the
-            // NymID
-            // who's trying to verify it. Thus, if they don't match, we can skip
-            // this
-            // signature without having to try to verify it at all.
-            //
-            if (pSig->getMetaData().FirstCharNymID() != cNymID) continue;
-        }
-
+    for (auto& pSig : nym_signatures(theNym)) {
         if (VerifySigAuthent(theNym, *pSig, pPWData)) return true;
     }
 
@@ -583,27 +565,7 @@ bool Contract::VerifySigAuthent(
 bool Contract::VerifySignature(const Nym& theNym, const OTPasswordData* pPWData)
     const
 {
-    String strNymID;
-    theNym.GetIdentifier(strNymID);
-    char cNymID = '0';
-    uint32_t uIndex = 3;
-    const bool bNymID = strNymID.At(uIndex, cNymID);
-
-    for (auto& it : m_listSignatures) {
-        OTSignature* pSig = it;
-        OT_ASSERT(nullptr != pSig);
-
-        if (bNymID && pSig->getMetaData().HasMetadata()) {
-            // If the signature has metadata, then it knows the first character
-            // of the NymID that signed it. We know the first character of the
-            // NymID
-            // who's trying to verify it. Thus, if they don't match, we can skip
-            // this
-            // signature without having to try to verify it at all.
-            //
-            if (pSig->getMetaData().FirstCharNymID() != cNymID) continue;
-        }
-
+    for (auto& pSig : nym_signatures(theNym)) {
         if (VerifySignature(theNym, *pSig, pPWData)) return true;
     }
 
@@ -651,41 +613,17 @@ bool Contract::VerifySigAuthent(
 {
 
     OTPasswordData thePWData("Contract::VerifySigAuthent 1");
-    listOfAsymmetricKeys listOutput;
 
-    const int32_t nCount = theNym.GetPublicKeysBySignature(
-        listOutput, theSignature, 'A');  // 'A' for authentication key.
-
-    if (nCount > 0)  // Found some (potentially) matching keys...
-    {
-        for (auto& it : listOutput) {
-            OTAsymmetricKey* pKey = it;
-            OT_ASSERT(nullptr != pKey);
-
-            if (VerifySignature(
-                    *pKey,
-                    theSignature,
-                    m_strSigHashType,
-                    (nullptr != pPWData) ? pPWData : &thePWData))
-                return true;
-        }
-    } else {
-        String strNymID;
-        theNym.GetIdentifier(strNymID);
-        otWarn << __FUNCTION__
-               << ": Tried to grab a list of keys from this Nym (" << strNymID
-               << ") which might match this signature, "
-                  "but recovered none. Therefore, will attempt to verify using "
-                  "the Nym's default public "
-                  "AUTHENTICATION key.\n";
+    for (auto& pKey : signature_keys(theNym, theSignature, 'A')) {
+        if (VerifySignature(
+                *pKey,
+                theSignature,
+                m_strSigHashType,
+                (nullptr != pPWData) ? pPWData : &thePWData))
+            return true;
     }
-    // else found no keys.
 
-    return VerifySignature(
-        theNym.GetPublicAuthKey(),
-        theSignature,
-        m_strSigHashType,
-        (nullptr != pPWData) ? pPWData : &thePWData);
+    return false;
 }
 
 // The only different between calling this with a Nym and calling it with an
@@ -701,41 +639,17 @@ bool Contract::VerifySignature(
 {
 
     OTPasswordData thePWData("Contract::VerifySignature 1");
-    listOfAsymmetricKeys listOutput;
 
-    const int32_t nCount = theNym.GetPublicKeysBySignature(
-        listOutput, theSignature, 'S');  // 'S' for signing key.
-
-    if (nCount > 0)  // Found some (potentially) matching keys...
-    {
-        for (auto& it : listOutput) {
-            OTAsymmetricKey* pKey = it;
-            OT_ASSERT(nullptr != pKey);
-
-            if (VerifySignature(
-                    *pKey,
-                    theSignature,
-                    m_strSigHashType,
-                    (nullptr != pPWData) ? pPWData : &thePWData))
-                return true;
-        }
-    } else {
-        String strNymID;
-        theNym.GetIdentifier(strNymID);
-        otWarn << __FUNCTION__
-               << ": Tried to grab a list of keys from this Nym (" << strNymID
-               << ") which might match this signature, "
-                  "but recovered none. Therefore, will attempt to verify using "
-                  "the Nym's default public "
-                  "SIGNING key.\n";
+    for (auto& pKey : signature_keys(theNym, theSignature, 'S')) {
+        if (VerifySignature(
+                *pKey,
+                theSignature,
+                m_strSigHashType,
+                (nullptr != pPWData) ? pPWData : &thePWData))
+            return true;
     }
-    // else found no keys.
 
-    return VerifySignature(
-        theNym.GetPublicSignKey(),
-        theSignature,
-        m_strSigHashType,
-        (nullptr != pPWData) ? pPWData : &thePWData);
+    return false;
 }
 
 bool Contract::VerifySignature(
@@ -770,6 +684,107 @@ bool Contract::VerifySignature(
     return true;
 }
 
+listOfSignatures Contract::nym_signatures(const Nym& theNym) const
+{
+    String strNymID;
+    theNym.GetIdentifier(strNymID);
+    char cNymID = '0';
+    uint32_t uIndex = 3;
+    const bool bNymID = strNymID.At(uIndex, cNymID);
+    listOfSignatures output;
+
+    for (auto& it : m_listSignatures) {
+        OTSignature* pSig = it;
+        OT_ASSERT(nullptr != pSig);
+
+        if (bNymID && pSig->getMetaData().HasMetadata()) {
+            // If the signature has metadata, then it knows the fourth
+            // character of the NymID that signed it. We know the fourth
+            // character of the NymID who's trying to verify it. Thus, if they
+            // don't match, we can skip this signature without having to try
+            // to verify it at all.
+            //
+            if (pSig->getMetaData().FirstCharNymID() != cNymID) continue;
+        }
+
+        output.push_back(pSig);
+    }
+
+    return output;
+}
+
+void Contract::SignatureChecks(
+    const Nym& theNym,
+    std::list<OTData>& data,
+    SignatureBatch& checks) const
+{
+    const String strContract(trim(m_xmlUnsigned));
+
+    // Same bytes as VerifyContractSignature, including the null terminator.
+    data.push_back(
+        Data::Factory(strContract.Get(), strContract.GetLength() + 1));
+    const Data& plaintext = data.back();
+
+    for (auto& pSig : nym_signatures(theNym)) {
+        data.push_back(Data::Factory());
+        pSig->GetData(data.back());
+        const Data& signature = data.back();
+
+        for (auto& pKey : signature_keys(theNym, *pSig, 'S')) {
+            checks.push_back({plaintext, *pKey, signature, m_strSigHashType});
+        }
+    }
+}
+
+listOfAsymmetricKeys Contract::signature_keys(
+    const Nym& theNym,
+    const OTSignature& theSignature,
+    const char keyType) const
+{
+    listOfAsymmetricKeys listKeys;
+    const int32_t nCount =
+        theNym.GetPublicKeysBySignature(listKeys, theSignature, keyType);
+
+    if (0 >= nCount) {
+        String strNymID;
+        theNym.GetIdentifier(strNymID);
+        otWarn << __FUNCTION__
+               << ": Tried to grab a list of keys from this Nym (" << strNymID
+               << ") which might match this signature, "
+                  "but recovered none. Therefore, will attempt to verify using "
+                  "the Nym's default public "
+               << (('A' == keyType) ? "AUTHENTICATION" : "SIGNING")
+               << " key.\n";
+    }
+
+    const OTAsymmetricKey* pDefault = ('A' == keyType)
+                                          ? &theNym.GetPublicAuthKey()
+                                          : &theNym.GetPublicSignKey();
+
+    if (listKeys.end() ==
+        std::find(listKeys.begin(), listKeys.end(), pDefault)) {
+        listKeys.push_back(const_cast<OTAsymmetricKey*>(pDefault));
+    }
+
+    listOfAsymmetricKeys output;
+
+    for (auto& pKey : listKeys) {
+        OT_ASSERT(nullptr != pKey);
+
+        // See VerifySignature(theKey, ...)
+        if ((nullptr != pKey->m_pMetadata) &&
+            pKey->m_pMetadata->HasMetadata() &&
+            theSignature.getMetaData().HasMetadata() &&
+            (theSignature.getMetaData() != *(pKey->m_pMetadata))) {
+            continue;
+        }
+
+        output.push_back(pKey);
+    }
+
+    return output;
+}
+
 void Contract::ReleaseSignatures()
 {
 
@@ -931,7 +946,7 @@ bool Contract::SignFlatText(
 // Saves the raw (pre-existing) contract text to any string you want to pass in.
 bool Contract::SaveContractRaw(String& strOutput) const
 {
-    strOutput.Concatenate("%s", m_strRawFile.Get());
+    strOutput.Concatenate(m_strRawFile);
 
     return true;
 }
@@ -952,7 +967,7 @@ bool Contract::AddBookendsAroundContent(
         strContractType.Get(),
         strHashType.Get());
 
-    strTemp.Concatenate("%s", strContents.Get());
+    strTemp.Concatenate(strContents);
 
     for (const auto& it : listSignatures) {
         OTSignature* pSig = it;
@@ -45,6 +45,7 @@
 #include "opentxs/core/util/Assert.hpp"
 
 #include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
@@ -123,7 +124,11 @@ Data& Data::operator=(Data&& rhs)
 
 bool Data::operator==(const opentxs::Data& rhs) const
 {
-    return data_ == dynamic_cast<const Data&>(rhs).data_;
+    if (data_.size() != rhs.GetSize()) { return false; }
+
+    if (data_.empty()) { return true; }
+
+    return 0 == std::memcmp(data_.data(), rhs.GetPointer(), data_.size());
 }
 
 bool Data::operator!=(const opentxs::Data& rhs) const
@@ -133,7 +138,8 @@ bool Data::operator!=(const opentxs::Data& rhs) const
 
 Data& Data::operator+=(const opentxs::Data& rhs)
 {
-    concatenate(dynamic_cast<const Data&>(rhs).data_);
+    const auto* start = static_cast<const std::uint8_t*>(rhs.GetPointer());
+    data_.insert(data_.end(), start, start + rhs.GetSize());
 
     return *this;
 }
@@ -153,13 +159,22 @@ std::string Data::asHex() const
 
 void Data::Assign(const opentxs::Data& rhs)
 {
+    // Identifier implements opentxs::Data without deriving from this class
+    const auto* data = dynamic_cast<const Data*>(&rhs);
+
+    if (nullptr == data) {
+        Assign(rhs.GetPointer(), rhs.GetSize());
+
+        return;
+    }
+
     // can't assign to self.
-    if (&dynamic_cast<const Data&>(rhs) == this) {
+    if (data == this) {
         return;
     }
 
-    data_ = dynamic_cast<const Data&>(rhs).data_;
-    position_ = dynamic_cast<const Data&>(rhs).position_;
+    data_ = data->data_;
+    position_ = data->position_;
 }
 
 void Data::Assign(const void* data, const std::size_t& size)
@@ -274,7 +289,20 @@ void Data::swap(Data& rhs)
     std::swap(position_, rhs.position_);
 }
 
-void Data::swap(opentxs::Data&& rhs) { swap(dynamic_cast<Data&>(rhs)); }
+void Data::swap(opentxs::Data&& rhs)
+{
+    auto* data = dynamic_cast<Data*>(&rhs);
+
+    if (nullptr != data) {
+        swap(*data);
+
+        return;
+    }
+
+    const auto temp = opentxs::Data::Factory(rhs);
+    rhs.Assign(GetPointer(), GetSize());
+    Assign(temp->GetPointer(), temp->GetSize());
+}
 
 void Data::zeroMemory()
 {
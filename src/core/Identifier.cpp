@@ -50,10 +50,19 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/OT.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#define OT_METHOD "opentxs::Identifier::"
+
 namespace opentxs
 {
 
@@ -84,51 +93,54 @@ proto::HashType Identifier::IDToHashType(const ID type)
 }
 
 Identifier::Identifier()
-    : ot_super()
+    : opentxs::Data()
 {
 }
 
 Identifier::Identifier(const Identifier& theID)
     : opentxs::Data()
-    , ot_super(theID)
-    , type_(theID.Type())
+    , type_(theID.type_)
+    , size_(theID.size_)
+    , data_(theID.data_)
+    , position_(theID.position_)
+    , string_(std::atomic_load(&theID.string_))
 {
 }
 
 Identifier::Identifier(const std::string& theStr)
-    : ot_super()
+    : opentxs::Data()
 {
     SetString(theStr);
 }
 
 Identifier::Identifier(const String& theStr)
-    : ot_super()
+    : opentxs::Data()
 {
     SetString(theStr);
 }
 
 Identifier::Identifier(const Contract& theContract)
-    : ot_super()  // Get the contract's ID into this identifier.
+    : opentxs::Data()  // Get the contract's ID into this identifier.
 {
     (const_cast<Contract&>(theContract)).GetIdentifier(*this);
 }
 
 Identifier::Identifier(const Nym& theNym)
-    : ot_super()  // Get the Nym's ID into this identifier.
+    : opentxs::Data()  // Get the Nym's ID into this identifier.
 {
     (const_cast<Nym&>(theNym)).GetIdentifier(*this);
 }
 
 Identifier::Identifier(const OTSymmetricKey& theKey)
-    : ot_super()  // Get the Symmetric Key's ID into *this. (It's a hash of the
-                  // encrypted form of the symmetric key.)
+    : opentxs::Data()  // Get the Symmetric Key's ID into *this. (It's a
+                       // hash of the encrypted form of the symmetric key.)
 {
     (const_cast<OTSymmetricKey&>(theKey)).GetIdentifier(*this);
 }
 
 Identifier::Identifier(const OTCachedKey& theKey)
-    : ot_super()  // Cached Key stores a symmetric key inside, so this actually
-                  // captures the ID for that symmetrickey.
+    : opentxs::Data()  // Cached Key stores a symmetric key inside, so this
+                       // actually captures the ID for that symmetrickey.
 {
     const bool bSuccess =
         (const_cast<OTCachedKey&>(theKey)).GetIdentifier(*this);
@@ -145,15 +157,20 @@ Identifier::Identifier(const OTCachedKey& theKey)
 Identifier::Identifier(
     const proto::ContactItemType type,
     const proto::HDPath& path)
-    : ot_super()
+    : opentxs::Data()
 {
     CalculateDigest(path_to_data(type, path), DefaultType);
 }
 
 Identifier& Identifier::operator=(const Identifier& rhs)
 {
-    Assign(rhs);
-    type_ = rhs.type_;
+    if (&rhs != this) {
+        type_ = rhs.type_;
+        size_ = rhs.size_;
+        data_ = rhs.data_;
+        position_ = rhs.position_;
+        string_ = std::atomic_load(&rhs.string_);
+    }
 
     return *this;
 }
@@ -165,44 +182,90 @@ Identifier& Identifier::operator=(Identifier&& rhs)
     return *this;
 }
 
+bool Identifier::operator==(const opentxs::Data& rhs) const
+{
+    if (GetSize() != rhs.GetSize()) { return false; }
+
+    if (0 == GetSize()) { return true; }
+
+    return 0 == std::memcmp(GetPointer(), rhs.GetPointer(), GetSize());
+}
+
 bool Identifier::operator==(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.Compare(ots2);
+    return 0 == compare(s2);
+}
+
+bool Identifier::operator!=(const opentxs::Data& rhs) const
+{
+    return !operator==(rhs);
 }
 
 bool Identifier::operator!=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return !(ots1.Compare(ots2));
+    return 0 != compare(s2);
 }
 
 bool Identifier::operator>(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator>(ots2);
+    return 0 < compare(s2);
 }
 
 bool Identifier::operator<(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator<(ots2);
+    return 0 > compare(s2);
 }
 
 bool Identifier::operator<=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator<=(ots2);
+    return 0 >= compare(s2);
 }
 
 bool Identifier::operator>=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.operator>=(ots2);
+    return 0 <= compare(s2);
+}
+
+Identifier& Identifier::operator+=(const opentxs::Data& rhs)
+{
+    if (0 < rhs.GetSize()) { Concatenate(rhs.GetPointer(), rhs.GetSize()); }
+
+    return *this;
+}
+
+std::string Identifier::asHex() const
+{
+    std::vector<char> output(2 * size_ + 1, 0x0);
+
+    for (std::size_t i = 0; i < size_; ++i) {
+        std::sprintf(&output[2 * i], "%02X", data_[i]);
+    }
+
+    return std::string(output.data(), 2 * size_);
+}
+
+void Identifier::Assign(const opentxs::Data& source)
+{
+    if (&source == this) { return; }
+
+    Assign(source.GetPointer(), source.GetSize());
+}
+
+void Identifier::Assign(const void* data, const std::size_t& size)
+{
+    Release();
+
+    if ((nullptr == data) || (0 == size)) { return; }
+
+    OT_ASSERT(MaxSize >= size);
+
+    std::memcpy(data_.data(), data, size);
+    size_ = static_cast<std::uint8_t>(size);
 }
 
 bool Identifier::CalculateDigest(const String& strInput, const ID type)
 {
+    invalidate();
     type_ = type;
 
     return OT::App().Crypto().Hash().Digest(
@@ -211,12 +274,112 @@ bool Identifier::CalculateDigest(const String& strInput, const ID type)
 
 bool Identifier::CalculateDigest(const opentxs::Data& dataInput, const ID type)
 {
+    invalidate();
     type_ = type;
 
     return OT::App().Crypto().Hash().Digest(
         IDToHashType(type_), dataInput, *this);
 }
 
+Identifier* Identifier::clone() const { return new Identifier(*this); }
+
+int Identifier::compare(const Identifier& rhs) const
+{
+    if ((0 == size_) || (0 == rhs.size_)) {
+
+        return int(0 < size_) - int(0 < rhs.size_);
+    }
+
+    if (type_ != rhs.type_) { return (type_ < rhs.type_) ? -1 : 1; }
+
+    const auto result = std::memcmp(
+        data_.data(), rhs.data_.data(), std::min(size_, rhs.size_));
+
+    if (0 != result) { return result; }
+
+    return int(size_) - int(rhs.size_);
+}
+
+void Identifier::Concatenate(const void* data, const std::size_t& size)
+{
+    OT_ASSERT(data != nullptr);
+    OT_ASSERT(size > 0);
+
+    OT_ASSERT(MaxSize - size_ >= size);
+
+    std::memcpy(data_.data() + size_, data, size);
+    size_ += static_cast<std::uint8_t>(size);
+    invalidate();
+}
+
+bool Identifier::empty() const { return 0 == size_; }
+
+const void* Identifier::GetPointer() const { return data_.data(); }
+
+std::size_t Identifier::GetSize() const { return size_; }
+
+std::size_t Identifier::Hash() const
+{
+    if (0 == size_) { return 0; }
+
+    const std::string_view bytes(
+        reinterpret_cast<const char*>(data_.data()), size_);
+
+    return std::hash<std::string_view>()(bytes) ^
+           static_cast<std::size_t>(type_);
+}
+
+void Identifier::invalidate()
+{
+    std::atomic_store(&string_, std::shared_ptr<const std::string>());
+}
+
+bool Identifier::IsEmpty() const { return empty(); }
+
+std::size_t Identifier::OTfread(std::uint8_t* data, const std::size_t& size)
+{
+    OT_ASSERT(data != nullptr && size > 0);
+
+    std::size_t sizeToRead = 0;
+
+    if (position_ < size_) {
+        sizeToRead = std::min(size, size_ - position_);
+        OTPassword::safe_memcpy(data, size, &data_[position_], sizeToRead);
+        position_ += sizeToRead;
+    }
+
+    return sizeToRead;
+}
+
+bool Identifier::Randomize(const std::size_t& size)
+{
+    SetSize(size);
+
+    if (size != size_) { return false; }
+
+    if (0 == size) { return false; }
+
+    return OTPassword::randomizeMemory_uint8(data_.data(), size);
+}
+
+void Identifier::Release()
+{
+    zeroMemory();
+    size_ = 0;
+    reset();
+}
+
+void Identifier::reset() { position_ = 0; }
+
+void Identifier::SetSize(const std::size_t& size)
+{
+    Release();
+
+    OT_ASSERT(MaxSize >= size);
+
+    size_ = static_cast<std::uint8_t>(size);
+}
+
 // SET (binary id) FROM ENCODED STRING
 void Identifier::SetString(const String& encoded)
 {
@@ -225,7 +388,7 @@ void Identifier::SetString(const String& encoded)
 
 void Identifier::SetString(const std::string& encoded)
 {
-    empty();
+    Release();
 
     if (MinimumSize > encoded.size()) {
         return;
@@ -242,6 +405,13 @@ void Identifier::SetString(const std::string& encoded)
     auto data = OT::App().Crypto().Encode().IdentifierDecode(input);
 
     if (!data.empty()) {
+        if (MaxSize < (data.size() - 1)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": " << (data.size() - 1)
+                  << " bytes is too large for an identifier." << std::endl;
+
+            return;
+        }
+
         type_ = static_cast<ID>(data[0]);
 
         switch (type_) {
@@ -269,20 +439,24 @@ void Identifier::SetString(const std::string& encoded)
 // Just call this function.
 void Identifier::GetString(String& id) const
 {
-    auto data = Data::Factory();
-    data->Assign(&type_, sizeof(type_));
-
-    OT_ASSERT(1 == data->GetSize());
-
-    if (0 == GetSize()) {
+    if (0 == size_) {
         return;
     }
 
-    data->Concatenate(GetPointer(), GetSize());
+    auto cached = std::atomic_load(&string_);
+
+    if (false == bool(cached)) {
+        auto data = Data::Factory(&type_, sizeof(type_));
 
-    String output("ot");
-    output.Concatenate(
-        String(OT::App().Crypto().Encode().IdentifierEncode(data).c_str()));
+        OT_ASSERT(1 == data->GetSize());
+
+        data->Concatenate(GetPointer(), GetSize());
+        cached = std::make_shared<const std::string>(
+            "ot" + OT::App().Crypto().Encode().IdentifierEncode(data));
+        std::atomic_store(&string_, cached);
+    }
+
+    String output(*cached);
     id.swap(output);
 }
 
@@ -300,10 +474,40 @@ OTData Identifier::path_to_data(
     return output;
 }
 
+void Identifier::swap(opentxs::Data&& rhs)
+{
+    auto* identifier = dynamic_cast<Identifier*>(&rhs);
+
+    if (nullptr != identifier) {
+        swap(*identifier);
+
+        return;
+    }
+
+    const auto temp = Data::Factory(rhs);
+    rhs.Assign(GetPointer(), GetSize());
+    Assign(temp->GetPointer(), temp->GetSize());
+}
+
+void Identifier::swap(Identifier& rhs)
+{
+    std::swap(type_, rhs.type_);
+    std::swap(size_, rhs.size_);
+    std::swap(data_, rhs.data_);
+    std::swap(position_, rhs.position_);
+    std::swap(string_, rhs.string_);
+}
+
 void Identifier::swap(Identifier&& rhs)
 {
-    ot_super::swap(rhs);
-    type_ = rhs.type_;
+    swap(rhs);
     rhs.type_ = ID::ERROR;
+    rhs.invalidate();
+}
+
+void Identifier::zeroMemory()
+{
+    std::fill(data_.begin(), data_.end(), 0);
+    invalidate();
 }
 }  // namespace opentxs
@@ -1979,7 +1979,7 @@ void Item::UpdateContents()  // Before transmission or serialization, this is
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 }  // namespace opentxs
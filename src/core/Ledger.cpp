@@ -47,6 +47,7 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
@@ -72,6 +73,11 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
+
+// Box receipts are loaded on one thread per this many receipts, up to the
+// number of hardware threads.
+#define OT_BOX_RECEIPTS_PER_THREAD 64
 
 namespace opentxs
 {
@@ -224,68 +230,81 @@ bool Ledger::DeleteBoxReceipt(const int64_t& lTransactionNum)
 // then add that transaction# to the set. (psetUnloaded)
 
 // if psetUnloaded passed in, then use it to return the #s that weren't there.
+//
+// The receipts are read, parsed and verified on several threads, since none of
+// that touches the ledger. They are then swapped in for the abbreviated
+// versions in transaction number order, on the calling thread.
 bool Ledger::LoadBoxReceipts(std::set<int64_t>* psetUnloaded)
 {
-    // Grab a copy of all the transaction #s stored inside this ledger.
+    // Grab all the abbreviated transactions stored inside this ledger, in
+    // transaction number order.
     //
-    std::set<int64_t> the_set;
+    std::vector<OTTransaction*> abbreviated;
 
     for (auto& it : m_mapTransactions) {
         OTTransaction* pTransaction = it.second;
         OT_ASSERT(nullptr != pTransaction);
-        the_set.insert(pTransaction->GetTransactionNum());
+
+        if (pTransaction->IsAbbreviated()) {
+            abbreviated.push_back(pTransaction);
+        }
     }
 
-    // Now iterate through those numbers and for each, load the box receipt.
+    const std::size_t count = abbreviated.size();
+    const int64_t lLedgerType = static_cast<int64_t>(GetType());
+    std::vector<OTTransaction*> receipts(count, nullptr);
+
+    ParallelFor(
+        count, OT_BOX_RECEIPTS_PER_THREAD, [&](const std::size_t i) -> void {
+            receipts[i] =
+                ::opentxs::LoadBoxReceipt(*abbreviated[i], lLedgerType);
+        });
+
+    // Now replace each abbreviated transaction with its box receipt.
     //
     bool bRetVal = true;
 
-    for (auto& it : the_set) {
-        int64_t lSetNum = it;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int64_t lSetNum = abbreviated[i]->GetTransactionNum();
+        OTTransaction* pBoxReceipt = receipts[i];
 
-        OTTransaction* pTransaction = GetTransaction(lSetNum);
-        OT_ASSERT(nullptr != pTransaction);
+        // Without psetUnloaded, nothing after the first failure is loaded.
+        if ((false == bRetVal) && (nullptr == psetUnloaded)) {
+            delete pBoxReceipt;
+            pBoxReceipt = nullptr;
+
+            continue;
+        }
+
+        if (nullptr != pBoxReceipt) {
+            // Remove the existing, abbreviated receipt, and replace it with
+            // the actual receipt.
+            //
+            RemoveTransaction(lSetNum);  // this deletes abbreviated[i]
+            abbreviated[i] = nullptr;
+            AddTransaction(*pBoxReceipt);  // takes ownership.
+
+            continue;
+        }
 
         // Failed loading the boxReceipt
         //
-        if ((true == pTransaction->IsAbbreviated()) &&
-            (false == LoadBoxReceipt(lSetNum))) {
-            // WARNING: pTransaction must be re-Get'd below this point if
-            // needed, since pointer
-            // is bad if success on LoadBoxReceipt() call.
-            //
-            pTransaction = nullptr;
-            bRetVal = false;
-            OTLogStream* pLog = &otOut;
+        bRetVal = false;
+        OTLogStream* pLog = &otOut;
 
-            if (nullptr != psetUnloaded) {
-                psetUnloaded->insert(lSetNum);
-                pLog = &otLog3;
-            }
-            *pLog << "OTLedger::LoadBoxReceipts: Failed calling LoadBoxReceipt "
-                     "on "
-                     "abbreviated transaction number:"
-                  << lSetNum << ".\n";
-            // If psetUnloaded is passed in, then we don't want to break,
-            // because we want to
-            // populate it with the conmplete list of IDs that wouldn't load as
-            // a Box Receipt.
-            // Thus, we only break if psetUnloaded is nullptr, which is better
-            // optimization in that case.
-            // (If not building a list of all failures, then we can return at
-            // first sign of failure.)
-            //
-            if (nullptr == psetUnloaded) break;
+        if (nullptr != psetUnloaded) {
+            psetUnloaded->insert(lSetNum);
+            pLog = &otLog3;
         }
-        // else (success), no need for a block in that case.
+        *pLog << "OTLedger::LoadBoxReceipts: Failed calling LoadBoxReceipt "
+                 "on "
+                 "abbreviated transaction number:"
+              << lSetNum << ".\n";
+        // If psetUnloaded is passed in, then we don't want to stop, because
+        // we want to populate it with the complete list of IDs that wouldn't
+        // load as a Box Receipt.
     }
 
-    // You might ask, why didn't I just iterate through the transactions
-    // directly and just call
-    // LoadBoxReceipt on each one? Answer: Because that function actually
-    // deletes the transaction
-    // and replaces it with a different object, if successful.
-
     return bRetVal;
 }
 
@@ -364,24 +383,27 @@ std::set<int64_t> Ledger::GetTransactionNums(
 {
     std::set<int64_t> the_set{};
 
-    int32_t current_index{-1};
+    if (nullptr == pOnlyForIndices) {
+        for (const auto& it : m_mapTransactions) {
+            const OTTransaction* pTransaction = it.second;
+            OT_ASSERT(nullptr != pTransaction);
+            the_set.insert(pTransaction->GetTransactionNum());
+        }
+
+        return the_set;
+    }
 
-    for (const auto& it : m_mapTransactions) {
-        ++current_index;  // 0 on first iteration.
-        const OTTransaction* pTransaction = it.second;
-        OT_ASSERT(nullptr != pTransaction);
-        const int64_t lTransNum = pTransaction->GetTransactionNum();
-        if (nullptr == pOnlyForIndices) {
-            the_set.insert(lTransNum);
+    const auto& vecTransactions = positions();
+
+    for (const auto& index : *pOnlyForIndices) {
+        if ((index < 0) ||
+            (static_cast<std::size_t>(index) >= vecTransactions.size())) {
             continue;
         }
-        // -------------------------------
-        std::set<int32_t>::const_iterator it_indices =
-            pOnlyForIndices->find(current_index);
-        if (pOnlyForIndices->end() != it_indices) {
-            the_set.insert(lTransNum);
-        }
+
+        the_set.insert(vecTransactions[index]->GetTransactionNum());
     }
+
     return the_set;
 }
 
@@ -1084,6 +1106,115 @@ const mapOfTransactions& Ledger::GetTransactionMap() const
     return m_mapTransactions;
 }
 
+const Ledger::vecOfTransactions& Ledger::positions() const
+{
+    if (m_bPositionsDirty) {
+        m_vecTransactions.clear();
+        m_vecTransactions.reserve(m_mapTransactions.size());
+
+        for (const auto& it : m_mapTransactions) {
+            m_vecTransactions.push_back(it.second);
+        }
+
+        m_bPositionsDirty = false;
+    }
+
+    OT_ASSERT(m_vecTransactions.size() == m_mapTransactions.size());
+
+    return m_vecTransactions;
+}
+
+Ledger::vecOfTransactions::const_iterator Ledger::find_position(
+    int64_t lTransactionNum) const
+{
+    const auto& vecTransactions = positions();
+
+    return std::lower_bound(
+        vecTransactions.begin(),
+        vecTransactions.end(),
+        lTransactionNum,
+        [](const OTTransaction* pTransaction, int64_t number) -> bool {
+            return pTransaction->GetTransactionNum() < number;
+        });
+}
+
+// Call after adding theTransaction to m_mapTransactions. Replaces whatever was
+// indexed under the same transaction number.
+void Ledger::index_transaction(OTTransaction& theTransaction)
+{
+    const int64_t lTransactionNum = theTransaction.GetTransactionNum();
+    unindex_transaction(lTransactionNum);
+
+    TransactionKeys& keys = m_mapTransactionKeys[lTransactionNum];
+    keys.reference_ = theTransaction.GetReferenceToNum();
+    keys.request_ = theTransaction.GetRequestNum();
+    keys.type_ = theTransaction.GetType();
+    m_mapReferenceIndex[keys.reference_].insert(lTransactionNum);
+    m_mapRequestIndex[keys.request_].insert(lTransactionNum);
+    m_mapTypeIndex[keys.type_].insert(lTransactionNum);
+
+    // Transactions usually arrive in order (for example while loading a box)
+    // so this is almost always an append.
+    if (m_bPositionsDirty) { return; }
+
+    if (m_vecTransactions.empty() ||
+        (m_vecTransactions.back()->GetTransactionNum() < lTransactionNum)) {
+        m_vecTransactions.push_back(&theTransaction);
+    } else {
+        m_bPositionsDirty = true;
+    }
+}
+
+// Call after removing lTransactionNum from m_mapTransactions.
+void Ledger::unindex_transaction(int64_t lTransactionNum)
+{
+    auto it = m_mapTransactionKeys.find(lTransactionNum);
+
+    if (m_mapTransactionKeys.end() == it) { return; }
+
+    const TransactionKeys keys = it->second;
+    m_mapTransactionKeys.erase(it);
+
+    auto reference = m_mapReferenceIndex.find(keys.reference_);
+
+    if (m_mapReferenceIndex.end() != reference) {
+        reference->second.erase(lTransactionNum);
+
+        if (reference->second.empty()) { m_mapReferenceIndex.erase(reference); }
+    }
+
+    auto request = m_mapRequestIndex.find(keys.request_);
+
+    if (m_mapRequestIndex.end() != request) {
+        request->second.erase(lTransactionNum);
+
+        if (request->second.empty()) { m_mapRequestIndex.erase(request); }
+    }
+
+    auto type = m_mapTypeIndex.find(keys.type_);
+
+    if (m_mapTypeIndex.end() != type) {
+        type->second.erase(lTransactionNum);
+
+        if (type->second.empty()) { m_mapTypeIndex.erase(type); }
+    }
+
+    if (m_bPositionsDirty) { return; }
+
+    auto position = std::lower_bound(
+        m_vecTransactions.begin(),
+        m_vecTransactions.end(),
+        lTransactionNum,
+        [](const OTTransaction* pTransaction, int64_t number) -> bool {
+            return pTransaction->GetTransactionNum() < number;
+        });
+
+    if ((m_vecTransactions.end() != position) &&
+        ((*position)->GetTransactionNum() == lTransactionNum)) {
+        m_vecTransactions.erase(position);
+    }
+}
+
 /// If transaction #87, in reference to #74, is in the inbox, you can remove it
 /// by calling this function and passing in 87. Deletes.
 ///
@@ -1105,6 +1236,7 @@ bool Ledger::RemoveTransaction(int64_t lTransactionNum, bool bDeleteIt)
         OTTransaction* pTransaction = it->second;
         OT_ASSERT(nullptr != pTransaction);
         m_mapTransactions.erase(it);
+        unindex_transaction(lTransactionNum);
 
         if (bDeleteIt) {
             delete pTransaction;
@@ -1123,6 +1255,7 @@ bool Ledger::AddTransaction(OTTransaction& theTransaction)
     // If it's not already on the list, then add it...
     if (it == m_mapTransactions.end()) {
         m_mapTransactions[theTransaction.GetTransactionNum()] = &theTransaction;
+        index_transaction(theTransaction);
         theTransaction.SetParent(*this);  // for convenience
         return true;
     }
@@ -1139,37 +1272,28 @@ bool Ledger::AddTransaction(OTTransaction& theTransaction)
 // Do NOT delete the return value, it's owned by the ledger.
 OTTransaction* Ledger::GetTransaction(OTTransaction::transactionType theType)
 {
-    // loop through the items that make up this transaction
+    auto it = m_mapTypeIndex.find(theType);
 
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pTransaction = it.second;
-        OT_ASSERT(nullptr != pTransaction);
+    if (m_mapTypeIndex.end() == it) { return nullptr; }
 
-        if (theType == pTransaction->GetType()) return pTransaction;
-    }
+    OT_ASSERT(false == it->second.empty());
 
-    return nullptr;
+    return GetTransaction(*it->second.begin());
 }
 
 // if not found, returns -1
 int32_t Ledger::GetTransactionIndex(int64_t lTransactionNum)
 {
-    // loop through the transactions inside this ledger
     // If a specific transaction is found, returns its index inside the ledger
     //
-    int32_t nIndex = -1;
-
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pTransaction = it.second;
-        OT_ASSERT(nullptr != pTransaction);
+    auto it = find_position(lTransactionNum);
 
-        ++nIndex;  // 0 on first iteration.
-
-        if (pTransaction->GetTransactionNum() == lTransactionNum) {
-            return nIndex;
-        }
+    if ((m_vecTransactions.end() == it) ||
+        ((*it)->GetTransactionNum() != lTransactionNum)) {
+        return -1;
     }
-    return -1;
+
+    return static_cast<int32_t>(it - m_vecTransactions.cbegin());
 }
 
 // Look up a transaction by transaction number and see if it is in the ledger.
@@ -1198,16 +1322,11 @@ OTTransaction* Ledger::GetTransaction(int64_t lTransactionNum) const
 //
 int32_t Ledger::GetTransactionCountInRefTo(int64_t lReferenceNum) const
 {
-    int32_t nCount{0};
+    auto it = m_mapReferenceIndex.find(lReferenceNum);
 
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pTransaction = it.second;
-        OT_ASSERT(nullptr != pTransaction);
+    if (m_mapReferenceIndex.end() == it) { return 0; }
 
-        if (pTransaction->GetReferenceToNum() == lReferenceNum) nCount++;
-    }
-
-    return nCount;
+    return static_cast<int32_t>(it->second.size());
 }
 
 // Look up a transaction by transaction number and see if it is in the ledger.
@@ -1220,19 +1339,10 @@ OTTransaction* Ledger::GetTransactionByIndex(int32_t nIndex) const
     // Out of bounds.
     if ((nIndex < 0) || (nIndex >= GetTransactionCount())) return nullptr;
 
-    int32_t nIndexCount = -1;
-
-    for (auto& it : m_mapTransactions) {
-        nIndexCount++;  // On first iteration, this is now 0, same as nIndex.
-        OTTransaction* pTransaction = it.second;
-        OT_ASSERT((nullptr != pTransaction));  // Should always be good.
-
-        // If this transaction is the one at the requested index
-        if (nIndexCount == nIndex) return pTransaction;
-    }
+    OTTransaction* pTransaction = positions()[nIndex];
+    OT_ASSERT((nullptr != pTransaction));  // Should always be good.
 
-    return nullptr;  // Should never reach this point, since bounds are checked
-                     // at the top.
+    return pTransaction;
 }
 
 // Nymbox-only.
@@ -1240,15 +1350,19 @@ OTTransaction* Ledger::GetTransactionByIndex(int32_t nIndex) const
 //
 OTTransaction* Ledger::GetReplyNotice(const int64_t& lRequestNum)
 {
-    // loop through the transactions that make up this ledger.
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pTransaction = it.second;
+    auto it = m_mapRequestIndex.find(lRequestNum);
+
+    if (m_mapRequestIndex.end() == it) { return nullptr; }
+
+    // loop through the transactions with this request number.
+    for (const auto& number : it->second) {
+        OTTransaction* pTransaction = GetTransaction(number);
         OT_ASSERT(nullptr != pTransaction);
 
         if (OTTransaction::replyNotice != pTransaction->GetType())  // <=======
             continue;
 
-        if (pTransaction->GetRequestNum() == lRequestNum) return pTransaction;
+        return pTransaction;
     }
 
     return nullptr;
@@ -1256,9 +1370,13 @@ OTTransaction* Ledger::GetReplyNotice(const int64_t& lRequestNum)
 
 OTTransaction* Ledger::GetTransferReceipt(int64_t lNumberOfOrigin)
 {
-    // loop through the transactions that make up this ledger.
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pTransaction = it.second;
+    auto receipts = m_mapTypeIndex.find(OTTransaction::transferReceipt);
+
+    if (m_mapTypeIndex.end() == receipts) { return nullptr; }
+
+    // loop through the transfer receipts in this ledger.
+    for (const auto& number : receipts->second) {
+        OTTransaction* pTransaction = GetTransaction(number);
         OT_ASSERT(nullptr != pTransaction);
 
         if (OTTransaction::transferReceipt == pTransaction->GetType()) {
@@ -1334,8 +1452,21 @@ OTTransaction* Ledger::GetChequeReceipt(
                            // RESPONSIBLE
                            // TO DELETE.
 {
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pCurrentReceipt = it.second;
+    // Only cheque and voucher receipts need to be loaded, in transaction
+    // number order.
+    std::set<int64_t> receipts;
+
+    for (const auto type :
+         {OTTransaction::chequeReceipt, OTTransaction::voucherReceipt}) {
+        auto it = m_mapTypeIndex.find(type);
+
+        if (m_mapTypeIndex.end() != it) {
+            receipts.insert(it->second.begin(), it->second.end());
+        }
+    }
+
+    for (const auto& number : receipts) {
+        OTTransaction* pCurrentReceipt = GetTransaction(number);
         OT_ASSERT(nullptr != pCurrentReceipt);
 
         if ((pCurrentReceipt->GetType() != OTTransaction::chequeReceipt) &&
@@ -1435,16 +1566,19 @@ OTTransaction* Ledger::GetChequeReceipt(
 //
 OTTransaction* Ledger::GetFinalReceipt(int64_t lReferenceNum)
 {
-    // loop through the transactions that make up this ledger.
-    for (auto& it : m_mapTransactions) {
-        OTTransaction* pTransaction = it.second;
+    auto it = m_mapReferenceIndex.find(lReferenceNum);
+
+    if (m_mapReferenceIndex.end() == it) { return nullptr; }
+
+    // loop through the transactions in reference to lReferenceNum.
+    for (const auto& number : it->second) {
+        OTTransaction* pTransaction = GetTransaction(number);
         OT_ASSERT(nullptr != pTransaction);
 
         if (OTTransaction::finalReceipt != pTransaction->GetType())  // <=======
             continue;
 
-        if (pTransaction->GetReferenceToNum() == lReferenceNum)
-            return pTransaction;
+        return pTransaction;
     }
 
     return nullptr;
@@ -1839,7 +1973,7 @@ void Ledger::UpdateContents()  // Before transmission or serialization, this is
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // LoadContract will call this function at the right time.
@@ -2146,6 +2280,7 @@ int32_t Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                         //
                         m_mapTransactions[pTransaction->GetTransactionNum()] =
                             pTransaction;
+                        index_transaction(*pTransaction);
                         pTransaction->SetParent(*this);
                         //                      otLog5 << "Loaded abbreviated
                         // transaction and adding to m_mapTransactions in
@@ -2314,6 +2449,7 @@ int32_t Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                 //
                 m_mapTransactions[pTransaction->GetTransactionNum()] =
                     pTransaction;
+                index_transaction(*pTransaction);
                 pTransaction->SetParent(*this);
                 //                otLog5 << "Loaded full transaction and adding
                 // to m_mapTransactions in OTLedger\n");
@@ -2417,6 +2553,13 @@ void Ledger::ReleaseTransactions()
         delete pTransaction;
         pTransaction = nullptr;
     }
+
+    m_vecTransactions.clear();
+    m_bPositionsDirty = false;
+    m_mapTransactionKeys.clear();
+    m_mapReferenceIndex.clear();
+    m_mapRequestIndex.clear();
+    m_mapTypeIndex.clear();
 }
 
 void Ledger::Release_Ledger() { ReleaseTransactions(); }
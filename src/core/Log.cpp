@@ -58,6 +58,7 @@
 #include <stdint.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
@@ -71,6 +72,11 @@
 #include <typeinfo>
 
 #define LOG_DEQUE_SIZE 1024
+#define LOG_QUEUE_SIZE 4096
+#define LOG_WRITER_SLEEP_MILLISECONDS 5
+// otErr is -1 and otLog5 is 5
+#define LOG_STREAM_MIN_LEVEL -1
+#define LOG_STREAM_MAX_LEVEL 5
 
 extern "C" {
 
@@ -142,46 +148,86 @@ OTLOG_IMPORT OTLogStream otLog5(5);  // logs using OTLog::vOutput(5)
 OTLogStream::OTLogStream(int _logLevel)
     : std::ostream(this)
     , logLevel(_logLevel)
-    , next(0)
-    , pBuffer(new char[1024])
 {
+    OT_ASSERT(LOG_STREAM_MIN_LEVEL <= logLevel);
+    OT_ASSERT(LOG_STREAM_MAX_LEVEL >= logLevel);
+
+    SetLogLevel(Log::LogLevel());
+}
+
+OTLogStream::~OTLogStream() {}
+
+std::string& OTLogStream::buffer()
+{
+    static thread_local std::array<
+        std::string,
+        LOG_STREAM_MAX_LEVEL - LOG_STREAM_MIN_LEVEL + 1>
+        buffers{};
+
+    return buffers.at(logLevel - LOG_STREAM_MIN_LEVEL);
 }
 
-OTLogStream::~OTLogStream()
+void OTLogStream::emit(std::string& line)
 {
-    delete[] pBuffer;
-    pBuffer = nullptr;
+    // Logging the line may write to this stream again.
+    const std::string output(std::move(line));
+    line.clear();
+
+    if (logLevel < 0) {
+        Log::Error(output.c_str());
+    } else {
+        Log::Output(logLevel, output.c_str());
+    }
 }
 
 int OTLogStream::overflow(int c)
 {
-    rLock lock(lock_);
+    typedef std::streambuf::traits_type traits;
 
-    pBuffer[next++] = c;
-    if (c != '\n' && next < 1000) {
-        return 0;
+    if (traits::eq_int_type(c, traits::eof())) { return traits::not_eof(c); }
+
+    auto& line = buffer();
+    line.push_back(traits::to_char_type(c));
+
+    if ('\n' == line.back()) { emit(line); }
+
+    return c;
+}
+
+void OTLogStream::SetLogLevel(std::int32_t nLogLevel)
+{
+    // Must match the filter in Log::Output()
+    if ((0 <= logLevel) && ((logLevel > nLogLevel) || (-1 == nLogLevel))) {
+        clear(std::ios_base::badbit);
+    } else {
+        clear();
     }
+}
 
-    pBuffer[next++] = '\0';
-    next = 0;
+std::streamsize OTLogStream::xsputn(const char* s, std::streamsize n)
+{
+    auto& line = buffer();
 
-    if (logLevel < 0) {
-        Log::Error(pBuffer);
-        return 0;
+    for (std::streamsize i = 0; i < n; ++i) {
+        line.push_back(s[i]);
+
+        if ('\n' == s[i]) { emit(line); }
     }
 
-    Log::Output(logLevel, pBuffer);
-    return 0;
+    return n;
 }
 
 Log::Log(const api::Settings& config)
     : config_(config)
+    , queue_(LOG_QUEUE_SIZE)
 {
     bool notUsed{false};
     config_.Check_bool(
         CONFIG_LOG_SECTION, CONFIG_LOG_TO_FILE_KEY, write_log_file_, notUsed);
 }
 
+Log::~Log() { stop_writer(); }
+
 //  OTLog Init, must run this before using any OTLog function.
 
 // static
@@ -247,6 +293,8 @@ bool Log::Init(
             }
 
         pLogger->m_bInitialized = true;
+        pLogger->start_writer();
+        update_streams();
 
         // Set the new log-assert function pointer.
         Assert* pLogAssert = new Assert(Log::logAssert);
@@ -323,12 +371,58 @@ bool Log::SetLogLevel(const int32_t& nLogLevel)
         OT_FAIL;
     } else {
         pLogger->m_nLogLevel = nLogLevel;
+        update_streams();
         return true;
     }
 }
 
 //  OTLog Functions
 
+// Waits until everything queued so far has been written.
+void Log::flush()
+{
+    if (false == running_.load()) { return; }
+
+    if (std::this_thread::get_id() == writer_.get_id()) { return; }
+
+    const auto target = queued_.load();
+
+    while (written_.load() < target) { std::this_thread::yield(); }
+}
+
+void Log::start_writer()
+{
+    if (running_.exchange(true)) { return; }
+
+    writer_ = std::thread(&Log::write_thread, this);
+}
+
+void Log::stop_writer()
+{
+    if (false == running_.exchange(false)) { return; }
+
+    if (writer_.joinable()) { writer_.join(); }
+
+    // Anything queued after the writer's last pass.
+    std::string line;
+
+    while (queue_.Pop(line)) {
+        write_direct(line.c_str());
+        ++written_;
+    }
+}
+
+// static
+void Log::update_streams()
+{
+    const auto level = LogLevel();
+
+    for (auto* stream :
+         {&otErr, &otOut, &otWarn, &otInfo, &otLog3, &otLog4, &otLog5}) {
+        stream->SetLogLevel(level);
+    }
+}
+
 // If there's no logfile, then send it to stderr.
 // (So we can still see it on the screen, but it doesn't interfere with any
 // command line utilities who might otherwise interpret it as their own input,
@@ -336,6 +430,14 @@ bool Log::SetLogLevel(const int32_t& nLogLevel)
 //
 // static
 bool Log::LogToFile(const String& strOutput)
+{
+    return write_line(strOutput, false);
+}
+
+// Used until the writer thread is running, and after it stops.
+//
+// static
+bool Log::write_direct(const String& strOutput)
 {
     // We now do this either way.
     {
@@ -380,6 +482,102 @@ bool Log::LogToFile(const String& strOutput)
     return bSuccess;
 }
 
+// Hands strOutput to the writer thread. If the queue is full, droppable lines
+// are counted and discarded, and anything else waits for room.
+//
+// static
+bool Log::write_line(const String& strOutput, bool bDroppable)
+{
+    if ((nullptr == pLogger) || (false == pLogger->running_.load())) {
+        return write_direct(strOutput);
+    }
+
+    if (false == strOutput.Exists()) { return true; }
+
+    std::string line(strOutput.Get());
+    // Counted before the line is visible to the writer, so flush() never
+    // takes a target that misses a line already in the queue.
+    ++pLogger->queued_;
+
+    while (false == pLogger->queue_.Push(std::move(line))) {
+        if (bDroppable) {
+            --pLogger->queued_;
+            ++pLogger->dropped_;
+
+            return false;
+        }
+
+        std::this_thread::yield();
+    }
+
+    return true;
+}
+
+// Owns the log file for as long as the logger is running, so it is opened
+// once instead of for every line.
+void Log::write_thread()
+{
+    std::ofstream logfile;
+
+    if (write_log_file_ && m_strLogFilePath.Exists()) {
+        logfile.open(m_strLogFilePath.Get(), std::ios::app);
+
+        if (logfile.fail()) {
+            std::cerr << "Log::write_thread: Failed to open log file: "
+                      << m_strLogFilePath << "\n";
+        }
+    }
+
+    const bool bToFile = logfile.is_open();
+    std::string line;
+
+    while (true) {
+        // Checked before draining so nothing queued before
+        // stop_writer() is missed.
+        const bool bRunning = running_.load();
+        std::uint64_t count{0};
+
+        while (queue_.Pop(line)) {
+            std::cerr << line;
+
+            if (bToFile) { logfile << line; }
+
+            ++count;
+        }
+
+        bool bWrote = (0 < count);
+
+        const auto dropped = dropped_.exchange(0);
+
+        if (0 < dropped) {
+            line = "Log::write_thread: Dropped " + std::to_string(dropped) +
+                   " log messages because the queue was full.\n";
+            std::cerr << line;
+
+            if (bToFile) { logfile << line; }
+
+            bWrote = true;
+        }
+
+        if (bWrote) {
+            std::cerr.flush();
+
+            if (bToFile) { logfile.flush(); }
+
+            // Only counted once flushed, so flush() returns after the lines
+            // have reached the file.
+            written_ += count;
+
+            continue;
+        }
+
+        if (false == bRunning) { break; }
+
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(LOG_WRITER_SLEEP_MILLISECONDS));
+    }
+}
+
 String Log::GetMemlogAtIndex(int32_t nIndex)
 {
     // lets check if we are Initialized in this context
@@ -592,6 +790,9 @@ size_t Log::logAssert(
 #endif
     }
 
+    // The process is likely about to terminate.
+    if (nullptr != pLogger) { pLogger->flush(); }
+
     print_stacktrace();
 
     return 1;  // normal
@@ -621,7 +822,8 @@ void Log::Output(int32_t nVerbosity, const char* szOutput)
 
 #ifndef ANDROID  // if NOT android
 
-    LogToFile(szOutput);
+    // Verbose output may be dropped if the writer can't keep up.
+    write_line(szOutput, 0 < nVerbosity);
 
 #else  // if IS Android
     /*
@@ -479,7 +479,7 @@ void Message::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 bool Message::updateContentsByType(Tag& parent)
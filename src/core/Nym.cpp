@@ -748,7 +748,7 @@ void Nym::GetPrivateCredentials(String& strCredList, String::Map* pmapCredFiles)
     std::string str_result;
     tag.output(str_result);
 
-    strCredList.Concatenate("%s", str_result.c_str());
+    strCredList.Concatenate(str_result);
 }
 
 const OTAsymmetricKey& Nym::GetPrivateEncrKey() const
@@ -2519,7 +2519,7 @@ bool Nym::SavePseudonym(String& strNym)
     std::string str_result;
     tag.output(str_result);
 
-    strNym.Concatenate("%s", str_result.c_str());
+    strNym.Concatenate(str_result);
 
     return true;
 }
@@ -47,6 +47,9 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/OTStoragePB.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <fstream>
 #include <sstream>
 #include <typeinfo>
@@ -649,6 +652,38 @@ bool StorePlainString(
         strContents, ot_strFolder.Get(), ot_oneStr.Get(), twoStr, threeStr);
 }
 
+bool AppendPlainString(
+    const std::string& strContents,
+    const std::string& strFolder,
+    const std::string& oneStr,
+    const std::string& twoStr,
+    const std::string& threeStr)
+{
+    String ot_strFolder(strFolder), ot_oneStr(oneStr), ot_twoStr(twoStr),
+        ot_threeStr(threeStr);
+    OT_ASSERT_MSG(
+        ot_strFolder.Exists(), "OTDB::AppendPlainString: strFolder is null");
+
+    if (!ot_oneStr.Exists()) {
+        OT_ASSERT_MSG(
+            (!ot_twoStr.Exists() && !ot_threeStr.Exists()),
+            "OTDB::AppendPlainString: bad options");
+        ot_oneStr = strFolder.c_str();
+        ot_strFolder = ".";
+    }
+    Storage* pStorage = details::s_pStorage;
+
+    OT_ASSERT((strFolder.length() > 3) || (0 == strFolder.compare(0, 1, ".")));
+    OT_ASSERT((oneStr.length() < 1) || (oneStr.length() > 3));
+
+    if (nullptr == pStorage) {
+        return false;
+    }
+
+    return pStorage->AppendPlainString(
+        strContents, ot_strFolder.Get(), ot_oneStr.Get(), twoStr, threeStr);
+}
+
 std::string QueryPlainString(
     const std::string& strFolder,
     const std::string& oneStr,
@@ -2257,6 +2292,17 @@ bool Storage::StorePlainString(
     return onStorePlainString(strContents, strFolder, oneStr, twoStr, threeStr);
 }
 
+bool Storage::AppendPlainString(
+    const std::string& strContents,
+    const std::string& strFolder,
+    const std::string& oneStr,
+    const std::string& twoStr,
+    const std::string& threeStr)
+{
+    return onAppendPlainString(
+        strContents, strFolder, oneStr, twoStr, threeStr);
+}
+
 std::string Storage::QueryPlainString(
     const std::string& strFolder,
     const std::string& oneStr,
@@ -2856,6 +2902,58 @@ bool StorageFS::onQueryPlainString(
     return bSuccess;
 }
 
+bool StorageFS::onAppendPlainString(
+    const std::string& theBuffer,
+    const std::string& strFolder,
+    const std::string& oneStr,
+    const std::string& twoStr,
+    const std::string& threeStr)
+{
+    std::string strOutput;
+
+    if (0 > ConstructAndCreatePath(
+                strOutput, strFolder, oneStr, twoStr, threeStr)) {
+        otErr << "StorageFS::" << __FUNCTION__ << ": Error writing to "
+              << strOutput << ".\n";
+        return false;
+    }
+
+    std::ofstream ofs(
+        strOutput.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+
+    if (ofs.fail()) {
+        otErr << __FUNCTION__ << ": Error opening file: " << strOutput << "\n";
+        return false;
+    }
+
+    ofs << theBuffer;
+    ofs.flush();
+    bool bSuccess = ofs.good();
+    ofs.close();
+
+    // Callers append records which must survive a crash once this returns.
+    if (bSuccess) {
+        const int fd = ::open(strOutput.c_str(), O_RDONLY);
+        bSuccess = (-1 != fd);
+
+        if (bSuccess) {
+#if defined(__APPLE__)
+            bSuccess = (0 == ::fcntl(fd, F_FULLFSYNC));
+#else
+            bSuccess = (0 == ::fsync(fd));
+#endif
+            ::close(fd);
+        }
+
+        if (false == bSuccess) {
+            otErr << __FUNCTION__ << ": Error syncing file: " << strOutput
+                  << "\n";
+        }
+    }
+
+    return bSuccess;
+}
+
 // Erase a value by location.
 //
 bool StorageFS::onEraseValueByKey(
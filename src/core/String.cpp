@@ -60,7 +60,9 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <sstream>
 #include <string>
@@ -640,20 +642,74 @@ void String::zeroMemory() const
     }
 }
 
-void String::Release_String(void)
+void String::deallocate()
 {
     if (nullptr != data_) {
         // for security purposes.
         //
         OTPassword::zeroMemory(data_, length_);
         //        memset(data_, 0, length_);
-        delete[] data_;
+
+        if (small_ != data_) { delete[] data_; }
     }
     data_ = nullptr;
+    capacity_ = 0;
+}
+
+void String::Release_String(void)
+{
+    deallocate();
     position_ = 0;
     length_ = 0;
 }
 
+void String::reserve(uint32_t size)
+{
+    if ((nullptr != data_) && (capacity_ >= size)) { return; }
+
+    OT_ASSERT_MSG(
+        size < (MAX_STRING_LENGTH - 10),
+        "ASSERT: OTString::reserve: Exceeded MAX_STRING_LENGTH!");
+
+    if ((nullptr == data_) && (size < sizeof(small_))) {
+        data_ = small_;
+        capacity_ = sizeof(small_) - 1;
+        data_[0] = '\0';
+
+        return;
+    }
+
+    // Grow geometrically, so that appends are amortized constant time.
+    uint32_t capacity = std::max(size, 2 * capacity_);
+
+    if (capacity >= (MAX_STRING_LENGTH - 10)) { capacity = size; }
+
+    char* buffer = new char[capacity + 1];
+    OT_ASSERT(nullptr != buffer);
+
+    if (nullptr != data_) {
+        std::memcpy(buffer, data_, length_);
+    }
+
+    buffer[length_] = '\0';
+
+    const uint32_t length = length_;
+    deallocate();
+    length_ = length;
+    data_ = buffer;
+    capacity_ = capacity;
+}
+
+void String::append(const char* data, uint32_t size)
+{
+    if ((nullptr == data) || (0 == size)) { return; }
+
+    reserve(length_ + size);
+    std::memcpy(data_ + length_, data, size);
+    length_ += size;
+    data_[length_] = '\0';
+}
+
 void String::Release(void)
 {
     Release_String();
@@ -669,12 +725,14 @@ void String::Initialize()
 {
     length_ = 0;
     position_ = 0;
+    capacity_ = 0;
     data_ = nullptr;
 }
 
 String::String()
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -686,6 +744,7 @@ String::String()
 String::String(const Identifier& theValue)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -696,6 +755,7 @@ String::String(const Identifier& theValue)
 String::String(const Contract& theValue)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -708,6 +768,7 @@ String::String(const Contract& theValue)
 String::String(const OTASCIIArmor& strValue)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -726,6 +787,7 @@ String::String(const OTASCIIArmor& strValue)
 String::String(const OTSignature& strValue)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -736,6 +798,7 @@ String::String(const OTSignature& strValue)
 String::String(Nym& theValue)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -746,15 +809,26 @@ String::String(Nym& theValue)
 String::String(const String& strValue)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
     LowLevelSetStr(strValue);
 }
 
+String::String(String&& strValue)
+    : length_(0)
+    , position_(0)
+    , capacity_(0)
+    , data_(nullptr)
+{
+    swap(strValue);
+}
+
 String::String(const char* new_string)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -764,6 +838,7 @@ String::String(const char* new_string)
 String::String(const char* new_string, size_t sizeLength)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -773,6 +848,7 @@ String::String(const char* new_string, size_t sizeLength)
 String::String(const std::string& new_string)
     : length_(0)
     , position_(0)
+    , capacity_(0)
     , data_(nullptr)
 {
     //    Initialize();
@@ -795,7 +871,9 @@ void String::LowLevelSetStr(const String& strBuf)
             "anyway--it would have been truncated here, potentially "
             "causing data corruption.)");  // 10 being a buffer.
 
-        data_ = str_dup2(strBuf.data_, length_);
+        const uint32_t length = length_;
+        length_ = 0;
+        append(strBuf.data_, length);
     }
 }
 
@@ -844,12 +922,7 @@ void String::LowLevelSet(const char* new_string, uint32_t nEnforcedMaxLength)
         //
         //      new_string[nLength] = '\0';
 
-        data_ = str_dup2(new_string, nLength);
-
-        if (nullptr != data_)
-            length_ = nLength;
-        else
-            length_ = 0;
+        append(new_string, nLength);
     }
 }
 
@@ -862,40 +935,14 @@ bool String::MemSet(const char* pMem, uint32_t theSize)  // if theSize is 10...
     // -------------------
     if ((nullptr == pMem) || (theSize < 1)) return true;
 
-    char* str_new = new char[theSize + 1];  // then we allocate 11
-    OT_ASSERT(nullptr != str_new);
-    // -------------------
-    OTPassword::zeroMemory(str_new, theSize + 1);
-
-    //  void * OTPassword::safe_memcpy(void* dest,
-    //                                 uint32_t dest_size,
-    //                                 const
-    //                                 void   * src,
-    //                                 uint32_t src_length,
-    //                                 bool     bZeroSource)
-
-    OTPassword::safe_memcpy(
-        static_cast<void*>(str_new), theSize + 1, pMem, theSize);
-    //    memcpy(static_cast<void*>(str_new), pMem, theSize); // then we copy 10
-    // bytes
-
-    // todo optimize: This is probably superfluous due to the zeroMemory above.
-    // Then again, we might want to remove that, and then keep this.
-    str_new[theSize] = '\0';  // add null-terminator. (I deliberately made this
-    // buffer 1 byte larger so I could put the 0 at the
-    // end.) Here the index[10] is the 11th byte, since
-    // we're counting from 0.
-
     // Calculate the length (in case there was a null terminator in the
     // middle...)
     // This way we're guaranteed to have the correct length.
     //
-    uint32_t nLength = static_cast<uint32_t>(
-        String::safe_strlen(str_new, static_cast<size_t>(theSize)));
-    str_new[nLength] = '\0';  // This SHOULD be superfluous as well...
+    const uint32_t nLength = static_cast<uint32_t>(
+        String::safe_strlen(pMem, static_cast<size_t>(theSize)));
 
-    length_ = nLength;  // the length doesn't count the 0.
-    data_ = str_new;
+    append(pMem, nLength);  // the length doesn't count the 0.
 
     return true;
 }
@@ -909,9 +956,19 @@ String& String::operator=(String rhs)
 
 void String::swap(String& rhs)
 {
+    // A string stored in small_ has to move with the buffer.
+    const bool bSmall = (small_ == data_);
+    const bool bRhsSmall = (rhs.small_ == rhs.data_);
+
     std::swap(length_, rhs.length_);
     std::swap(position_, rhs.position_);
+    std::swap(capacity_, rhs.capacity_);
     std::swap(data_, rhs.data_);
+    std::swap(small_, rhs.small_);
+
+    if (bSmall) { rhs.data_ = rhs.small_; }
+
+    if (bRhsSmall) { data_ = small_; }
 }
 
 bool String::At(uint32_t lIndex, char& c) const
@@ -1220,23 +1277,28 @@ void String::Concatenate(const char* fmt, ...)
 
     va_end(vl);
 
-    if (bSuccess) {
-        const String strConcat(str_output);
-
-        Concatenate(strConcat);
-    }
+    if (bSuccess) Concatenate(str_output);
 }
 
 // append a string at the end of the current buffer.
 void String::Concatenate(const String& strBuf)
 {
-    std::string str_output;
+    if (this == &strBuf) {
+        const String strCopy(strBuf);
+        append(strCopy.data_, strCopy.length_);
 
-    if ((length_ > 0) && (nullptr != data_)) str_output += data_;
+        return;
+    }
 
-    if (strBuf.Exists() && (strBuf.GetLength() > 0)) str_output += strBuf.Get();
+    append(strBuf.data_, strBuf.length_);
+}
 
-    Set(str_output.c_str());
+// append a string at the end of the current buffer.
+void String::Concatenate(const std::string& data)
+{
+    append(
+        data.c_str(),
+        static_cast<uint32_t>(String::safe_strlen(data.c_str(), data.size())));
 }
 
 void String::WriteToFile(std::ostream& ofs) const
@@ -352,7 +352,7 @@ void Basket::GenerateContents(OTStringXML& xmlUnsigned, bool bHideAccountID)
     std::string str_result;
     tag.output(str_result);
 
-    xmlUnsigned.Concatenate("%s", str_result.c_str());
+    xmlUnsigned.Concatenate(str_result);
 }
 
 // Most contracts calculate their ID by hashing the Raw File (signatures and
@@ -41,6 +41,7 @@
 #include "opentxs/core/cron/OTCron.hpp"
 
 #include "opentxs/core/cron/OTCronItem.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/trade/OTMarket.hpp"
 #include "opentxs/core/util/Assert.hpp"
@@ -48,23 +49,28 @@
 #include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/util/StringUtils.hpp"
 #include "opentxs/core/util/Tag.hpp"
-#include "opentxs/core/util/Timer.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/core/NumList.hpp"
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/String.hpp"
 
 #include <irrxml/irrXML.hpp>
 #include <string.h>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -84,7 +90,10 @@ int32_t OTCron::__cron_max_items_per_nym = 10;  // The maximum number of cron
                                                 // items any given Nym can have
                                                 // active at the same time.
 
-Timer OTCron::tCron(true);
+int32_t OTCron::__market_checkpoint_interval = 100;  // The number of journal
+                                                     // records a market writes
+                                                     // before it is re-signed
+                                                     // and saved in full.
 
 // Make sure Server Nym is set on this cron object before loading or saving,
 // since it's
@@ -98,7 +107,83 @@ bool OTCron::LoadCron()
 
     bool bSuccess = LoadContract(szFoldername, szFilename);
 
-    if (bSuccess) bSuccess = VerifySignature(*(GetServerNym()));
+    // Whatever was read before any parse error is still added, as it was when
+    // the items were verified one at a time while parsing.
+    const bool bItems = add_pending_items();
+
+    if (bSuccess) bSuccess = bItems && VerifySignature(*(GetServerNym()));
+
+    return bSuccess;
+}
+
+// Verifies the server's signature on every cron item ProcessXMLNode read,
+// as a single batch, and then adds them to Cron in file order. Once one fails,
+// it and all the items after it are discarded.
+bool OTCron::add_pending_items()
+{
+    OT_ASSERT(nullptr != GetServerNym());
+
+    std::list<OTData> data;
+    SignatureBatch checks;
+    std::vector<std::size_t> ends;
+
+    for (auto& it : m_listPendingItems) {
+        it.second->SignatureChecks(*m_pServerNym, data, checks);
+        ends.push_back(checks.size());
+    }
+
+    const auto verified = CryptoAsymmetric::VerifyBatch(checks);
+    bool bSuccess = true;
+    std::size_t first = 0;
+    auto end = ends.begin();
+
+    while (!m_listPendingItems.empty()) {
+        const time64_t tDateAdded = m_listPendingItems.front().first;
+        OTCronItem* pItem = m_listPendingItems.front().second;
+        m_listPendingItems.pop_front();
+        const std::size_t last = *end++;
+        const bool bVerified = std::any_of(
+            verified.begin() + first,
+            verified.begin() + last,
+            [](const bool result) -> bool { return result; });
+        first = last;
+
+        if (false == bSuccess) {
+            delete pItem;
+
+            continue;
+        }
+
+        if (false == bVerified) {
+            otErr << "OTCron::" << __FUNCTION__
+                  << ": ERROR SECURITY: Server signature failed to verify on "
+                     "a cron item while loading: "
+                  << pItem->GetTransactionNum() << "\n";
+            delete pItem;
+            bSuccess = false;
+        } else if (AddCronItem(
+                       *pItem,
+                       nullptr,
+                       false,  // bSaveReceipt=false. The receipt is only saved
+                               // once: When item FIRST added to cron...
+                       tDateAdded)) {  // ...But here, the item was ALREADY in
+                                       // cron, and is merely being loaded from
+                                       // disk.
+            // Thus, it would be wrong to try to create the "original record"
+            // as if it were brand new and still had the user's signature on
+            // it. (Once added to Cron, the signatures are released and the
+            // SERVER signs it from there. That's why the user's version is
+            // saved as a receipt in the first place -- so we have a record of
+            // the user's authorization.)
+            otInfo << "Successfully loaded cron item and added to list.\n";
+        } else {
+            otErr << "OTCron::" << __FUNCTION__
+                  << ": Though loaded / verified successfully, unable to add "
+                     "cron item (from cron file) to cron list.\n";
+            delete pItem;
+            bSuccess = false;
+        }
+    }
 
     return bSuccess;
 }
@@ -123,9 +208,8 @@ bool OTCron::SaveCron()
         return true;
 }
 
-// Loops through ALL markets, and calls pMarket->GetNym_OfferList(NYM_ID,
-// *pOfferList) for each.
 // Returns a list of all the offers that a specific Nym has on all the markets.
+// Only the Nym's own cron items are visited, using the indexes.
 //
 bool OTCron::GetNym_OfferList(
     OTASCIIArmor& ascOutput,
@@ -138,25 +222,27 @@ bool OTCron::GetNym_OfferList(
         dynamic_cast<OTDB::OfferListNym*>(
             OTDB::CreateObject(OTDB::STORED_OBJ_OFFER_LIST_NYM)));
 
-    for (auto& it : m_mapMarkets) {
-        OTMarket* pMarket = it.second;
-        OT_ASSERT(nullptr != pMarket);
+    auto nym = m_mapNymItems.find(String(NYM_ID).Get());
 
-        int32_t nNymOfferCount = 0;
+    if (m_mapNymItems.end() != nym) {
+        for (const auto& lTransactionNum : nym->second) {
+            auto it = m_mapOfferMarkets.find(lTransactionNum);
 
-        if (false ==
-            pMarket->GetNym_OfferList(
-                NYM_ID,
-                *pOfferList,
-                nNymOfferCount))  // appends to
-                                  // *pOfferList,
-                                  // each
-                                  // iteration.
-        {
-            // may wish to add a log later. Anyway, keep iterationg and
-            // appending, then send back whatever we have.
-        } else  // Success!
-            nOfferCount += nNymOfferCount;
+            // Not a trade, or its offer isn't on a market yet.
+            if (m_mapOfferMarkets.end() == it) continue;
+
+            OTMarket* pMarket = it->second;
+            OT_ASSERT(nullptr != pMarket);
+
+            OTOffer* pOffer = pMarket->GetOffer(lTransactionNum);
+
+            if (nullptr == pOffer) continue;
+
+            // appends to *pOfferList, each iteration.
+            if (pMarket->GetNym_OfferData(NYM_ID, *pOffer, *pOfferList)) {
+                nOfferCount++;
+            }
+        }
     }
 
     // Now pack the list into strOutput...
@@ -256,13 +342,11 @@ bool OTCron::GetMarketList(OTASCIIArmor& ascOutput, int32_t& nMarketCount)
 
         pMarketData->last_sale_date = pMarket->GetLastSaleDate();
 
-        const mapOfOffers::size_type theBidCount = pMarket->GetBidCount();
-        const mapOfOffers::size_type theAskCount = pMarket->GetAskCount();
+        const std::size_t theBidCount = pMarket->GetBidCount();
+        const std::size_t theAskCount = pMarket->GetAskCount();
 
-        pMarketData->number_bids =
-            to_string<mapOfOffers::size_type>(theBidCount);
-        pMarketData->number_asks =
-            to_string<mapOfOffers::size_type>(theAskCount);
+        pMarketData->number_bids = to_string<std::size_t>(theBidCount);
+        pMarketData->number_asks = to_string<std::size_t>(theAskCount);
 
         // In the past 24 hours.
         // (I'm not collecting this data yet, (maybe never), so these values
@@ -418,47 +502,12 @@ int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                 return (-1);
             }
 
-            // Why not do this here (when loading from storage), as well as when
-            // first adding the item to cron,
-            // and thus save myself the trouble of verifying the signature EVERY
-            // ITERATION of ProcessCron().
+            // The server's signature on the item is verified by LoadCron,
+            // together with all the other items, rather than one at a time
+            // here. That way it isn't verified EVERY ITERATION of
+            // ProcessCron() either.
             //
-            if (!pItem->VerifySignature(*m_pServerNym)) {
-                otErr << "OTCron::ProcessXMLNode: ERROR SECURITY: Server "
-                         "signature failed to "
-                         "verify on a cron item while loading: "
-                      << pItem->GetTransactionNum() << "\n";
-                delete pItem;
-                pItem = nullptr;
-                return (-1);
-            } else if (AddCronItem(
-                           *pItem,
-                           nullptr,
-                           false,          // bSaveReceipt=false. The receipt is
-                                           // only saved once: When item FIRST
-                                           // added to cron...
-                           tDateAdded)) {  // ...But here, the item was
-                                           // ALREADY in cron, and is
-                                           // merely being loaded from
-                                           // disk.
-                // Thus, it would be wrong to try to create the "original
-                // record" as if it were brand
-                // new and still had the user's signature on it. (Once added to
-                // Cron, the signatures are
-                // released and the SERVER signs it from there. That's why the
-                // user's version is saved
-                // as a receipt in the first place -- so we have a record of the
-                // user's authorization.)
-                otInfo << "Successfully loaded cron item and added to list.\n";
-            } else {
-                otErr << "OTCron::ProcessXMLNode: Though loaded / verified "
-                         "successfully, "
-                         "unable to add cron item (from cron file) to cron "
-                         "list.\n";
-                delete pItem;
-                pItem = nullptr;
-                return (-1);
-            }
+            m_listPendingItems.emplace_back(tDateAdded, pItem);
         }
 
         nReturnVal = 1;
@@ -568,12 +617,50 @@ void OTCron::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
+}
+
+int64_t OTCron::computeTimeout() const
+{
+    const int64_t maximum = OTCron::GetCronMsBetweenProcess();
+
+    if ((false == m_bIsActivated) || m_setDeadlines.empty()) {
+
+        return maximum;
+    }
+
+    const auto due = m_setDeadlines.begin()->first;
+    const auto now = OTTimeGetCurrentTime();
+
+    if (due <= now) { return 0; }
+
+    const int64_t output = 1000 * OTTimeGetTimeInterval(due, now);
+
+    return std::min(output, maximum);
+}
+
+void OTCron::schedule(const int64_t lTransactionNum, const time64_t tDue)
+{
+    unschedule(lTransactionNum);
+    m_setDeadlines.emplace(tDue, lTransactionNum);
+    m_mapDeadlines[lTransactionNum] = tDue;
 }
 
-int64_t OTCron::computeTimeout()
+void OTCron::unschedule(const int64_t lTransactionNum)
 {
-    return OTCron::GetCronMsBetweenProcess() - tCron.getElapsedTimeInMilliSec();
+    auto it = m_mapDeadlines.find(lTransactionNum);
+
+    if (m_mapDeadlines.end() == it) { return; }
+
+    m_setDeadlines.erase({it->second, lTransactionNum});
+    m_mapDeadlines.erase(it);
+}
+
+void OTCron::WakeCronItem(int64_t lTransactionNum)
+{
+    if (1 == m_mapDeadlines.count(lTransactionNum)) {
+        schedule(lTransactionNum, OT_TIME_ZERO);
+    }
 }
 
 // Make sure to call this regularly so the CronItems get a chance to process and
@@ -585,11 +672,28 @@ void OTCron::ProcessCronItems()
         return;
     }
 
-    // check elapsed time since last items processing
-    if (computeTimeout() > 0) {
+    const auto now = OTTimeGetCurrentTime();
+
+    // Nothing is due yet.
+    if (m_setDeadlines.empty() || (m_setDeadlines.begin()->first > now)) {
         return;
     }
-    tCron.start();
+
+    // Collect the due items first, since processing one item may wake or
+    // remove others.
+    std::vector<int64_t> due{};
+
+    for (const auto& it : m_setDeadlines) {
+        if (it.first > now) break;
+
+        due.push_back(it.second);
+    }
+
+    // No item is processed more often than once per cron interval, even if
+    // its own process interval is shorter.
+    const int64_t lMinimumInterval =
+        std::max(1, (OTCron::GetCronMsBetweenProcess() + 999) / 1000);
+    const auto tNextRound = OTTimeAddTimeInterval(now, lMinimumInterval);
 
     const int32_t nTwentyPercent = OTCron::GetCronRefillAmount() / 5;
     if (GetTransactionCount() <= nTwentyPercent) {
@@ -604,15 +708,21 @@ void OTCron::ProcessCronItems()
               << " were used in the last round alone!!! \n"
                  "SKIPPING THE CRON ITEMS THAT WERE SCHEDULED FOR THIS "
                  "ROUND!!!\n\n";
+        // Retry on the next round rather than immediately.
+        for (const auto& lTransactionNum : due) {
+            schedule(lTransactionNum, tNextRound);
+        }
+
         return;
     }
     bool bNeedToSave = false;
 
-    // loop through the cron items and tell each one to ProcessCron().
+    // tell each due cron item to ProcessCron().
     // If the item returns true, that means leave it on the list. Otherwise,
     // if it returns false, that means "it's done: remove it."
-    for (auto it = m_multimapCronItems.begin();
-         it != m_multimapCronItems.end();) {
+    for (auto it = due.begin(); it != due.end(); ++it) {
+        const auto& lTransactionNum = *it;
+
         if (GetTransactionCount() <= nTwentyPercent) {
             otErr << "WARNING: Cron has fewer than 20 percent of its normal "
                      "transaction "
@@ -626,25 +736,42 @@ void OTCron::ProcessCronItems()
                   << " were used in the current round alone!!! \n"
                      "SKIPPING THE REMAINDER OF THE CRON ITEMS THAT WERE "
                      "SCHEDULED FOR THIS ROUND!!!\n\n";
+
+            for (; it != due.end(); ++it) {
+                if (1 == m_mapDeadlines.count(*it)) {
+                    schedule(*it, tNextRound);
+                }
+            }
+
             break;
         }
-        OTCronItem* pItem = it->second;
+
+        auto it_map = FindItemOnMap(lTransactionNum);
+
+        // Already removed by an item processed earlier in this round.
+        if (m_mapCronItems.end() == it_map) continue;
+
+        OTCronItem* pItem = it_map->second;
         OT_ASSERT(nullptr != pItem);
         otInfo << "OTCron::" << __FUNCTION__
                << ": Processing item number: " << pItem->GetTransactionNum()
                << " \n";
 
         if (pItem->ProcessCron()) {
-            it++;
+            schedule(
+                lTransactionNum,
+                std::max(pItem->GetNextProcessDate(), tNextRound));
             continue;
         }
         pItem->HookRemovalFromCron(nullptr, GetNextTransactionNumber());
         otOut << "OTCron::" << __FUNCTION__
               << ": Removing cron item: " << pItem->GetTransactionNum() << "\n";
-        it = m_multimapCronItems.erase(it);
-        auto it_map = FindItemOnMap(pItem->GetTransactionNum());
-        OT_ASSERT(m_mapCronItems.end() != it_map);
+        auto it_multimap = FindItemOnMultimap(lTransactionNum);
+        OT_ASSERT(m_multimapCronItems.end() != it_multimap);
+        unindex(*pItem);
+        m_multimapCronItems.erase(it_multimap);
         m_mapCronItems.erase(it_map);
+        unschedule(lTransactionNum);
 
         delete pItem;
         pItem = nullptr;
@@ -704,13 +831,15 @@ bool OTCron::AddCronItem(
 
         // Insert to the MULTIMAP (by Date)
         //
-        m_multimapCronItems.insert(
+        auto position = m_multimapCronItems.insert(
             m_multimapCronItems.upper_bound(tDateAdded),
             std::pair<time64_t, OTCronItem*>(tDateAdded, &theItem));
+        index(theItem, position);
 
         theItem.SetCronPointer(*this);
         theItem.setServerNym(m_pServerNym);
         theItem.setNotaryID(&m_NOTARY_ID);
+        schedule(theItem.GetTransactionNum(), theItem.GetNextProcessDate());
 
         bool bSuccess = true;
 
@@ -800,8 +929,10 @@ bool OTCron::RemoveCronItem(
 
         pItem->HookRemovalFromCron(&theRemover, GetNextTransactionNumber());
 
+        unindex(*pItem);
         m_mapCronItems.erase(it_map);            // Remove from MAP.
         m_multimapCronItems.erase(it_multimap);  // Remove from MULTIMAP.
+        unschedule(lTransactionNum);
 
         delete pItem;
 
@@ -851,18 +982,15 @@ mapOfCronItems::iterator OTCron::FindItemOnMap(int64_t lTransactionNum)
 multimapOfCronItems::iterator OTCron::FindItemOnMultimap(
     int64_t lTransactionNum)
 {
-    auto itt = m_multimapCronItems.begin();
+    auto itt = m_mapItemIndexes.find(lTransactionNum);
 
-    while (m_multimapCronItems.end() != itt) {
-        OTCronItem* pItem = itt->second;
-        OT_ASSERT((nullptr != pItem));
-
-        if (pItem->GetTransactionNum() == lTransactionNum) break;
+    if (m_mapItemIndexes.end() == itt) { return m_multimapCronItems.end(); }
 
-        ++itt;
-    }
+    auto position = itt->second.position_;
+    OT_ASSERT(nullptr != position->second);
+    OT_ASSERT(position->second->GetTransactionNum() == lTransactionNum);
 
-    return itt;
+    return position;
 }
 
 // Look up a transaction by transaction number and see if it is in the map.
@@ -905,40 +1033,85 @@ OTCronItem* OTCron::GetItemByOfficialNum(int64_t lTransactionNum)
 //
 OTCronItem* OTCron::GetItemByValidOpeningNum(int64_t lOpeningNum)
 {
-    // See if there's something there with that transaction number.
-    auto itt = m_mapCronItems.find(lOpeningNum);
-
-    if (itt == m_mapCronItems.end()) {
-        // We didn't find it as the "official" number, so let's loop
-        // through the cron items one-by-one and see if it's a valid
-        // opening number. (We searched for the "official" number first,
-        // since it will often be the right one, and avoids doing this
-        // longer search. Basically for optimization purposes.)
-        //
-        for (auto& it : m_mapCronItems) {
-            OTCronItem* pItem = it.second;
-            OT_ASSERT((nullptr != pItem));
-
-            if (pItem->IsValidOpeningNumber(lOpeningNum))  // Todo optimization.
-                // Probably can remove
-                // this check.
-                return pItem;
+    // Every opening and closing number of every item is indexed.
+    auto itt = m_mapItemNumbers.find(lOpeningNum);
+
+    if (m_mapItemNumbers.end() == itt) { return nullptr; }
+
+    OTCronItem* pItem = itt->second;
+    OT_ASSERT((nullptr != pItem));
+
+    // It might be one of the closing numbers instead.
+    if (pItem->IsValidOpeningNumber(lOpeningNum)) { return pItem; }
+
+    return nullptr;
+}
+
+void OTCron::index(OTCronItem& theItem, multimapOfCronItems::iterator position)
+{
+    const auto lTransactionNum = theItem.GetTransactionNum();
+    NumList numbers;
+    theItem.GetAllTransactionNumbers(numbers);
+    numbers.Add(theItem.GetOpeningNum());
+
+    for (int32_t i = 0; i < theItem.GetCountClosingNumbers(); ++i) {
+        numbers.Add(theItem.GetClosingTransactionNoAt(i));
+    }
+
+    std::set<int64_t> all;
+    numbers.Output(all);
+    auto& entry = m_mapItemIndexes[lTransactionNum];
+    entry.position_ = position;
+
+    for (const auto& lNumber : all) {
+        if (0 >= lNumber) continue;
+
+        const auto inserted = m_mapItemNumbers.emplace(lNumber, &theItem);
+
+        if (inserted.second) {
+            entry.numbers_.insert(lNumber);
+        } else {
+            otErr << "OTCron::" << __FUNCTION__ << ": Number " << lNumber
+                  << " of cron item " << lTransactionNum
+                  << " already belongs to cron item "
+                  << inserted.first->second->GetTransactionNum() << "\n";
         }
     }
-    // Found it!
-    else {
-        OTCronItem* pItem = itt->second;
-        OT_ASSERT((nullptr != pItem));
-        OT_ASSERT(pItem->IsValidOpeningNumber(lOpeningNum));  // Todo
-                                                              // optimization.
-                                                              // Probably can
-                                                              // remove this
-                                                              // check.
 
-        return pItem;
+    m_mapNymItems[String(theItem.GetSenderNymID()).Get()].insert(
+        lTransactionNum);
+}
+
+void OTCron::unindex(OTCronItem& theItem)
+{
+    const auto lTransactionNum = theItem.GetTransactionNum();
+    auto it = m_mapItemIndexes.find(lTransactionNum);
+
+    if (m_mapItemIndexes.end() != it) {
+        for (const auto& lNumber : it->second.numbers_) {
+            m_mapItemNumbers.erase(lNumber);
+        }
+
+        m_mapItemIndexes.erase(it);
     }
 
-    return nullptr;
+    auto nym = m_mapNymItems.find(String(theItem.GetSenderNymID()).Get());
+
+    if (m_mapNymItems.end() != nym) {
+        nym->second.erase(lTransactionNum);
+
+        if (nym->second.empty()) { m_mapNymItems.erase(nym); }
+    }
+}
+
+void OTCron::OfferAdded(const int64_t lTransactionNum, OTMarket& theMarket)
+{
+    m_mapOfferMarkets[lTransactionNum] = &theMarket;
+}
+
+void OTCron::OfferRemoved(const int64_t lTransactionNum)
+{
+    m_mapOfferMarkets.erase(lTransactionNum);
 }
 
 // OTCron IS responsible for cleaning up theMarket, and takes ownership.
@@ -1134,6 +1307,13 @@ void OTCron::Release()
 void OTCron::Release_Cron()
 {
     // If there were any dynamically allocated objects, clean them up here.
+    while (!m_listPendingItems.empty()) {
+        delete m_listPendingItems.front().second;
+        m_listPendingItems.pop_front();
+    }
+
+    m_setDeadlines.clear();
+    m_mapDeadlines.clear();
 
     while (!m_multimapCronItems.empty()) {
         auto it = m_multimapCronItems.begin();
@@ -1158,6 +1338,11 @@ void OTCron::Release_Cron()
         delete pMarket;
         pMarket = nullptr;
     }
+
+    m_mapItemNumbers.clear();
+    m_mapItemIndexes.clear();
+    m_mapNymItems.clear();
+    m_mapOfferMarkets.clear();
 }
 
 }  // namespace opentxs
@@ -44,6 +44,7 @@
 #include "opentxs/api/Native.hpp"
 #include "opentxs/consensus/ClientContext.hpp"
 #include "opentxs/consensus/ServerContext.hpp"
+#include "opentxs/core/cron/OTCron.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/recurring/OTPaymentPlan.hpp"
 #include "opentxs/core/script/OTSmartContract.hpp"
@@ -704,6 +705,33 @@ bool OTCronItem::ProcessCron()
     return true;
 }
 
+void OTCronItem::FlagForRemoval()
+{
+    m_bRemovalFlag = true;
+
+    if (nullptr != m_pCron) { m_pCron->WakeCronItem(GetTransactionNum()); }
+}
+
+time64_t OTCronItem::GetNextProcessDate() const
+{
+    if (OT_TIME_ZERO >= m_LAST_PROCESS_DATE) { return OT_TIME_ZERO; }
+
+    // ProcessCron() skips the item until strictly more than the interval
+    // has passed
+    auto output =
+        OTTimeAddTimeInterval(m_LAST_PROCESS_DATE, m_PROCESS_INTERVAL + 1);
+    const auto validTo = GetValidTo();
+
+    // The item must still be visited when it expires, so it can be removed
+    if (OT_TIME_ZERO < validTo) {
+        const auto expires = OTTimeAddTimeInterval(validTo, 1);
+
+        if (expires < output) { output = expires; }
+    }
+
+    return output;
+}
+
 // OTCron calls this when a cron item is added.
 // bForTheFirstTime=true means that this cron item is being
 // activated for the very first time. (Versus being re-added
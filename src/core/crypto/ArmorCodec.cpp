@@ -0,0 +1,452 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/crypto/ArmorCodec.hpp"
+
+#include <zconf.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+
+// Bytes of binary input which become one full line of armor
+#define OT_ARMOR_LINE_BYTES 54
+// Size of the intermediate buffer between zlib and base64. A multiple of
+// OT_ARMOR_LINE_BYTES so that every block except the last ends on a line.
+#define OT_ARMOR_BLOCK_BYTES (OT_ARMOR_LINE_BYTES * 512)
+// Marks a character outside of the base64 alphabet in the decode tables
+#define OT_ARMOR_INVALID 0x01000000
+#define OT_ARMOR_MIN_OUTPUT 4096
+
+namespace opentxs
+{
+namespace
+{
+const char alphabet_[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** Lookup tables for the base64 kernels
+ *
+ *  pairs_ maps 12 bits of input to two output characters, so three input
+ *  bytes take two lookups. decode_ holds the value of each character
+ *  pre-shifted for each of the four positions in a group, so a group of
+ *  four characters is decoded by OR-ing four lookups. Invalid characters
+ *  set a bit above the 24 data bits, which survives the OR.
+ */
+struct Tables {
+    char pairs_[4096][2];
+    std::uint32_t decode_[4][256];
+
+    Tables()
+    {
+        for (std::size_t i = 0; i < 4096; ++i) {
+            pairs_[i][0] = alphabet_[i >> 6];
+            pairs_[i][1] = alphabet_[i & 0x3f];
+        }
+
+        for (auto& position : decode_) {
+            std::fill(
+                std::begin(position), std::end(position), OT_ARMOR_INVALID);
+        }
+
+        for (std::uint32_t i = 0; i < 64; ++i) {
+            const auto c = static_cast<unsigned char>(alphabet_[i]);
+            decode_[0][c] = i << 18;
+            decode_[1][c] = i << 12;
+            decode_[2][c] = i << 6;
+            decode_[3][c] = i;
+        }
+    }
+};
+
+const Tables& tables()
+{
+    static const Tables output;
+
+    return output;
+}
+
+class Encoder
+{
+public:
+    Encoder(char* output, const bool lineBreaks)
+        : tables_(tables())
+        , line_breaks_(lineBreaks)
+        , out_(output)
+        , column_(0)
+    {
+    }
+
+    char* End() const { return out_; }
+
+    /** Encodes the last of the input, including any padding */
+    void Finish(const std::uint8_t* input, const std::size_t size)
+    {
+        const auto remainder = size % 3;
+        Write(input, size - remainder);
+        input += size - remainder;
+
+        if (1 == remainder) {
+            const auto& pair = tables_.pairs_[input[0] << 4];
+            *out_++ = pair[0];
+            *out_++ = pair[1];
+            *out_++ = '=';
+            *out_++ = '=';
+            column_ += 4;
+        } else if (2 == remainder) {
+            const std::size_t bits = (input[0] << 10) | (input[1] << 2);
+            const auto& pair = tables_.pairs_[bits >> 6];
+            *out_++ = pair[0];
+            *out_++ = pair[1];
+            *out_++ = alphabet_[bits & 0x3f];
+            *out_++ = '=';
+            column_ += 4;
+        }
+
+        if (line_breaks_ && (0 != column_)) {
+            *out_++ = '\n';
+            column_ = 0;
+        }
+    }
+
+    /** Encodes a multiple of three bytes */
+    void Write(const std::uint8_t* input, std::size_t size)
+    {
+        if (false == line_breaks_) {
+            for (; size >= 6; size -= 6, input += 6) { six(input); }
+        } else {
+            for (; (0 == column_) && (size >= OT_ARMOR_LINE_BYTES);
+                 size -= OT_ARMOR_LINE_BYTES, input += OT_ARMOR_LINE_BYTES) {
+                line(input);
+            }
+        }
+
+        for (; size >= 3; size -= 3, input += 3) { three(input); }
+    }
+
+private:
+    const Tables& tables_;
+    const bool line_breaks_{true};
+    char* out_{nullptr};
+    std::size_t column_{0};
+
+    void line(const std::uint8_t* input)
+    {
+        for (std::size_t i = 0; i < OT_ARMOR_LINE_BYTES; i += 6) {
+            six(input + i);
+        }
+
+        *out_++ = '\n';
+    }
+
+    void six(const std::uint8_t* input)
+    {
+        const std::uint64_t bits =
+            (std::uint64_t(input[0]) << 40) | (std::uint64_t(input[1]) << 32) |
+            (std::uint64_t(input[2]) << 24) | (std::uint64_t(input[3]) << 16) |
+            (std::uint64_t(input[4]) << 8) | std::uint64_t(input[5]);
+        std::memcpy(out_, tables_.pairs_[(bits >> 36) & 0xfff], 2);
+        std::memcpy(out_ + 2, tables_.pairs_[(bits >> 24) & 0xfff], 2);
+        std::memcpy(out_ + 4, tables_.pairs_[(bits >> 12) & 0xfff], 2);
+        std::memcpy(out_ + 6, tables_.pairs_[bits & 0xfff], 2);
+        out_ += 8;
+    }
+
+    void three(const std::uint8_t* input)
+    {
+        const std::size_t bits = (input[0] << 16) | (input[1] << 8) | input[2];
+        std::memcpy(out_, tables_.pairs_[bits >> 12], 2);
+        std::memcpy(out_ + 2, tables_.pairs_[bits & 0xfff], 2);
+        out_ += 4;
+
+        if (line_breaks_ && (ArmorCodec::LineWidth == (column_ += 4))) {
+            *out_++ = '\n';
+            column_ = 0;
+        }
+    }
+
+    Encoder() = delete;
+    Encoder(const Encoder&) = delete;
+    Encoder& operator=(const Encoder&) = delete;
+};
+
+class Decoder
+{
+public:
+    Decoder(const char* input, const std::size_t size)
+        : tables_(tables())
+        , in_(reinterpret_cast<const unsigned char*>(input))
+        , end_(in_ + size)
+        , done_(0 == size)
+        , bits_(0)
+        , count_(0)
+    {
+    }
+
+    bool Done() const { return done_; }
+
+    /** Decodes until the input is exhausted or fewer than three bytes of
+     *  capacity remain, and returns the number of bytes written */
+    std::size_t Read(std::uint8_t* output, const std::size_t capacity)
+    {
+        const auto& decode = tables_.decode_;
+        auto* out = output;
+        const auto* limit = output + capacity;
+
+        while ((false == done_) && (3 <= (limit - out))) {
+            if ((0 == count_) && (4 <= (end_ - in_))) {
+                const auto bits = decode[0][in_[0]] | decode[1][in_[1]] |
+                                  decode[2][in_[2]] | decode[3][in_[3]];
+
+                if (bits < OT_ARMOR_INVALID) {
+                    out[0] = static_cast<std::uint8_t>(bits >> 16);
+                    out[1] = static_cast<std::uint8_t>(bits >> 8);
+                    out[2] = static_cast<std::uint8_t>(bits);
+                    out += 3;
+                    in_ += 4;
+
+                    continue;
+                }
+            }
+
+            if ((end_ == in_) || ('=' == *in_)) {
+                out += flush(out);
+                done_ = true;
+
+                break;
+            }
+
+            const auto value = decode[3][*in_++];
+
+            if (OT_ARMOR_INVALID <= value) { continue; }
+
+            bits_ = (bits_ << 6) | value;
+
+            if (4 == ++count_) {
+                out[0] = static_cast<std::uint8_t>(bits_ >> 16);
+                out[1] = static_cast<std::uint8_t>(bits_ >> 8);
+                out[2] = static_cast<std::uint8_t>(bits_);
+                out += 3;
+                bits_ = 0;
+                count_ = 0;
+            }
+        }
+
+        return out - output;
+    }
+
+private:
+    const Tables& tables_;
+    const unsigned char* in_{nullptr};
+    const unsigned char* const end_{nullptr};
+    bool done_{false};
+    std::uint32_t bits_{0};
+    std::size_t count_{0};
+
+    std::size_t flush(std::uint8_t* output)
+    {
+        std::size_t written{0};
+
+        if (2 == count_) {
+            output[0] = static_cast<std::uint8_t>(bits_ >> 4);
+            written = 1;
+        } else if (3 == count_) {
+            output[0] = static_cast<std::uint8_t>(bits_ >> 10);
+            output[1] = static_cast<std::uint8_t>(bits_ >> 2);
+            written = 2;
+        }
+
+        bits_ = 0;
+        count_ = 0;
+
+        return written;
+    }
+
+    Decoder() = delete;
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
+};
+}  // namespace
+
+const std::int32_t ArmorCodec::BestCompression;
+const std::int32_t ArmorCodec::FastCompression;
+const std::size_t ArmorCodec::LineWidth;
+
+std::size_t ArmorCodec::EncodedSize(
+    const std::size_t size,
+    const bool lineBreaks)
+{
+    const std::size_t characters = ((size + 2) / 3) * 4;
+
+    if (false == lineBreaks) { return characters; }
+
+    return characters + (characters / LineWidth) + 1;
+}
+
+void ArmorCodec::Base64Encode(
+    const void* input,
+    const std::size_t size,
+    const bool lineBreaks,
+    std::string& output)
+{
+    output.resize(EncodedSize(size, lineBreaks));
+    Encoder encoder(&output[0], lineBreaks);
+    encoder.Finish(static_cast<const std::uint8_t*>(input), size);
+    output.resize(encoder.End() - output.data());
+}
+
+bool ArmorCodec::Base64Decode(
+    const char* input,
+    const std::size_t size,
+    std::string& output)
+{
+    Decoder decoder(input, size);
+    std::size_t written{0};
+    output.resize(((size / 4) + 1) * 3);
+
+    while (false == decoder.Done()) {
+        if (3 > (output.size() - written)) { output.resize(written + 3); }
+
+        written += decoder.Read(
+            reinterpret_cast<std::uint8_t*>(&output[written]),
+            output.size() - written);
+    }
+
+    output.resize(written);
+
+    return 0 < written;
+}
+
+bool ArmorCodec::Encode(
+    const void* input,
+    const std::size_t size,
+    const std::int32_t level,
+    const bool lineBreaks,
+    std::string& output)
+{
+    output.clear();
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+
+    if (Z_OK != deflateInit(&zs, level)) { return false; }
+
+    output.resize(EncodedSize(deflateBound(&zs, size), lineBreaks));
+    Encoder encoder(&output[0], lineBreaks);
+    std::uint8_t block[OT_ARMOR_BLOCK_BYTES];
+    std::size_t carry{0};
+    zs.next_in = static_cast<Bytef*>(const_cast<void*>(input));
+    zs.avail_in = static_cast<uInt>(size);
+    int ret{Z_OK};
+
+    while (Z_OK == ret) {
+        zs.next_out = block + carry;
+        zs.avail_out = static_cast<uInt>(sizeof(block) - carry);
+        ret = deflate(&zs, Z_FINISH);
+        const std::size_t have = sizeof(block) - zs.avail_out;
+
+        if (Z_STREAM_END == ret) {
+            encoder.Finish(block, have);
+        } else if (Z_OK == ret) {
+            const auto whole = have - (have % OT_ARMOR_LINE_BYTES);
+            encoder.Write(block, whole);
+            carry = have - whole;
+            std::memmove(block, block + whole, carry);
+        }
+    }
+
+    deflateEnd(&zs);
+
+    if (Z_STREAM_END != ret) {
+        output.clear();
+
+        return false;
+    }
+
+    output.resize(encoder.End() - output.data());
+
+    return true;
+}
+
+bool ArmorCodec::Decode(
+    const char* input,
+    const std::size_t size,
+    std::string& output)
+{
+    output.clear();
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+
+    if (Z_OK != inflateInit(&zs)) { return false; }
+
+    Decoder decoder(input, size);
+    std::uint8_t block[OT_ARMOR_BLOCK_BYTES];
+    std::size_t written{0};
+    // Armored contracts typically inflate to about three times the size of
+    // their base64 form
+    output.resize(std::max<std::size_t>(size * 3, OT_ARMOR_MIN_OUTPUT));
+    int ret{Z_OK};
+
+    while (Z_OK == ret) {
+        if ((0 == zs.avail_in) && (false == decoder.Done())) {
+            zs.next_in = block;
+            zs.avail_in =
+                static_cast<uInt>(decoder.Read(block, sizeof(block)));
+        }
+
+        if (written == output.size()) { output.resize(2 * output.size()); }
+
+        zs.next_out = reinterpret_cast<Bytef*>(&output[written]);
+        zs.avail_out = static_cast<uInt>(output.size() - written);
+        ret = inflate(&zs, Z_NO_FLUSH);
+        written = reinterpret_cast<char*>(zs.next_out) - output.data();
+    }
+
+    inflateEnd(&zs);
+
+    if (Z_STREAM_END != ret) {
+        output.clear();
+
+        return false;
+    }
+
+    output.resize(written);
+
+    return true;
+}
+}  // namespace opentxs
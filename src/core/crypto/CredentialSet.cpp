@@ -77,6 +77,7 @@
 #include "opentxs/core/crypto/VerificationCredential.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
@@ -88,13 +89,16 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #define OT_METHOD "opentxs::CredentialSet::"
+#define OT_CREDENTIALS_PER_THREAD 2
 
 namespace opentxs
 {
@@ -155,16 +159,30 @@ bool CredentialSet::VerifyInternally() const
         return false;
     }
 
-    // Check each child credential for validity.
+    // Check each child credential for validity. Each one only locks itself
+    // and reads the (already verified) master credential, so their signatures
+    // are checked concurrently.
+    std::vector<const Credential*> children;
+
     for (const auto& it : m_mapCredentials) {
-        std::string str_sub_id = it.first;
-        auto& pSub = it.second;
+        OT_ASSERT(it.second);
 
-        OT_ASSERT(pSub);
+        children.push_back(it.second.get());
+    }
+
+    std::vector<std::uint8_t> valid(children.size(), 0);
+    ParallelFor(
+        children.size(),
+        OT_CREDENTIALS_PER_THREAD,
+        [&](const std::size_t i) -> void {
+            valid[i] = children[i]->Validate();
+        });
+    std::size_t i = 0;
 
-        if (!pSub->Validate()) {
+    for (const auto& it : m_mapCredentials) {
+        if (0 == valid[i++]) {
             otOut << __FUNCTION__
-                  << ": Child credential failed to verify: " << str_sub_id
+                  << ": Child credential failed to verify: " << it.first
                   << "\nNymID: " << GetNymID() << "\n";
 
             return false;
@@ -40,12 +40,49 @@
 
 #include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/crypto/AsymmetricKeyEC.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/crypto/OTSignature.hpp"
+#include "opentxs/core/crypto/VerificationCache.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define OT_VERIFICATION_CACHE_SIZE 4096
+#define OT_VERIFY_BATCH_PER_THREAD 32
 
 namespace opentxs
 {
+bool CryptoAsymmetric::CachedVerify(
+    const Data& plaintext,
+    const OTAsymmetricKey& theKey,
+    const Data& signature,
+    const proto::HashType hashType,
+    const OTPasswordData* pPWData) const
+{
+    auto& cache = SignatureCache();
+    std::string fingerprint{};
+    const bool cacheable = verification_fingerprint(
+        plaintext, theKey, signature, hashType, fingerprint);
+
+    if (cacheable && cache.Check(fingerprint)) { return true; }
+
+    const bool verified =
+        Verify(plaintext, theKey, signature, hashType, pPWData);
+
+    if (cacheable && verified) { cache.Add(fingerprint); }
+
+    return verified;
+}
+
 
 proto::AsymmetricKeyType CryptoAsymmetric::CurveToKeyType(
     const EcdsaCurve& curve)
@@ -124,7 +161,76 @@ bool CryptoAsymmetric::VerifyContractSignature(
     auto signature = Data::Factory();
     theSignature.GetData(signature);
 
-    return Verify(plaintext, theKey, signature, hashType, pPWData);
+    return CachedVerify(plaintext, theKey, signature, hashType, pPWData);
+}
+
+VerificationCache& CryptoAsymmetric::SignatureCache()
+{
+    static VerificationCache cache(OT_VERIFICATION_CACHE_SIZE);
+
+    return cache;
+}
+
+std::vector<bool> CryptoAsymmetric::VerifyBatch(const SignatureBatch& batch)
+{
+    // std::vector<bool> packs its elements, so the workers write to bytes.
+    std::vector<std::uint8_t> verified(batch.size(), 0);
+
+    ParallelFor(
+        batch.size(),
+        OT_VERIFY_BATCH_PER_THREAD,
+        [&](const std::size_t i) -> void {
+            const auto& item = batch[i];
+            verified[i] = item.key_.engine().CachedVerify(
+                item.plaintext_, item.key_, item.signature_, item.hashType_);
+        });
+
+    return std::vector<bool>(verified.begin(), verified.end());
+}
+
+// Only public EC keys are cached: their raw key bytes identify them exactly,
+// while reading the public half of a private key may require a passphrase.
+bool CryptoAsymmetric::verification_fingerprint(
+    const Data& plaintext,
+    const OTAsymmetricKey& theKey,
+    const Data& signature,
+    const proto::HashType hashType,
+    std::string& output)
+{
+    if (false == theKey.IsPublic()) { return false; }
+
+    const auto* key = dynamic_cast<const AsymmetricKeyEC*>(&theKey);
+
+    if (nullptr == key) { return false; }
+
+    auto pubkey = Data::Factory();
+
+    if (false == key->GetPublicKey(pubkey)) { return false; }
+
+    auto digest = Data::Factory();
+
+    if (false ==
+        OT::App().Crypto().Hash().Digest(hashType, plaintext, digest)) {
+        return false;
+    }
+
+    const auto append = [&output](const Data& data) -> void {
+        const std::uint32_t size = data.GetSize();
+        output.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        output.append(static_cast<const char*>(data.GetPointer()), size);
+    };
+
+    output.clear();
+    output.reserve(
+        2 + 3 * sizeof(std::uint32_t) + pubkey->GetSize() +
+        digest->GetSize() + signature.GetSize());
+    output.push_back(static_cast<char>(theKey.keyType()));
+    output.push_back(static_cast<char>(hashType));
+    append(pubkey);
+    append(digest);
+    append(signature);
+
+    return true;
 }
 
 }  // namespace opentxs
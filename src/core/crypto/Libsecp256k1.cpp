@@ -51,6 +51,7 @@
 #include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/crypto/OTPasswordData.hpp"
+#include "opentxs/core/crypto/SecureArena.hpp"
 #if OT_CRYPTO_USING_TREZOR
 #include "opentxs/core/crypto/TrezorCrypto.hpp"
 #endif
@@ -63,6 +64,8 @@
 #include <stdint.h>
 #include <ostream>
 
+#define OT_SECP256K1_PARSED_KEY_CACHE 1024
+
 namespace opentxs
 {
 bool Libsecp256k1::Initialized_ = false;
@@ -73,6 +76,8 @@ Libsecp256k1::Libsecp256k1(api::crypto::Util& ssl, Ecdsa& ecdsa)
           SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY))
     , ecdsa_(ecdsa)
     , ssl_(ssl)
+    , parsed_keys_lock_()
+    , parsed_keys_()
 {
     OT_ASSERT_MSG(nullptr != context_, "secp256k1_context_create failed.");
 }
@@ -84,12 +89,13 @@ bool Libsecp256k1::RandomKeypair(OTPassword& privateKey, Data& publicKey) const
     }
 
     bool validPrivkey = false;
-    std::uint8_t candidateKey[PrivateKeySize]{};
+    SecureBuffer candidateKey(PrivateKeySize);
     std::uint8_t nullKey[PrivateKeySize]{};
     std::uint8_t counter = 0;
 
     while (!validPrivkey) {
-        privateKey.randomizeMemory_uint8(candidateKey, sizeof(candidateKey));
+        privateKey.randomizeMemory_uint8(
+            candidateKey.data(), candidateKey.size());
         // We add the random key to a zero value key because
         // secp256k1_privkey_tweak_add checks the result to make sure it's in
         // the correct range for secp256k1.
@@ -97,12 +103,12 @@ bool Libsecp256k1::RandomKeypair(OTPassword& privateKey, Data& publicKey) const
         // This loop should almost always run exactly one time (about 1/(2^128)
         // chance of randomly generating an invalid key thus requiring a second
         // attempt)
-        validPrivkey =
-            secp256k1_ec_privkey_tweak_add(context_, candidateKey, nullKey);
+        validPrivkey = secp256k1_ec_privkey_tweak_add(
+            context_, candidateKey.data(), nullKey);
 
         OT_ASSERT(3 > ++counter);
     }
-    privateKey.setMemory(candidateKey, sizeof(candidateKey));
+    privateKey.setMemory(candidateKey.data(), candidateKey.size());
 
     return ScalarBaseMultiply(privateKey, publicKey);
 }
@@ -285,15 +291,36 @@ void Libsecp256k1::Init_Override() const
 bool Libsecp256k1::ParsePublicKey(const Data& input, secp256k1_pubkey& output)
     const
 {
-    if (nullptr == context_) {
+    if ((nullptr == context_) || input.empty()) {
         return false;
     }
 
-    return secp256k1_ec_pubkey_parse(
+    const std::string index(
+        static_cast<const char*>(input.GetPointer()), input.GetSize());
+    std::lock_guard<std::mutex> lock(parsed_keys_lock_);
+    const auto it = parsed_keys_.find(index);
+
+    if (parsed_keys_.end() != it) {
+        output = it->second;
+
+        return true;
+    }
+
+    const bool parsed = secp256k1_ec_pubkey_parse(
         context_,
         &output,
         reinterpret_cast<const unsigned char*>(input.GetPointer()),
         input.GetSize());
+
+    if (false == parsed) { return false; }
+
+    if (OT_SECP256K1_PARSED_KEY_CACHE <= parsed_keys_.size()) {
+        parsed_keys_.clear();
+    }
+
+    parsed_keys_.emplace(index, output);
+
+    return true;
 }
 
 bool Libsecp256k1::ScalarBaseMultiply(
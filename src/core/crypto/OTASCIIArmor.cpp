@@ -40,25 +40,19 @@
 
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 
-#include "opentxs/api/crypto/Crypto.hpp"
-#include "opentxs/api/crypto/Encode.hpp"
-#include "opentxs/api/Native.hpp"
+#include "opentxs/core/crypto/ArmorCodec.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/String.hpp"
-#include "opentxs/OT.hpp"
 
 #include <stdint.h>
 #include <sys/types.h>
-#include <zconf.h>
-#include <zlib.h>
 #include <cstring>
 #include <fstream>
 #include <sstream>
-#include <stdexcept>
 #include <string>
 
 namespace opentxs
@@ -192,94 +186,6 @@ OTASCIIArmor& OTASCIIArmor::operator=(const OTASCIIArmor& strValue)
     return *this;
 }
 
-// Source for these two functions: http://panthema.net/2007/0328-ZLibString.html
-
-/** Compress a STL string using zlib with given compression level and return
- * the binary data. */
-std::string OTASCIIArmor::compress_string(
-    const std::string& str,
-    int32_t compressionlevel = Z_BEST_COMPRESSION) const
-{
-    z_stream zs;  // z_stream is zlib's control structure
-    memset(&zs, 0, sizeof(zs));
-
-    if (deflateInit(&zs, compressionlevel) != Z_OK)
-        throw(std::runtime_error("deflateInit failed while compressing."));
-
-    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
-    zs.avail_in = static_cast<uInt>(str.size());  // set the z_stream's input
-
-    int32_t ret;
-    char outbuffer[32768];
-    std::string outstring;
-
-    // retrieve the compressed bytes blockwise
-    do {
-        zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-        zs.avail_out = sizeof(outbuffer);
-
-        ret = deflate(&zs, Z_FINISH);
-
-        if (outstring.size() < zs.total_out) {
-            // append the block to the output string
-            outstring.append(outbuffer, zs.total_out - outstring.size());
-        }
-    } while (ret == Z_OK);
-
-    deflateEnd(&zs);
-
-    if (ret != Z_STREAM_END) {  // an error occurred that was not EOF
-        std::ostringstream oss;
-        oss << "Exception during zlib compression: (" << ret << ") " << zs.msg;
-        throw(std::runtime_error(oss.str()));
-    }
-
-    return outstring;
-}
-
-/** Decompress an STL string using zlib and return the original data. */
-std::string OTASCIIArmor::decompress_string(const std::string& str) const
-{
-    z_stream zs;  // z_stream is zlib's control structure
-    memset(&zs, 0, sizeof(zs));
-
-    if (inflateInit(&zs) != Z_OK)
-        throw(std::runtime_error("inflateInit failed while decompressing."));
-
-    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
-    zs.avail_in = static_cast<uInt>(str.size());
-
-    int32_t ret;
-    char outbuffer[32768];
-    std::string outstring;
-
-    // get the decompressed bytes blockwise using repeated calls to inflate
-    do {
-        zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-        zs.avail_out = sizeof(outbuffer);
-
-        ret = inflate(&zs, 0);
-
-        if (outstring.size() < zs.total_out) {
-            outstring.append(outbuffer, zs.total_out - outstring.size());
-        }
-
-    } while (ret == Z_OK);
-
-    inflateEnd(&zs);
-
-    if (ret != Z_STREAM_END) {  // an error occurred that was not EOF
-        std::ostringstream oss;
-        oss << "Exception during zlib decompression: (" << ret << ")";
-        if (zs.msg != nullptr) {
-            oss << " " << zs.msg;
-        }
-        throw(std::runtime_error(oss.str()));
-    }
-
-    return outstring;
-}
-
 // Base64-decode
 bool OTASCIIArmor::GetData(
     Data& theData,
@@ -289,9 +195,8 @@ bool OTASCIIArmor::GetData(
 
     if (GetLength() < 1) return true;
 
-    auto decoded =
-        OT::App().Crypto().Encode().DataDecode(std::string(Get(), GetLength()));
-
+    std::string decoded;
+    ArmorCodec::Base64Decode(Get(), GetLength(), decoded);
     theData.Assign(decoded.c_str(), decoded.size());
 
     return (0 < decoded.size());
@@ -304,15 +209,17 @@ bool OTASCIIArmor::SetData(const Data& theData, bool bLineBreaks)
 
     if (theData.GetSize() < 1) return true;
 
-    auto string = OT::App().Crypto().Encode().DataEncode(theData);
+    std::string encoded;
+    ArmorCodec::Base64Encode(
+        theData.GetPointer(), theData.GetSize(), bLineBreaks, encoded);
 
-    if (string.empty()) {
+    if (encoded.empty()) {
         otErr << __FUNCTION__ << "Base64Encode failed" << std::endl;
 
         return false;
     }
 
-    Set(string.data(), string.size());
+    Set(encoded.data(), encoded.size());
 
     return true;
 }
@@ -326,55 +233,50 @@ bool OTASCIIArmor::GetString(String& strData, bool bLineBreaks) const
         return true;
     }
 
-    std::string str_decoded = OT::App().Crypto().Encode().DataDecode(Get());
-
-    if (str_decoded.empty()) {
-        otErr << __FUNCTION__ << "Base58CheckDecode failed." << std::endl;
-
-        return false;
-    }
+    std::string decoded;
 
-    std::string str_uncompressed;
-    try {
-        str_uncompressed = decompress_string(str_decoded);
-    } catch (const std::runtime_error&) {
-        otErr << __FUNCTION__ << ": decompress failed" << std::endl;
+    if (false == ArmorCodec::Decode(Get(), GetLength(), decoded)) {
+        otErr << "OTASCIIArmor::" << __FUNCTION__ << ": decode failed."
+              << std::endl;
 
         return false;
     }
 
-    strData.Set(str_uncompressed.c_str(), str_uncompressed.length());
+    strData.Set(decoded.c_str(), decoded.length());
 
     return true;
 }
 
 // Compress and Base64-encode
 bool OTASCIIArmor::SetString(const String& strData, bool bLineBreaks)  //=true
+{
+    return SetString(strData, bLineBreaks, ArmorCodec::BestCompression);
+}
+
+bool OTASCIIArmor::SetString(
+    const String& strData,
+    bool bLineBreaks,
+    std::int32_t compressionLevel)
 {
     Release();
 
     if (strData.GetLength() < 1) return true;
 
-    std::string str_compressed = compress_string(strData.Get());
+    std::string encoded;
 
-    // "Success"
-    if (str_compressed.size() == 0) {
+    if (false == ArmorCodec::Encode(
+                     strData.Get(),
+                     strData.GetLength(),
+                     compressionLevel,
+                     bLineBreaks,
+                     encoded)) {
         otErr << "OTASCIIArmor::" << __FUNCTION__ << ": compression failed."
               << std::endl;
 
         return false;
     }
 
-    auto pString = OT::App().Crypto().Encode().DataEncode(str_compressed);
-
-    if (pString.empty()) {
-        otErr << "OTASCIIArmor::" << __FUNCTION__ << ": Base64Encode failed."
-              << std::endl;
-
-        return false;
-    }
-
-    Set(pString.data(), pString.size());
+    Set(encoded.data(), encoded.size());
 
     return true;
 }
@@ -548,7 +450,7 @@ bool OTASCIIArmor::WriteArmoredString(
         OT_END_ARMORED,
         str_type.c_str());  // "%s%s %s-----\n"
 
-    strOutput.Concatenate("%s", strTemp.Get());
+    strOutput.Concatenate(strTemp);
 
     return true;
 }
@@ -482,7 +482,7 @@ bool OTAsymmetricKey::Verify(const Data& plaintext, const proto::Signature& sig)
     auto signature = Data::Factory();
     signature->Assign(sig.signature().c_str(), sig.signature().size());
 
-    return engine().Verify(
+    return engine().CachedVerify(
         plaintext, *this, signature, sig.hashtype(), nullptr);
 }
 
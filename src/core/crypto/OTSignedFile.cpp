@@ -95,7 +95,7 @@ void OTSignedFile::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 int32_t OTSignedFile::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
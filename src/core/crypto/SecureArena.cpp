@@ -0,0 +1,274 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/crypto/SecureArena.hpp"
+
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Log.hpp"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define OT_SECURE_ARENA_CHUNK_SIZE (64 * 1024)
+#define OT_SECURE_ARENA_SMALL_STEP 64
+#define OT_SECURE_ARENA_SMALL_MAX 512
+#define OT_SECURE_ARENA_SLOT_MAX 4096
+
+#define OT_METHOD "opentxs::SecureArena::"
+
+namespace opentxs
+{
+SecureArena::SecureArena()
+    : lock_()
+    , free_()
+    , large_()
+    , stats_()
+{
+}
+
+void* SecureArena::Allocate(const std::size_t size)
+{
+    OT_ASSERT(0 < size);
+
+    const auto slotSize = SlotSize(size);
+
+    if (0 == slotSize) {
+        bool locked{false};
+        auto* output = map(size, locked);
+
+        OT_ASSERT(nullptr != output);
+
+        std::lock_guard<std::mutex> lock(lock_);
+        large_.emplace(output, locked);
+        ++stats_.allocations_;
+        ++stats_.large_in_use_;
+
+        if (locked) {
+            stats_.locked_bytes_ += size;
+        } else {
+            stats_.unlocked_bytes_ += size;
+        }
+
+        return output;
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    auto& slots = free_[slotSize];
+
+    if (slots.empty()) { OT_ASSERT(add_chunk(slotSize)); }
+
+    auto* output = slots.back();
+    slots.pop_back();
+    ++stats_.allocations_;
+    ++stats_.slots_in_use_;
+    stats_.slot_bytes_in_use_ += slotSize;
+
+    return output;
+}
+
+bool SecureArena::add_chunk(const std::size_t slotSize)
+{
+    bool locked{false};
+    auto* chunk = map(OT_SECURE_ARENA_CHUNK_SIZE, locked);
+
+    if (nullptr == chunk) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to reserve memory."
+              << std::endl;
+
+        return false;
+    }
+
+    ++stats_.chunks_;
+
+    if (locked) {
+        stats_.locked_bytes_ += OT_SECURE_ARENA_CHUNK_SIZE;
+    } else {
+        stats_.unlocked_bytes_ += OT_SECURE_ARENA_CHUNK_SIZE;
+    }
+
+    auto& slots = free_[slotSize];
+    auto* start = static_cast<std::uint8_t*>(chunk);
+    const std::size_t count = OT_SECURE_ARENA_CHUNK_SIZE / slotSize;
+    slots.reserve(slots.size() + count);
+
+    // Hand out the lowest addresses first
+    for (std::size_t i = count; i > 0; --i) {
+        slots.push_back(start + ((i - 1) * slotSize));
+    }
+
+    return true;
+}
+
+void SecureArena::Free(void* memory, const std::size_t size)
+{
+    if (nullptr == memory) { return; }
+
+    const auto slotSize = SlotSize(size);
+
+    if (0 == slotSize) {
+        OTPassword::zeroMemory(memory, static_cast<std::uint32_t>(size));
+        bool locked{false};
+
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            auto it = large_.find(memory);
+
+            OT_ASSERT(large_.end() != it);
+
+            locked = it->second;
+            large_.erase(it);
+            ++stats_.frees_;
+            --stats_.large_in_use_;
+
+            if (locked) {
+                stats_.locked_bytes_ -= size;
+            } else {
+                stats_.unlocked_bytes_ -= size;
+            }
+        }
+
+        unmap(memory, size, locked);
+
+        return;
+    }
+
+    OTPassword::zeroMemory(memory, static_cast<std::uint32_t>(slotSize));
+    std::lock_guard<std::mutex> lock(lock_);
+    free_[slotSize].push_back(memory);
+    ++stats_.frees_;
+    --stats_.slots_in_use_;
+    stats_.slot_bytes_in_use_ -= slotSize;
+}
+
+SecureArena& SecureArena::Get()
+{
+    // Never destroyed, so that secrets owned by other static objects can
+    // still be freed during shutdown. Every free slot is already zeroed.
+    static auto* arena = new SecureArena();
+
+    return *arena;
+}
+
+void* SecureArena::map(const std::size_t size, bool& locked)
+{
+    locked = false;
+#ifdef _WIN32
+    void* output =
+        ::VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+    if (nullptr == output) { return nullptr; }
+
+    locked = (0 != ::VirtualLock(output, size));
+#else
+    void* output = ::mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+
+    if (MAP_FAILED == output) { return nullptr; }
+
+    locked = (0 == ::mlock(output, size));
+#ifdef MADV_DONTDUMP
+    ::madvise(output, size, MADV_DONTDUMP);
+#endif
+#endif
+
+    if (false == locked) {
+        static bool warned{false};
+
+        if (false == warned) {
+            warned = true;
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": WARNING: unable to lock memory. "
+                  << "(Passwords / secret keys may be swapped to disk!)"
+                  << std::endl;
+        }
+    }
+
+    return output;
+}
+
+std::size_t SecureArena::SlotSize(const std::size_t size)
+{
+    if (OT_SECURE_ARENA_SMALL_MAX >= size) {
+        const std::size_t steps = (size + OT_SECURE_ARENA_SMALL_STEP - 1) /
+                                  OT_SECURE_ARENA_SMALL_STEP;
+
+        return std::max<std::size_t>(1, steps) * OT_SECURE_ARENA_SMALL_STEP;
+    }
+
+    if (OT_SECURE_ARENA_SLOT_MAX < size) { return 0; }
+
+    std::size_t output{OT_SECURE_ARENA_SMALL_MAX};
+
+    while (output < size) { output <<= 1; }
+
+    return output;
+}
+
+SecureArena::Statistics SecureArena::Stats() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+
+    return stats_;
+}
+
+void SecureArena::unmap(void* memory, const std::size_t size, const bool locked)
+{
+#ifdef _WIN32
+    if (locked) { ::VirtualUnlock(memory, size); }
+
+    ::VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    if (locked) { ::munlock(memory, size); }
+
+    ::munmap(memory, size);
+#endif
+}
+}  // namespace opentxs
@@ -173,13 +173,12 @@ serializedAsymmetricKey TrezorCrypto::GetChild(
     return key;
 }
 
-std::unique_ptr<HDNode> TrezorCrypto::GetChild(
+SecurePointer<HDNode> TrezorCrypto::GetChild(
     const HDNode& parent,
     const uint32_t index,
     const DerivationMode privateVersion)
 {
-    std::unique_ptr<HDNode> output;
-    output.reset(new HDNode(parent));
+    auto output = MakeSecure<HDNode>(parent);
 
     if (!output) {
         OT_FAIL;
@@ -194,7 +193,7 @@ std::unique_ptr<HDNode> TrezorCrypto::GetChild(
     return output;
 }
 
-std::unique_ptr<HDNode> TrezorCrypto::DeriveChild(
+SecurePointer<HDNode> TrezorCrypto::DeriveChild(
     const EcdsaCurve& curve,
     const OTPassword& seed,
     proto::HDPath& path) const
@@ -208,7 +207,7 @@ std::unique_ptr<HDNode> TrezorCrypto::DeriveChild(
         proto::HDPath newpath = path;
         newpath.mutable_child()->RemoveLast();
         auto parentnode = DeriveChild(curve, seed, newpath);
-        std::unique_ptr<HDNode> output{nullptr};
+        SecurePointer<HDNode> output{nullptr};
 
         if (parentnode) {
             const auto child = path.child(depth - 1);
@@ -250,6 +249,82 @@ serializedAsymmetricKey TrezorCrypto::GetHDKey(
     return output;
 }
 
+bool TrezorCrypto::GetPublicNode(
+    const EcdsaCurve& curve,
+    const OTPassword& seed,
+    proto::HDPath& path,
+    Data& publicKey,
+    Data& chainCode) const
+{
+    auto node = DeriveChild(curve, seed, path);
+
+    if (!node) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to derive child."
+              << std::endl;
+
+        return false;
+    }
+
+    // Private derivation leaves the public key empty.
+    ::hdnode_fill_public_key(node.get());
+    publicKey.Assign(node->public_key, sizeof(node->public_key));
+    chainCode.Assign(node->chain_code, sizeof(node->chain_code));
+    OTPassword::zeroMemory(node->private_key, sizeof(node->private_key));
+
+    return true;
+}
+
+bool TrezorCrypto::PublicChild(
+    const EcdsaCurve& curve,
+    const Data& publicKey,
+    const Data& chainCode,
+    const std::uint32_t index,
+    Data& child) const
+{
+    HDNode node{};
+
+    if ((sizeof(node.public_key) != publicKey.GetSize()) ||
+        (sizeof(node.chain_code) != chainCode.GetSize())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid extended key."
+              << std::endl;
+
+        return false;
+    }
+
+    node.curve = get_curve_by_name(CurveName(curve).c_str());
+
+    if (nullptr == node.curve) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unsupported curve."
+              << std::endl;
+
+        return false;
+    }
+
+    OTPassword::safe_memcpy(
+        &(node.public_key[0]),
+        sizeof(node.public_key),
+        publicKey.GetPointer(),
+        publicKey.GetSize(),
+        false);
+    OTPassword::safe_memcpy(
+        &(node.chain_code[0]),
+        sizeof(node.chain_code),
+        chainCode.GetPointer(),
+        chainCode.GetSize(),
+        false);
+
+    if (1 != ::hdnode_public_ckd(&node, index)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to derive child."
+              << std::endl;
+
+        return false;
+    }
+
+    child.Assign(node.public_key, sizeof(node.public_key));
+
+    return true;
+}
+
 serializedAsymmetricKey TrezorCrypto::HDNodeToSerialized(
     const proto::AsymmetricKeyType& type,
     const HDNode& node,
@@ -280,7 +355,7 @@ serializedAsymmetricKey TrezorCrypto::HDNodeToSerialized(
     return key;
 }
 
-std::unique_ptr<HDNode> TrezorCrypto::InstantiateHDNode(const EcdsaCurve& curve)
+SecurePointer<HDNode> TrezorCrypto::InstantiateHDNode(const EcdsaCurve& curve)
 {
     auto entropy = OT::App().Crypto().AES().InstantiateBinarySecretSP();
 
@@ -301,12 +376,11 @@ std::unique_ptr<HDNode> TrezorCrypto::InstantiateHDNode(const EcdsaCurve& curve)
     return output;
 }
 
-std::unique_ptr<HDNode> TrezorCrypto::InstantiateHDNode(
+SecurePointer<HDNode> TrezorCrypto::InstantiateHDNode(
     const EcdsaCurve& curve,
     const OTPassword& seed)
 {
-    std::unique_ptr<HDNode> output;
-    output.reset(new HDNode);
+    auto output = MakeSecure<HDNode>();
 
     OT_ASSERT_MSG(output, "Instantiation of HD node failed.");
 
@@ -329,7 +403,7 @@ std::unique_ptr<HDNode> TrezorCrypto::InstantiateHDNode(
     return output;
 }
 
-std::unique_ptr<HDNode> TrezorCrypto::SerializedToHDNode(
+SecurePointer<HDNode> TrezorCrypto::SerializedToHDNode(
     const proto::AsymmetricKey& serialized) const
 {
     auto node =
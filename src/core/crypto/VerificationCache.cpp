@@ -0,0 +1,107 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/crypto/VerificationCache.hpp"
+
+namespace opentxs
+{
+VerificationCache::VerificationCache(const std::size_t capacity)
+    : capacity_(capacity)
+    , lock_()
+    , entries_()
+    , order_()
+{
+}
+
+void VerificationCache::Add(const std::string& fingerprint)
+{
+    if (0 == capacity_) { return; }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    const auto inserted = entries_.insert(fingerprint);
+
+    if (false == inserted.second) { return; }
+
+    // Element pointers stay valid across rehashing, so the eviction order can
+    // refer to the stored strings instead of keeping a second copy.
+    order_.push_back(&(*inserted.first));
+
+    while (order_.size() > capacity_) {
+        // Erase by iterator: erasing by key would pass a reference to the
+        // string being destroyed.
+        auto it = entries_.find(*order_.front());
+        order_.pop_front();
+
+        if (entries_.end() != it) { entries_.erase(it); }
+    }
+}
+
+bool VerificationCache::Check(const std::string& fingerprint) const
+{
+    bool found{false};
+
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        found = (0 < entries_.count(fingerprint));
+    }
+
+    if (found) {
+        ++hits_;
+    } else {
+        ++misses_;
+    }
+
+    return found;
+}
+
+void VerificationCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    order_.clear();
+    entries_.clear();
+}
+
+std::size_t VerificationCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+
+    return entries_.size();
+}
+}  // namespace opentxs
@@ -304,7 +304,7 @@ void OTPaymentPlan::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // *** Set Initial Payment ***  / Make sure to call SetAgreement() first.
@@ -1383,7 +1383,8 @@ bool OTPaymentPlan::ProcessCron()
     // Right now Cron is called 10 times per second.
     // I'm going to slow down all trades so they are once every
     // GetProcessInterval()
-    if (GetLastProcessDate() > OT_TIME_ZERO) {
+    if ((GetLastProcessDate() > OT_TIME_ZERO) &&
+        (false == IsFlaggedForRemoval())) {
         //      OTLog::vOutput(0, "DEBUG: time: %d  Last process date: %d   Time
         //      since last: %d    Interval: %d\n",
         //                 OTTimeGetCurrentTime(), GetLastProcessDate(),
@@ -216,6 +216,11 @@ OTScript::~OTScript()
     // parties.
     // See OTSmartContract, rather, for that.
 
+    unregister_variables();
+}
+
+void OTScript::unregister_variables()
+{
     while (!m_mapVariables.empty()) {
         OTVariable* pVar = m_mapVariables.begin()->second;
         OT_ASSERT(nullptr != pVar);
@@ -229,6 +234,16 @@ OTScript::~OTScript()
     }
 }
 
+void OTScript::Reset()
+{
+    unregister_variables();
+    m_mapParties.clear();
+    m_mapAccounts.clear();
+    m_str_script.clear();
+    m_str_display_filename.clear();
+    m_pContext = nullptr;
+}
+
 void OTScript::SetScript(const String& strValue)
 {
     if (strValue.Exists()) m_str_script = strValue.Get();
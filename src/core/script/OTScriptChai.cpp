@@ -57,11 +57,29 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <exception>
+#include <map>
+#include <set>
 #include <string>
+#include <unordered_map>
+
+#define OT_CHAI_MAX_PARSED_SCRIPTS 256
 
 namespace opentxs
 {
 
+struct OTScriptChai::Baseline {
+    chaiscript::ChaiScript::State state_;
+    std::map<std::string, chaiscript::Boxed_Value> locals_;
+    // Party and account names registered on top of state_, and the state
+    // Reset() returns to while those names stay the same.
+    std::set<std::string> names_;
+    chaiscript::ChaiScript::State named_state_;
+    // Syntax trees remember the stack positions of the locals they resolve,
+    // so they are keyed by the locals they were first run with as well as
+    // by their source text, and are only reused by this interpreter.
+    std::unordered_map<std::string, chaiscript::AST_NodePtr> parsed_;
+};
+
 bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
 {
     using namespace chaiscript;
@@ -89,62 +107,54 @@ bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
         //      chai_->add(m); // Here we add the OTParty class to the
         //      chaiscript engine.
 
+        std::set<std::string> names{};
+
         for (auto& it : m_mapParties) {
             OTParty* pParty = it.second;
             OT_ASSERT(nullptr != pParty);
 
-            std::string party_name = pParty->GetPartyName();
-
-            //          std::cerr << " TESTING PARTY: " << party_name <<
-            //            std::endl;
-            //            chai_->add(chaiscript::var(&d), "d");
-
-            // Currently I don't make the entire party available -- just his ID.
+            // Currently I don't make the entire party available -- just his
+            // name.
             //
-            // Update: The client side uses constant variables only (a block or
-            // two down
-            // from here) and it stores the user's ID, and acct IDs, directly in
-            // those
-            // variables based on name.  Whereas the server side passes in
-            // Parties and
-            // PartyAccounts, and only the names are made available inside the
-            // scripts.
-            // This way the scripts must entirely rely on the server-side API,
-            // functions
-            // such as move_funds(from_name, to_name), which expect a name, and
-            // translate
-            // only internally to resolve the ID.
-            // (Contrast this with client-side scripts, which actually have the
-            // real ID
-            // available inside the script, and which can call any OT API
-            // function that
+            // The client side uses constant variables only (a block or two
+            // down from here) and it stores the user's ID, and acct IDs,
+            // directly in those variables based on name.  Whereas the server
+            // side passes in Parties and PartyAccounts, and only the names are
+            // made available inside the scripts. This way the scripts must
+            // entirely rely on the server-side API, functions such as
+            // move_funds(from_name, to_name), which expect a name, and
+            // translate only internally to resolve the ID. (Contrast this with
+            // client-side scripts, which actually have the real ID available
+            // inside the script, and which can call any OT API function that
             // exists...)
             //
-            chai_->add_global_const(
-                const_var(party_name),
-                party_name.c_str());  // Why name and not
-                                      // ID? See comment
-                                      // just above.
+            names.emplace(pParty->GetPartyName());
         }
 
         for (auto& it : m_mapAccounts) {
             OTPartyAccount* pAcct = it.second;
             OT_ASSERT(nullptr != pAcct);
 
-            std::string acct_name = pAcct->GetName().Get();
+            // Accounts are made available by name as well.
+            names.emplace(pAcct->GetName().Get());
+        }
 
-            //          std::cerr << " TESTING ACCOUNT: " << acct_name <<
-            //            std::endl;
-            //            chai_->add(chaiscript::var(&d), "d");
+        // A pooled interpreter keeps the names from its previous execution,
+        // so they are only registered again when the parties have changed.
+        const bool changed =
+            (false == bool(baseline_)) || (names != baseline_->names_);
 
-            // Currently I don't make the entire account available -- just his
-            // ID.
-            //
-            chai_->add_global_const(
-                const_var(acct_name),
-                acct_name.c_str());  // See comment in
-                                     // above block for
-                                     // party name.
+        if (changed) {
+            if (baseline_) { chai_->set_state(baseline_->state_); }
+
+            for (const auto& name : names) {
+                chai_->add_global_const(const_var(name), name.c_str());
+            }
+
+            if (baseline_) {
+                baseline_->names_ = names;
+                baseline_->named_state_ = chai_->get_state();
+            }
         }
 
         /*
@@ -165,11 +175,19 @@ bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
          std::string& GetValueString() { return m_str_Value; }
          */
 
+        // Names of the locals, in the order they are added
+        std::string layout{};
+
         for (auto& it : m_mapVariables) {
             const std::string var_name = it.first;
             OTVariable* pVar = it.second;
             OT_ASSERT((nullptr != pVar) && (var_name.size() > 0));
 
+            if (OTVariable::Var_Constant != pVar->GetAccess()) {
+                layout += var_name;
+                layout += '\n';
+            }
+
             switch (pVar->GetType()) {
                 case OTVariable::Var_Integer: {
                     int32_t& nValue = pVar->GetValueInteger();
@@ -248,8 +266,65 @@ bool OTScriptChai::ExecuteScript(OTVariable* pReturnVar)
         //      chai_->add_global_const(const_var(m_mapParties),
         // "Parties");
 
+        // Parses the script the first time this interpreter runs it with
+        // these locals, then evaluates the saved syntax tree.
+        const auto evaluate = [&]() -> Boxed_Value {
+            auto& cache = baseline_->parsed_;
+            const auto key = layout + '\0' + m_str_script;
+            auto it = cache.find(key);
+
+            if (cache.end() == it) {
+                if (OT_CHAI_MAX_PARSED_SCRIPTS <= cache.size()) {
+                    cache.clear();
+                }
+
+                it = cache.emplace(key, chai_->parse(m_str_script)).first;
+            }
+
+            OT_ASSERT(it->second);
+
+            try {
+                return chai_->eval(*it->second);
+            } catch (const chaiscript::eval::detail::Return_Value& ret) {
+                // Evaluating source text handles a top level return itself;
+                // evaluating a syntax tree leaves it to the caller.
+                return ret.retval;
+            } catch (const Boxed_Value& error) {
+                // Evaluating a syntax tree throws its errors boxed. Unbox
+                // them for the handlers below.
+                throw chai_->boxed_cast<exception::eval_error>(error);
+            }
+        };
+
         try {
-            if (nullptr == pReturnVar)  // Nothing to return.
+            if (baseline_) {
+                const auto result = evaluate();
+
+                if (nullptr != pReturnVar) {
+                    switch (pReturnVar->GetType()) {
+                        case OTVariable::Var_Integer: {
+                            pReturnVar->SetValue(
+                                chai_->boxed_cast<int32_t>(result));
+                        } break;
+
+                        case OTVariable::Var_Bool: {
+                            pReturnVar->SetValue(
+                                chai_->boxed_cast<bool>(result));
+                        } break;
+
+                        case OTVariable::Var_String: {
+                            pReturnVar->SetValue(
+                                chai_->boxed_cast<std::string>(result));
+                        } break;
+
+                        default:
+                            otErr << "OTScriptChai::ExecuteScript: Unknown "
+                                     "return type passed in, unable to "
+                                     "service it.\n";
+                            return false;
+                    }
+                }
+            } else if (nullptr == pReturnVar)  // Nothing to return.
                 chai_->eval(
                     m_str_script.c_str(),
                     exception_specification<const std::exception&>(),
@@ -436,6 +511,29 @@ OTScriptChai::OTScriptChai(const std::string& new_string)
 
 #endif  // defined(OT_USE_CHAI_STDLIB)
 
+void OTScriptChai::Reset()
+{
+    OTScript::Reset();
+
+    if (baseline_) {
+        chai_->set_state(baseline_->named_state_);
+        chai_->set_locals(baseline_->locals_);
+    }
+}
+
+void OTScriptChai::SaveBaseline()
+{
+    OT_ASSERT(nullptr != chai_);
+
+    if (false == bool(baseline_)) { baseline_.reset(new Baseline); }
+
+    baseline_->state_ = chai_->get_state();
+    baseline_->locals_ = chai_->get_locals();
+    baseline_->names_.clear();
+    baseline_->named_state_ = baseline_->state_;
+    baseline_->parsed_.clear();
+}
+
 OTScriptChai::~OTScriptChai()
 {
     if (nullptr != chai_) delete chai_;
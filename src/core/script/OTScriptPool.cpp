@@ -0,0 +1,127 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/script/OTScriptPool.hpp"
+
+#include "opentxs/core/script/OTScript.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Log.hpp"
+
+#include <utility>
+
+#define OT_METHOD "opentxs::OTScriptPool::"
+
+namespace opentxs
+{
+OTScriptPool::OTScriptPool(
+    const std::string& language,
+    const Initializer& initializer,
+    const std::size_t maxIdle)
+    : language_(language)
+    , initializer_(initializer)
+    , max_idle_(maxIdle)
+    , created_(0)
+    , idle_(std::make_shared<Inventory>())
+{
+    OT_ASSERT(idle_);
+}
+
+std::shared_ptr<OTScript> OTScriptPool::create()
+{
+    auto output = OTScriptFactory(language_);
+
+    if (false == bool(output)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to create a "
+              << language_ << " interpreter." << std::endl;
+
+        return {};
+    }
+
+    if (initializer_) { initializer_(*output); }
+
+    output->SaveBaseline();
+    ++created_;
+
+    return output;
+}
+
+std::shared_ptr<OTScript> OTScriptPool::Get()
+{
+    std::shared_ptr<OTScript> script{};
+
+    {
+        Lock lock(idle_->lock_);
+
+        if (false == idle_->scripts_.empty()) {
+            script = std::move(idle_->scripts_.back());
+            idle_->scripts_.pop_back();
+        }
+    }
+
+    if (false == bool(script)) { script = create(); }
+
+    if (false == bool(script)) { return {}; }
+
+    std::weak_ptr<Inventory> inventory{idle_};
+    const auto maxIdle = max_idle_;
+    auto* pointer = script.get();
+
+    return std::shared_ptr<OTScript>(
+        pointer, [script, inventory, maxIdle](OTScript*) mutable {
+            script->Reset();
+            auto idle = inventory.lock();
+
+            if (false == bool(idle)) { return; }
+
+            Lock lock(idle->lock_);
+
+            if (maxIdle > idle->scripts_.size()) {
+                idle->scripts_.emplace_back(std::move(script));
+            }
+        });
+}
+
+std::size_t OTScriptPool::Idle() const
+{
+    Lock lock(idle_->lock_);
+
+    return idle_->scripts_.size();
+}
+}  // namespace opentxs
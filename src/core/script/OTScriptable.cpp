@@ -2407,7 +2407,7 @@ void OTScriptable::CalculateContractID(Identifier& newID) const
     std::string str_result;
     tag.output(str_result);
 
-    xmlUnsigned.Concatenate("%s", str_result.c_str());
+    xmlUnsigned.Concatenate(str_result);
 
     newID.CalculateDigest(xmlUnsigned);
 }
@@ -2496,7 +2496,7 @@ void OTScriptable::UpdateContents()  // Before transmission or serialization,
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // return -1 if error, 0 if nothing, and 1 if the node was processed.
@@ -523,6 +523,7 @@ various sequence numbers. Hm.
 #else
 #include "opentxs/core/script/OTScript.hpp"
 #endif
+#include "opentxs/core/script/OTScriptPool.hpp"
 #include "opentxs/core/script/OTScriptable.hpp"
 #include "opentxs/core/script/OTStash.hpp"
 #include "opentxs/core/script/OTStashItem.hpp"
@@ -552,7 +553,9 @@ various sequence numbers. Hm.
 #include <irrxml/irrXML.hpp>
 
 #include <ctime>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #ifndef SMART_CONTRACT_PROCESS_INTERVAL
 #define SMART_CONTRACT_PROCESS_INTERVAL                                        \
@@ -599,6 +602,12 @@ various sequence numbers. Hm.
 #define SMARTCONTRACT_HOOK_ON_ACTIVATE "cron_activate"
 #endif
 
+// Interpreters kept for reuse by ExecuteClauses, per script language.
+//
+#ifndef SMARTCONTRACT_IDLE_INTERPRETERS
+#define SMARTCONTRACT_IDLE_INTERPRETERS 16
+#endif
+
 namespace opentxs
 {
 
@@ -873,6 +882,118 @@ void OTSmartContract::RegisterOTNativeCallsWithScript(OTScript& theScript)
 
 }  // void function
 
+void OTSmartContract::RegisterPooledNativeCalls(OTScript& theScript)
+{
+#if OT_SCRIPT_CHAI
+    using namespace chaiscript;
+
+    OTScriptChai* pScript = dynamic_cast<OTScriptChai*>(&theScript);
+
+    if (nullptr != pScript) {
+        OT_ASSERT(nullptr != pScript->chai_)
+
+        auto& chai = *pScript->chai_;
+        OTScript* script = &theScript;
+        const auto contract = [script]() -> OTSmartContract& {
+            auto* output = dynamic_cast<OTSmartContract*>(script->GetContext());
+
+            OT_ASSERT(nullptr != output);
+
+            return *output;
+        };
+
+        // Same names and signatures as RegisterOTNativeCallsWithScript.
+        chai.add(fun(&OTScriptable::GetTime), "get_time");
+        chai.add(
+            fun([contract](std::string party, std::string clause) {
+                return contract().CanExecuteClause(party, clause);
+            }),
+            "party_may_execute_clause");
+        chai.add(
+            fun([contract](
+                    std::string from, std::string to, std::string amount) {
+                return contract().MoveAcctFundsStr(from, to, amount);
+            }),
+            "move_funds");
+        chai.add(
+            fun([contract](
+                    std::string from, std::string to, std::string amount) {
+                return contract().StashAcctFunds(from, to, amount);
+            }),
+            "stash_funds");
+        chai.add(
+            fun([contract](
+                    std::string to, std::string from, std::string amount) {
+                return contract().UnstashAcctFunds(to, from, amount);
+            }),
+            "unstash_funds");
+        chai.add(
+            fun([contract](std::string acct) {
+                return contract().GetAcctBalance(acct);
+            }),
+            "get_acct_balance");
+        chai.add(
+            fun([contract](std::string acct) {
+                return contract().GetInstrumentDefinitionIDofAcct(acct);
+            }),
+            "get_acct_instrument_definition_id");
+        chai.add(
+            fun([contract](std::string stash, std::string unit) {
+                return contract().GetStashBalance(stash, unit);
+            }),
+            "get_stash_balance");
+        chai.add(
+            fun([contract](std::string party) {
+                return contract().SendNoticeToParty(party);
+            }),
+            "send_notice");
+        chai.add(
+            fun([contract]() { return contract().SendANoticeToAllParties(); }),
+            "send_notice_to_parties");
+        chai.add(
+            fun([contract](std::string seconds) {
+                contract().SetRemainingTimer(seconds);
+            }),
+            "set_seconds_until_timer");
+        chai.add(
+            fun([contract]() { return contract().GetRemainingTimer(); }),
+            "get_remaining_timer");
+        chai.add(
+            fun([contract]() { contract().DeactivateSmartContract(); }),
+            "deactivate_contract");
+        chai.add(
+            fun([contract](std::string party) {
+                return contract().CanCancelContract(party);
+            }),
+            "party_may_cancel_contract");
+    } else
+#endif  // OT_SCRIPT_CHAI
+    {
+        otErr << "OTSmartContract::RegisterPooledNativeCalls: Failed "
+                 "dynamic casting OTScript to OTScriptChai \n";
+    }
+}
+
+OTScriptPool& OTSmartContract::clause_pool(const std::string& language)
+{
+    static std::mutex lock;
+    static std::map<std::string, std::unique_ptr<OTScriptPool>> pools;
+
+    Lock poolLock(lock);
+    auto& pool = pools[language];
+
+    if (false == bool(pool)) {
+        pool.reset(new OTScriptPool(
+            language,
+            &OTSmartContract::RegisterPooledNativeCalls,
+            SMARTCONTRACT_IDLE_INTERPRETERS));
+    }
+
+    OT_ASSERT(pool);
+
+    return *pool;
+}
+
 void OTSmartContract::DeactivateSmartContract()  // Called from within script.
 {
     // WARNING: If a party has the right to execute a clause that calls
@@ -3593,7 +3714,8 @@ bool OTSmartContract::ProcessCron()
     // ones who are paying for those
     // kinds of resources. (Different lists will cost different server fees.)
     //
-    if (GetLastProcessDate() > OT_TIME_ZERO) {
+    if ((GetLastProcessDate() > OT_TIME_ZERO) &&
+        (false == IsFlaggedForRemoval())) {
         // Default ProcessInternal is 1 second, but Trades will use 10 seconds,
         // and Payment
         // Plans will use an hour or day. Smart contracts are currently 30
@@ -3719,8 +3841,9 @@ void OTSmartContract::ExecuteClauses(
         const std::string str_language =
             pBylaw->GetLanguage();  // language it's in. (Default is "chai")
 
-        std::shared_ptr<OTScript> pScript =
-            OTScriptFactory(str_language, str_code);
+        // Borrowed interpreters already have the native calls registered,
+        // and are reset when pScript goes out of scope.
+        std::shared_ptr<OTScript> pScript = clause_pool(str_language).Get();
 
         std::unique_ptr<OTVariable> theVarAngel;
 
@@ -3729,10 +3852,11 @@ void OTSmartContract::ExecuteClauses(
         // VARIABLES, AND EXECUTE THE SCRIPT.
         //
         if (pScript) {
-            // Register the special server-side native OT calls we make
-            // available to all scripts.
+            pScript->SetScript(str_code);
+            // The server-side native OT calls we make available to all
+            // scripts find this contract through the script's context.
             //
-            RegisterOTNativeCallsWithScript(*pScript);
+            pScript->SetContext(this);
 
             // Register all the parties with the script.
             //
@@ -5443,7 +5567,7 @@ void OTSmartContract::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // Used internally here.
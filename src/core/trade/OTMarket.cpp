@@ -40,9 +40,14 @@
 
 #include "opentxs/core/trade/OTMarket.hpp"
 
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Encode.hpp"
+#include "opentxs/api/Native.hpp"
 #include "opentxs/core/cron/OTCron.hpp"
 #include "opentxs/core/cron/OTCronItem.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/trade/OTOffer.hpp"
 #include "opentxs/core/trade/OTTrade.hpp"
 #include "opentxs/core/util/Assert.hpp"
@@ -62,15 +67,18 @@
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
 
 #include <inttypes.h>
 #include <irrxml/irrXML.hpp>
 #include <string.h>
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -99,6 +107,7 @@ int32_t OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         m_lLastSalePrice =
             String::StringToLong(xml->getAttributeValue("lastSalePrice"));
         m_strLastSaleDate = xml->getAttributeValue("lastSaleDate");
+        m_strJournalHash = String(xml->getAttributeValue("journalHash")).Get();
 
         const String strNotaryID(xml->getAttributeValue("notaryID")),
             strInstrumentDefinitionID(
@@ -180,10 +189,10 @@ void OTMarket::UpdateContents()
     tag.add_attribute("marketScale", formatLong(m_lScale));
     tag.add_attribute("lastSaleDate", m_strLastSaleDate);
     tag.add_attribute("lastSalePrice", formatLong(m_lLastSalePrice));
+    tag.add_attribute("journalHash", m_strJournalHash);
 
     // Save the offers for sale.
-    for (auto& it : m_mapAsks) {
-        OTOffer* pOffer = it.second;
+    for (auto* pOffer : m_bookAsks) {
         OT_ASSERT(nullptr != pOffer);
 
         String strOffer(
@@ -197,8 +206,7 @@ void OTMarket::UpdateContents()
     }
 
     // Save the bids.
-    for (auto& it : m_mapBids) {
-        OTOffer* pOffer = it.second;
+    for (auto* pOffer : m_bookBids) {
         OT_ASSERT(nullptr != pOffer);
 
         String strOffer(
@@ -214,15 +222,14 @@ void OTMarket::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 int64_t OTMarket::GetTotalAvailableAssets()
 {
     int64_t lTotal = 0;
 
-    for (auto& it : m_mapAsks) {
-        OTOffer* pOffer = it.second;
+    for (auto* pOffer : m_bookAsks) {
         OT_ASSERT(nullptr != pOffer);
 
         lTotal += pOffer->GetAmountAvailable();
@@ -248,87 +255,100 @@ bool OTMarket::GetNym_OfferList(
         OTOffer* pOffer = it.second;
         OT_ASSERT(nullptr != pOffer);
 
-        OTTrade* pTrade = pOffer->GetTrade();
-
-        // We only return offers for a specific Nym ID, since this is private
-        // info only for that Nym.
-        //
-        if ((nullptr == pTrade) || (pTrade->GetSenderNymID() != NYM_ID))
-            continue;
-
-        // Below this point, I KNOW pTrade and pOffer are both good pointers.
-        // with no need to cleanup. I also know they are for the right Nym.
-
-        std::unique_ptr<OTDB::OfferDataNym> pOfferData(
-            dynamic_cast<OTDB::OfferDataNym*>(
-                OTDB::CreateObject(OTDB::STORED_OBJ_OFFER_DATA_NYM)));
+        if (GetNym_OfferData(NYM_ID, *pOffer, theOutputList)) {
+            nNymOfferCount++;
+        }
+    }
 
-        const int64_t& lTransactionNum = pOffer->GetTransactionNum();
-        const int64_t& lPriceLimit = pOffer->GetPriceLimit();
-        const int64_t& lTotalAssets = pOffer->GetTotalAssetsOnOffer();
-        const int64_t& lFinishedSoFar = pOffer->GetFinishedSoFar();
-        const int64_t& lMinimumIncrement = pOffer->GetMinimumIncrement();
-        const int64_t& lScale = pOffer->GetScale();
+    return true;
+}
 
-        const time64_t tValidFrom = pOffer->GetValidFrom();
-        const time64_t tValidTo = pOffer->GetValidTo();
+// Adds the offer to theOutputList if it belongs to NYM_ID.
+//
+bool OTMarket::GetNym_OfferData(
+    const Identifier& NYM_ID,
+    OTOffer& theOffer,
+    OTDB::OfferListNym& theOutputList)
+{
+    OTTrade* pTrade = theOffer.GetTrade();
 
-        const time64_t tDateAddedToMarket = pOffer->GetDateAddedToMarket();
+    // We only return offers for a specific Nym ID, since this is private
+    // info only for that Nym.
+    //
+    if ((nullptr == pTrade) || (pTrade->GetSenderNymID() != NYM_ID))
+        return false;
 
-        const Identifier& theNotaryID = pOffer->GetNotaryID();
-        const String strNotaryID(theNotaryID);
-        const Identifier& theInstrumentDefinitionID =
-            pOffer->GetInstrumentDefinitionID();
-        const String strInstrumentDefinitionID(theInstrumentDefinitionID);
-        const Identifier& theAssetAcctID = pTrade->GetSenderAcctID();
-        const String strAssetAcctID(theAssetAcctID);
-        const Identifier& theCurrencyID = pOffer->GetCurrencyID();
-        const String strCurrencyID(theCurrencyID);
-        const Identifier& theCurrencyAcctID = pTrade->GetCurrencyAcctID();
-        const String strCurrencyAcctID(theCurrencyAcctID);
-
-        const bool bSelling = pOffer->IsAsk();
-
-        if (pTrade->IsStopOrder()) {
-            if (pTrade->IsGreaterThan())
-                pOfferData->stop_sign = ">";
-            else if (pTrade->IsLessThan())
-                pOfferData->stop_sign = "<";
-
-            if (!pOfferData->stop_sign.compare(">") ||
-                !pOfferData->stop_sign.compare("<")) {
-                const int64_t& lStopPrice = pTrade->GetStopPrice();
-                pOfferData->stop_price = to_string<int64_t>(lStopPrice);
-            }
+    // Below this point, I KNOW pTrade and theOffer are both good pointers.
+    // with no need to cleanup. I also know they are for the right Nym.
+
+    std::unique_ptr<OTDB::OfferDataNym> pOfferData(
+        dynamic_cast<OTDB::OfferDataNym*>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_OFFER_DATA_NYM)));
+
+    const int64_t& lTransactionNum = theOffer.GetTransactionNum();
+    const int64_t& lPriceLimit = theOffer.GetPriceLimit();
+    const int64_t& lTotalAssets = theOffer.GetTotalAssetsOnOffer();
+    const int64_t& lFinishedSoFar = theOffer.GetFinishedSoFar();
+    const int64_t& lMinimumIncrement = theOffer.GetMinimumIncrement();
+    const int64_t& lScale = theOffer.GetScale();
+
+    const time64_t tValidFrom = theOffer.GetValidFrom();
+    const time64_t tValidTo = theOffer.GetValidTo();
+
+    const time64_t tDateAddedToMarket = theOffer.GetDateAddedToMarket();
+
+    const Identifier& theNotaryID = theOffer.GetNotaryID();
+    const String strNotaryID(theNotaryID);
+    const Identifier& theInstrumentDefinitionID =
+        theOffer.GetInstrumentDefinitionID();
+    const String strInstrumentDefinitionID(theInstrumentDefinitionID);
+    const Identifier& theAssetAcctID = pTrade->GetSenderAcctID();
+    const String strAssetAcctID(theAssetAcctID);
+    const Identifier& theCurrencyID = theOffer.GetCurrencyID();
+    const String strCurrencyID(theCurrencyID);
+    const Identifier& theCurrencyAcctID = pTrade->GetCurrencyAcctID();
+    const String strCurrencyAcctID(theCurrencyAcctID);
+
+    const bool bSelling = theOffer.IsAsk();
+
+    if (pTrade->IsStopOrder()) {
+        if (pTrade->IsGreaterThan())
+            pOfferData->stop_sign = ">";
+        else if (pTrade->IsLessThan())
+            pOfferData->stop_sign = "<";
+
+        if (!pOfferData->stop_sign.compare(">") ||
+            !pOfferData->stop_sign.compare("<")) {
+            const int64_t& lStopPrice = pTrade->GetStopPrice();
+            pOfferData->stop_price = to_string<int64_t>(lStopPrice);
         }
+    }
 
-        pOfferData->transaction_id = to_string<int64_t>(lTransactionNum);
-        pOfferData->price_per_scale = to_string<int64_t>(lPriceLimit);
-        pOfferData->total_assets = to_string<int64_t>(lTotalAssets);
-        pOfferData->finished_so_far = to_string<int64_t>(lFinishedSoFar);
-        pOfferData->minimum_increment = to_string<int64_t>(lMinimumIncrement);
-        pOfferData->scale = to_string<int64_t>(lScale);
+    pOfferData->transaction_id = to_string<int64_t>(lTransactionNum);
+    pOfferData->price_per_scale = to_string<int64_t>(lPriceLimit);
+    pOfferData->total_assets = to_string<int64_t>(lTotalAssets);
+    pOfferData->finished_so_far = to_string<int64_t>(lFinishedSoFar);
+    pOfferData->minimum_increment = to_string<int64_t>(lMinimumIncrement);
+    pOfferData->scale = to_string<int64_t>(lScale);
 
-        pOfferData->valid_from = to_string<time64_t>(tValidFrom);
-        pOfferData->valid_to = to_string<time64_t>(tValidTo);
+    pOfferData->valid_from = to_string<time64_t>(tValidFrom);
+    pOfferData->valid_to = to_string<time64_t>(tValidTo);
 
-        pOfferData->date = to_string<time64_t>(tDateAddedToMarket);
+    pOfferData->date = to_string<time64_t>(tDateAddedToMarket);
 
-        pOfferData->notary_id = strNotaryID.Get();
-        pOfferData->instrument_definition_id = strInstrumentDefinitionID.Get();
-        pOfferData->asset_acct_id = strAssetAcctID.Get();
-        pOfferData->currency_type_id = strCurrencyID.Get();
-        pOfferData->currency_acct_id = strCurrencyAcctID.Get();
+    pOfferData->notary_id = strNotaryID.Get();
+    pOfferData->instrument_definition_id = strInstrumentDefinitionID.Get();
+    pOfferData->asset_acct_id = strAssetAcctID.Get();
+    pOfferData->currency_type_id = strCurrencyID.Get();
+    pOfferData->currency_acct_id = strCurrencyAcctID.Get();
 
-        pOfferData->selling = bSelling;
+    pOfferData->selling = bSelling;
 
-        // *pOfferData is CLONED at this time (I'm still responsible to delete.)
-        // That's also why I add it here, below: So the data is set right before
-        // the cloning occurs.
-        //
-        theOutputList.AddOfferDataNym(*pOfferData);
-        nNymOfferCount++;
-    }
+    // *pOfferData is CLONED at this time (I'm still responsible to delete.)
+    // That's also why I add it here, below: So the data is set right before
+    // the cloning occurs.
+    //
+    theOutputList.AddOfferDataNym(*pOfferData);
 
     return true;
 }
@@ -418,17 +438,14 @@ bool OTMarket::GetOfferList(
         dynamic_cast<OTDB::OfferListMarket*>(
             OTDB::CreateObject(OTDB::STORED_OBJ_OFFER_LIST_MARKET)));
 
-    //    mapOfOffers            m_mapBids;        // The buyers, ordered by
-    // price limit
-    //    mapOfOffers            m_mapAsks;        // The sellers, ordered by
-    // price limit
+    // Both books iterate best price first, and in the order received for
+    // each price.
 
     int32_t nTempDepth = 0;
 
-    for (auto& it : m_mapBids) {
+    for (auto* pOffer : m_bookBids) {
         if (nTempDepth++ > lDepth) break;
 
-        OTOffer* pOffer = it.second;
         OT_ASSERT(nullptr != pOffer);
 
         const int64_t& lPriceLimit = pOffer->GetPriceLimit();
@@ -461,10 +478,9 @@ bool OTMarket::GetOfferList(
 
     nTempDepth = 0;
 
-    for (auto& it : m_mapAsks) {
+    for (auto* pOffer : m_bookAsks) {
         if (nTempDepth++ > lDepth) break;
 
-        OTOffer* pOffer = it.second;
         OT_ASSERT(nullptr != pOffer);
 
         // OfferDataMarket
@@ -534,18 +550,6 @@ bool OTMarket::GetOfferList(
     return false;
 }
 
-// To insure that offers of a specific price are always inserted at the upper
-// bound,
-// use this:  my_mmap.insert(my_mmap.upper_bound(key), my_mmap::value_type(key,
-// val));
-// This way I can read them from the lower bound later, and always get them in
-// the
-// order received for that price.
-//
-// typedef std::multimap<int64_t, OTOffer *>    mapOfOffers;
-// mapOfOffers    m_mapBids; // The buyers, ordered
-// mapOfOffers    m_mapAsks; // The sellers, ordered
-
 OTOffer* OTMarket::GetOffer(const int64_t& lTransactionNum)
 {
     // See if there's something there with that transaction number.
@@ -572,10 +576,11 @@ OTOffer* OTMarket::GetOffer(const int64_t& lTransactionNum)
     return nullptr;
 }
 
-bool OTMarket::RemoveOffer(const int64_t& lTransactionNum)  // if false, offer
-                                                            // wasn't found.
+// Takes the offer off the market without deleting it. Returns nullptr if the
+// offer wasn't found.
+OTOffer* OTMarket::remove_offer(const int64_t& lTransactionNum)
 {
-    bool bReturnValue = false;
+    OTOffer* pOffer = nullptr;
 
     // See if there's something there with that transaction number.
     auto it = m_mapOffers.find(lTransactionNum);
@@ -585,11 +590,11 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum)  // if false, offer
         otErr << "Attempt to remove non-existent Offer from Market. "
                  "Transaction #: "
               << lTransactionNum << "\n";
-        return false;
+        return nullptr;
     }
     // Otherwise, if it WAS already there, remove it properly.
     else {
-        OTOffer* pOffer = it->second;
+        pOffer = it->second;
 
         OT_ASSERT(nullptr != pOffer);
 
@@ -598,44 +603,15 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum)  // if false, offer
         // But it's still on one of the other lists...
         m_mapOffers.erase(it);
 
-        // The code operates the same whether ask or bid. Just use a pointer.
-        mapOfOffers* pMap = (pOffer->IsBid() ? &m_mapBids : &m_mapAsks);
-
-        // Future solution here: instead of looping through all the offers and
-        // finding it,
-        // I could just have each Offer store a copy of the iterator that's
-        // returned when
-        // it's first inserted. Later I just erase that iterator from the right
-        // list to remove. Todo.
-        OTOffer* pSameOffer = nullptr;
-
-        for (mapOfOffers::iterator iii = pMap->begin(); iii != pMap->end();
-             ++iii) {
-            pSameOffer = iii->second;
-
-            OT_ASSERT_MSG(
-                nullptr != pSameOffer,
-                "nullptr offer pointer in OTMarket::RemoveOffer.\n");
-
-            // found it!
-            if (lTransactionNum == pSameOffer->GetTransactionNum()) {
-                pMap->erase(iii);
-                break;
-            }
+        if (nullptr != m_pCron) { m_pCron->OfferRemoved(lTransactionNum); }
 
-            // Later on, below this loop, this pointer will be nullptr or not,
-            // and
-            // I will know if it was removed.
-            pSameOffer = nullptr;
-        }
+        // The book keeps a handle to the offer, so no search is needed.
+        OTOffer* pSameOffer =
+            (pOffer->IsBid() ? m_bookBids : m_bookAsks).Remove(lTransactionNum);
 
         if (nullptr == pSameOffer) {
             otErr << "Removed Offer from offers list, but not found on bid/ask "
                      "list.\n";
-        } else  // This means it was found and removed from the second list as
-                // well.
-        {
-            bReturnValue = true;  // Success.
         }
 
         // pOffer was found on the Offers list.
@@ -645,16 +621,38 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum)  // if false, offer
         // Therefore I CANNOT delete them both.
         //
         OT_ASSERT(pOffer == pSameOffer);
-
-        delete pOffer;
-        pOffer = nullptr;
-        pSameOffer = nullptr;
     }
 
-    if (bReturnValue)
-        return SaveMarket();  // <====== SAVE since an offer was removed.
-    else
+    return pOffer;
+}
+
+bool OTMarket::RemoveOffer(const int64_t& lTransactionNum)  // if false, offer
+                                                            // wasn't found.
+{
+    OTOffer* pOffer = remove_offer(lTransactionNum);
+
+    if (nullptr == pOffer) { return false; }
+
+    delete pOffer;
+    pOffer = nullptr;
+
+    // <====== SAVE since an offer was removed.
+    return append_journal("remove " + formatLong(lTransactionNum));
+}
+
+bool OTMarket::SaveOffer(OTOffer& theOffer)
+{
+    const int64_t lTransactionNum = theOffer.GetTransactionNum();
+
+    if (&theOffer != GetOffer(lTransactionNum)) {
+        otErr << "OTMarket::" << __FUNCTION__ << ": Offer "
+              << lTransactionNum << " is not on this market.\n";
         return false;
+    }
+
+    return append_journal(
+        "update " + formatLong(lTransactionNum) + " " +
+        encode_offer(theOffer));
 }
 
 // This method demands an Offer reference in order to verify that it really
@@ -709,36 +707,31 @@ bool OTMarket::AddOffer(
         // So next, let's add it to the lists that are indexed by price:
 
         // Determine if it's a buy or sell, and add it to the right list.
+        // No bother checking if the offer is already on these lists, since
+        // the code above basically already verifies that for us. Each new
+        // offer is last in line at its price.
         if (theOffer.IsBid()) {
-            // No bother checking if the offer is already on this list,
-            // since the code above basically already verifies that for us.
-
-            m_mapBids.insert(
-                m_mapBids.lower_bound(
-                    lPriceLimit),  // highest bidders go first,
-                                   // so I am last in line at
-                                   // lower bound.
-                std::pair<int64_t, OTOffer*>(lPriceLimit, &theOffer));
+            m_bookBids.Add(lTransactionNum, lPriceLimit, theOffer);
             otLog4 << "Offer added as a bid to the market.\n";
         } else {
-            m_mapAsks.insert(
-                m_mapAsks.upper_bound(
-                    lPriceLimit),  // lowest price sells first,
-                                   // so I am last in line at
-                                   // upper bound.
-                std::pair<int64_t, OTOffer*>(lPriceLimit, &theOffer));
+            m_bookAsks.Add(lTransactionNum, lPriceLimit, theOffer);
             otLog4 << "Offer added as an ask to the market.\n";
         }
 
+        if (nullptr != m_pCron) { m_pCron->OfferAdded(lTransactionNum, *this); }
+
         if (bSaveFile) {
             // Set this to the current date/time, since the offer is
             // being added for the first time.
             //
             theOffer.SetDateAddedToMarket(OTTimeGetCurrentTime());
 
-            return SaveMarket();  // <====== SAVE since an offer was added to
-                                  // the
-                                  // Market.
+            // <====== SAVE since an offer was added to the Market.
+            return append_journal(
+                "add " + formatLong(lTransactionNum) + " " +
+                formatLong(OTTimeGetSecondsFromTime(
+                    theOffer.GetDateAddedToMarket())) +
+                " " + encode_offer(theOffer));
         } else {
             // Set this to the date passed in, since this offer was
             // added to the market in the past, and we are preserving that date.
@@ -786,6 +779,10 @@ bool OTMarket::LoadMarket()
             str_TRADES_FILE.Get()));  // markets/recent/<market_ID>.bin
     }
 
+    // Bring the market up to date with any changes recorded since it was
+    // signed.
+    if (bSuccess) bSuccess = replay_journal(str_MARKET_ID.Get());
+
     return bSuccess;
 }
 
@@ -836,9 +833,360 @@ bool OTMarket::SaveMarket()
                   << Log::PathSeparator() << szFilename << "\n";
     }
 
+    // The signed market includes everything in the journal, so start a new
+    // one. If this fails, the old records will not match the hash stored in
+    // the market and they will be ignored when it is loaded.
+    if (!OTDB::StorePlainString("", szFoldername, "journal", szFilename)) {
+        otErr << "Error clearing journal for Market:\n"
+              << szFoldername << Log::PathSeparator() << "journal"
+              << Log::PathSeparator() << szFilename << "\n";
+    }
+
+    m_nJournalRecords = 0;
+
+    return true;
+}
+
+std::string OTMarket::encode_offer(OTOffer& theOffer)
+{
+    const String strOffer(theOffer);
+
+    return single_line(OT::App().Crypto().Encode().DataEncode(
+        std::string(strOffer.Get())));
+}
+
+// Each journal record must fit on a single line.
+std::string OTMarket::single_line(std::string input)
+{
+    input.erase(
+        std::remove_if(
+            input.begin(),
+            input.end(),
+            [](const char c) { return ('\n' == c) || ('\r' == c); }),
+        input.end());
+
+    return input;
+}
+
+std::string OTMarket::journal_hash(
+    const std::string& strPrevious,
+    const std::string& strRecord)
+{
+    Identifier theHash;
+    theHash.CalculateDigest(String(strPrevious + strRecord));
+
+    return String(theHash).Get();
+}
+
+void OTMarket::add_trade_data(
+    const int64_t& lTransactionNum,
+    const time64_t& tDate,
+    const int64_t& lPrice,
+    const int64_t& lAmount)
+{
+    if (nullptr == m_pTradeList) {
+        m_pTradeList = dynamic_cast<OTDB::TradeListMarket*>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_TRADE_LIST_MARKET));
+    }
+
+    std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
+        dynamic_cast<OTDB::TradeDataMarket*>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
+
+    pTradeData->transaction_id = to_string<int64_t>(lTransactionNum);
+    pTradeData->date = to_string<time64_t>(tDate);
+    pTradeData->price = to_string<int64_t>(lPrice);
+    pTradeData->amount_sold = to_string<int64_t>(lAmount);
+
+    m_strLastSaleDate = pTradeData->date;
+
+    // *pTradeData is CLONED at this time (I'm still responsible to delete.)
+    // That's also why I add it here, after all the above: So the data is set
+    // right BEFORE the cloning occurs.
+    //
+    m_pTradeList->AddTradeDataMarket(*pTradeData);
+
+    // Here we erase the oldest elements so the list never exceeds 50 elements
+    // total.
+    //
+    while (m_pTradeList->GetTradeDataMarketCount() > MAX_MARKET_QUERY_DEPTH)
+        m_pTradeList->RemoveTradeDataMarket(0);
+}
+
+// Records are written as "<hash> <signature> <type> <fields...>" on a single
+// line, where the hash covers the hash of the previous record plus the record
+// itself, and the signature is the server nym's signature of the hash. Since
+// the chain starts from the hash in the signed market, a journal which was
+// not written by the server can not be replayed.
+bool OTMarket::append_journal(const std::string& strRecord)
+{
+    OT_ASSERT(nullptr != GetCron());
+
+    const int32_t nInterval = OTCron::GetMarketCheckpointInterval();
+
+    if (0 >= nInterval) { return SaveMarket(); }
+
+    Identifier MARKET_ID(*this);
+    String str_MARKET_ID(MARKET_ID);
+    const std::string strHash = journal_hash(m_strJournalHash, strRecord);
+    const std::string strSignature = sign_journal(strHash);
+
+    if (strSignature.empty()) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": Failed to sign journal record for market "
+              << str_MARKET_ID << ". Saving the full market instead.\n";
+
+        return SaveMarket();
+    }
+
+    if (!OTDB::AppendPlainString(
+            strHash + " " + strSignature + " " + strRecord + "\n",
+            OTFolders::Market().Get(),
+            "journal",
+            str_MARKET_ID.Get())) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": Failed to append to journal for market " << str_MARKET_ID
+              << ". Saving the full market instead.\n";
+
+        // A partially written record would corrupt the next one, so replace
+        // the journal entirely.
+        return SaveMarket();
+    }
+
+    m_strJournalHash = strHash;
+
+    if (++m_nJournalRecords >= nInterval) { return SaveMarket(); }
+
+    return true;
+}
+
+bool OTMarket::apply_journal(const std::string& strRecord)
+{
+    std::istringstream input(strRecord);
+    std::string strType;
+    input >> strType;
+
+    if ("add" == strType) {
+        int64_t lTransactionNum{0};
+        int64_t lDateAdded{0};
+        std::string strEncoded;
+        input >> lTransactionNum >> lDateAdded >> strEncoded;
+
+        if (input.fail()) { return false; }
+
+        OTOffer* pOffer = new OTOffer(
+            m_NOTARY_ID,
+            m_INSTRUMENT_DEFINITION_ID,
+            m_CURRENCY_TYPE_ID,
+            m_lScale);
+
+        OT_ASSERT(nullptr != pOffer);
+
+        const String strOffer(
+            OT::App().Crypto().Encode().DataDecode(strEncoded));
+
+        if (pOffer->LoadContractFromString(strOffer) &&
+            (lTransactionNum == pOffer->GetTransactionNum()) &&
+            AddOffer(
+                nullptr,
+                *pOffer,
+                false,
+                OTTimeGetTimeFromSeconds(lDateAdded))) {
+
+            return true;
+        }
+
+        delete pOffer;
+        pOffer = nullptr;
+
+        return false;
+    } else if ("update" == strType) {
+        int64_t lTransactionNum{0};
+        std::string strEncoded;
+        input >> lTransactionNum >> strEncoded;
+
+        if (input.fail()) { return false; }
+
+        return reload_offer(lTransactionNum, strEncoded);
+    } else if ("remove" == strType) {
+        int64_t lTransactionNum{0};
+        input >> lTransactionNum;
+
+        if (input.fail()) { return false; }
+
+        OTOffer* pOffer = remove_offer(lTransactionNum);
+
+        if (nullptr == pOffer) { return false; }
+
+        delete pOffer;
+        pOffer = nullptr;
+
+        return true;
+    } else if ("trade" == strType) {
+        int64_t lDate{0}, lPrice{0}, lAmount{0};
+        int64_t lTransactionNum{0}, lOtherTransactionNum{0};
+        std::string strEncoded, strOtherEncoded;
+        input >> lDate >> lPrice >> lAmount >> lTransactionNum >> strEncoded >>
+            lOtherTransactionNum >> strOtherEncoded;
+
+        if (input.fail()) { return false; }
+
+        if (!reload_offer(lTransactionNum, strEncoded) ||
+            !reload_offer(lOtherTransactionNum, strOtherEncoded)) {
+
+            return false;
+        }
+
+        m_lLastSalePrice = lPrice;
+        add_trade_data(
+            lTransactionNum, OTTimeGetTimeFromSeconds(lDate), lPrice, lAmount);
+
+        return true;
+    }
+
+    otErr << "OTMarket::" << __FUNCTION__ << ": Unknown journal record type "
+          << strType << ".\n";
+
+    return false;
+}
+
+// Replaces the contents of an offer without changing its place on the market.
+bool OTMarket::reload_offer(
+    const int64_t& lTransactionNum,
+    const std::string& strEncoded)
+{
+    OTOffer* pOffer = GetOffer(lTransactionNum);
+
+    if (nullptr == pOffer) { return false; }
+
+    const time64_t tDateAdded = pOffer->GetDateAddedToMarket();
+    const int64_t lPriceLimit = pOffer->GetPriceLimit();
+    const bool bSelling = pOffer->IsAsk();
+    const String strOffer(OT::App().Crypto().Encode().DataDecode(strEncoded));
+
+    if (!pOffer->LoadContractFromString(strOffer)) { return false; }
+
+    pOffer->SetDateAddedToMarket(tDateAdded);
+
+    // The books are keyed on these, so they must never change.
+    OT_ASSERT(lTransactionNum == pOffer->GetTransactionNum());
+    OT_ASSERT(lPriceLimit == pOffer->GetPriceLimit());
+    OT_ASSERT(bSelling == pOffer->IsAsk());
+
     return true;
 }
 
+bool OTMarket::replay_journal(const std::string& strMarketID)
+{
+    const char* szFoldername = OTFolders::Market().Get();
+
+    if (!OTDB::Exists(szFoldername, "journal", strMarketID)) { return true; }
+
+    const std::string strJournal =
+        OTDB::QueryPlainString(szFoldername, "journal", strMarketID);
+
+    if (strJournal.empty()) { return true; }
+
+    std::istringstream input(strJournal);
+    std::string strLine;
+    int32_t nApplied{0};
+    int32_t nSkipped{0};
+
+    while (std::getline(input, strLine)) {
+        const auto first = strLine.find(' ');
+        const auto second = (std::string::npos == first)
+                                ? std::string::npos
+                                : strLine.find(' ', first + 1);
+
+        if (std::string::npos == second) {
+            ++nSkipped;
+
+            continue;
+        }
+
+        const std::string strHash = strLine.substr(0, first);
+        const std::string strSignature =
+            strLine.substr(first + 1, second - first - 1);
+        const std::string strRecord = strLine.substr(second + 1);
+
+        // Records written before the last signed save, or a record that was
+        // only partly written, do not continue the chain.
+        if (strHash != journal_hash(m_strJournalHash, strRecord)) {
+            ++nSkipped;
+
+            continue;
+        }
+
+        if (!verify_journal(strHash, strSignature)) {
+            otErr << "OTMarket::" << __FUNCTION__
+                  << ": Journal record for market " << strMarketID
+                  << " is not signed by the server nym.\n";
+
+            return false;
+        }
+
+        if (!apply_journal(strRecord)) {
+            otErr << "OTMarket::" << __FUNCTION__
+                  << ": Failed to apply journal record for market "
+                  << strMarketID << ": " << strRecord.substr(0, 64) << "\n";
+
+            return false;
+        }
+
+        m_strJournalHash = strHash;
+        ++nApplied;
+    }
+
+    otWarn << "OTMarket::" << __FUNCTION__ << ": Market " << strMarketID
+           << ": applied " << nApplied << " journal records, skipped "
+           << nSkipped << ".\n";
+
+    if (0 == nApplied) { return true; }
+
+    // Start the next journal from a freshly signed market.
+    return SaveMarket();
+}
+
+// Returns an empty string on failure.
+std::string OTMarket::sign_journal(const std::string& strHash) const
+{
+    OT_ASSERT(nullptr != m_pCron);
+    OT_ASSERT(nullptr != m_pCron->GetServerNym());
+
+    const auto& key = m_pCron->GetServerNym()->GetPrivateSignKey();
+    const auto plaintext = Data::Factory(strHash.data(), strHash.size());
+    auto signature = Data::Factory();
+
+    if (!key.engine().Sign(
+            plaintext.get(), key, key.SigHashType(), signature)) {
+
+        return "";
+    }
+
+    return single_line(OT::App().Crypto().Encode().DataEncode(signature.get()));
+}
+
+bool OTMarket::verify_journal(
+    const std::string& strHash,
+    const std::string& strSignature) const
+{
+    OT_ASSERT(nullptr != m_pCron);
+    OT_ASSERT(nullptr != m_pCron->GetServerNym());
+
+    const auto& key = m_pCron->GetServerNym()->GetPublicSignKey();
+    const auto plaintext = Data::Factory(strHash.data(), strHash.size());
+    const std::string strDecoded =
+        OT::App().Crypto().Encode().DataDecode(strSignature);
+
+    if (strDecoded.empty()) { return false; }
+
+    const auto signature =
+        Data::Factory(strDecoded.data(), strDecoded.size());
+
+    return key.engine().Verify(
+        plaintext.get(), key, signature.get(), key.SigHashType());
+}
+
 // A Market's ID is based on the instrument definition, the currency type, and
 // the scale.
 //
@@ -862,49 +1210,16 @@ void OTMarket::GetIdentifier(Identifier& theIdentifier) const
 
 // returns 0 if there are no bids. Otherwise returns the value of the highest
 // bid on the market.
-int64_t OTMarket::GetHighestBidPrice()
-{
-    int64_t lPrice = 0;
-
-    mapOfOffers::reverse_iterator rr = m_mapBids.rbegin();
-
-    if (rr != m_mapBids.rend()) {
-        lPrice = rr->first;
-    }
-
-    return lPrice;
-}
+int64_t OTMarket::GetHighestBidPrice() { return m_bookBids.BestPrice(); }
 
 // returns 0 if there are no asks. Otherwise returns the value of the lowest ask
 // on the market.
-int64_t OTMarket::GetLowestAskPrice()
-{
-    int64_t lPrice = 0;
-
-    auto it = m_mapAsks.begin();
-
-    if (it != m_mapAsks.end()) {
-        lPrice = it->first;
-
-        // Market orders have a 0 price, so we need to skip any if they are
-        // here.
-        //
-        // Note that we don't have to do this with the highest bid price (above
-        // function) but in the case of asks, a "0 price" will undercut the
-        // other
-        // actual prices, so we need to skip any that have a 0 price.
-        //
-        while (0 == lPrice) {
-            ++it;
-
-            if (it == m_mapAsks.end()) break;
-
-            lPrice = it->first;
-        }
-    }
-
-    return lPrice;
-}
+//
+// Market orders have a 0 price, so we need to skip them if they are here.
+// Note that we don't have to do this with the highest bid price (above
+// function) but in the case of asks, a "0 price" will undercut the other
+// actual prices.
+int64_t OTMarket::GetLowestAskPrice() { return m_bookAsks.BestPrice(true); }
 
 // This utility function is used directly below (only).
 void OTMarket::cleanup_four_accounts(
@@ -1899,52 +2214,26 @@ void OTMarket::ProcessTrade(
 
                 // Here we save this trade in a list of the most recent 50
                 // trades.
-                {
-                    if (nullptr == m_pTradeList) {
-                        m_pTradeList = dynamic_cast<OTDB::TradeListMarket*>(
-                            OTDB::CreateObject(
-                                OTDB::STORED_OBJ_TRADE_LIST_MARKET));
-                    }
-
-                    std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
-                        dynamic_cast<OTDB::TradeDataMarket*>(OTDB::CreateObject(
-                            OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
-
-                    const int64_t& lTransactionNum =
-                        theOffer.GetTransactionNum();
-                    const time64_t theDate = OTTimeGetCurrentTime();
-                    const int64_t& lPriceLimit =
-                        theOtherOffer.GetPriceLimit();  // Priced per scale.
-                    const int64_t& lAmountSold = lOfferFinished;
-
-                    pTradeData->transaction_id =
-                        to_string<int64_t>(lTransactionNum);
-                    pTradeData->date = to_string<time64_t>(theDate);
-                    pTradeData->price = to_string<int64_t>(lPriceLimit);
-                    pTradeData->amount_sold = to_string<int64_t>(lAmountSold);
-
-                    m_strLastSaleDate = pTradeData->date;
-
-                    // *pTradeData is CLONED at this time (I'm still responsible
-                    // to delete.)
-                    // That's also why I add it here, after all the above: So
-                    // the data is set right BEFORE the cloning occurs.
-                    //
-                    m_pTradeList->AddTradeDataMarket(*pTradeData);
-
-                    // Here we erase the oldest elements so the list never
-                    // exceeds 50 elements total.
-                    //
-                    while (m_pTradeList->GetTradeDataMarketCount() >
-                           MAX_MARKET_QUERY_DEPTH)
-                        m_pTradeList->RemoveTradeDataMarket(0);
-                }
+                const time64_t theDate = OTTimeGetCurrentTime();
+                add_trade_data(
+                    theOffer.GetTransactionNum(),
+                    theDate,
+                    m_lLastSalePrice,
+                    lOfferFinished);
 
                 // Account balances have changed based on these trades that we
                 // just processed.
                 // Make sure to save the Market since it contains those offers
-                // that have just updated.
-                SaveMarket();
+                // that have just updated. Only the two offers and the sale are
+                // recorded.
+                append_journal(
+                    "trade " + formatLong(OTTimeGetSecondsFromTime(theDate)) +
+                    " " + formatLong(m_lLastSalePrice) + " " +
+                    formatLong(lOfferFinished) + " " +
+                    formatLong(theOffer.GetTransactionNum()) + " " +
+                    encode_offer(theOffer) + " " +
+                    formatLong(theOtherOffer.GetTransactionNum()) + " " +
+                    encode_offer(theOtherOffer));
 
                 // The Trade has changed, and it is stored as a CronItem. So I
                 // save Cron as well, for
@@ -2512,18 +2801,12 @@ bool OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer)
 
     if (theOffer.IsAsk())  // If I'm selling,
     {
-        // rbegin puts us on the upper bound of the highest bidder (any new
-        // bidders at the same price would
-        // be added at the lower bound, where they are last in line.) The upper
-        // bound, on the other hand, is
-        // first in line.  So we start there, and loop backwards until there are
-        // no other bids within my price range.
-        for (mapOfOffers::reverse_iterator rr = m_mapBids.rbegin();
-             rr != m_mapBids.rend();
-             ++rr) {
+        // The bid book starts at the highest bidder, and the first bidder at
+        // each price is first in line. So we start there, and loop until there
+        // are no other bids within my price range.
+        for (auto* pBid : m_bookBids) {
             // then I want to start at the highest bidder and loop DOWN until
             // hitting my price limit.
-            OTOffer* pBid = rr->second;
             OT_ASSERT(nullptr != pBid);
 
             // NOTE: Market orders only process once, and they are processed in
@@ -2622,10 +2905,9 @@ bool OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer)
         // first in line.  So we start there, and loop forwards until there are
         // no other asks within my price range.
         //
-        for (auto& it : m_mapAsks) {
+        for (auto* pAsk : m_bookAsks) {
             // then I want to start at the lowest seller and loop UP until
             // hitting my price limit.
-            OTOffer* pAsk = it.second;
             OT_ASSERT(nullptr != pAsk);
 
             // NOTE: Market orders only process once, and they are processed in
@@ -2862,6 +3144,9 @@ void OTMarket::Release_Market()
 
     m_NOTARY_ID.Release();
 
+    m_strJournalHash.clear();
+    m_nJournalRecords = 0;
+
     // Elements of this list are cleaned up automatically.
     if (nullptr != m_pTradeList) {
         delete m_pTradeList;
@@ -2869,18 +3154,17 @@ void OTMarket::Release_Market()
     }
 
     // If there were any dynamically allocated objects, clean them up here.
-    while (!m_mapBids.empty()) {
-        OTOffer* pOffer = m_mapBids.begin()->second;
-        m_mapBids.erase(m_mapBids.begin());
-        delete pOffer;
-        pOffer = nullptr;
-    }
-    while (!m_mapAsks.empty()) {
-        OTOffer* pOffer = m_mapAsks.begin()->second;
-        m_mapAsks.erase(m_mapAsks.begin());
-        delete pOffer;
-        pOffer = nullptr;
+    // The books and m_mapOffers hold the same pointers.
+    if (nullptr != m_pCron) {
+        for (const auto& it : m_mapOffers) { m_pCron->OfferRemoved(it.first); }
     }
+
+    for (auto* pOffer : m_bookBids) { delete pOffer; }
+    for (auto* pOffer : m_bookAsks) { delete pOffer; }
+
+    m_bookBids.clear();
+    m_bookAsks.clear();
+    m_mapOffers.clear();
 }
 
 void OTMarket::Release()
@@ -290,7 +290,7 @@ void OTTrade::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Concatenate(str_result);
 }
 
 // The trade stores a copy of the Offer in string form.
@@ -526,7 +526,7 @@ OTOffer* OTTrade::GetOffer(Identifier* offerMarketId, OTMarket** market)
             offer_->SignContract(*(GetCron()->GetServerNym()));
             offer_->SaveContract();
 
-            pMarket->SaveMarket();
+            pMarket->SaveOffer(*offer_);
 
             // Now when the market loads next time, it can verify this offer
             // using the server's signature,
@@ -592,7 +592,7 @@ OTOffer* OTTrade::GetOffer(Identifier* offerMarketId, OTMarket** market)
                 offer_->SignContract(*(GetCron()->GetServerNym()));
                 offer_->SaveContract();
 
-                pMarket->SaveMarket();
+                pMarket->SaveOffer(*offer_);
 
                 // Now when the market loads next time, it can verify this offer
                 // using the server's signature,
@@ -1019,7 +1019,10 @@ bool OTTrade::ProcessCron()
     // Right now Cron is called 10 times per second.
     // I'm going to slow down all trades so they are once every
     // GetProcessInterval()
-    if (GetLastProcessDate() > OT_TIME_ZERO) {
+    // Items flagged for removal are not throttled, so they leave Cron
+    // as soon as they are woken.
+    if ((GetLastProcessDate() > OT_TIME_ZERO) &&
+        (false == IsFlaggedForRemoval())) {
         // (Default ProcessInterval is 1 second, but Trades will use 10 seconds,
         // and Payment Plans will use an hour or day.)
         if (OTTimeGetTimeInterval(
@@ -0,0 +1,154 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/util/Executor.hpp"
+
+#include <algorithm>
+
+namespace opentxs
+{
+Executor::Executor(const std::size_t threads)
+    : threads_(
+          (0 == threads)
+              ? std::max(1u, std::thread::hardware_concurrency())
+              : threads)
+    , lock_()
+    , wake_()
+    , running_(true)
+    , ready_()
+    , timers_()
+    , workers_()
+{
+    for (std::size_t i = 0; i < threads_; ++i) {
+        workers_.emplace_back(&Executor::worker, this);
+    }
+}
+
+void Executor::Post(Task&& task) const
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+
+        if (false == running_) { return; }
+
+        ready_.emplace_back(std::move(task));
+    }
+
+    wake_.notify_one();
+}
+
+void Executor::PostAfter(const Clock::duration& delay, Task&& task) const
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+
+        if (false == running_) { return; }
+
+        timers_.emplace(Clock::now() + delay, std::move(task));
+    }
+
+    // The new deadline may be earlier than the one the workers sleep on
+    wake_.notify_all();
+}
+
+std::size_t Executor::Queued() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+
+    return ready_.size() + timers_.size();
+}
+
+void Executor::Stop() const
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+
+        if (false == running_) { return; }
+
+        running_ = false;
+        ready_.clear();
+        timers_.clear();
+    }
+
+    wake_.notify_all();
+
+    for (auto& thread : workers_) {
+        if (thread.joinable()) { thread.join(); }
+    }
+}
+
+void Executor::worker() const
+{
+    std::unique_lock<std::mutex> lock(lock_);
+
+    while (running_) {
+        const auto now = Clock::now();
+
+        while ((false == timers_.empty()) &&
+               (timers_.begin()->first <= now)) {
+            ready_.emplace_back(std::move(timers_.begin()->second));
+            timers_.erase(timers_.begin());
+        }
+
+        if (ready_.empty()) {
+            if (timers_.empty()) {
+                wake_.wait(lock);
+            } else {
+                wake_.wait_until(lock, timers_.begin()->first);
+            }
+
+            continue;
+        }
+
+        auto task = std::move(ready_.front());
+        ready_.pop_front();
+
+        // Another worker may have to take over the timers while this one runs
+        if ((false == ready_.empty()) || (false == timers_.empty())) {
+            wake_.notify_one();
+        }
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+Executor::~Executor() { Stop(); }
+}  // namespace opentxs
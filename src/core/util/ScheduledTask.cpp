@@ -0,0 +1,162 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/util/ScheduledTask.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace opentxs
+{
+struct ScheduledTask::State {
+    const Executor& executor_;
+    const Pass pass_;
+    std::mutex lock_;
+    std::condition_variable idle_;
+    std::atomic<std::uint64_t> passes_;
+    /** A pass has been posted but has not started */
+    bool queued_;
+    /** A pass is running */
+    bool active_;
+    /** Trigger() was called while a pass was running */
+    bool again_;
+    bool stopped_;
+    /** Only the timer carrying the current value may trigger a pass */
+    std::uint64_t timer_;
+
+    State(const Executor& executor, Pass&& pass)
+        : executor_(executor)
+        , pass_(std::move(pass))
+        , lock_()
+        , idle_()
+        , passes_(0)
+        , queued_(false)
+        , active_(false)
+        , again_(false)
+        , stopped_(false)
+        , timer_(0)
+    {
+    }
+};
+
+ScheduledTask::ScheduledTask(const Executor& executor, Pass&& pass)
+    : state_(std::make_shared<State>(executor, std::move(pass)))
+{
+    Trigger();
+}
+
+std::uint64_t ScheduledTask::Passes() const { return state_->passes_.load(); }
+
+void ScheduledTask::run(const std::shared_ptr<State>& state)
+{
+    {
+        std::lock_guard<std::mutex> lock(state->lock_);
+        state->queued_ = false;
+
+        if (state->stopped_) { return; }
+
+        state->active_ = true;
+    }
+
+    ++state->passes_;
+    const auto delay = state->pass_();
+    std::lock_guard<std::mutex> lock(state->lock_);
+    state->active_ = false;
+
+    if (state->stopped_) {
+        state->idle_.notify_all();
+
+        return;
+    }
+
+    if (state->again_) {
+        state->again_ = false;
+        trigger(state);
+
+        return;
+    }
+
+    if (Idle() == delay) { return; }
+
+    const auto timer = ++state->timer_;
+    // Pending timers must not keep a destroyed task alive
+    std::weak_ptr<State> weak(state);
+    state->executor_.PostAfter(delay, [weak, timer]() -> void {
+        auto state = weak.lock();
+
+        if (false == bool(state)) { return; }
+
+        std::lock_guard<std::mutex> lock(state->lock_);
+
+        if (timer == state->timer_) { trigger(state); }
+    });
+}
+
+void ScheduledTask::Trigger() const
+{
+    std::lock_guard<std::mutex> lock(state_->lock_);
+    trigger(state_);
+}
+
+// The caller must hold the state lock
+void ScheduledTask::trigger(const std::shared_ptr<State>& state)
+{
+    if (state->stopped_ || state->queued_) { return; }
+
+    if (state->active_) {
+        state->again_ = true;
+
+        return;
+    }
+
+    state->queued_ = true;
+    // Invalidates any pending timer
+    ++state->timer_;
+    auto task = state;
+    state->executor_.Post([task]() -> void { run(task); });
+}
+
+ScheduledTask::~ScheduledTask()
+{
+    std::unique_lock<std::mutex> lock(state_->lock_);
+    state_->stopped_ = true;
+    state_->idle_.wait(lock, [this]() -> bool { return !state_->active_; });
+}
+}  // namespace opentxs
@@ -45,6 +45,7 @@
 #include "opentxs/api/Native.hpp"
 #include "opentxs/api/Settings.hpp"
 #include "opentxs/core/contract/ServerContract.hpp"
+#include "opentxs/core/crypto/ArmorCodec.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
@@ -208,7 +209,8 @@ NetworkReplyRaw ServerConnection::Send(const std::string& input)
 
 NetworkReplyString ServerConnection::Send(const String& message)
 {
-    OTASCIIArmor envelope(message);
+    OTASCIIArmor envelope;
+    envelope.SetString(message, true, ArmorCodec::FastCompression);
     NetworkReplyString output{SendResult::ERROR, nullptr};
     auto& status = output.first;
     auto& reply = output.second;
@@ -224,10 +226,12 @@ NetworkReplyString ServerConnection::Send(const String& message)
     status = rawOutput.first;
 
     if (SendResult::VALID_REPLY == status) {
-        OTASCIIArmor armored;
-        armored.Set(rawOutput.second->c_str());
+        const auto& armored = *rawOutput.second;
+        std::string decoded;
 
-        if (false == armored.GetString(*reply)) {
+        if (ArmorCodec::Decode(armored.data(), armored.size(), decoded)) {
+            reply->Set(decoded.data(), decoded.size());
+        } else {
             otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
                   << "but unable to decode it into a String." << std::endl;
             reply.reset();
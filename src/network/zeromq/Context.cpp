@@ -44,8 +44,11 @@
 #include "opentxs/network/zeromq/PublishSocket.hpp"
 #include "opentxs/network/zeromq/ReplySocket.hpp"
 #include "opentxs/network/zeromq/RequestSocket.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
 #include "opentxs/network/zeromq/SubscribeSocket.hpp"
 
+#include "Reactor.hpp"
+
 #include <zmq.h>
 
 namespace opentxs::network::zeromq
@@ -60,9 +63,14 @@ namespace opentxs::network::zeromq::implementation
 {
 Context::Context()
     : context_(zmq_ctx_new())
+    , reactor_(nullptr)
 {
     OT_ASSERT(nullptr != context_);
     OT_ASSERT(1 == zmq_has("curve"));
+
+    reactor_.reset(new implementation::Reactor(context_));
+
+    OT_ASSERT(reactor_);
 }
 
 Context::operator void*() const { return context_; }
@@ -84,6 +92,18 @@ OTZMQRequestSocket Context::RequestSocket() const
     return RequestSocket::Factory(*this);
 }
 
+OTZMQRouterSocket Context::RouterSocket(const RouterCallback& callback) const
+{
+    return RouterSocket::Factory(*this, callback);
+}
+
+std::shared_ptr<Reactor> Context::reactor() const
+{
+    OT_ASSERT(reactor_);
+
+    return reactor_;
+}
+
 OTZMQSubscribeSocket Context::SubscribeSocket(
     const ListenCallback& callback) const
 {
@@ -92,6 +112,11 @@ OTZMQSubscribeSocket Context::SubscribeSocket(
 
 Context::~Context()
 {
+    // The reactor polls sockets in this context and must stop before
+    // shutdown. Sockets which outlive the context keep it allocated.
+    reactor_->Stop();
+    reactor_.reset();
+
     if (nullptr != context_) {
         zmq_ctx_shutdown(context_);
     }
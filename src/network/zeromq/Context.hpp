@@ -43,8 +43,12 @@
 
 #include "opentxs/network/zeromq/Context.hpp"
 
+#include <memory>
+
 namespace opentxs::network::zeromq::implementation
 {
+class Reactor;
+
 class Context : virtual public zeromq::Context
 {
 public:
@@ -53,15 +57,20 @@ public:
     OTZMQPublishSocket PublishSocket() const override;
     OTZMQReplySocket ReplySocket(const ReplyCallback& callback) const override;
     OTZMQRequestSocket RequestSocket() const override;
+    OTZMQRouterSocket RouterSocket(
+        const RouterCallback& callback) const override;
     OTZMQSubscribeSocket SubscribeSocket(
         const ListenCallback& callback) const override;
 
+    std::shared_ptr<implementation::Reactor> reactor() const;
+
     ~Context();
 
 private:
     friend network::zeromq::Context;
 
     void* context_{nullptr};
+    std::shared_ptr<implementation::Reactor> reactor_{nullptr};
 
     Context* clone() const override;
 
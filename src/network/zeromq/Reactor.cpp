@@ -0,0 +1,319 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "Reactor.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include "Receiver.hpp"
+
+#include <algorithm>
+
+#include <zmq.h>
+
+#define REACTOR_CONTROL_ENDPOINT "inproc://opentxs/reactor/control"
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::Reactor::"
+
+namespace opentxs::network::zeromq::implementation
+{
+Reactor::Reactor(void* context)
+    : running_(Flag::Factory(true))
+    , control_receiver_(zmq_socket(context, ZMQ_PAIR))
+    , control_sender_(zmq_socket(context, ZMQ_PAIR))
+    , control_lock_()
+    , instructions_()
+    , items_()
+    , receivers_()
+    , thread_(nullptr)
+{
+    OT_ASSERT(nullptr != control_receiver_);
+    OT_ASSERT(nullptr != control_sender_);
+
+    const int linger{0};
+    zmq_setsockopt(control_receiver_, ZMQ_LINGER, &linger, sizeof(linger));
+    zmq_setsockopt(control_sender_, ZMQ_LINGER, &linger, sizeof(linger));
+    auto status = zmq_bind(control_receiver_, REACTOR_CONTROL_ENDPOINT);
+
+    OT_ASSERT(0 == status);
+
+    status = zmq_connect(control_sender_, REACTOR_CONTROL_ENDPOINT);
+
+    OT_ASSERT(0 == status);
+
+    items_.push_back({control_receiver_, 0, ZMQ_POLLIN, 0});
+    receivers_.push_back(nullptr);
+    thread_.reset(new std::thread(&Reactor::thread, this));
+
+    OT_ASSERT(thread_)
+
+    thread_id_ = thread_->get_id();
+}
+
+void Reactor::add(Receiver* receiver)
+{
+    OT_ASSERT(nullptr != receiver);
+
+    const auto it = std::find(receivers_.begin(), receivers_.end(), receiver);
+
+    if (receivers_.end() != it) { return; }
+
+    items_.push_back({receiver->receiver_socket_, 0, ZMQ_POLLIN, 0});
+    receivers_.push_back(receiver);
+}
+
+void Reactor::Add(Receiver& receiver)
+{
+    send_instruction({Command::Add, &receiver, nullptr, {}});
+}
+
+void Reactor::compact()
+{
+    // Index 0 is the control socket and is never removed
+    std::size_t out{1};
+
+    for (std::size_t in{1}; in < receivers_.size(); ++in) {
+        if (nullptr == receivers_.at(in)) { continue; }
+
+        receivers_[out] = receivers_[in];
+        items_[out] = items_[in];
+        ++out;
+    }
+
+    receivers_.resize(out);
+    items_.resize(out);
+}
+
+void Reactor::Execute(Receiver& receiver, std::function<void()>&& task)
+{
+    send_instruction({Command::Execute, &receiver, nullptr, std::move(task)});
+}
+
+void Reactor::flush_control()
+{
+    while (true) {
+        zmq_msg_t message;
+        zmq_msg_init(&message);
+        const auto received =
+            zmq_msg_recv(&message, control_receiver_, ZMQ_DONTWAIT);
+        zmq_msg_close(&message);
+
+        if (-1 == received) { break; }
+    }
+}
+
+bool Reactor::is_registered(const Receiver* receiver) const
+{
+    return receivers_.end() !=
+           std::find(receivers_.begin() + 1, receivers_.end(), receiver);
+}
+
+void Reactor::process_instructions()
+{
+    std::vector<Instruction> instructions{};
+
+    {
+        Lock lock(control_lock_);
+        instructions.swap(instructions_);
+    }
+
+    for (auto& instruction : instructions) {
+        switch (instruction.command_) {
+            case Command::Add: {
+                add(instruction.receiver_);
+            } break;
+            case Command::Remove: {
+                remove(instruction.receiver_);
+            } break;
+            case Command::Execute: {
+                if (instruction.task_ &&
+                    is_registered(instruction.receiver_)) {
+                    instruction.task_();
+                }
+            } break;
+            default: {
+                OT_FAIL;
+            }
+        }
+
+        if (instruction.done_) { instruction.done_->set_value(); }
+    }
+
+    compact();
+}
+
+void Reactor::remove(Receiver* receiver)
+{
+    // The poll set is only compacted between dispatch rounds so that a
+    // callback may safely destroy a socket owned by this reactor
+    for (std::size_t i{1}; i < receivers_.size(); ++i) {
+        if (receiver == receivers_.at(i)) { receivers_[i] = nullptr; }
+    }
+}
+
+void Reactor::Remove(Receiver& receiver)
+{
+    if (std::this_thread::get_id() == thread_id_) {
+        remove(&receiver);
+
+        return;
+    }
+
+    auto done = std::make_shared<std::promise<void>>();
+    auto future = done->get_future();
+
+    if (send_instruction({Command::Remove, &receiver, done, {}})) {
+        future.get();
+    }
+}
+
+bool Reactor::send_instruction(Instruction&& instruction)
+{
+    Lock lock(control_lock_);
+
+    // Once the reactor thread has stopped nothing will process instructions
+    if (false == running_.get()) { return false; }
+
+    instructions_.emplace_back(std::move(instruction));
+    lock.unlock();
+    wake();
+
+    return true;
+}
+
+void Reactor::Stop()
+{
+    {
+        Lock lock(control_lock_);
+
+        if (false == running_.get()) { return; }
+
+        running_->Off();
+    }
+
+    wake();
+
+    // From a callback the thread exits once the callback returns
+    if (std::this_thread::get_id() == thread_id_) { return; }
+
+    if (thread_ && thread_->joinable()) { thread_->join(); }
+}
+
+void Reactor::thread()
+{
+    while (running_.get()) {
+        const auto events = zmq_poll(items_.data(), items_.size(), -1);
+
+        if (-1 == events) {
+            const auto error = zmq_errno();
+
+            if (ETERM == error) { break; }
+
+            if (EINTR != error) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Poll error: " << zmq_strerror(error) << std::endl;
+            }
+
+            continue;
+        }
+
+        if (0 != (items_.at(0).revents & ZMQ_POLLIN)) {
+            flush_control();
+            process_instructions();
+
+            // The poll set may have changed so the remaining revents values
+            // can not be trusted.
+            continue;
+        }
+
+        const auto count = receivers_.size();
+
+        for (std::size_t i{1}; i < count; ++i) {
+            if (0 == (items_.at(i).revents & ZMQ_POLLIN)) { continue; }
+
+            auto* receiver = receivers_.at(i);
+
+            if (nullptr != receiver) { receiver->receive(); }
+        }
+
+        compact();
+    }
+
+    // Release any thread waiting on a removal that will never be processed
+    Lock lock(control_lock_);
+
+    for (auto& instruction : instructions_) {
+        if (instruction.done_) { instruction.done_->set_value(); }
+    }
+
+    instructions_.clear();
+}
+
+void Reactor::wake()
+{
+    Lock lock(control_lock_);
+    const char byte{0};
+    const auto sent = zmq_send(control_sender_, &byte, sizeof(byte), 0);
+
+    if (-1 == sent) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to wake reactor: " << zmq_strerror(zmq_errno())
+              << std::endl;
+    }
+}
+
+Reactor::~Reactor()
+{
+    Stop();
+
+    if (thread_ && thread_->joinable()) {
+        // Only if Stop() was first called from a callback. The last socket
+        // must not be destroyed by one, since the thread can not join itself.
+        OT_ASSERT(std::this_thread::get_id() != thread_id_);
+
+        thread_->join();
+    }
+
+    thread_.reset();
+
+    zmq_close(control_sender_);
+    zmq_close(control_receiver_);
+}
+}  // namespace opentxs::network::zeromq::implementation
@@ -0,0 +1,139 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_REACTOR_IMPLEMENTATION_HPP
+#define OPENTXS_NETWORK_ZEROMQ_REACTOR_IMPLEMENTATION_HPP
+
+#include "opentxs/Internal.hpp"
+
+#include "opentxs/core/Flag.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct zmq_pollitem_t;
+
+namespace opentxs::network::zeromq::implementation
+{
+class Receiver;
+
+/** Multiplexes every receiving socket of a Context onto a single thread
+ *
+ *  The reactor thread blocks in zmq_poll until either a registered socket
+ *  becomes readable or a command arrives on the inproc control pipe, so
+ *  idle sockets cost nothing and incoming messages are dispatched as soon
+ *  as they arrive.
+ *
+ *  Sockets must be fully configured before they are added since ZeroMQ
+ *  sockets are not safe to poll while another thread modifies them.
+ */
+class Reactor
+{
+public:
+    void Add(Receiver& receiver);
+    /** Runs a task for the receiver on the reactor thread
+     *
+     *  Tasks are executed in the order they were submitted, and before any
+     *  subsequent Remove takes effect. A task is discarded if its receiver
+     *  is not registered by the time the task comes up, so that it can never
+     *  run after the receiver has been removed.
+     */
+    void Execute(Receiver& receiver, std::function<void()>&& task);
+    /** Blocks until the reactor thread has stopped polling the receiver */
+    void Remove(Receiver& receiver);
+    /** Stops the reactor thread
+     *
+     *  Called by the Context before it shuts down. Sockets may hold the
+     *  reactor past that point, but any further Add, Execute or Remove has
+     *  no effect.
+     */
+    void Stop();
+
+    Reactor(void* context);
+    ~Reactor();
+
+private:
+    enum class Command : std::uint8_t {
+        Add = 0,
+        Remove = 1,
+        Execute = 2,
+    };
+
+    struct Instruction {
+        Command command_{Command::Add};
+        Receiver* receiver_{nullptr};
+        std::shared_ptr<std::promise<void>> done_{nullptr};
+        std::function<void()> task_{};
+    };
+
+    OTFlag running_;
+    // Bound by the reactor thread
+    void* control_receiver_{nullptr};
+    // Used by other threads to wake the reactor. Protected by control_lock_
+    void* control_sender_{nullptr};
+    std::mutex control_lock_;
+    std::vector<Instruction> instructions_;
+    // Only accessed by the reactor thread
+    std::vector<zmq_pollitem_t> items_;
+    std::vector<Receiver*> receivers_;
+    std::unique_ptr<std::thread> thread_{nullptr};
+    std::thread::id thread_id_{};
+
+    void add(Receiver* receiver);
+    void compact();
+    void flush_control();
+    bool is_registered(const Receiver* receiver) const;
+    void process_instructions();
+    void remove(Receiver* receiver);
+    bool send_instruction(Instruction&& instruction);
+    void thread();
+    void wake();
+
+    Reactor() = delete;
+    Reactor(const Reactor&) = delete;
+    Reactor(Reactor&&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    Reactor& operator=(Reactor&&) = delete;
+};
+}  // namespace opentxs::network::zeromq::implementation
+#endif  // OPENTXS_NETWORK_ZEROMQ_REACTOR_IMPLEMENTATION_HPP
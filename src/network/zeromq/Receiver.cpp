@@ -43,41 +43,45 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 
+#include "Context.hpp"
+#include "Reactor.hpp"
+
 #include <zmq.h>
 
-#define CALLBACK_WAIT_MILLISECONDS 50
-#define MESSAGE_CHECK_MICROSECONDS 1000
+// Upper bound on messages drained per wakeup so that one busy socket can not
+// starve the other sockets sharing the reactor
+#define RECEIVER_MAX_BATCH 64
 
 #define OT_METHOD "opentxs::network::zeromq::implementation::Receiver::"
 
 namespace opentxs::network::zeromq::implementation
 {
-Receiver::Receiver(std::mutex& lock, void* socket)
+Receiver::Receiver(
+    std::mutex& lock,
+    void* socket,
+    const zeromq::Context& context)
     : receiver_lock_(lock)
     , receiver_socket_(socket)
-    , receiver_run_(Flag::Factory(true))
-    , receiver_thread_(nullptr)
+    , reactor_(dynamic_cast<const implementation::Context&>(context).reactor())
+    , receiver_registered_(false)
 {
-    receiver_thread_.reset(new std::thread(&Receiver::thread, this));
-
-    OT_ASSERT(receiver_thread_)
+    OT_ASSERT(reactor_);
 }
 
-void Receiver::thread()
+void Receiver::execute(std::function<void()>&& task) const
 {
-    while (receiver_run_.get()) {
-        if (have_callback()) {
-            break;
-        }
+    reactor_->Execute(const_cast<Receiver&>(*this), std::move(task));
+}
 
-        Log::Sleep(std::chrono::milliseconds(CALLBACK_WAIT_MILLISECONDS));
-    }
+void Receiver::receive()
+{
+    if (false == have_callback()) { return; }
 
-    while (receiver_run_.get()) {
+    for (std::size_t i{0}; i < RECEIVER_MAX_BATCH; ++i) {
         Lock lock(receiver_lock_);
         auto request = Message::Factory();
         Message& message = request;
-        auto status =
+        const auto status =
             (-1 != zmq_msg_recv(message, receiver_socket_, ZMQ_DONTWAIT));
 
         if (status) {
@@ -90,23 +94,29 @@ void Receiver::thread()
                       << ": Receive error: " << zmq_strerror(error)
                       << std::endl;
             }
-        }
 
-        lock.unlock();
-        Log::Sleep(std::chrono::microseconds(MESSAGE_CHECK_MICROSECONDS));
+            return;
+        }
     }
 }
 
-Receiver::~Receiver()
+void Receiver::start_receiver() const
 {
-    Lock lock(receiver_lock_);
-    receiver_run_->Off();
+    if (receiver_registered_.exchange(true)) { return; }
 
-    if (receiver_thread_ && receiver_thread_->joinable()) {
-        receiver_thread_->join();
-        receiver_thread_.reset();
-    }
+    reactor_->Add(const_cast<Receiver&>(*this));
+}
+
+void Receiver::stop_receiver() const
+{
+    if (false == receiver_registered_.exchange(false)) { return; }
 
+    reactor_->Remove(const_cast<Receiver&>(*this));
+}
+
+Receiver::~Receiver()
+{
+    stop_receiver();
     receiver_socket_ = nullptr;
 }
 }  // namespace opentxs::network::zeromq::implementation
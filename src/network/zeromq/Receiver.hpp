@@ -41,33 +41,57 @@
 
 #include "opentxs/Internal.hpp"
 
-#include "opentxs/core/Flag.hpp"
 #include "opentxs/Types.hpp"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <thread>
 
 namespace opentxs::network::zeromq::implementation
 {
+class Reactor;
+
 class Receiver
 {
 protected:
-    Receiver(std::mutex& lock, void* socket);
+    /** Queues a task to run on the thread which delivers incoming messages
+     *
+     *  The task is dropped if the receiver is not registered when the task
+     *  comes up, so it may capture this socket.
+     */
+    void execute(std::function<void()>&& task) const;
+    /** Registers the socket with the context's reactor
+     *
+     *  Call after the socket has been bound or connected. Repeated calls
+     *  have no effect.
+     */
+    void start_receiver() const;
+    /** Unregisters the socket from the reactor
+     *
+     *  Must be called by the destructor of the most derived class so that
+     *  process_incoming is never invoked on a partially destroyed object.
+     */
+    void stop_receiver() const;
+
+    Receiver(std::mutex& lock, void* socket, const zeromq::Context& context);
 
     virtual ~Receiver();
 
 private:
+    friend class Reactor;
+
     std::mutex& receiver_lock_;
     // Not owned by this class
     void* receiver_socket_{nullptr};
-    OTFlag receiver_run_;
-    std::unique_ptr<std::thread> receiver_thread_{nullptr};
+    // Shared with the context, so it stays valid if the socket outlives it
+    std::shared_ptr<Reactor> reactor_{nullptr};
+    mutable std::atomic<bool> receiver_registered_{false};
 
     virtual bool have_callback() const = 0;
 
     virtual void process_incoming(const Lock& lock, Message& message) = 0;
-    void thread();
+    void receive();
 
     Receiver() = delete;
     Receiver(const Receiver&) = delete;
@@ -65,7 +65,7 @@ ReplySocket::ReplySocket(
     const ReplyCallback& callback)
     : ot_super(context, SocketType::Reply)
     , CurveServer(lock_, socket_)
-    , Receiver(lock_, socket_)
+    , Receiver(lock_, socket_, context)
     , callback_(callback)
 {
 }
@@ -100,8 +100,18 @@ bool ReplySocket::Start(const std::string& endpoint) const
 {
     Lock lock(lock_);
 
-    return (0 == zmq_bind(socket_, endpoint.c_str()));
+    if (0 != zmq_bind(socket_, endpoint.c_str())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to bind to "
+              << endpoint << std::endl;
+
+        return false;
+    }
+
+    lock.unlock();
+    start_receiver();
+
+    return true;
 }
 
-ReplySocket::~ReplySocket() {}
+ReplySocket::~ReplySocket() { stop_receiver(); }
 }  // namespace opentxs::network::zeromq::implementation
@@ -0,0 +1,74 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "RouterCallback.hpp"
+
+//#define OT_METHOD "opentxs::network::zeromq::implementation::RouterCallback::"
+
+namespace opentxs::network::zeromq
+{
+OTZMQRouterCallback RouterCallback::Factory(
+    zeromq::RouterCallback::ReceiveCallback callback)
+{
+    return OTZMQRouterCallback(new implementation::RouterCallback(callback));
+}
+}  // namespace opentxs::network::zeromq
+
+namespace opentxs::network::zeromq::implementation
+{
+RouterCallback::RouterCallback(zeromq::RouterCallback::ReceiveCallback callback)
+    : callback_(callback)
+{
+}
+
+RouterCallback* RouterCallback::clone() const
+{
+    return new RouterCallback(callback_);
+}
+
+void RouterCallback::Process(
+    const Data& connection,
+    const zeromq::Message& message) const
+{
+    callback_(connection, message);
+}
+
+RouterCallback::~RouterCallback() {}
+}  // namespace opentxs::network::zeromq::implementation
@@ -0,0 +1,71 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_ROUTERCALLBACK_IMPLEMENTATION_HPP
+#define OPENTXS_NETWORK_ZEROMQ_ROUTERCALLBACK_IMPLEMENTATION_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/network/zeromq/RouterCallback.hpp"
+
+namespace opentxs::network::zeromq::implementation
+{
+class RouterCallback : virtual public zeromq::RouterCallback
+{
+public:
+    void Process(const Data& connection, const zeromq::Message& message)
+        const override;
+
+    ~RouterCallback();
+
+private:
+    friend zeromq::RouterCallback;
+
+    const zeromq::RouterCallback::ReceiveCallback callback_;
+
+    RouterCallback* clone() const override;
+
+    RouterCallback(zeromq::RouterCallback::ReceiveCallback callback);
+    RouterCallback() = delete;
+    RouterCallback(const RouterCallback&) = delete;
+    RouterCallback(RouterCallback&&) = delete;
+    RouterCallback& operator=(const RouterCallback&) = delete;
+    RouterCallback& operator=(RouterCallback&&) = delete;
+};
+}  // namespace opentxs::network::zeromq::implementation
+#endif  // OPENTXS_NETWORK_ZEROMQ_ROUTERCALLBACK_IMPLEMENTATION_HPP
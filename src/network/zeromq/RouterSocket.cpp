@@ -0,0 +1,163 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "RouterSocket.hpp"
+
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/RouterCallback.hpp"
+
+#include <zmq.h>
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::RouterSocket::"
+
+namespace opentxs::network::zeromq
+{
+OTZMQRouterSocket RouterSocket::Factory(
+    const Context& context,
+    const RouterCallback& callback)
+{
+    return OTZMQRouterSocket(
+        new implementation::RouterSocket(context, callback));
+}
+}  // namespace opentxs::network::zeromq
+
+namespace opentxs::network::zeromq::implementation
+{
+RouterSocket::RouterSocket(
+    const zeromq::Context& context,
+    const RouterCallback& callback)
+    : ot_super(context, SocketType::Router)
+    , CurveServer(lock_, socket_)
+    , Receiver(lock_, socket_, context)
+    , callback_(callback)
+    , frames_()
+{
+}
+
+RouterSocket* RouterSocket::clone() const
+{
+    return new RouterSocket(context_, callback_);
+}
+
+bool RouterSocket::have_callback() const { return true; }
+
+void RouterSocket::process_incoming(const Lock& lock, Message& message)
+{
+    OT_ASSERT(verify_lock(lock))
+
+    const bool more = (1 == zmq_msg_more(message));
+    frames_.emplace_back(zeromq::Message::Factory(std::string(message)));
+
+    if (more) { return; }
+
+    // Envelope from a REQ peer: identity, empty delimiter, body
+    if (3 > frames_.size()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Malformed envelope ("
+              << frames_.size() << " frames)" << std::endl;
+        frames_.clear();
+
+        return;
+    }
+
+    const auto& identity = frames_.front().get();
+    const auto connection = Data::Factory(identity.data(), identity.size());
+    auto body = std::move(frames_.back());
+    frames_.clear();
+    callback_.Process(connection.get(), body);
+}
+
+void RouterSocket::send(const OTData connection, const std::string& reply)
+    const
+{
+    Lock lock(lock_);
+    auto identity = zeromq::Message::Factory(connection.get());
+    auto delimiter = zeromq::Message::Factory();
+    auto body = zeromq::Message::Factory(reply);
+    zeromq::Message& first = identity;
+    zeromq::Message& second = delimiter;
+    zeromq::Message& third = body;
+    bool sent = (-1 != zmq_msg_send(first, socket_, ZMQ_SNDMORE));
+    sent &= (-1 != zmq_msg_send(second, socket_, ZMQ_SNDMORE));
+    sent &= (-1 != zmq_msg_send(third, socket_, 0));
+
+    if (false == sent) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Send error: "
+              << zmq_strerror(zmq_errno()) << std::endl;
+    }
+}
+
+bool RouterSocket::Send(const Data& connection, const std::string& reply) const
+{
+    const OTData id = Data::Factory(connection);
+    // ZeroMQ sockets are not thread safe, so the reply is handed off to the
+    // same thread which polls this socket. The destructor unregisters the
+    // socket before anything is destroyed, and that runs or discards every
+    // reply still queued.
+    execute([this, id, reply]() -> void { this->send(id, reply); });
+
+    return true;
+}
+
+bool RouterSocket::SetCurve(const OTPassword& key) const
+{
+    return set_curve(key);
+}
+
+bool RouterSocket::Start(const std::string& endpoint) const
+{
+    Lock lock(lock_);
+
+    if (0 != zmq_bind(socket_, endpoint.c_str())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to bind to "
+              << endpoint << std::endl;
+
+        return false;
+    }
+
+    lock.unlock();
+    start_receiver();
+
+    return true;
+}
+
+RouterSocket::~RouterSocket() { stop_receiver(); }
+}  // namespace opentxs::network::zeromq::implementation
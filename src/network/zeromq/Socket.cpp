@@ -61,6 +61,7 @@ const std::map<SocketType, int> Socket::types_{
     {SocketType::Reply, ZMQ_REP},
     {SocketType::Publish, ZMQ_PUB},
     {SocketType::Subscribe, ZMQ_SUB},
+    {SocketType::Router, ZMQ_ROUTER},
 };
 
 Socket::Socket(const Context& context, const SocketType type)
@@ -68,7 +68,7 @@ SubscribeSocket::SubscribeSocket(
     const zeromq::ListenCallback& callback)
     : ot_super(context, SocketType::Subscribe)
     , CurveClient(lock_, socket_)
-    , Receiver(lock_, socket_)
+    , Receiver(lock_, socket_, context)
     , callback_(callback)
 {
     // subscribe to all messages until filtering is implemented
@@ -114,8 +114,11 @@ bool SubscribeSocket::Start(const std::string& endpoint) const
         return false;
     }
 
+    lock.unlock();
+    start_receiver();
+
     return true;
 }
 
-SubscribeSocket::~SubscribeSocket() {}
+SubscribeSocket::~SubscribeSocket() { stop_receiver(); }
 }  // namespace opentxs::network::zeromq::implementation
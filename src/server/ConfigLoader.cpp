@@ -159,6 +159,24 @@ bool ConfigLoader::load(
         OTCron::SetCronMaxItemsPerNym(static_cast<int32_t>(lValue));
     }
 
+    {
+        const char* szComment = "; market_checkpoint_interval is the number of "
+                                "changes a market appends to its journal\n"
+                                "; before the whole market is signed and saved "
+                                "again.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "cron",
+            "market_checkpoint_interval",
+            100,
+            lValue,
+            bIsNewKey,
+            szComment);
+        OTCron::SetMarketCheckpointInterval(static_cast<int32_t>(lValue));
+    }
+
     // HEARTBEAT
 
     {
@@ -192,6 +210,60 @@ bool ConfigLoader::load(
             static_cast<int32_t>(lValue));
     }
 
+    // TRANSACTION NUMBERS
+
+    {
+        const char* szComment = ";; TRANSACTION NUMBERS\n";
+
+        bool bSectionExist = false;
+        config.CheckSetSection("transactions", szComment, bSectionExist);
+    }
+
+    {
+        const char* szComment = "; number_block is how many transaction "
+                                "numbers are reserved each time the\n"
+                                "; notary file is saved. Reserved numbers "
+                                "which are not issued before a\n"
+                                "; restart are skipped.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "transactions",
+            "number_block",
+            ServerSettings::GetTransactionNumberBlock(),
+            lValue,
+            bIsNewKey,
+            szComment);
+        ServerSettings::SetTransactionNumberBlock(lValue);
+    }
+
+    // WORKERS
+
+    {
+        const char* szComment = ";; WORKERS\n";
+
+        bool bSectionExist = false;
+        config.CheckSetSection("workers", szComment, bSectionExist);
+    }
+
+    {
+        const char* szComment = "; threads is the number of threads which "
+                                "process client requests in parallel.\n"
+                                "; 0 means one thread per processor core.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        config.CheckSet_long(
+            "workers",
+            "threads",
+            ServerSettings::GetWorkerThreads(),
+            lValue,
+            bIsNewKey,
+            szComment);
+        ServerSettings::SetWorkerThreads(static_cast<int32_t>(lValue));
+    }
+
     // PERMISSIONS
 
     {
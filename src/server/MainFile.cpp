@@ -81,6 +81,7 @@ MainFile::MainFile(
     , crypto_(crypto)
     , wallet_(wallet)
     , version_()
+    , save_lock_()
 {
 }
 
@@ -94,7 +95,7 @@ bool MainFile::SaveMainFileToString(String& strMainFile)
     tag.add_attribute("notaryID", String(server_.m_strNotaryID).Get());
     tag.add_attribute("serverNymID", server_.m_strServerNymID.Get());
     tag.add_attribute(
-        "transactionNum", formatLong(server_.transactor_.transactionNumber()));
+        "transactionNum", formatLong(server_.transactor_.ceiling()));
 
     if (cachedKey.IsGenerated())  // If it exists, then serialize it.
     {
@@ -145,7 +146,7 @@ bool MainFile::SaveMainFileToString(String& strMainFile)
     std::string str_result;
     tag.output(str_result);
 
-    strMainFile.Concatenate("%s", str_result.c_str());
+    strMainFile.Concatenate(str_result);
 
     return true;
 }
@@ -156,6 +157,8 @@ bool MainFile::SaveMainFileToString(String& strMainFile)
 //
 bool MainFile::SaveMainFile()
 {
+    std::lock_guard<std::mutex> lock(save_lock_);
+
     // Get the loaded (or new) version of the Server's Main File.
     //
     String strMainFile;
@@ -41,28 +41,43 @@
 #include "opentxs/server/MessageProcessor.hpp"
 
 #include "opentxs/api/network/ZMQ.hpp"
-#include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/crypto/ArmorCodec.hpp"
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Item.hpp"
+#include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
-#include "opentxs/network/zeromq/ReplyCallback.hpp"
-#include "opentxs/network/zeromq/ReplySocket.hpp"
+#include "opentxs/network/zeromq/RouterCallback.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
 #include "opentxs/server/Server.hpp"
+#include "opentxs/server/ServerSettings.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <chrono>
+#include <functional>
 #include <ostream>
+#include <set>
 #include <string>
 
 #define OT_METHOD "opentxs::MessageProcessor::"
 
 namespace opentxs::server
 {
+MessageProcessor::Job::Job(const Data& connection, std::string&& raw)
+    : connection_(Data::Factory(connection))
+    , raw_(std::move(raw))
+    , request_(nullptr)
+{
+}
 
 MessageProcessor::MessageProcessor(
     Server& server,
@@ -71,102 +86,185 @@ MessageProcessor::MessageProcessor(
     : server_(server)
     , running_(running)
     , context_(context)
-    , reply_socket_callback_(network::zeromq::ReplyCallback::Factory(
-          [this](const network::zeromq::Message& incoming) -> OTZMQMessage {
-              return this->processSocket(incoming);
+    , workers_()
+    , frontend_callback_(network::zeromq::RouterCallback::Factory(
+          [this](
+              const Data& connection,
+              const network::zeromq::Message& incoming) -> void {
+              this->receive(connection, incoming);
           }))
-    , reply_socket_(context.ReplySocket(reply_socket_callback_.get()))
+    , frontend_socket_(context.RouterSocket(frontend_callback_.get()))
+    , state_lock_()
+    , keys_lock_()
+    , keys_()
+    , cron_lock_()
+    , cron_cv_()
+    , cron_wake_(false)
     , thread_(nullptr)
 {
 }
 
 void MessageProcessor::cleanup()
 {
+    for (auto& worker : workers_) {
+        OT_ASSERT(worker);
+
+        Lock lock(worker->lock_);
+        worker->cv_.notify_all();
+        lock.unlock();
+
+        if (worker->thread_ && worker->thread_->joinable()) {
+            worker->thread_->join();
+            worker->thread_.reset();
+        }
+    }
+
     if (thread_) {
+        wake_cron();
         thread_->join();
         thread_.reset();
     }
 }
 
+bool MessageProcessor::decode_request(
+    const std::string& messageString,
+    Message& request) const
+{
+    if (messageString.size() < 1) {
+
+        return false;
+    }
+
+    std::string decoded;
+    ArmorCodec::Decode(messageString.data(), messageString.size(), decoded);
+    const String serialized(decoded);
+
+    if (false == serialized.Exists()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Empty serialized request."
+              << std::endl;
+
+        return false;
+    }
+
+    if (false == request.LoadContractFromString(serialized)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to deserialized request." << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+void MessageProcessor::dispatch(const std::size_t index, Job&& job)
+{
+    auto& worker = *workers_.at(index);
+    Lock lock(worker.lock_);
+    worker.queue_.emplace_back(std::move(job));
+    lock.unlock();
+    worker.cv_.notify_one();
+}
+
 void MessageProcessor::init(const int port, const OTPassword& privkey)
 {
     if (port == 0) {
         OT_FAIL;
     }
 
-    const auto set = reply_socket_->SetCurve(privkey);
+    if (workers_.empty()) {
+        auto count = ServerSettings::GetWorkerThreads();
+
+        if (1 > count) { count = std::thread::hardware_concurrency(); }
+
+        if (1 > count) { count = 1; }
+
+        for (std::int32_t i = 0; i < count; ++i) {
+            workers_.emplace_back(new Worker);
+        }
+    }
+
+    const auto set = frontend_socket_->SetCurve(privkey);
 
     OT_ASSERT(set);
 
     const auto endpoint = std::string("tcp://*:") + std::to_string(port);
-    const auto bound = reply_socket_->Start(endpoint);
+    const auto bound = frontend_socket_->Start(endpoint);
 
     OT_ASSERT(bound);
 }
 
-void MessageProcessor::run()
+void MessageProcessor::lock_keys(const std::set<std::string>& keys)
 {
-    while (running_) {
-        // timeout is the time left until the next cron should execute.
-        const auto timeout = server_.computeTimeout();
+    // std::set is sorted, so every request acquires its locks in the same
+    // order
+    for (const auto& key : keys) {
+        Lock lock(keys_lock_);
+        auto& entry = keys_[key];
 
-        if (timeout <= 0) {
-            // ProcessCron and processSocket must not run simultaneously
-            Lock lock(lock_);
-            server_.ProcessCron();
-        }
+        if (false == bool(entry)) { entry.reset(new KeyLock); }
 
-        Log::Sleep(std::chrono::milliseconds(50));
+        OT_ASSERT(entry);
+
+        ++entry->users_;
+        auto& mutex = entry->lock_;
+        lock.unlock();
+        mutex.lock();
     }
 }
 
-OTZMQMessage MessageProcessor::processSocket(
-    const network::zeromq::Message& incoming)
+void MessageProcessor::process_job(const std::size_t index, Job& job)
 {
-    // ProcessCron and processSocket must not run simultaneously
-    Lock lock(lock_);
-    std::string reply{};
-    bool error = processMessage(std::string(incoming), reply);
+    if (false == bool(job.request_)) {
+        job.request_.reset(new Message);
 
-    if (error) {
-        reply = "";
-    }
+        OT_ASSERT(job.request_);
 
-    return network::zeromq::Message::Factory(reply);
-}
+        if (false == decode_request(job.raw_, *job.request_)) {
+            frontend_socket_->Send(job.connection_.get(), "");
 
-bool MessageProcessor::processMessage(
-    const std::string& messageString,
-    std::string& reply)
-{
-    if (messageString.size() < 1) {
+            return;
+        }
 
-        return true;
-    }
+        job.raw_.clear();
+        const std::string nymID(job.request_->m_strNymID.Get());
+        const auto partition =
+            std::hash<std::string>{}(nymID) % workers_.size();
 
-    OTASCIIArmor armored;
-    armored.MemSet(messageString.data(), messageString.size());
-    String serialized;
-    armored.GetString(serialized);
-    Message request;
+        if (partition != index) {
+            dispatch(partition, std::move(job));
 
-    if (false == serialized.Exists()) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Empty serialized request."
-              << std::endl;
-
-        return true;
+            return;
+        }
     }
 
-    if (false == request.LoadContractFromString(serialized)) {
-        otErr << OT_METHOD << __FUNCTION__
-              << ": Failed to deserialized request." << std::endl;
+    Message message{};
+    std::set<std::string> keys{};
 
-        return true;
+    if (request_keys(*job.request_, keys)) {
+        std::shared_lock<std::shared_mutex> lock(state_lock_);
+        lock_keys(keys);
+        process_request(*job.request_, message);
+        unlock_keys(keys);
+    } else {
+        std::unique_lock<std::shared_mutex> lock(state_lock_);
+        process_request(*job.request_, message);
+        lock.unlock();
+        wake_cron();
     }
 
-    Message repy{};
+    // The reply is already signed, so it is serialized and armored after the
+    // lock has been released.
+    std::string reply{};
+
+    if (false == serialize_reply(message, reply)) { reply = ""; }
+
+    frontend_socket_->Send(job.connection_.get(), reply);
+}
+
+void MessageProcessor::process_request(const Message& request, Message& reply)
+{
     const bool processed =
-        server_.userCommandProcessor_.ProcessUserCommand(request, repy);
+        server_.userCommandProcessor_.ProcessUserCommand(request, reply);
 
     if (false == processed) {
         otWarn << OT_METHOD << __FUNCTION__
@@ -178,36 +276,244 @@ bool MessageProcessor::processMessage(
                << ": Successfully processed user command "
                << request.m_strCommand << std::endl;
     }
+}
+
+void MessageProcessor::receive(
+    const Data& connection,
+    const network::zeromq::Message& incoming)
+{
+    OT_ASSERT(false == workers_.empty());
+
+    // Requests are decoded by a worker chosen by connection, then handed to
+    // the worker which owns the sender's nym.
+    const std::string id(
+        static_cast<const char*>(connection.GetPointer()),
+        connection.GetSize());
+    const auto index = std::hash<std::string>{}(id) % workers_.size();
+    dispatch(index, Job(connection, std::string(incoming)));
+}
+
+bool MessageProcessor::request_keys(
+    const Message& request,
+    std::set<std::string>& keys)
+{
+    const std::string nymID(request.m_strNymID.Get());
+    const std::string accountID(request.m_strAcctID.Get());
+
+    if (false == nymID.empty()) { keys.emplace(nymID); }
+
+    switch (Message::Type(request.m_strCommand.Get())) {
+        case MessageType::pingNotary:
+        case MessageType::checkNym:
+        case MessageType::getInstrumentDefinition:
+        case MessageType::queryInstrumentDefinitions: {
+            keys.clear();
+
+            return true;
+        }
+        case MessageType::getRequestNumber:
+        case MessageType::getNymbox:
+        case MessageType::getTransactionNumbers:
+        case MessageType::processNymbox: {
+
+            return true;
+        }
+        case MessageType::getBoxReceipt:
+        case MessageType::getAccountData: {
+            if (false == accountID.empty()) { keys.emplace(accountID); }
+
+            return true;
+        }
+        case MessageType::processInbox:
+        case MessageType::notarizeTransaction: {
+            if (false == accountID.empty()) { keys.emplace(accountID); }
+
+            return transaction_keys(request, keys);
+        }
+        default: {
+
+            return false;
+        }
+    }
+}
 
-    String serializedReply(repy);
+void MessageProcessor::run()
+{
+    while (running_) {
+        std::int64_t timeout{0};
+
+        {
+            std::shared_lock<std::shared_mutex> lock(state_lock_);
+            // timeout is the time left until the next cron item is due.
+            timeout = server_.computeTimeout();
+        }
+
+        if (timeout <= 0) {
+            // Cron may touch any account or box
+            std::unique_lock<std::shared_mutex> lock(state_lock_);
+            server_.ProcessCron();
+
+            continue;
+        }
+
+        Lock lock(cron_lock_);
+        cron_cv_.wait_for(lock, std::chrono::milliseconds(timeout), [&]() {
+            return cron_wake_;
+        });
+        cron_wake_ = false;
+    }
+}
+
+bool MessageProcessor::serialize_reply(
+    const Message& message,
+    std::string& reply) const
+{
+    String serializedReply(message);
 
     if (false == serializedReply.Exists()) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to serialize reply."
               << std::endl;
 
-        return true;
+        return false;
     }
 
-    OTASCIIArmor armoredReply(serializedReply);
+    // Replies are never stored, so favor speed over size
+    const bool armored = ArmorCodec::Encode(
+        serializedReply.Get(),
+        serializedReply.GetLength(),
+        ArmorCodec::FastCompression,
+        true,
+        reply);
 
-    if (false == armoredReply.Exists()) {
+    if (false == armored) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to armor reply."
               << std::endl;
 
-        return true;
+        return false;
+    }
+
+    return true;
+}
+
+// Adds the destination accounts of a transaction request to keys. Returns
+// false if the request contains anything other than transfers or receipt
+// acceptances, since those may change other nyms' accounts and boxes.
+bool MessageProcessor::transaction_keys(
+    const Message& request,
+    std::set<std::string>& keys)
+{
+    const Identifier nymID(request.m_strNymID);
+    const Identifier accountID(request.m_strAcctID);
+    const Identifier notaryID(request.m_strNotaryID);
+    Ledger ledger(nymID, accountID, notaryID);
+
+    if (false == ledger.LoadLedgerFromString(String(request.m_ascPayload))) {
+
+        return false;
     }
 
-    reply.assign(armoredReply.Get(), armoredReply.GetLength());
+    for (const auto& it : ledger.GetTransactionMap()) {
+        auto* transaction = it.second;
+
+        if (nullptr == transaction) { return false; }
+
+        switch (transaction->GetType()) {
+            case OTTransaction::transfer:
+            case OTTransaction::processInbox: {
+            } break;
+            default: {
+
+                return false;
+            }
+        }
+
+        for (auto* item : transaction->GetItemList()) {
+            if (nullptr == item) { return false; }
+
+            switch (item->GetType()) {
+                case Item::transfer: {
+                    const String destination(item->GetDestinationAcctID());
+
+                    if (false == destination.Exists()) { return false; }
+
+                    keys.emplace(destination.Get());
+                } break;
+                case Item::balanceStatement:
+                case Item::transactionStatement:
+                case Item::acceptCronReceipt:
+                case Item::acceptItemReceipt:
+                case Item::acceptFinalReceipt:
+                case Item::acceptBasketReceipt: {
+                } break;
+                default: {
+
+                    return false;
+                }
+            }
+        }
+    }
 
-    return false;
+    return true;
 }
 
 void MessageProcessor::Start()
 {
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        auto& worker = *workers_[i];
+
+        if (false == bool(worker.thread_)) {
+            worker.thread_.reset(
+                new std::thread(&MessageProcessor::work, this, i));
+        }
+    }
+
     if (false == bool(thread_)) {
         thread_.reset(new std::thread(&MessageProcessor::run, this));
     }
 }
 
+void MessageProcessor::work(const std::size_t index)
+{
+    auto& worker = *workers_.at(index);
+
+    while (running_) {
+        Lock lock(worker.lock_);
+        worker.cv_.wait(lock, [&]() -> bool {
+            return (false == worker.queue_.empty()) || (false == running_);
+        });
+
+        if (worker.queue_.empty()) { continue; }
+
+        auto job = std::move(worker.queue_.front());
+        worker.queue_.pop_front();
+        lock.unlock();
+        process_job(index, job);
+    }
+}
+
+void MessageProcessor::unlock_keys(const std::set<std::string>& keys)
+{
+    Lock lock(keys_lock_);
+
+    for (const auto& key : keys) {
+        auto it = keys_.find(key);
+
+        OT_ASSERT(keys_.end() != it);
+        OT_ASSERT(it->second);
+
+        it->second->lock_.unlock();
+
+        if (0 == --it->second->users_) { keys_.erase(it); }
+    }
+}
+
+void MessageProcessor::wake_cron()
+{
+    Lock lock(cron_lock_);
+    cron_wake_ = true;
+    lock.unlock();
+    cron_cv_.notify_all();
+}
+
 MessageProcessor::~MessageProcessor() {}
 }  // namespace opentxs::server
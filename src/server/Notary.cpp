@@ -46,6 +46,7 @@
 #if OT_CASH
 #include "opentxs/cash/Mint.hpp"
 #include "opentxs/cash/Purse.hpp"
+#include "opentxs/cash/SpentTokenStore.hpp"
 #include "opentxs/cash/Token.hpp"
 #endif  // OT_CASH
 #include "opentxs/consensus/ClientContext.hpp"
@@ -83,10 +84,12 @@
 #include <cstdint>
 #include <deque>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #define OT_METHOD "opentxs::Notary::"
 
@@ -1168,12 +1171,63 @@ void Notary::NotarizeWithdrawal(
 
                 // Pull the token(s) out of the purse that was received from the
                 // client.
+                std::vector<Token*> tokens;
+
                 while ((pToken = thePurse.Pop(server_.m_nymServer)) !=
                        nullptr) {
                     // We are responsible to cleanup pToken
                     // So I grab a copy here for later...
                     theDeque.push_front(pToken);
+                    tokens.push_back(pToken);
+                }
+
+                // The tokens of each series are blind-signed in one batch, so
+                // the mint can spread the work across cores. The loop below
+                // still checks every token in order and stops at the first
+                // failure.
+                std::vector<String> signatures(tokens.size());
+                std::vector<bool> signedTokens(tokens.size(), false);
+                {
+                    std::map<std::int32_t, std::vector<std::size_t>> series;
+
+                    for (std::size_t i = 0; i < tokens.size(); ++i) {
+                        if (tokens[i]->GetInstrumentDefinitionID() ==
+                            INSTRUMENT_DEFINITION_ID) {
+                            series[tokens[i]->GetSeries()].push_back(i);
+                        }
+                    }
+
+                    for (const auto& it : series) {
+                        const auto& indices = it.second;
+                        auto mint = mint_.GetPrivateMint(
+                            INSTRUMENT_DEFINITION_ID, it.first);
+
+                        if ((false == bool(mint)) || mint->Expired()) {
+                            continue;
+                        }
 
+                        std::vector<Token*> batch;
+                        std::vector<String> output;
+
+                        for (const auto& i : indices) {
+                            batch.push_back(tokens[i]);
+                        }
+
+                        const auto result = mint->SignTokens(
+                            server_.m_nymServer,
+                            batch,
+                            output,
+                            0);  // nTokenIndex = 0
+
+                        for (std::size_t j = 0; j < indices.size(); ++j) {
+                            signedTokens[indices[j]] = result[j];
+                            signatures[indices[j]] = output[j];
+                        }
+                    }
+                }
+
+                for (std::size_t i = 0; i < tokens.size(); ++i) {
+                    pToken = tokens[i];
                     pMint = mint_.GetPrivateMint(
                         INSTRUMENT_DEFINITION_ID, pToken->GetSeries());
 
@@ -1214,8 +1268,6 @@ void Notary::NotarizeWithdrawal(
                         bSuccess = false;
                         break;  // Once there's a failure, we ditch the loop.
                     } else {
-                        String theStringReturnVal;
-
                         if (pToken->GetInstrumentDefinitionID() !=
                             INSTRUMENT_DEFINITION_ID) {
                             const String str1(
@@ -1236,25 +1288,19 @@ void Notary::NotarizeWithdrawal(
                         // proto-tokens, so the Mint
                         // knows which proto-token has been chosen for signing.
                         // But Lucre only uses a single proto-token, so the
-                        // token index is always 0.
+                        // token index is always 0. (Signed above.)
                         //
-                        else if (!(pMint->SignToken(
-                                     server_.m_nymServer,
-                                     *pToken,
-                                     theStringReturnVal,
-                                     0)))  // nTokenIndex = 0 //
-                        // ******************************************
-                        {
+                        else if (false == signedTokens[i]) {
                             bSuccess = false;
                             Log::vError(
                                 "%s: Failure in call: "
-                                "pMint->SignToken(server_.m_nymServer, "
-                                "*pToken, theStringReturnVal, 0). "
+                                "pMint->SignTokens(server_.m_nymServer, "
+                                "tokens, signatures, 0). "
                                 "(Returning.)\n",
                                 __FUNCTION__);
                             break;
                         } else {
-                            OTASCIIArmor theArmorReturnVal(theStringReturnVal);
+                            OTASCIIArmor theArmorReturnVal(signatures[i]);
 
                             pToken->ReleaseSignatures();  // this releases the
                                                           // normal signatures,
@@ -1333,7 +1379,7 @@ void Notary::NotarizeWithdrawal(
                             }
                         }
                     }
-                }  // While success popping token out of the purse...
+                }  // For each token popped out of the purse...
 
                 if (bSuccess) {
                     while (!theDeque.empty()) {
@@ -3944,6 +3990,11 @@ void Notary::NotarizeDeposit(
 
                 // Pull the token(s) out of the purse that was received from the
                 // client.
+                std::vector<std::unique_ptr<Token>> tokens;
+                // The cleartext of each token, with its denomination
+                std::vector<std::pair<String, std::int64_t>> spendable;
+                std::vector<bool> extracted;
+
                 while (true) {
                     std::unique_ptr<Token> pToken(
                         thePurse.Pop(server_.m_nymServer));
@@ -3951,6 +4002,91 @@ void Notary::NotarizeDeposit(
                         break;
                     }
 
+                    String strSpendableToken;
+                    extracted.push_back(pToken->GetSpendableString(
+                        server_.m_nymServer, strSpendableToken));
+                    spendable.emplace_back(
+                        strSpendableToken, pToken->GetDenomination());
+                    tokens.emplace_back(std::move(pToken));
+                }
+
+                // The tokens of each series are verified in one batch, so the
+                // mint can spread the work across cores. The loop below still
+                // checks every token in order and stops at the first failure.
+                std::vector<bool> verified(tokens.size(), false);
+                {
+                    std::map<std::int32_t, std::vector<std::size_t>> series;
+
+                    for (std::size_t i = 0; i < tokens.size(); ++i) {
+                        const auto& token = *tokens[i];
+
+                        if (extracted[i] &&
+                            (token.GetInstrumentDefinitionID() ==
+                             INSTRUMENT_DEFINITION_ID) &&
+                            (token.GetNotaryID() == NOTARY_ID)) {
+                            series[token.GetSeries()].push_back(i);
+                        }
+                    }
+
+                    for (const auto& it : series) {
+                        const auto& indices = it.second;
+                        auto mint = mint_.GetPrivateMint(
+                            INSTRUMENT_DEFINITION_ID, it.first);
+
+                        if (false == bool(mint)) { continue; }
+
+                        std::vector<std::pair<String, std::int64_t>> batch;
+
+                        for (const auto& i : indices) {
+                            batch.push_back(spendable[i]);
+                        }
+
+                        const auto result =
+                            mint->VerifyTokens(server_.m_nymServer, batch);
+
+                        for (std::size_t j = 0; j < indices.size(); ++j) {
+                            verified[indices[j]] = result[j];
+                        }
+                    }
+                }
+
+                // Every token is looked up in the spent token database before
+                // any balance is touched. The tokens are only recorded as
+                // spent once every one of them has been credited, so that a
+                // deposit which fails does not burn the cash in the purse.
+                std::vector<bool> alreadySpent(tokens.size(), false);
+                std::map<std::int32_t, std::vector<Identifier>> hashes;
+                {
+                    std::set<Identifier> seen;
+
+                    for (std::size_t i = 0; i < tokens.size(); ++i) {
+                        if (false == verified[i]) { break; }
+
+                        const auto number = tokens[i]->GetSeries();
+                        auto store = SpentTokenStore::Get(
+                            INSTRUMENT_DEFINITION_ID, number);
+                        Identifier hash;
+                        hash.CalculateDigest(spendable[i].first);
+
+                        // Errors are reported as spent, as in
+                        // Token::IsTokenAlreadySpent
+                        if ((false == bool(store)) ||
+                            (false == seen.insert(hash).second) ||
+                            store->Contains(hash)) {
+                            alreadySpent[i] = true;
+                            break;
+                        }
+
+                        hashes[number].push_back(hash);
+                    }
+                }
+
+                // The reserve account and amount of each token credited so
+                // far, in case the deposit has to be rolled back.
+                std::vector<std::pair<Account*, std::int64_t>> credited;
+
+                for (std::size_t i = 0; i < tokens.size(); ++i) {
+                    auto& pToken = tokens[i];
                     pMint = mint_.GetPrivateMint(
                         INSTRUMENT_DEFINITION_ID, pToken->GetSeries());
 
@@ -3961,9 +4097,7 @@ void Notary::NotarizeDeposit(
                     } else if (
                         (pMintCashReserveAcct =
                              pMint->GetCashReserveAccount()) != nullptr) {
-                        String strSpendableToken;
-                        bool bToken = pToken->GetSpendableString(
-                            server_.m_nymServer, strSpendableToken);
+                        const bool bToken = extracted[i];
 
                         if (!bToken)  // if failure getting the spendable token
                                       // data from the token object
@@ -4009,12 +4143,10 @@ void Notary::NotarizeDeposit(
                         // the key for that series and
                         // denomination. (The signed and unblinded Lucre coin is
                         // finally verified in Lucre
-                        // using the appropriate Mint private key.)
+                        // using the appropriate Mint private key.) (Verified
+                        // above.)
                         //
-                        else if (!(pMint->VerifyToken(
-                                     server_.m_nymServer,
-                                     strSpendableToken,
-                                     pToken->GetDenomination()))) {
+                        else if (false == verified[i]) {
                             bSuccess = false;
                             Log::vOutput(
                                 0,
@@ -4026,8 +4158,7 @@ void Notary::NotarizeDeposit(
                         // Lookup the token in the SPENT TOKEN DATABASE, and
                         // make sure
                         // that it hasn't already been spent...
-                        else if (pToken->IsTokenAlreadySpent(
-                                     strSpendableToken)) {
+                        else if (alreadySpent[i]) {
                             // TODO!!!! Need to store the spent token database
                             // in multiple places, on multiple media!
                             //          Furthermore need to CHECK those multiple
@@ -4087,34 +4218,11 @@ void Notary::NotarizeDeposit(
                                 bSuccess = false;
                                 break;
                             }
-                            // Spent token database. This is where the call is
-                            // made to add
-                            // the token to the spent token database.
-                            else if (
-                                false ==
-                                pToken->RecordTokenAsSpent(strSpendableToken)) {
-                                Log::Error("Notary::NotarizeDeposit: "
-                                           "Failed recording token as "
-                                           "spent...\n");
-
-                                if (false == pMintCashReserveAcct->Credit(
-                                                 pToken->GetDenomination()))
-                                    Log::Error("Notary::NotarizeDeposit: "
-                                               "Failure crediting-back "
-                                               "mint's cash reserve account "
-                                               "while depositing cash.\n");
-
-                                if (false ==
-                                    theAccount.Debit(pToken->GetDenomination()))
-                                    Log::Error("Notary::NotarizeDeposit: "
-                                               "Failure debiting-back user's "
-                                               "asset account while "
-                                               "depositing cash.\n");
-
-                                bSuccess = false;
-                                break;
-                            } else  // SUCCESS!!! (this iteration)
+                            else  // SUCCESS!!! (this iteration)
                             {
+                                credited.emplace_back(
+                                    pMintCashReserveAcct,
+                                    pToken->GetDenomination());
                                 Log::vOutput(
                                     2,
                                     "Notary::NotarizeDeposit: "
@@ -4132,7 +4240,71 @@ void Notary::NotarizeDeposit(
                         bSuccess = false;
                         break;
                     }
-                }  // while success popping token from purse
+                }  // for each token popped from the purse
+
+                // Spent token database. Each series records its tokens with a
+                // single append. If any token can not be recorded, for
+                // instance because a concurrent deposit of the same token got
+                // there first, the tokens this deposit did record are
+                // withdrawn again, the balances are rolled back and the
+                // deposit fails.
+                if (bSuccess) {
+                    std::map<std::int32_t, std::vector<Identifier>> recorded;
+
+                    for (const auto& it : hashes) {
+                        auto store = SpentTokenStore::Get(
+                            INSTRUMENT_DEFINITION_ID, it.first);
+
+                        if (false == bool(store)) {
+                            bSuccess = false;
+                            break;
+                        }
+
+                        const auto result = store->Insert(it.second);
+                        auto& added = recorded[it.first];
+
+                        for (std::size_t j = 0; j < result.size(); ++j) {
+                            if (result[j]) {
+                                added.push_back(it.second[j]);
+                            } else {
+                                bSuccess = false;
+                            }
+                        }
+
+                        if (false == bSuccess) { break; }
+                    }
+
+                    if (false == bSuccess) {
+                        Log::Error("Notary::NotarizeDeposit: Failed to record "
+                                   "tokens as spent.\n");
+
+                        for (const auto& it : recorded) {
+                            auto store = SpentTokenStore::Get(
+                                INSTRUMENT_DEFINITION_ID, it.first);
+
+                            if ((false == bool(store)) ||
+                                (false == store->Remove(it.second)))
+                                Log::Error("Notary::NotarizeDeposit: "
+                                           "Failure withdrawing tokens "
+                                           "from the spent token "
+                                           "database.\n");
+                        }
+
+                        for (const auto& it : credited) {
+                            if (false == it.first->Credit(it.second))
+                                Log::Error("Notary::NotarizeDeposit: "
+                                           "Failure crediting-back "
+                                           "mint's cash reserve account "
+                                           "while depositing cash.\n");
+
+                            if (false == theAccount.Debit(it.second))
+                                Log::Error("Notary::NotarizeDeposit: "
+                                           "Failure debiting-back user's "
+                                           "asset account while "
+                                           "depositing cash.\n");
+                        }
+                    }
+                }
 
                 if (bSuccess) {
                     // Release any signatures that were there before (They won't
@@ -54,6 +54,10 @@ int64_t ServerSettings::__min_market_scale = 1;
 int32_t ServerSettings::__heartbeat_no_requests = 10;
 // number of ms between each heartbeat.
 int32_t ServerSettings::__heartbeat_ms_between_beats = 100;
+// The number of threads processing client requests. 0 means one per core.
+int32_t ServerSettings::__worker_threads = 0;
+// The number of transaction numbers reserved each time the main file is saved.
+int64_t ServerSettings::__transaction_number_block = 1000;
 // The Nym who's allowed to do certain
 // commands even if they are turned off.
 std::string ServerSettings::__override_nym_id;
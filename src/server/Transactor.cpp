@@ -51,9 +51,11 @@
 #include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/server/MainFile.hpp"
 #include "opentxs/server/Server.hpp"
+#include "opentxs/server/ServerSettings.hpp"
 
 #include <inttypes.h>
 #include <stdint.h>
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -64,6 +66,9 @@ namespace opentxs::server
 
 Transactor::Transactor(Server* server)
     : transactionNumber_(0)
+    , reservedNumber_(0)
+    , ceiling_(0)
+    , reserve_lock_()
     , server_(server)
 {
 }
@@ -78,25 +83,34 @@ Transactor::~Transactor() {}
 ///
 /// Users must ask the server to send them transaction numbers so that they
 /// can be used in transaction requests.
+///
+/// Numbers are reserved from the main file in blocks so that only the first
+/// number of each block costs a main file save. If the server stops before a
+/// block is used up, the remainder of the block is never issued.
 bool Transactor::issueNextTransactionNumber(
     TransactionNumber& lTransactionNumber)
 {
     // transactionNumber_ stores the last VALID AND ISSUED transaction number.
     // So first, we increment that, since we don't want to issue the same number
     // twice.
-    transactionNumber_++;
+    const TransactionNumber number = ++transactionNumber_;
 
-    // Next, we save it to file.
-    if (!server_->mainFile_.SaveMainFile()) {
-        Log::Error("Error saving main server file.\n");
-        transactionNumber_--;
-        return false;
+    // Next, make sure the number is covered by a reservation saved to file.
+    if (number > reservedNumber_) {
+        if (false == reserve(number)) {
+            // The number is burned rather than reused since other threads may
+            // have already been issued higher numbers.
+            Log::Error("Error saving main server file.\n");
+
+            return false;
+        }
     }
 
     // SUCCESS?
-    // Now the server main file has saved the latest transaction number,
-    // NOW we set it onto the parameter and return true.
-    lTransactionNumber = transactionNumber_;
+    // Now the server main file has saved a reservation which includes this
+    // transaction number, NOW we set it onto the parameter and return true.
+    lTransactionNumber = number;
+
     return true;
 }
 
@@ -115,20 +129,40 @@ bool Transactor::issueNextTransactionNumberToNym(
     // it is recorded in his Nym file before being sent to the client (where it
     // is also recorded in his Nym file.)  That way the server always knows
     // which numbers are valid for each Nym.
-    if (!context.IssueNumber(transactionNumber_)) {
+    if (!context.IssueNumber(lTransactionNumber)) {
         Log::Error("Error adding transaction number to Nym file.\n");
-        transactionNumber_--;
-        // Save it back how it was, since we're not issuing this number after
-        // all.
-        server_->mainFile_.SaveMainFile();
+        // The number is skipped, just as the unused remainder of a reserved
+        // block is skipped after a restart.
 
         return false;
     }
 
-    // SUCCESS?
-    // Now the server main file has saved the latest transaction number,
-    // NOW we set it onto the parameter and return true.
-    lTransactionNumber = transactionNumber_;
+    return true;
+}
+
+bool Transactor::reserve(const TransactionNumber number)
+{
+    Lock lock(reserve_lock_);
+
+    // Another thread may have reserved a block while this one was waiting
+    if (number <= reservedNumber_) { return true; }
+
+    TransactionNumber block = ServerSettings::GetTransactionNumberBlock();
+
+    if (1 > block) { block = 1; }
+
+    // A burst of concurrent requests may have run past the end of the block
+    const TransactionNumber issued = transactionNumber_;
+    const TransactionNumber ceiling =
+        std::max(std::max(number, issued) + block - 1, ceiling_.load());
+
+    // Other threads keep issuing numbers up to reservedNumber_ while the main
+    // file is saved, so the new ceiling is only published once it is durable.
+    ceiling_ = ceiling;
+
+    if (false == server_->mainFile_.SaveMainFile()) { return false; }
+
+    reservedNumber_ = ceiling;
 
     return true;
 }
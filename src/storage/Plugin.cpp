@@ -42,6 +42,10 @@
 
 #include "opentxs/api/storage/Storage.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/storage/StorageConfig.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 #define OT_METHOD "opentxs::Plugin::"
 
@@ -59,6 +63,12 @@ Plugin::Plugin(
     , storage_(storage)
     , digest_(hash)
     , current_bucket_(bucket)
+    , write_lock_()
+    , write_ready_()
+    , write_space_()
+    , write_queue_()
+    , writers_()
+    , writers_stopped_(false)
 {
 }
 
@@ -168,9 +178,26 @@ void Plugin::Store(
     const bool bucket,
     std::promise<bool>& promise) const
 {
-    std::thread thread(
-        &Plugin::store, this, isTransaction, key, value, bucket, &promise);
-    thread.detach();
+    Lock lock(write_lock_);
+    start_writers(lock);
+    const std::size_t limit =
+        std::max<std::int64_t>(1, config_.write_queue_size_);
+    write_space_.wait(lock, [&]() -> bool {
+        return writers_stopped_ || (write_queue_.size() < limit);
+    });
+
+    if (writers_stopped_) {
+        lock.unlock();
+        otErr << OT_METHOD << __FUNCTION__ << ": Write queue is shut down."
+              << std::endl;
+        promise.set_value(false);
+
+        return;
+    }
+
+    write_queue_.push_back({isTransaction, key, value, bucket, &promise});
+    lock.unlock();
+    write_ready_.notify_one();
 }
 
 bool Plugin::Store(
@@ -188,4 +215,73 @@ bool Plugin::Store(
 
     return false;
 }
+
+void Plugin::start_writers(const Lock& lock) const
+{
+    OT_ASSERT(lock.mutex() == &write_lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    if (writers_stopped_ || (false == writers_.empty())) { return; }
+
+    const std::size_t count =
+        std::max<std::int64_t>(1, config_.write_threads_);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        writers_.emplace_back(&Plugin::write_worker, this);
+    }
+}
+
+void Plugin::stop_writers() const
+{
+    Lock lock(write_lock_);
+    writers_stopped_ = true;
+    auto writers = std::move(writers_);
+    writers_.clear();
+    lock.unlock();
+    write_ready_.notify_all();
+    write_space_.notify_all();
+
+    for (auto& thread : writers) {
+        if (thread.joinable()) { thread.join(); }
+    }
+}
+
+void Plugin::store_batch(const WriteBatch& batch) const
+{
+    for (const auto& write : batch) {
+        store(
+            write.isTransaction_,
+            write.key_,
+            write.value_,
+            write.bucket_,
+            write.promise_);
+    }
+}
+
+void Plugin::write_worker() const
+{
+    WriteBatch batch{};
+
+    while (true) {
+        Lock lock(write_lock_);
+        write_ready_.wait(lock, [&]() -> bool {
+            return writers_stopped_ || (false == write_queue_.empty());
+        });
+
+        // Queued writes are always drained, even during shutdown, since
+        // callers are blocked on their promises
+        if (write_queue_.empty()) { return; }
+
+        batch.assign(
+            std::make_move_iterator(write_queue_.begin()),
+            std::make_move_iterator(write_queue_.end()));
+        write_queue_.clear();
+        lock.unlock();
+        write_space_.notify_all();
+        store_batch(batch);
+        batch.clear();
+    }
+}
+
+Plugin::~Plugin() { stop_writers(); }
 }  // namespace opentxs
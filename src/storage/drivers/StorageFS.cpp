@@ -44,11 +44,13 @@
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <ios>
 #include <iostream>
-#include <thread>
+#include <set>
 #include <vector>
 
 extern "C" {
@@ -74,6 +76,13 @@ StorageFS::StorageFS(
     , folder_(folder)
     , path_seperator_(PATH_SEPERATOR)
     , ready_(Flag::Factory(false))
+    , commit_window_(std::max<std::int64_t>(0, config.fs_commit_window_))
+    , directory_lock_()
+    , directories_()
+    , pending_lock_()
+    , pending_files_()
+    , pending_directories_()
+    , pending_since_()
 {
     Init_StorageFS();
 }
@@ -82,7 +91,44 @@ void StorageFS::Cleanup() { Cleanup_StorageFS(); }
 
 void StorageFS::Cleanup_StorageFS()
 {
-    // future cleanup actions go here
+    stop_writers();
+    Lock lock(pending_lock_);
+    flush(lock);
+}
+
+bool StorageFS::flush(const Lock& lock) const
+{
+    OT_ASSERT(lock.mutex() == &pending_lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    bool output{true};
+
+    for (const auto& filename : pending_files_) {
+        if (false == sync_file(filename)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync file "
+                  << filename << std::endl;
+            output = false;
+        }
+    }
+
+    // Directories are synced after the files so that every entry they
+    // reference is already durable
+    output &= sync(pending_directories_);
+    pending_files_.clear();
+    pending_directories_.clear();
+
+    return output;
+}
+
+void StorageFS::flush_expired() const
+{
+    Lock lock(pending_lock_);
+
+    if (pending_files_.empty() && pending_directories_.empty()) { return; }
+
+    const auto age = std::chrono::steady_clock::now() - pending_since_;
+
+    if (age >= commit_window_) { flush(lock); }
 }
 
 void StorageFS::Init_StorageFS()
@@ -98,12 +144,6 @@ bool StorageFS::LoadFromBucket(
     value.clear();
     std::string directory{};
     const auto filename = calculate_path(key, bucket, directory);
-    boost::system::error_code ec{};
-
-    if (false == boost::filesystem::exists(filename, ec)) {
-
-        return false;
-    }
 
     if (ready_.get() && false == folder_.empty()) {
         value = read_file(filename);
@@ -122,6 +162,66 @@ std::string StorageFS::LoadRoot() const
     return "";
 }
 
+void StorageFS::mark_pending(
+    const std::string& directory,
+    const std::string& filename) const
+{
+    Lock lock(pending_lock_);
+
+    if (pending_files_.empty() && pending_directories_.empty()) {
+        pending_since_ = std::chrono::steady_clock::now();
+    }
+
+    pending_directories_.insert(directory);
+
+    if (false == filename.empty()) { pending_files_.insert(filename); }
+}
+
+bool StorageFS::prepare_directory(const std::string& directory) const
+{
+    Lock lock(directory_lock_);
+
+    if (1 == directories_.count(directory)) { return true; }
+
+    std::vector<boost::filesystem::path> missing{};
+    boost::filesystem::path path(directory);
+    boost::system::error_code ec{};
+
+    while ((false == path.empty()) &&
+           (false == boost::filesystem::exists(path, ec))) {
+        missing.push_back(path);
+        path = path.parent_path();
+    }
+
+    if (false == missing.empty()) {
+        boost::filesystem::create_directories(directory, ec);
+
+        if (ec) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to create directory " << directory << ": "
+                  << ec.message() << std::endl;
+
+            return false;
+        }
+
+        // A new directory entry is only durable once its parent is synced
+        for (const auto& created : missing) {
+            const auto parent = created.parent_path().string();
+
+            if (group_commit()) {
+                mark_pending(parent, "");
+            } else if (false == sync(parent)) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Failed to sync directory " << parent << std::endl;
+            }
+        }
+    }
+
+    directories_.insert(directory);
+
+    return true;
+}
+
 std::string StorageFS::prepare_read(const std::string& input) const
 {
     return input;
@@ -134,13 +234,6 @@ std::string StorageFS::prepare_write(const std::string& input) const
 
 std::string StorageFS::read_file(const std::string& filename) const
 {
-    boost::system::error_code ec{};
-
-    if (false == boost::filesystem::exists(filename, ec)) {
-
-        return {};
-    }
-
     std::ifstream file(
         filename, std::ios::in | std::ios::ate | std::ios::binary);
 
@@ -171,18 +264,52 @@ void StorageFS::store(
 {
     OT_ASSERT(nullptr != promise);
 
-    if (ready_.get() && false == folder_.empty()) {
-        std::string directory{};
-        const auto filename = calculate_path(key, bucket, directory);
-        promise->set_value(write_file(directory, filename, value));
-    } else {
-        promise->set_value(false);
+    std::set<std::string> directories{};
+    const bool written = write_object(key, value, bucket, directories);
+    sync(directories);
+    flush_expired();
+    promise->set_value(written);
+}
+
+void StorageFS::store_batch(const WriteBatch& batch) const
+{
+    std::vector<bool> written(batch.size(), false);
+    std::set<std::string> directories{};
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto& write = batch.at(i);
+        written[i] =
+            write_object(write.key_, write.value_, write.bucket_, directories);
+    }
+
+    // Directory entries only need to be made durable once per batch no
+    // matter how many files were created in them
+    sync(directories);
+    flush_expired();
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto& promise = batch.at(i).promise_;
+
+        OT_ASSERT(nullptr != promise);
+
+        promise->set_value(written.at(i));
     }
 }
 
 bool StorageFS::StoreRoot(const bool, const std::string& hash) const
 {
     if (ready_.get() && false == folder_.empty()) {
+        if (group_commit()) {
+            Lock lock(pending_lock_);
+
+            // The root must never reference objects which are not durable
+            if (false == flush(lock)) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Failed to sync pending writes." << std::endl;
+
+                return false;
+            }
+        }
 
         return write_file(folder_, root_filename(), hash);
     }
@@ -191,12 +318,17 @@ bool StorageFS::StoreRoot(const bool, const std::string& hash) const
 }
 
 bool StorageFS::sync(const std::string& path) const
+{
+    return sync(path, O_DIRECTORY | O_RDONLY);
+}
+
+bool StorageFS::sync(const std::string& path, const int flags) const
 {
     class FileDescriptor
     {
     public:
-        FileDescriptor(const std::string& path)
-            : fd_(::open(path.c_str(), O_DIRECTORY | O_RDONLY))
+        FileDescriptor(const std::string& path, const int flags)
+            : fd_(::open(path.c_str(), flags))
         {
         }
 
@@ -222,7 +354,7 @@ bool StorageFS::sync(const std::string& path) const
         FileDescriptor& operator=(FileDescriptor&&) = delete;
     };
 
-    FileDescriptor fd(path);
+    FileDescriptor fd(path, flags);
 
     if (!fd) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to open " << path
@@ -234,6 +366,21 @@ bool StorageFS::sync(const std::string& path) const
     return sync(fd);
 }
 
+bool StorageFS::sync(const std::set<std::string>& directories) const
+{
+    bool output{true};
+
+    for (const auto& directory : directories) {
+        if (false == sync(directory)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to sync directory " << directory << std::endl;
+            output = false;
+        }
+    }
+
+    return output;
+}
+
 bool StorageFS::sync(File& file) const { return sync(file->handle()); }
 
 bool StorageFS::sync(int fd) const
@@ -247,10 +394,30 @@ bool StorageFS::sync(int fd) const
 #endif
 }
 
+bool StorageFS::sync_file(const std::string& filename) const
+{
+    return sync(filename, O_RDONLY);
+}
+
 bool StorageFS::write_file(
     const std::string& directory,
     const std::string& filename,
     const std::string& contents) const
+{
+    if (false == write_file(filename, contents, true)) { return false; }
+
+    if (false == sync(directory)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync directory "
+              << directory << std::endl;
+    }
+
+    return true;
+}
+
+bool StorageFS::write_file(
+    const std::string& filename,
+    const std::string& contents,
+    const bool syncFile) const
 {
     if (false == filename.empty()) {
         boost::filesystem::path filePath(filename);
@@ -260,17 +427,11 @@ bool StorageFS::write_file(
         if (file.good()) {
             file.write(data.c_str(), data.size());
 
-            if (false == sync(file)) {
+            if (syncFile && (false == sync(file))) {
                 otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync file "
                       << filename << std::endl;
             }
 
-            if (false == sync(directory)) {
-                otErr << OT_METHOD << __FUNCTION__
-                      << ": Failed to sync directory " << directory
-                      << std::endl;
-            }
-
             file.close();
 
             return true;
@@ -286,6 +447,32 @@ bool StorageFS::write_file(
     return false;
 }
 
+bool StorageFS::write_object(
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::set<std::string>& directories) const
+{
+    if ((false == ready_.get()) || folder_.empty()) { return false; }
+
+    std::string directory{};
+    const auto filename = calculate_path(key, bucket, directory);
+
+    if (false == prepare_directory(directory)) { return false; }
+
+    if (group_commit()) {
+        if (false == write_file(filename, value, false)) { return false; }
+
+        mark_pending(directory, filename);
+    } else {
+        if (false == write_file(filename, value, true)) { return false; }
+
+        directories.insert(directory);
+    }
+
+    return true;
+}
+
 StorageFS::~StorageFS() { Cleanup_StorageFS(); }
 
 }  // namespace opentxs
@@ -99,13 +99,10 @@ std::string StorageFSArchive::calculate_path(
     std::string& directory) const
 {
     directory = folder_;
-    auto& level1 = folder_;
-    std::string level2{};
 
     if (4 < key.size()) {
         directory += path_seperator_;
         directory += key.substr(0, 4);
-        level2 = directory;
     }
 
     if (8 < key.size()) {
@@ -113,21 +110,6 @@ std::string StorageFSArchive::calculate_path(
         directory += key.substr(4, 4);
     }
 
-    boost::system::error_code ec{};
-    boost::filesystem::create_directories(directory, ec);
-
-    if (8 < key.size()) {
-        if (false == sync(level2)) {
-            otErr << OT_METHOD << __FUNCTION__ << ": Unable to sync directory"
-                  << level2 << std::endl;
-        }
-    }
-
-    if (false == sync(level1)) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to sync directory"
-              << level1 << std::endl;
-    }
-
     return {directory + path_seperator_ + key};
 }
 
@@ -137,10 +119,7 @@ void StorageFSArchive::Cleanup()
     ot_super::Cleanup();
 }
 
-void StorageFSArchive::Cleanup_StorageFSArchive()
-{
-    // future cleanup actions go here
-}
+void StorageFSArchive::Cleanup_StorageFSArchive() { stop_writers(); }
 
 bool StorageFSArchive::EmptyBucket(const bool) const { return true; }
 
@@ -437,6 +437,8 @@ bool StorageMultiplex::Store(
 
     std::vector<std::promise<bool>> promises{};
     std::vector<std::future<bool>> futures{};
+    // The plugins hold pointers to these promises until they are satisfied
+    promises.reserve(1 + backup_plugins_.size());
     promises.push_back(std::promise<bool>());
     auto& primaryPromise = promises.back();
     futures.push_back(primaryPromise.get_future());
@@ -63,58 +63,77 @@ StorageSqlite3::StorageSqlite3(
     , transaction_lock_()
     , transaction_bucket_(Flag::Factory(false))
     , pending_()
+    , statement_lock_()
+    , statements_()
     , db_(nullptr)
 {
     Init_StorageSqlite3();
 }
 
-std::string StorageSqlite3::bind_key(
-    const std::string& source,
-    const std::string& key,
-    const std::size_t start) const
-{
-    sqlite3_stmt* statement{nullptr};
-    sqlite3_prepare_v2(db_, source.c_str(), -1, &statement, nullptr);
-    sqlite3_bind_text(statement, start, key.c_str(), key.size(), SQLITE_STATIC);
-    const std::string output = sqlite3_expanded_sql(statement);
-    sqlite3_finalize(statement);
-
-    return output;
-}
-
 void StorageSqlite3::Cleanup() { Cleanup_StorageSqlite3(); }
 
-void StorageSqlite3::Cleanup_StorageSqlite3() { sqlite3_close(db_); }
-
-void StorageSqlite3::commit(std::stringstream& sql) const
+void StorageSqlite3::Cleanup_StorageSqlite3()
 {
-    sql << "COMMIT TRANSACTION;";
+    stop_writers();
+    Lock lock(statement_lock_);
+
+    for (auto& it : statements_) { sqlite3_finalize(it.second); }
+
+    statements_.clear();
+    sqlite3_close(db_);
+    db_ = nullptr;
 }
 
 bool StorageSqlite3::commit_transaction(const std::string& rootHash) const
 {
     Lock lock(transaction_lock_);
-    std::stringstream sql{};
-    start_transaction(sql);
-    set_data(sql);
-    set_root(rootHash, sql);
-    commit(sql);
+    Lock statementLock(statement_lock_);
+    const std::string tablename{GetTableName(transaction_bucket_.get())};
+
+    if (false == exec(statementLock, "BEGIN TRANSACTION;")) {
+        pending_.clear();
+
+        return false;
+    }
+
+    bool success{true};
+
+    for (const auto& it : pending_) {
+        success = upsert(statementLock, it.first, tablename, it.second);
+
+        if (false == success) { break; }
+    }
+
+    if (success) {
+        success = upsert(
+            statementLock,
+            config_.sqlite3_root_key_,
+            config_.sqlite3_control_table_,
+            rootHash);
+    }
+
     pending_.clear();
-    otInfo << sql.str() << std::endl;
 
-    return (
-        SQLITE_OK ==
-        sqlite3_exec(db_, sql.str().c_str(), nullptr, nullptr, nullptr));
+    if (success) { success = exec(statementLock, "COMMIT TRANSACTION;"); }
+
+    if (false == success) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to commit transaction: " << sqlite3_errmsg(db_)
+              << std::endl;
+        exec(statementLock, "ROLLBACK TRANSACTION;");
+    }
+
+    return success;
 }
 
-bool StorageSqlite3::Create(const std::string& tablename) const
+bool StorageSqlite3::Create(const Lock& lock, const std::string& tablename)
+    const
 {
     const std::string createTable = "create table if not exists ";
     const std::string tableFormat = " (k text PRIMARY KEY, v BLOB);";
     const std::string sql = createTable + "`" + tablename + "`" + tableFormat;
 
-    return (
-        SQLITE_OK == sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr));
+    return exec(lock, sql);
 }
 
 bool StorageSqlite3::EmptyBucket(const bool bucket) const
@@ -122,6 +141,31 @@ bool StorageSqlite3::EmptyBucket(const bool bucket) const
     return Purge(GetTableName(bucket));
 }
 
+bool StorageSqlite3::exec(const Lock& lock, const std::string& sql) const
+{
+    OT_ASSERT(lock.mutex() == &statement_lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    return (
+        SQLITE_OK == sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr));
+}
+
+void StorageSqlite3::finalize(const Lock& lock, const std::string& tablename)
+    const
+{
+    OT_ASSERT(lock.mutex() == &statement_lock_)
+    OT_ASSERT(lock.owns_lock())
+
+    for (auto it = statements_.begin(); it != statements_.end();) {
+        if (tablename == it->first.first) {
+            sqlite3_finalize(it->second);
+            it = statements_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 std::string StorageSqlite3::GetTableName(const bool bucket) const
 {
     return bucket ? config_.sqlite3_secondary_bucket_
@@ -138,11 +182,11 @@ void StorageSqlite3::Init_StorageSqlite3()
             &db_,
             SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX,
             nullptr)) {
-        sqlite3_exec(
-            db_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
-        Create(config_.sqlite3_primary_bucket_);
-        Create(config_.sqlite3_secondary_bucket_);
-        Create(config_.sqlite3_control_table_);
+        Lock lock(statement_lock_);
+        exec(lock, "PRAGMA journal_mode=WAL;");
+        Create(lock, config_.sqlite3_primary_bucket_);
+        Create(lock, config_.sqlite3_secondary_bucket_);
+        Create(lock, config_.sqlite3_control_table_);
     } else {
         otErr << OT_METHOD << __FUNCTION__ << "Failed to initialize database."
               << std::endl;
@@ -174,11 +218,14 @@ std::string StorageSqlite3::LoadRoot() const
 
 bool StorageSqlite3::Purge(const std::string& tablename) const
 {
-    const std::string sql = "DROP TABLE `" + tablename + "`;";
+    // Statements prepared against the old table must not outlive it, and no
+    // other query may run between the drop and the create.
+    Lock lock(statement_lock_);
+    finalize(lock, tablename);
 
-    if (SQLITE_OK ==
-        sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr)) {
-        return Create(tablename);
+    if (exec(lock, "DROP TABLE `" + tablename + "`;")) {
+
+        return Create(lock, tablename);
     }
 
     return false;
@@ -189,12 +236,20 @@ bool StorageSqlite3::Select(
     const std::string& tablename,
     std::string& value) const
 {
-    sqlite3_stmt* statement{nullptr};
-    const std::string query =
-        "SELECT v FROM '" + tablename + "' WHERE k GLOB ?1;";
-    const auto sql = bind_key(query, key, 1);
-    sqlite3_prepare_v2(db_, sql.c_str(), -1, &statement, 0);
-    otInfo << sql << std::endl;
+    Lock lock(statement_lock_);
+    auto* statement = this->statement(lock, tablename, Query::Select);
+
+    if (nullptr == statement) { return false; }
+
+    const auto bound = sqlite3_bind_text(
+        statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
+
+    if (SQLITE_OK != bound) {
+        sqlite3_reset(statement);
+
+        return false;
+    }
+
     auto result = sqlite3_step(statement);
     bool success = false;
     std::size_t retry{3};
@@ -214,94 +269,66 @@ bool StorageSqlite3::Select(
             } break;
             case SQLITE_BUSY: {
                 otErr << OT_METHOD << __FUNCTION__ << ": Busy" << std::endl;
+                sqlite3_reset(statement);
                 result = sqlite3_step(statement);
                 --retry;
             } break;
             default: {
                 otErr << OT_METHOD << __FUNCTION__ << ": Unknown error ("
                       << result << ")" << std::endl;
+                sqlite3_reset(statement);
                 result = sqlite3_step(statement);
                 --retry;
             }
         }
     }
 
-    sqlite3_finalize(statement);
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
 
     return success;
 }
 
-void StorageSqlite3::set_data(std::stringstream& sql) const
+sqlite3_stmt* StorageSqlite3::statement(
+    const Lock& lock,
+    const std::string& tablename,
+    const Query type) const
 {
-    sqlite3_stmt* data{nullptr};
-    std::stringstream dataSQL{};
-    const std::string tablename{GetTableName(transaction_bucket_.get())};
-    dataSQL << "INSERT OR REPLACE INTO '" << tablename << "' (k, v) VALUES ";
-    std::size_t counter{0};
-    const auto size = pending_.size();
+    OT_ASSERT(lock.mutex() == &statement_lock_)
+    OT_ASSERT(lock.owns_lock())
 
-    for (std::size_t i = 0; i < size; ++i) {
-        dataSQL << "(?" << ++counter << ", ?";
-        dataSQL << ++counter << ")";
+    auto& output = statements_[StatementKey{tablename, type}];
 
-        if (counter < (2 * size)) {
-            dataSQL << ", ";
-        } else {
-            dataSQL << "; ";
-        }
-    }
+    if (nullptr != output) { return output; }
 
-    sqlite3_prepare_v2(db_, dataSQL.str().c_str(), -1, &data, 0);
-    counter = 0;
+    std::string sql{};
 
-    for (const auto& it : pending_) {
-        const auto& key = it.first;
-        const auto& value = it.second;
-        auto bound = sqlite3_bind_text(
-            data, ++counter, key.c_str(), key.size(), SQLITE_STATIC);
+    switch (type) {
+        case Query::Select: {
+            sql = "SELECT v FROM `" + tablename + "` WHERE k = ?1;";
+        } break;
+        case Query::Upsert: {
+            sql = "INSERT OR REPLACE INTO `" + tablename +
+                  "` (k, v) VALUES (?1, ?2);";
+        } break;
+        default: {
+            OT_FAIL;
+        }
+    }
 
-        OT_ASSERT(SQLITE_OK == bound);
+    const auto prepared =
+        sqlite3_prepare_v2(db_, sql.c_str(), -1, &output, nullptr);
 
-        bound = sqlite3_bind_blob(
-            data, ++counter, value.c_str(), value.size(), SQLITE_STATIC);
+    if (SQLITE_OK != prepared) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to prepare " << sql
+              << ": " << sqlite3_errmsg(db_) << std::endl;
+        sqlite3_finalize(output);
+        statements_.erase(StatementKey{tablename, type});
 
-        OT_ASSERT(SQLITE_OK == bound);
+        return nullptr;
     }
 
-    sql << sqlite3_expanded_sql(data) << " ";
-    sqlite3_finalize(data);
-}
-
-void StorageSqlite3::set_root(
-    const std::string& rootHash,
-    std::stringstream& sql) const
-{
-    sqlite3_stmt* root{nullptr};
-    std::stringstream rootSQL{};
-    rootSQL << "INSERT OR REPLACE INTO '" << config_.sqlite3_control_table_
-            << "'  (k, v) VALUES (?1, ?2); ";
-    sqlite3_prepare_v2(db_, rootSQL.str().c_str(), -1, &root, 0);
-    auto bound = sqlite3_bind_text(
-        root,
-        1,
-        config_.sqlite3_root_key_.c_str(),
-        config_.sqlite3_root_key_.size(),
-        SQLITE_STATIC);
-
-    OT_ASSERT(SQLITE_OK == bound)
-
-    bound = sqlite3_bind_blob(
-        root, 2, rootHash.c_str(), rootHash.size(), SQLITE_STATIC);
-
-    OT_ASSERT(SQLITE_OK == bound)
-
-    sql << sqlite3_expanded_sql(root) << " ";
-    sqlite3_finalize(root);
-}
-
-void StorageSqlite3::start_transaction(std::stringstream& sql) const
-{
-    sql << "BEGIN TRANSACTION; ";
+    return output;
 }
 
 void StorageSqlite3::store(
@@ -323,6 +350,53 @@ void StorageSqlite3::store(
     }
 }
 
+void StorageSqlite3::store_batch(const WriteBatch& batch) const
+{
+    std::vector<bool> written(batch.size(), false);
+    std::vector<std::size_t> direct{};
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto& write = batch.at(i);
+
+        if (write.isTransaction_) {
+            Lock lock(transaction_lock_);
+            transaction_bucket_->Set(write.bucket_);
+            pending_.emplace_back(write.key_, write.value_);
+            written[i] = true;
+        } else {
+            direct.push_back(i);
+        }
+    }
+
+    if (false == direct.empty()) {
+        Lock lock(statement_lock_);
+        const bool transaction = exec(lock, "BEGIN TRANSACTION;");
+
+        for (const auto& i : direct) {
+            const auto& write = batch.at(i);
+            written[i] = upsert(
+                lock, write.key_, GetTableName(write.bucket_), write.value_);
+        }
+
+        if (transaction && (false == exec(lock, "COMMIT TRANSACTION;"))) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to commit batch: " << sqlite3_errmsg(db_)
+                  << std::endl;
+            exec(lock, "ROLLBACK TRANSACTION;");
+
+            for (const auto& i : direct) { written[i] = false; }
+        }
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto& promise = batch.at(i).promise_;
+
+        OT_ASSERT(nullptr != promise);
+
+        promise->set_value(written.at(i));
+    }
+}
+
 bool StorageSqlite3::StoreRoot(const bool commit, const std::string& hash) const
 {
     if (commit) {
@@ -340,16 +414,33 @@ bool StorageSqlite3::Upsert(
     const std::string& tablename,
     const std::string& value) const
 {
-    sqlite3_stmt* statement;
-    const std::string query =
-        "insert or replace into `" + tablename + "` (k, v) values (?1, ?2);";
-
-    sqlite3_prepare_v2(db_, query.c_str(), -1, &statement, 0);
-    sqlite3_bind_text(statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
-    sqlite3_bind_blob(statement, 2, value.c_str(), value.size(), SQLITE_STATIC);
-    otInfo << sqlite3_expanded_sql(statement) << std::endl;
-    const auto result = sqlite3_step(statement);
-    sqlite3_finalize(statement);
+    Lock lock(statement_lock_);
+
+    return upsert(lock, key, tablename, value);
+}
+
+bool StorageSqlite3::upsert(
+    const Lock& lock,
+    const std::string& key,
+    const std::string& tablename,
+    const std::string& value) const
+{
+    auto* statement = this->statement(lock, tablename, Query::Upsert);
+
+    if (nullptr == statement) { return false; }
+
+    auto result{SQLITE_ERROR};
+    const auto boundKey = sqlite3_bind_text(
+        statement, 1, key.c_str(), key.size(), SQLITE_STATIC);
+    const auto boundValue = sqlite3_bind_blob(
+        statement, 2, value.c_str(), value.size(), SQLITE_STATIC);
+
+    if ((SQLITE_OK == boundKey) && (SQLITE_OK == boundValue)) {
+        result = sqlite3_step(statement);
+    }
+
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
 
     return (result == SQLITE_DONE);
 }
@@ -46,6 +46,14 @@
 #include "opentxs/storage/tree/Mailbox.hpp"
 #include "opentxs/storage/Plugin.hpp"
 
+#include <algorithm>
+#include <iterator>
+
+// Version of the page index stored at the thread root
+#define PAGE_INDEX_VERSION 2
+// A page which grows past this size is split in half
+#define MAX_PAGE_ITEMS 64
+
 #define OT_METHOD "opentxs::storage::Thread::"
 
 namespace opentxs
@@ -65,6 +73,9 @@ Thread::Thread(
     , index_(0)
     , mail_inbox_(mailInbox)
     , mail_outbox_(mailOutbox)
+    , items_()
+    , pages_(1)
+    , unread_(0)
     , participants_()
 {
     if (check_hash(hash)) {
@@ -85,6 +96,9 @@ Thread::Thread(
     , id_(id)
     , mail_inbox_(mailInbox)
     , mail_outbox_(mailOutbox)
+    , items_()
+    , pages_(1)
+    , unread_(0)
     , participants_(participants)
 {
     version_ = 1;
@@ -133,6 +147,12 @@ bool Thread::Add(
         return false;
     }
 
+    auto existing = items_.find(id);
+
+    if (items_.end() != existing) {
+        erase(lock, existing->second);
+    }
+
     auto& item = items_[id];
     item.set_version(version_);
     item.set_id(id);
@@ -156,6 +176,8 @@ bool Thread::Add(
         return false;
     }
 
+    insert(lock, item);
+
     return save(lock);
 }
 
@@ -166,48 +188,223 @@ std::string Thread::Alias() const
     return alias_;
 }
 
+bool Thread::Check(const std::string& id) const
+{
+    Lock lock(write_lock_);
+
+    return items_.end() != items_.find(id);
+}
+
+void Thread::dirty_all(const Lock& lock)
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    for (auto& page : pages_) {
+        page.dirty_ = true;
+    }
+}
+
+void Thread::erase(const Lock& lock, const proto::StorageThreadItem& item)
+{
+    const auto key = sort_key(item);
+    auto page = find_page(lock, key);
+
+    if (0 == page->keys_.erase(key)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Item " << item.id()
+              << " is not in any page." << std::endl;
+
+        return;
+    }
+
+    if (item.unread()) {
+        --page->unread_;
+        --unread_;
+    }
+
+    page->dirty_ = true;
+
+    if (page->keys_.empty() && (1 < pages_.size())) {
+        pages_.erase(page);
+    }
+}
+
+std::vector<Thread::Page>::iterator Thread::find_page(
+    const Lock& lock,
+    const SortKey& key)
+{
+    OT_ASSERT(verify_write_lock(lock));
+    OT_ASSERT(false == pages_.empty());
+
+    // The first page which does not end before the key
+    auto output = std::lower_bound(
+        pages_.begin(),
+        pages_.end(),
+        key,
+        [](const Page& page, const SortKey& key) -> bool {
+            return page.keys_.empty() || (*page.keys_.rbegin() < key);
+        });
+
+    if (pages_.end() == output) {
+        output = std::prev(pages_.end());
+    }
+
+    return output;
+}
+
+std::string Thread::ID() const { return id_; }
+
 void Thread::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageThread> serialized;
-    driver_.LoadProto(hash, serialized);
+    Lock lock(write_lock_);
+    std::string raw{};
 
-    if (false == bool(serialized)) {
+    if (false == driver_.Load(hash, false, raw)) {
         otErr << OT_METHOD << __FUNCTION__
               << ": Failed to load thread index file." << std::endl;
         OT_FAIL;
     }
 
-    version_ = serialized->version();
+    proto::StorageNymList index;
+
+    // Threads written before items were paged keep every item in a single
+    // StorageThread, which does not parse as a page index. They are converted
+    // the next time they are saved.
+    if (index.ParseFromArray(raw.data(), raw.size()) &&
+        proto::Validate(index, SILENT)) {
+        init_index(lock, index);
+    } else {
+        proto::StorageThread serialized;
+        const bool parsed = serialized.ParseFromArray(raw.data(), raw.size());
+
+        if (false == (parsed && proto::Validate(serialized, VERBOSE))) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to load thread index file." << std::endl;
+            OT_FAIL;
+        }
+
+        init_items(lock, serialized);
+    }
+
+    upgrade(lock);
+}
+
+void Thread::init_index(const Lock& lock, const proto::StorageNymList& index)
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    pages_.clear();
+
+    for (const auto& it : index.nym()) {
+        std::shared_ptr<proto::StorageThread> serialized;
+        driver_.LoadProto(it.hash(), serialized);
+
+        if (false == bool(serialized)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to load page "
+                  << it.itemid() << std::endl;
+            OT_FAIL;
+        }
+
+        version_ = std::max(serialized->version(), std::uint32_t(1));
+
+        for (const auto& participant : serialized->participant()) {
+            participants_.emplace(participant);
+        }
+
+        pages_.emplace_back();
+        auto& page = pages_.back();
+        page.hash_ = it.hash();
+        page.dirty_ = false;
+
+        for (const auto& item : serialized->item()) {
+            const auto& index = item.index();
+            items_.emplace(item.id(), item);
+            page.keys_.emplace(sort_key(item));
+
+            if (item.unread()) {
+                ++page.unread_;
+                ++unread_;
+            }
+
+            if (index >= index_) {
+                index_ = index + 1;
+            }
+        }
+    }
+
+    if (pages_.empty()) {
+        pages_.emplace_back();
+    }
+}
+
+void Thread::init_items(
+    const Lock& lock,
+    const proto::StorageThread& serialized)
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    version_ = serialized.version();
 
     if (1 > version_) {
         version_ = 1;
     }
 
-    for (const auto& participant : serialized->participant()) {
+    for (const auto& participant : serialized.participant()) {
         participants_.emplace(participant);
     }
 
-    for (const auto& it : serialized->item()) {
+    for (const auto& it : serialized.item()) {
         const auto& index = it.index();
-        items_.emplace(it.id(), it);
+        auto inserted = items_.emplace(it.id(), it);
+
+        if (inserted.second) {
+            insert(lock, inserted.first->second);
+        }
 
         if (index >= index_) {
             index_ = index + 1;
         }
     }
-
-    Lock lock(write_lock_);
-    upgrade(lock);
 }
 
-bool Thread::Check(const std::string& id) const
+void Thread::insert(const Lock& lock, const proto::StorageThreadItem& item)
 {
-    Lock lock(write_lock_);
+    const auto key = sort_key(item);
+    auto page = find_page(lock, key);
+    const bool append = (std::next(page) == pages_.end()) &&
+                        (false == page->keys_.empty()) &&
+                        (*page->keys_.rbegin() < key);
+
+    // New items go to a fresh page instead of splitting a full last page
+    if (append && (MAX_PAGE_ITEMS <= page->keys_.size())) {
+        page = pages_.emplace(pages_.end());
+    }
 
-    return items_.end() != items_.find(id);
-}
+    page->keys_.emplace(key);
+    page->dirty_ = true;
 
-std::string Thread::ID() const { return id_; }
+    if (item.unread()) {
+        ++page->unread_;
+        ++unread_;
+    }
+
+    if (MAX_PAGE_ITEMS >= page->keys_.size()) {
+        return;
+    }
+
+    Page upper{};
+    auto middle = std::next(page->keys_.begin(), page->keys_.size() / 2);
+
+    for (auto it = middle; it != page->keys_.end(); ++it) {
+        if (items_.at(std::get<2>(*it)).unread()) {
+            ++upper.unread_;
+        }
+    }
+
+    upper.keys_.insert(middle, page->keys_.end());
+    page->keys_.erase(middle, page->keys_.end());
+    page->unread_ -= upper.unread_;
+    pages_.insert(std::next(page), std::move(upper));
+}
 
 proto::StorageThread Thread::Items() const
 {
@@ -216,9 +413,37 @@ proto::StorageThread Thread::Items() const
     return serialize(lock);
 }
 
+proto::StorageThread Thread::Items(const std::size_t page) const
+{
+    Lock lock(write_lock_);
+
+    if (page >= pages_.size()) {
+        return {};
+    }
+
+    return serialize(lock, pages_.at(page));
+}
+
 bool Thread::Migrate(const opentxs::api::storage::Driver& to) const
 {
-    return Node::migrate(root_, to);
+    Lock lock(write_lock_);
+    bool output = Node::migrate(root_, to);
+
+    for (const auto& page : pages_) {
+        // Pages which were never written are not referenced by the root
+        if (false == page.dirty_) {
+            output &= Node::migrate(page.hash_, to);
+        }
+    }
+
+    return output;
+}
+
+std::size_t Thread::Pages() const
+{
+    Lock lock(write_lock_);
+
+    return pages_.size();
 }
 
 bool Thread::Read(const std::string& id, const bool unread)
@@ -234,9 +459,7 @@ bool Thread::Read(const std::string& id, const bool unread)
         return false;
     }
 
-    auto& item = it->second;
-
-    item.set_unread(unread);
+    set_unread(lock, it->second, unread);
 
     return save(lock);
 }
@@ -253,6 +476,7 @@ bool Thread::Remove(const std::string& id)
 
     auto& item = it->second;
     StorageBox box = static_cast<StorageBox>(item.box());
+    erase(lock, item);
     items_.erase(it);
 
     switch (box) {
@@ -282,6 +506,9 @@ bool Thread::Rename(const std::string& newID)
         participants_.emplace(newID);
     }
 
+    // Every page carries the thread id and participants
+    dirty_all(lock);
+
     return save(lock);
 }
 
@@ -289,13 +516,34 @@ bool Thread::save(const Lock& lock) const
 {
     OT_ASSERT(verify_write_lock(lock));
 
-    auto serialized = serialize(lock);
+    proto::StorageNymList index;
+    index.set_version(PAGE_INDEX_VERSION);
+
+    for (auto& page : pages_) {
+        if (page.dirty_) {
+            auto serialized = serialize(lock, page);
+
+            if (!proto::Validate(serialized, VERBOSE)) {
+                return false;
+            }
+
+            if (false == driver_.StoreProto(serialized, page.hash_)) {
+                return false;
+            }
+
+            page.dirty_ = false;
+        }
 
-    if (!proto::Validate(serialized, VERBOSE)) {
+        // Pages have no id of their own, so they are listed by hash. The
+        // order of the entries is the order of the pages.
+        set_hash(PAGE_INDEX_VERSION, page.hash_, page.hash_, *index.add_nym());
+    }
+
+    if (!proto::Validate(index, VERBOSE)) {
         return false;
     }
 
-    return driver_.StoreProto(serialized, root_);
+    return driver_.StoreProto(index, root_);
 }
 
 proto::StorageThread Thread::serialize(const Lock& lock) const
@@ -312,13 +560,32 @@ proto::StorageThread Thread::serialize(const Lock& lock) const
         }
     }
 
-    auto sorted = sort(lock);
+    for (const auto& page : pages_) {
+        for (const auto& key : page.keys_) {
+            *serialized.add_item() = items_.at(std::get<2>(key));
+        }
+    }
+
+    return serialized;
+}
+
+proto::StorageThread Thread::serialize(const Lock& lock, const Page& page)
+    const
+{
+    OT_ASSERT(verify_write_lock(lock));
 
-    for (const auto& it : sorted) {
-        OT_ASSERT(nullptr != it.second);
+    proto::StorageThread serialized;
+    serialized.set_version(version_);
+    serialized.set_id(id_);
 
-        const auto& item = *it.second;
-        *serialized.add_item() = item;
+    for (const auto nym : participants_) {
+        if (!nym.empty()) {
+            *serialized.add_participant() = nym;
+        }
+    }
+
+    for (const auto& key : page.keys_) {
+        *serialized.add_item() = items_.at(std::get<2>(key));
     }
 
     return serialized;
@@ -333,39 +600,39 @@ bool Thread::SetAlias(const std::string& alias)
     return true;
 }
 
-Thread::SortedItems Thread::sort(const Lock& lock) const
+void Thread::set_unread(
+    const Lock& lock,
+    proto::StorageThreadItem& item,
+    const bool unread)
 {
-    OT_ASSERT(verify_write_lock(lock));
-
-    SortedItems output;
+    if (item.unread() == unread) {
+        return;
+    }
 
-    for (const auto& it : items_) {
-        const auto& id = it.first;
-        const auto& item = it.second;
+    auto page = find_page(lock, sort_key(item));
+    page->dirty_ = true;
 
-        if (!id.empty()) {
-            SortKey key{item.index(), item.time(), id};
-            output.emplace(key, &item);
-        }
+    if (unread) {
+        ++page->unread_;
+        ++unread_;
+    } else {
+        --page->unread_;
+        --unread_;
     }
 
-    return output;
+    item.set_unread(unread);
+}
+
+Thread::SortKey Thread::sort_key(const proto::StorageThreadItem& item)
+{
+    return SortKey{item.index(), item.time(), item.id()};
 }
 
 std::size_t Thread::UnreadCount() const
 {
     Lock lock(write_lock_);
-    std::size_t output{0};
-
-    for (const auto& it : items_) {
-        const auto& item = it.second;
 
-        if (item.unread()) {
-            ++output;
-        }
-    }
-
-    return output;
+    return unread_;
 }
 
 void Thread::upgrade(const Lock& lock)
@@ -382,7 +649,7 @@ void Thread::upgrade(const Lock& lock)
             case StorageBox::MAILOUTBOX:
             case StorageBox::OUTGOINGBLOCKCHAIN: {
                 if (item.unread()) {
-                    item.set_unread(false);
+                    set_unread(lock, item, false);
                     changed = true;
                 }
             } break;
@@ -0,0 +1,222 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/client/Sync.hpp"
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/network/ZMQ.hpp"
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/api/Settings.hpp"
+#include "opentxs/client/OTAPI_Exec.hpp"
+#include "opentxs/core/contract/ServerContract.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/ReplyCallback.hpp"
+#include "opentxs/network/zeromq/ReplySocket.hpp"
+#include "opentxs/network/zeromq/RouterCallback.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentxs;
+
+#define CONTEXT_COUNT 1000
+#define STALLED_PORT 17521
+#define RESPONSIVE_PORT 17522
+#define TIMEOUT_SECONDS 1
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+bool wait_for(const std::function<bool()>& done, const Clock::duration limit)
+{
+    const auto deadline = Clock::now() + limit;
+
+    while (Clock::now() < deadline) {
+        if (done()) { return true; }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return done();
+}
+
+std::string endpoint(const std::uint32_t port)
+{
+    return "tcp://127.0.0.1:" + std::to_string(port);
+}
+
+Identifier server_contract(
+    const std::string& nymID,
+    const std::string& name,
+    const std::uint32_t port)
+{
+    std::list<ServerContract::Endpoint> endpoints;
+    endpoints.push_back(ServerContract::Endpoint{proto::ADDRESSTYPE_IPV4,
+                                                 proto::PROTOCOLVERSION_LEGACY,
+                                                 "127.0.0.1",
+                                                 port,
+                                                 1});
+    const auto contract =
+        OT::App().Wallet().Server(nymID, name, "stand-in notary", endpoints);
+
+    if (false == bool(contract)) { return {}; }
+
+    return contract->ID();
+}
+
+// A notary which accepts requests and never answers them
+struct StalledNotary {
+    std::atomic<std::size_t> requests_{0};
+    OTZMQRouterCallback callback_;
+    OTZMQRouterSocket socket_;
+
+    StalledNotary()
+        : callback_(network::zeromq::RouterCallback::Factory(
+              [this](const Data&, const network::zeromq::Message&) -> void {
+                  ++requests_;
+              }))
+        , socket_(OT::App().ZMQ().Context().RouterSocket(callback_.get()))
+    {
+    }
+};
+
+// A notary which answers every request with an empty reply
+struct ResponsiveNotary {
+    std::atomic<std::size_t> requests_{0};
+    OTZMQReplyCallback callback_;
+    OTZMQReplySocket socket_;
+
+    ResponsiveNotary()
+        : callback_(network::zeromq::ReplyCallback::Factory(
+              [this](const network::zeromq::Message&) -> OTZMQMessage {
+                  ++requests_;
+
+                  return network::zeromq::Message::Factory();
+              }))
+        , socket_(OT::App().ZMQ().Context().ReplySocket(callback_.get()))
+    {
+    }
+};
+
+TEST(Test_Sync, thousand_contexts_on_stalled_notary)
+{
+    const auto& app = OT::App();
+    const auto& exec = app.API().Exec();
+    const auto& sync = app.API().Sync();
+    bool notUsed{false};
+    app.Config().Set_long(
+        String("latency"), String("send_timeout"), TIMEOUT_SECONDS, notUsed);
+    app.Config().Set_long(
+        String("latency"), String("recv_timeout"), TIMEOUT_SECONDS, notUsed);
+    app.ZMQ().RefreshConfig();
+
+    StalledNotary stalled;
+    ResponsiveNotary responsive;
+
+    ASSERT_TRUE(stalled.socket_->Start(endpoint(STALLED_PORT)));
+    ASSERT_TRUE(responsive.socket_->Start(endpoint(RESPONSIVE_PORT)));
+
+    const auto serverNym =
+        exec.CreateNymHD(proto::CITEMTYPE_SERVER, "notary", "", 0);
+
+    ASSERT_FALSE(serverNym.empty());
+
+    const auto stalledID =
+        server_contract(serverNym, "stalled", STALLED_PORT);
+    const auto responsiveID =
+        server_contract(serverNym, "responsive", RESPONSIVE_PORT);
+
+    ASSERT_FALSE(stalledID.empty());
+    ASSERT_FALSE(responsiveID.empty());
+
+    std::vector<Identifier> nyms{};
+
+    for (std::uint32_t i = 1; i <= CONTEXT_COUNT; ++i) {
+        const auto nymID = exec.CreateNymHD(
+            proto::CITEMTYPE_INDIVIDUAL, "nym " + std::to_string(i), "", i);
+
+        ASSERT_FALSE(nymID.empty());
+
+        nyms.emplace_back(nymID);
+    }
+
+    const auto start = Clock::now();
+
+    for (const auto& nymID : nyms) {
+        EXPECT_FALSE(sync.ScheduleDownloadNymbox(nymID, stalledID).empty());
+    }
+
+    // Every context needs the stalled notary before it can do anything else
+    ASSERT_TRUE(wait_for(
+        [&]() { return 0 < stalled.requests_.load(); },
+        std::chrono::seconds(5)));
+
+    // A context on another server must not wait for the stalled contexts
+    EXPECT_FALSE(
+        sync.ScheduleDownloadNymbox(nyms.front(), responsiveID).empty());
+    EXPECT_TRUE(wait_for(
+        [&]() { return 0 < responsive.requests_.load(); },
+        std::chrono::seconds(3 * TIMEOUT_SECONDS)));
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - start);
+    std::cout << CONTEXT_COUNT << " contexts, responsive notary reached after "
+              << elapsed.count() << " ms" << std::endl;
+
+    // Once the first request times out the other contexts leave the stalled
+    // notary alone instead of each waiting for their own timeout
+    std::this_thread::sleep_for(std::chrono::seconds(3 * TIMEOUT_SECONDS));
+
+    EXPECT_GT(std::size_t{CONTEXT_COUNT / 10}, stalled.requests_.load());
+}
+}  // namespace
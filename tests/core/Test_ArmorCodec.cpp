@@ -0,0 +1,301 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/crypto/ArmorCodec.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+const std::string MESSAGE(
+    "<notaryMessage requestNum=\"42\" "
+    "nymID=\"ot2xuVPJDdweZvKLQD42UMCzhCmT3okn3W1PktLgCbmQLRnaKy848sX\">"
+    "hello</notaryMessage>\n");
+// MESSAGE as armored by the previous zlib + base64 + BreakLines pipeline
+const std::string LEGACY_ARMOR(
+    "eNqzycsvSSyq9E0tLk5MT1UoSi0sTS0u8SvNtVUyMVJSyKvM9XSxVcovMaooDQvwckkpT40q\n"
+    "8/YJdDExCvV1rspwzg0xzs/OMw43DMgu8Ul3TsoN9AnKS/SutDCxKI5QsstIzcnJt9FHscSO\n"
+    "CwBu6CiG\n");
+
+std::string base64(const std::string& input, bool lineBreaks = false)
+{
+    std::string output;
+    ArmorCodec::Base64Encode(
+        input.data(), input.size(), lineBreaks, output);
+
+    return output;
+}
+
+std::string unbase64(const std::string& input)
+{
+    std::string output;
+    ArmorCodec::Base64Decode(input.data(), input.size(), output);
+
+    return output;
+}
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Something shaped like a serialized ledger: repetitive markup with
+// varying numbers and base64 blobs
+std::string ledger(const std::size_t size)
+{
+    std::string output;
+    std::uint64_t state{88172645463325252ULL};
+
+    while (output.size() < size) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        output += "<transaction type=\"pending\" number=\"" +
+                  std::to_string(state % 10000000) + "\" inReferenceTo=\"" +
+                  std::to_string(state % 1000) + "\">\n" +
+                  base64(std::string(
+                      reinterpret_cast<const char*>(&state), sizeof(state))) +
+                  "\n</transaction>\n";
+    }
+
+    output.resize(size);
+
+    return output;
+}
+
+TEST(ArmorCodec, base64_vectors)
+{
+    EXPECT_EQ("", base64(""));
+    EXPECT_EQ("Zg==", base64("f"));
+    EXPECT_EQ("Zm8=", base64("fo"));
+    EXPECT_EQ("Zm9v", base64("foo"));
+    EXPECT_EQ("Zm9vYg==", base64("foob"));
+    EXPECT_EQ("Zm9vYmE=", base64("fooba"));
+    EXPECT_EQ("Zm9vYmFy", base64("foobar"));
+    EXPECT_EQ("+/+/", base64("\xfb\xff\xbf"));
+
+    EXPECT_EQ("f", unbase64("Zg=="));
+    EXPECT_EQ("fo", unbase64("Zm8="));
+    EXPECT_EQ("foobar", unbase64("Zm9vYmFy"));
+    EXPECT_EQ("\xfb\xff\xbf", unbase64("+/+/"));
+}
+
+TEST(ArmorCodec, line_breaks)
+{
+    const std::string input(200, 'x');
+    const auto encoded = base64(input, true);
+
+    ASSERT_EQ(ArmorCodec::EncodedSize(input.size(), false) + 4, encoded.size());
+    EXPECT_EQ('\n', encoded[ArmorCodec::LineWidth]);
+    EXPECT_EQ('\n', encoded[2 * (ArmorCodec::LineWidth + 1) - 1]);
+    EXPECT_EQ('\n', encoded.back());
+    EXPECT_EQ(input, unbase64(encoded));
+
+    // Exactly one line ends with a single newline
+    const auto line = base64(std::string(54, 'y'), true);
+    EXPECT_EQ(ArmorCodec::LineWidth + 1, line.size());
+    EXPECT_EQ(ArmorCodec::LineWidth, line.find('\n'));
+}
+
+TEST(ArmorCodec, decode_skips_noise)
+{
+    EXPECT_EQ("foobar", unbase64("  Zm9v\r\nYm\tFy\n"));
+    EXPECT_EQ("foob", unbase64("Zm9vYg==ignored"));
+    EXPECT_EQ("fo", unbase64("Zm8"));
+
+    std::string output;
+    EXPECT_FALSE(ArmorCodec::Base64Decode("\n\n", 2, output));
+}
+
+TEST(ArmorCodec, legacy_armor)
+{
+    std::string decoded;
+
+    ASSERT_TRUE(ArmorCodec::Decode(
+        LEGACY_ARMOR.data(), LEGACY_ARMOR.size(), decoded));
+    EXPECT_EQ(MESSAGE, decoded);
+
+    std::string encoded;
+
+    ASSERT_TRUE(ArmorCodec::Encode(
+        MESSAGE.data(),
+        MESSAGE.size(),
+        ArmorCodec::BestCompression,
+        true,
+        encoded));
+    EXPECT_EQ(LEGACY_ARMOR, encoded);
+}
+
+TEST(ArmorCodec, round_trip)
+{
+    const std::vector<std::int32_t> levels{
+        ArmorCodec::FastCompression, ArmorCodec::BestCompression};
+
+    for (const auto size :
+         {1, 2, 3, 53, 54, 55, 4095, 27648, 27649, 100000, 1000000}) {
+        const auto input = ledger(size);
+
+        for (const auto level : levels) {
+            for (const auto lineBreaks : {true, false}) {
+                std::string encoded;
+                std::string decoded;
+
+                ASSERT_TRUE(ArmorCodec::Encode(
+                    input.data(), input.size(), level, lineBreaks, encoded));
+                ASSERT_TRUE(ArmorCodec::Decode(
+                    encoded.data(), encoded.size(), decoded));
+                EXPECT_EQ(input, decoded);
+                EXPECT_EQ(
+                    lineBreaks, std::string::npos != encoded.find('\n'));
+            }
+        }
+
+        EXPECT_EQ(input, unbase64(base64(input, true)));
+    }
+}
+
+TEST(ArmorCodec, rejects_damage)
+{
+    const auto input = ledger(10000);
+    std::string encoded;
+    std::string decoded;
+
+    ASSERT_TRUE(ArmorCodec::Encode(
+        input.data(),
+        input.size(),
+        ArmorCodec::BestCompression,
+        true,
+        encoded));
+
+    const auto truncated = encoded.substr(0, encoded.size() / 2);
+    EXPECT_FALSE(
+        ArmorCodec::Decode(truncated.data(), truncated.size(), decoded));
+    EXPECT_TRUE(decoded.empty());
+
+    auto corrupt = encoded;
+    corrupt[10] = ('A' == corrupt[10]) ? 'B' : 'A';
+    corrupt[11] = ('A' == corrupt[11]) ? 'B' : 'A';
+    EXPECT_FALSE(ArmorCodec::Decode(corrupt.data(), corrupt.size(), decoded));
+
+    EXPECT_FALSE(ArmorCodec::Decode("", 0, decoded));
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(ArmorCodec, DISABLED_codec_benchmark)
+{
+    const int bytesPerSize{16 * 1024 * 1024};
+    std::int64_t bestTotal{0};
+    std::int64_t fastTotal{0};
+
+    for (const std::size_t size : {1024, 16 * 1024, 256 * 1024, 1024 * 1024}) {
+        const auto input = ledger(size);
+        const auto rounds = std::max<std::size_t>(1, bytesPerSize / size);
+
+        for (const auto level :
+             {ArmorCodec::BestCompression, ArmorCodec::FastCompression}) {
+            std::string encoded;
+            std::string decoded;
+            auto start = std::chrono::steady_clock::now();
+
+            for (std::size_t i = 0; i < rounds; ++i) {
+                ArmorCodec::Encode(
+                    input.data(), input.size(), level, true, encoded);
+            }
+
+            const auto encodeTime = elapsed(start);
+            start = std::chrono::steady_clock::now();
+
+            for (std::size_t i = 0; i < rounds; ++i) {
+                ArmorCodec::Decode(encoded.data(), encoded.size(), decoded);
+            }
+
+            const auto decodeTime = elapsed(start);
+
+            ASSERT_EQ(input, decoded);
+
+            if (ArmorCodec::BestCompression == level) {
+                bestTotal += encodeTime;
+            } else {
+                fastTotal += encodeTime;
+            }
+
+            std::cout << size << " byte message at level " << level << ": "
+                      << encoded.size() << " bytes armored, "
+                      << (encodeTime / rounds) << " us to encode, "
+                      << (decodeTime / rounds) << " us to decode.\n";
+        }
+    }
+
+    std::cout << "Total encode time: " << bestTotal << " us at level "
+              << ArmorCodec::BestCompression << ", " << fastTotal
+              << " us at level " << ArmorCodec::FastCompression << ".\n";
+
+    const std::string raw = ledger(1024 * 1024);
+    std::string encoded;
+    std::string decoded;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 16; ++i) {
+        ArmorCodec::Base64Encode(raw.data(), raw.size(), true, encoded);
+    }
+
+    const auto encodeTime = elapsed(start);
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 16; ++i) {
+        ArmorCodec::Base64Decode(encoded.data(), encoded.size(), decoded);
+    }
+
+    const auto decodeTime = elapsed(start);
+
+    ASSERT_EQ(raw, decoded);
+    std::cout << "base64 of 16 MiB: " << encodeTime << " us to encode, "
+              << decodeTime << " us to decode.\n";
+}
+}  // namespace
@@ -0,0 +1,138 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/util/BoundedQueue.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+TEST(BoundedQueue, capacity)
+{
+    BoundedQueue<int> one(1);
+    BoundedQueue<int> thousand(1000);
+    BoundedQueue<int> exact(1024);
+
+    EXPECT_EQ(2, one.Capacity());
+    EXPECT_EQ(1024, thousand.Capacity());
+    EXPECT_EQ(1024, exact.Capacity());
+}
+
+TEST(BoundedQueue, full)
+{
+    BoundedQueue<std::string> queue(4);
+    std::string item;
+
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.Pop(item));
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.Push(std::to_string(i)));
+    }
+
+    std::string rejected("rejected");
+    EXPECT_FALSE(queue.Push(std::move(rejected)));
+    // A failed push leaves the item with the caller.
+    EXPECT_EQ("rejected", rejected);
+
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.Pop(item));
+            EXPECT_EQ(std::to_string(lap * 4 + i), item);
+            ASSERT_TRUE(queue.Push(std::to_string((lap + 1) * 4 + i)));
+        }
+    }
+
+    EXPECT_FALSE(queue.Empty());
+}
+
+TEST(BoundedQueue, producers)
+{
+    const int producers = 4;
+    const int count = 100000;
+    BoundedQueue<std::int64_t> queue(256);
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+
+    for (int producer = 0; producer < producers; ++producer) {
+        threads.emplace_back([&queue, &finished, producer, count]() {
+            for (std::int64_t i = 0; i < count; ++i) {
+                std::int64_t item = (std::int64_t(producer) << 32) | i;
+
+                while (false == queue.Push(std::move(item))) {
+                    std::this_thread::yield();
+                }
+            }
+
+            ++finished;
+        });
+    }
+
+    // Items from any one producer must arrive in the order it pushed them.
+    std::vector<std::int64_t> next(producers, 0);
+    std::int64_t received{0};
+    std::int64_t item{0};
+
+    while ((producers != finished.load()) || (false == queue.Empty())) {
+        if (false == queue.Pop(item)) {
+            std::this_thread::yield();
+
+            continue;
+        }
+
+        const auto producer = static_cast<std::size_t>(item >> 32);
+        ASSERT_LT(producer, next.size());
+        ASSERT_EQ(next[producer], item & 0xffffffff);
+        ++next[producer];
+        ++received;
+    }
+
+    for (auto& thread : threads) { thread.join(); }
+
+    EXPECT_EQ(producers * count, received);
+}
+}  // namespace
@@ -42,6 +42,7 @@
 #include "gtest/gtest-message.h"
 #include "gtest/gtest-test-part.h"
 #include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
 
 using namespace opentxs;
 
@@ -122,3 +123,19 @@ TEST(Data, copy_from_interface)
         other->GetPointer()), other->GetSize());
     ASSERT_EQ(value, "abcd");
 }
+
+TEST(Data, swap_with_identifier)
+{
+    auto one = Data::Factory("abcd", 4);
+    Identifier id;
+    id.Assign("wxyz", 4);
+    one->swap(std::move(id));
+    std::string value(
+        static_cast<const char*>(
+        one->GetPointer()), one->GetSize());
+    ASSERT_EQ(value, "wxyz");
+    std::string swapped(
+        static_cast<const char*>(
+        id.GetPointer()), id.GetSize());
+    ASSERT_EQ(swapped, "abcd");
+}
@@ -0,0 +1,258 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/trade/OfferBook.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+struct Offer {
+    std::int64_t number_{0};
+    std::int64_t price_{0};
+};
+
+typedef OfferBook<Offer, std::greater<std::int64_t>> Bids;
+typedef OfferBook<Offer, std::less<std::int64_t>> Asks;
+
+// The structure OTMarket used before price levels: a multimap keyed by price
+// which had to be scanned to find an offer by transaction number.
+class MultimapBook
+{
+public:
+    void Add(const std::int64_t price, Offer& offer)
+    {
+        offers_.insert(offers_.upper_bound(price), {price, &offer});
+    }
+
+    Offer* Remove(const std::int64_t number)
+    {
+        for (auto it = offers_.begin(); it != offers_.end(); ++it) {
+            if (number == it->second->number_) {
+                auto* output = it->second;
+                offers_.erase(it);
+
+                return output;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::int64_t BestPrice() const
+    {
+        if (offers_.empty()) { return 0; }
+
+        return offers_.rbegin()->first;
+    }
+
+private:
+    std::multimap<std::int64_t, Offer*> offers_;
+};
+
+const std::size_t operations_{1000000};
+const std::size_t depth_{1000};
+
+std::vector<Offer> make_offers()
+{
+    std::vector<Offer> output(operations_);
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<std::int64_t> price(900, 1100);
+    std::int64_t number{0};
+
+    for (auto& offer : output) {
+        offer.number_ = ++number;
+        offer.price_ = price(random);
+    }
+
+    return output;
+}
+
+// Keeps depth_ offers live, cancelling a random live offer for every add.
+template <class Book>
+std::chrono::milliseconds replay(
+    std::vector<Offer>& offers,
+    Book& book,
+    void (*add)(Book&, Offer&),
+    std::int64_t& checksum)
+{
+    std::mt19937_64 random(7);
+    std::deque<std::int64_t> live;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto& offer : offers) {
+        add(book, offer);
+        live.push_back(offer.number_);
+
+        if (depth_ < live.size()) {
+            const auto index = random() % live.size();
+            auto* removed = book.Remove(live[index]);
+            live.erase(live.begin() + index);
+            checksum += removed->number_ + book.BestPrice();
+        }
+    }
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+}  // namespace
+
+TEST(OfferBook, empty)
+{
+    Bids bids;
+
+    ASSERT_TRUE(bids.empty());
+    ASSERT_EQ(bids.size(), 0);
+    ASSERT_EQ(bids.BestPrice(), 0);
+    ASSERT_TRUE(bids.begin() == bids.end());
+    ASSERT_EQ(bids.Remove(1), nullptr);
+}
+
+TEST(OfferBook, bids_best_price_first)
+{
+    Offer one{1, 100}, two{2, 300}, three{3, 200}, market{4, 0};
+    Bids bids;
+
+    ASSERT_TRUE(bids.Add(one.number_, one.price_, one));
+    ASSERT_TRUE(bids.Add(two.number_, two.price_, two));
+    ASSERT_TRUE(bids.Add(three.number_, three.price_, three));
+    ASSERT_TRUE(bids.Add(market.number_, market.price_, market));
+    ASSERT_FALSE(bids.Add(one.number_, one.price_, one));
+    ASSERT_EQ(bids.size(), 4);
+    ASSERT_EQ(bids.BestPrice(), 300);
+
+    std::vector<std::int64_t> order;
+
+    for (auto* offer : bids) { order.push_back(offer->number_); }
+
+    ASSERT_EQ(order, std::vector<std::int64_t>({2, 3, 1, 4}));
+}
+
+TEST(OfferBook, asks_skip_market_orders)
+{
+    Offer market{1, 0}, low{2, 50}, high{3, 70};
+    Asks asks;
+
+    asks.Add(market.number_, market.price_, market);
+    asks.Add(high.number_, high.price_, high);
+    asks.Add(low.number_, low.price_, low);
+
+    ASSERT_EQ(asks.BestPrice(), 0);
+    ASSERT_EQ(asks.BestPrice(true), 50);
+    ASSERT_EQ(*asks.Best(true), &low);
+    ASSERT_EQ(*asks.begin(), &market);
+}
+
+TEST(OfferBook, fifo_within_price)
+{
+    std::vector<Offer> offers{{1, 10}, {2, 10}, {3, 20}, {4, 10}};
+    Asks asks;
+
+    for (auto& offer : offers) {
+        asks.Add(offer.number_, offer.price_, offer);
+    }
+
+    std::vector<std::int64_t> order;
+
+    for (auto it = asks.begin(); it != asks.end(); ++it) {
+        order.push_back((*it)->number_);
+    }
+
+    ASSERT_EQ(order, std::vector<std::int64_t>({1, 2, 4, 3}));
+}
+
+TEST(OfferBook, remove)
+{
+    std::vector<Offer> offers{{1, 10}, {2, 10}, {3, 20}};
+    Bids bids;
+
+    for (auto& offer : offers) {
+        bids.Add(offer.number_, offer.price_, offer);
+    }
+
+    ASSERT_EQ(bids.Remove(3), &offers[2]);
+    ASSERT_EQ(bids.Remove(3), nullptr);
+    ASSERT_EQ(bids.BestPrice(), 10);
+    ASSERT_EQ(bids.Remove(1), &offers[0]);
+    ASSERT_EQ(*bids.begin(), &offers[1]);
+    ASSERT_EQ(bids.size(), 1);
+
+    bids.clear();
+
+    ASSERT_TRUE(bids.empty());
+    ASSERT_TRUE(bids.begin() == bids.end());
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(OfferBook, DISABLED_benchmark)
+{
+    auto offers = make_offers();
+    std::int64_t oldChecksum{0};
+    std::int64_t newChecksum{0};
+    MultimapBook oldBook;
+    Bids newBook;
+    const auto oldTime = replay<MultimapBook>(
+        offers,
+        oldBook,
+        [](MultimapBook& book, Offer& offer) { book.Add(offer.price_, offer); },
+        oldChecksum);
+    const auto newTime = replay<Bids>(
+        offers,
+        newBook,
+        [](Bids& book, Offer& offer) {
+            book.Add(offer.number_, offer.price_, offer);
+        },
+        newChecksum);
+
+    std::cout << "multimap book: " << oldTime.count() << " ms" << std::endl;
+    std::cout << "price level book: " << newTime.count() << " ms" << std::endl;
+
+    ASSERT_EQ(oldChecksum, newChecksum);
+}
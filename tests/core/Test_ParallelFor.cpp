@@ -0,0 +1,117 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/util/ParallelFor.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+TEST(ParallelFor, every_index_once)
+{
+    const std::size_t count = 10000;
+    std::vector<std::atomic<int>> calls(count);
+
+    for (auto& call : calls) { call.store(0); }
+
+    ParallelFor(count, 16, [&](const std::size_t i) -> void { ++calls[i]; });
+
+    for (const auto& call : calls) { EXPECT_EQ(1, call.load()); }
+}
+
+TEST(ParallelFor, empty)
+{
+    std::atomic<int> calls{0};
+    ParallelFor(0, 16, [&](const std::size_t) -> void { ++calls; });
+
+    EXPECT_EQ(0, calls.load());
+}
+
+TEST(ParallelFor, small_jobs_stay_on_caller)
+{
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> elsewhere{0};
+    ParallelFor(8, 8, [&](const std::size_t) -> void {
+        if (caller != std::this_thread::get_id()) { ++elsewhere; }
+    });
+
+    EXPECT_EQ(0, elsewhere.load());
+}
+
+TEST(ParallelFor, nested)
+{
+    const std::size_t count = 64;
+    std::vector<std::atomic<int>> calls(count * count);
+
+    for (auto& call : calls) { call.store(0); }
+
+    ParallelFor(count, 1, [&](const std::size_t i) -> void {
+        ParallelFor(count, 1, [&](const std::size_t j) -> void {
+            ++calls[i * count + j];
+        });
+    });
+
+    for (const auto& call : calls) { EXPECT_EQ(1, call.load()); }
+}
+
+TEST(ParallelFor, shared_workers)
+{
+    std::mutex lock;
+    std::set<std::thread::id> threads;
+
+    for (int i = 0; i < 100; ++i) {
+        ParallelFor(64, 1, [&](const std::size_t) -> void {
+            std::lock_guard<std::mutex> guard(lock);
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+
+    // The caller plus the shared workers, however many calls are made
+    EXPECT_LE(threads.size(), ParallelExecutor().Threads() + 1);
+}
+}  // namespace
@@ -0,0 +1,296 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/util/Executor.hpp"
+#include "opentxs/core/util/ScheduledTask.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = Executor::Clock;
+
+/** Stand-in for a notary: every nym's first registration attempt fails and
+ *  every request takes a little while to answer */
+class Notary
+{
+public:
+    bool Register(const std::size_t nym)
+    {
+        const auto attempt = request();
+        std::lock_guard<std::mutex> lock(lock_);
+
+        return (1 < ++attempts_[nym]) && attempt;
+    }
+
+    bool Process(const std::size_t)
+    {
+        const auto output = request();
+        ++processed_;
+
+        return output;
+    }
+
+    std::size_t MaxConcurrent() const { return max_concurrent_.load(); }
+    std::size_t Processed() const { return processed_.load(); }
+
+private:
+    std::mutex lock_{};
+    std::map<std::size_t, int> attempts_{};
+    std::atomic<std::size_t> concurrent_{0};
+    std::atomic<std::size_t> max_concurrent_{0};
+    std::atomic<std::size_t> processed_{0};
+
+    bool request()
+    {
+        const std::size_t now = ++concurrent_;
+        std::size_t max = max_concurrent_.load();
+
+        while ((now > max) &&
+               (false == max_concurrent_.compare_exchange_weak(max, now))) {
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        --concurrent_;
+
+        return true;
+    }
+};
+
+/** Same shape as a client Sync context: register first, then drain the
+ *  operation queue, backing off with long timers in between */
+struct Context {
+    const std::size_t nym_;
+    Notary& notary_;
+    std::mutex lock_{};
+    std::deque<int> queue_{};
+    bool registered_{false};
+    std::unique_ptr<ScheduledTask> task_{nullptr};
+
+    ScheduledTask::Duration pass()
+    {
+        if (false == registered_) {
+            registered_ = notary_.Register(nym_);
+
+            if (false == registered_) { return std::chrono::seconds(10); }
+        }
+
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(lock_);
+
+                if (queue_.empty()) { break; }
+
+                queue_.pop_front();
+            }
+
+            notary_.Process(nym_);
+        }
+
+        return std::chrono::seconds(5);
+    }
+
+    void Schedule()
+    {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            queue_.push_back(0);
+        }
+
+        task_->Trigger();
+    }
+
+    Context(const Executor& executor, const std::size_t nym, Notary& notary)
+        : nym_(nym)
+        , notary_(notary)
+    {
+        task_.reset(new ScheduledTask(executor, [this]() { return pass(); }));
+    }
+};
+
+bool wait_for(const std::function<bool()>& done, const Clock::duration limit)
+{
+    const auto deadline = Clock::now() + limit;
+
+    while (Clock::now() < deadline) {
+        if (done()) { return true; }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return done();
+}
+
+TEST(Executor, timers_fire_in_deadline_order)
+{
+    Executor executor(1);
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&](const int value) {
+        return [&, value]() {
+            std::lock_guard<std::mutex> guard(lock);
+            order.push_back(value);
+        };
+    };
+
+    executor.PostAfter(std::chrono::milliseconds(60), record(3));
+    executor.PostAfter(std::chrono::milliseconds(20), record(2));
+    executor.Post(record(1));
+
+    ASSERT_TRUE(wait_for(
+        [&]() {
+            std::lock_guard<std::mutex> guard(lock);
+            return 3 == order.size();
+        },
+        std::chrono::seconds(5)));
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), order);
+}
+
+TEST(Executor, stop_discards_pending_timers)
+{
+    std::atomic<int> ran{0};
+
+    {
+        Executor executor(2);
+        executor.PostAfter(std::chrono::hours(1), [&]() { ++ran; });
+        EXPECT_EQ(1, executor.Queued());
+        executor.Stop();
+        EXPECT_EQ(0, executor.Queued());
+    }
+
+    EXPECT_EQ(0, ran.load());
+}
+
+TEST(ScheduledTask, trigger_during_pass_is_not_lost)
+{
+    Executor executor(4);
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    std::atomic<int> passes{0};
+    ScheduledTask task(executor, [&]() -> ScheduledTask::Duration {
+        if (1 < ++running) { overlapped = true; }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --running;
+        ++passes;
+
+        return ScheduledTask::Idle();
+    });
+
+    // Lands while the first pass sleeps
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    for (int i = 0; i < 10; ++i) { task.Trigger(); }
+
+    ASSERT_TRUE(wait_for(
+        [&]() { return 2 <= passes.load(); }, std::chrono::seconds(5)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_EQ(2, passes.load());
+}
+
+TEST(ScheduledTask, timer_starts_next_pass)
+{
+    Executor executor(1);
+    std::atomic<int> passes{0};
+    ScheduledTask task(executor, [&]() -> ScheduledTask::Duration {
+        ++passes;
+
+        return std::chrono::milliseconds(10);
+    });
+
+    EXPECT_TRUE(wait_for(
+        [&]() { return 5 <= passes.load(); }, std::chrono::seconds(5)));
+}
+
+TEST(ScheduledTask, thousand_contexts_on_shared_executor)
+{
+    const std::size_t contexts{1000};
+    const std::size_t threads{4};
+    Notary notary;
+    Executor executor(threads);
+    std::vector<std::unique_ptr<Context>> list;
+
+    for (std::size_t i = 0; i < contexts; ++i) {
+        list.emplace_back(new Context(executor, i, notary));
+    }
+
+    // Every first registration attempt fails, which puts every context on a
+    // ten second backoff timer.
+    ASSERT_TRUE(wait_for(
+        [&]() {
+            return std::all_of(list.begin(), list.end(), [](const auto& c) {
+                return 1 == c->task_->Passes();
+            });
+        },
+        std::chrono::seconds(10)));
+
+    const auto start = Clock::now();
+
+    for (auto& context : list) { context->Schedule(); }
+
+    // Scheduled work must not wait for the backoff timers to expire
+    ASSERT_TRUE(wait_for(
+        [&]() { return contexts == notary.Processed(); },
+        std::chrono::seconds(5)));
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - start);
+    std::cout << contexts << " contexts on " << threads
+              << " threads: " << elapsed.count() << " ms" << std::endl;
+
+    EXPECT_LE(notary.MaxConcurrent(), threads);
+
+    list.clear();
+}
+}  // namespace
@@ -0,0 +1,250 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/script/OTScript.hpp"
+#include "opentxs/core/script/OTScriptPool.hpp"
+#include "opentxs/core/script/OTSmartContract.hpp"
+#include "opentxs/core/script/OTVariable.hpp"
+
+#if OT_SCRIPT_CHAI
+using namespace opentxs;
+
+namespace
+{
+const std::string LANGUAGE{"chai"};
+// Roughly the size of a typical clause: some arithmetic on a bylaw variable.
+const std::string CLAUSE{
+    "var total = 0\n"
+    "for (var i = 0; i < 10; ++i) { total += i }\n"
+    "counter = counter + total\n"
+    "counter > 0\n"};
+
+bool run(OTScript& script, OTVariable& counter)
+{
+    OTVariable result("result", false);
+    counter.RegisterForExecution(script);
+
+    return script.ExecuteScript(&result) && result.CopyValueBool();
+}
+}  // namespace
+
+TEST(OTScriptPool, reuse)
+{
+    OTScriptPool pool(LANGUAGE, OTSmartContract::RegisterPooledNativeCalls, 2);
+    OTVariable counter("counter", 0);
+
+    for (int i = 0; i < 3; ++i) {
+        auto script = pool.Get();
+
+        ASSERT_TRUE(bool(script));
+
+        script->SetScript(CLAUSE);
+
+        EXPECT_TRUE(run(*script, counter));
+    }
+
+    EXPECT_EQ(135, counter.CopyValueInteger());
+    EXPECT_EQ(1u, pool.Created());
+    EXPECT_EQ(1u, pool.Idle());
+
+    {
+        auto first = pool.Get();
+        auto second = pool.Get();
+        auto third = pool.Get();
+    }
+
+    EXPECT_EQ(3u, pool.Created());
+    EXPECT_EQ(2u, pool.Idle());
+}
+
+TEST(OTScriptPool, reset)
+{
+    OTScriptPool pool(LANGUAGE, OTSmartContract::RegisterPooledNativeCalls, 1);
+    OTVariable counter("counter", 0);
+
+    {
+        auto script = pool.Get();
+        script->SetScript("def leak() { 1 }\nvar leaked = 2\ntrue\n");
+
+        EXPECT_TRUE(script->ExecuteScript());
+    }
+
+    // Definitions made by an earlier execution must not be visible, and
+    // repeating them must not collide with what is left over.
+    {
+        auto script = pool.Get();
+        script->SetScript("leak() + leaked\n");
+
+        EXPECT_FALSE(script->ExecuteScript());
+    }
+
+    {
+        auto script = pool.Get();
+        script->SetScript("def leak() { 1 }\nvar leaked = 2\ntrue\n");
+
+        EXPECT_TRUE(script->ExecuteScript());
+    }
+
+    // Registered variables are forgotten when the interpreter is returned
+    {
+        auto script = pool.Get();
+        script->SetScript(CLAUSE);
+
+        EXPECT_TRUE(run(*script, counter));
+    }
+
+    {
+        auto script = pool.Get();
+        script->SetScript(CLAUSE);
+
+        EXPECT_FALSE(script->ExecuteScript());
+        EXPECT_EQ(nullptr, script->FindVariable("counter"));
+    }
+
+    EXPECT_EQ(1u, pool.Created());
+}
+
+// Pooled interpreters, which reuse parsed clauses, must give a clause the
+// same results as a new interpreter set up by RegisterOTNativeCallsWithScript
+TEST(OTScriptPool, same_results)
+{
+    typedef std::tuple<bool, std::int32_t, std::string, bool> Outcome;
+
+    const std::string clause{
+        "amount = amount * 2\n"
+        "memo = memo + \"-paid\"\n"
+        "flag = !flag\n"
+        "if (amount > 100) { return false }\n"
+        "return flag\n"};
+    OTScriptPool pool(LANGUAGE, OTSmartContract::RegisterPooledNativeCalls, 1);
+    OTSmartContract contract;
+    std::vector<Outcome> outcomes[2]{};
+
+    for (const auto pooled : {false, true}) {
+        OTVariable amount("amount", 30);
+        OTVariable memo("memo", std::string("invoice"));
+        OTVariable flag("flag", false);
+        // Added to the last run only, which moves the other variables
+        OTVariable extra("a_extra", 0);
+
+        for (int i = 0; i < 3; ++i) {
+            std::shared_ptr<OTScript> script{nullptr};
+
+            if (pooled) {
+                script = pool.Get();
+            } else {
+                script = OTScriptFactory(LANGUAGE);
+
+                ASSERT_TRUE(bool(script));
+
+                contract.RegisterOTNativeCallsWithScript(*script);
+            }
+
+            ASSERT_TRUE(bool(script));
+
+            script->SetScript(clause);
+
+            if (2 == i) { extra.RegisterForExecution(*script); }
+
+            amount.RegisterForExecution(*script);
+            memo.RegisterForExecution(*script);
+            flag.RegisterForExecution(*script);
+            OTVariable result("result", false);
+
+            EXPECT_TRUE(script->ExecuteScript(&result));
+
+            outcomes[pooled].emplace_back(
+                result.CopyValueBool(),
+                amount.CopyValueInteger(),
+                memo.CopyValueString(),
+                flag.CopyValueBool());
+        }
+    }
+
+    EXPECT_EQ(1u, pool.Created());
+    ASSERT_EQ(3u, outcomes[0].size());
+    EXPECT_EQ(Outcome(true, 60, "invoice-paid", true), outcomes[0][0]);
+    EXPECT_EQ(Outcome(false, 120, "invoice-paid-paid", false), outcomes[0][1]);
+    EXPECT_EQ(outcomes[0], outcomes[1]);
+}
+
+TEST(OTScriptPool, clause_benchmark)
+{
+    const std::size_t count{200};
+    OTVariable counter("counter", 0);
+    OTScriptPool pool(LANGUAGE, OTSmartContract::RegisterPooledNativeCalls, 1);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto script = OTScriptFactory(LANGUAGE, CLAUSE);
+        OTSmartContract::RegisterPooledNativeCalls(*script);
+
+        ASSERT_TRUE(run(*script, counter));
+    }
+
+    const std::chrono::duration<double> fresh =
+        std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto script = pool.Get();
+        script->SetScript(CLAUSE);
+
+        ASSERT_TRUE(run(*script, counter));
+    }
+
+    const std::chrono::duration<double> pooled =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "Clause executions per second: "
+              << (count / fresh.count()) << " (new interpreter), "
+              << (count / pooled.count()) << " (pooled)" << std::endl;
+}
+#endif  // OT_SCRIPT_CHAI
@@ -0,0 +1,184 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/crypto/SecureArena.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+bool is_zero(const void* memory, const std::size_t size)
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(memory);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        if (0 != bytes[i]) { return false; }
+    }
+
+    return true;
+}
+
+struct Secret {
+    std::uint8_t key_[32];
+    std::uint32_t index_;
+};
+
+TEST(SecureArena, size_classes)
+{
+    EXPECT_EQ(64, SecureArena::SlotSize(1));
+    EXPECT_EQ(64, SecureArena::SlotSize(64));
+    EXPECT_EQ(128, SecureArena::SlotSize(65));
+    // OTPassword blocks
+    EXPECT_EQ(320, SecureArena::SlotSize(257));
+    EXPECT_EQ(512, SecureArena::SlotSize(512));
+    EXPECT_EQ(1024, SecureArena::SlotSize(513));
+    EXPECT_EQ(4096, SecureArena::SlotSize(4096));
+    EXPECT_EQ(0, SecureArena::SlotSize(4097));
+}
+
+TEST(SecureArena, freed_slots_are_zeroed)
+{
+    auto& arena = SecureArena::Get();
+    auto* memory = arena.Allocate(257);
+
+    ASSERT_NE(nullptr, memory);
+    EXPECT_TRUE(is_zero(memory, 320));
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(memory) % 64);
+
+    std::memset(memory, 0xaa, 257);
+    arena.Free(memory, 257);
+
+    // The most recently freed slot of a class is handed out first
+    auto* again = arena.Allocate(300);
+
+    EXPECT_EQ(memory, again);
+    EXPECT_TRUE(is_zero(again, 320));
+
+    arena.Free(again, 300);
+}
+
+TEST(SecureArena, statistics)
+{
+    auto& arena = SecureArena::Get();
+    const auto before = arena.Stats();
+    std::vector<void*> slots;
+
+    for (int i = 0; i < 10; ++i) { slots.push_back(arena.Allocate(100)); }
+
+    auto* large = arena.Allocate(10000);
+    auto during = arena.Stats();
+
+    EXPECT_EQ(before.slots_in_use_ + 10, during.slots_in_use_);
+    EXPECT_EQ(before.slot_bytes_in_use_ + 1280, during.slot_bytes_in_use_);
+    EXPECT_EQ(before.large_in_use_ + 1, during.large_in_use_);
+    EXPECT_EQ(before.allocations_ + 11, during.allocations_);
+    EXPECT_LT(0, during.locked_bytes_ + during.unlocked_bytes_);
+
+    std::memset(large, 0xff, 10000);
+    arena.Free(large, 10000);
+
+    for (auto* slot : slots) { arena.Free(slot, 100); }
+
+    const auto after = arena.Stats();
+
+    EXPECT_EQ(before.slots_in_use_, after.slots_in_use_);
+    EXPECT_EQ(before.slot_bytes_in_use_, after.slot_bytes_in_use_);
+    EXPECT_EQ(before.large_in_use_, after.large_in_use_);
+    EXPECT_EQ(before.frees_ + 11, after.frees_);
+    // Chunks stay mapped for reuse, only the large mapping is returned
+    EXPECT_LE(
+        before.locked_bytes_ + before.unlocked_bytes_,
+        after.locked_bytes_ + after.unlocked_bytes_);
+    EXPECT_GT(
+        during.locked_bytes_ + during.unlocked_bytes_,
+        after.locked_bytes_ + after.unlocked_bytes_);
+}
+
+TEST(SecureArena, buffers_and_objects)
+{
+    auto& arena = SecureArena::Get();
+    const auto before = arena.Stats().slots_in_use_;
+
+    {
+        SecureBuffer buffer(32);
+        auto secret = MakeSecure<Secret>();
+
+        EXPECT_EQ(32, buffer.size());
+        EXPECT_TRUE(is_zero(buffer.data(), buffer.size()));
+        EXPECT_TRUE(is_zero(secret->key_, sizeof(secret->key_)));
+        EXPECT_EQ(before + 2, arena.Stats().slots_in_use_);
+
+        std::memset(buffer.data(), 1, buffer.size());
+        secret->index_ = 7;
+    }
+
+    EXPECT_EQ(before, arena.Stats().slots_in_use_);
+}
+
+TEST(SecureArena, short_lived_secrets_reuse_chunks)
+{
+    auto& arena = SecureArena::Get();
+    const auto chunks = arena.Stats().chunks_;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&arena]() {
+            for (int i = 0; i < 100000; ++i) {
+                SecureBuffer key(32);
+                key.data()[0] = 1;
+                auto* block = arena.Allocate(257);
+                arena.Free(block, 257);
+            }
+        });
+    }
+
+    for (auto& thread : threads) { thread.join(); }
+
+    // 400,000 temporary secrets, but no new locked memory beyond what the
+    // peak number of simultaneous secrets needs.
+    EXPECT_GE(chunks + 2, arena.Stats().chunks_);
+}
+}  // namespace
@@ -0,0 +1,341 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/cash/SpentTokenStore.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+#if OT_CASH
+using namespace opentxs;
+
+namespace
+{
+const std::size_t KEY_SIZE{20};
+const std::size_t RECORD_SIZE{KEY_SIZE + 4};
+const std::size_t HEADER_SIZE{16};
+const std::size_t BENCHMARK_TOKENS{10000000};
+const std::size_t PURSE_SIZE{1000};
+const std::size_t LEGACY_SAMPLE{10000};
+
+class SpentTokenStoreTest : public ::testing::Test
+{
+protected:
+    const boost::filesystem::path folder_;
+    const std::string path_;
+
+    SpentTokenStoreTest()
+        : folder_(
+              boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path())
+        , path_((folder_ / "spent.log").string())
+    {
+        boost::filesystem::create_directories(folder_);
+    }
+
+    ~SpentTokenStoreTest() { boost::filesystem::remove_all(folder_); }
+};
+
+// splitmix64, so that generating tokens does not dominate the timings
+std::uint64_t next(std::uint64_t& state)
+{
+    auto output = (state += 0x9e3779b97f4a7c15ULL);
+    output = (output ^ (output >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    output = (output ^ (output >> 27)) * 0x94d049bb133111ebULL;
+
+    return output ^ (output >> 31);
+}
+
+Identifier token(std::uint64_t seed)
+{
+    std::array<std::uint64_t, 3> bytes{{next(seed), next(seed), next(seed)}};
+    Identifier output;
+    output.Assign(bytes.data(), KEY_SIZE);
+
+    return output;
+}
+
+std::vector<Identifier> purse(std::uint64_t first, std::size_t count)
+{
+    std::vector<Identifier> output{};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        output.push_back(token(first + i));
+    }
+
+    return output;
+}
+}  // namespace
+
+TEST_F(SpentTokenStoreTest, insert_and_contains)
+{
+    SpentTokenStore store(path_);
+
+    ASSERT_TRUE(store.IsValid());
+    EXPECT_FALSE(store.Contains(token(1)));
+    EXPECT_TRUE(store.Insert(token(1)));
+    EXPECT_TRUE(store.Contains(token(1)));
+    EXPECT_FALSE(store.Insert(token(1)));
+    EXPECT_FALSE(store.Contains(token(2)));
+    EXPECT_EQ(1, store.Size());
+}
+
+TEST_F(SpentTokenStoreTest, batch)
+{
+    SpentTokenStore store(path_);
+    const auto first = store.Insert({token(1), token(2), token(1), token(3)});
+
+    EXPECT_EQ(std::vector<bool>({true, true, false, true}), first);
+
+    const auto second = store.Insert({token(3), token(4)});
+
+    EXPECT_EQ(std::vector<bool>({false, true}), second);
+    EXPECT_EQ(4, store.Size());
+    EXPECT_EQ(
+        HEADER_SIZE + 4 * RECORD_SIZE, boost::filesystem::file_size(path_));
+}
+
+TEST_F(SpentTokenStoreTest, reopen)
+{
+    {
+        SpentTokenStore store(path_);
+        store.Insert(purse(0, 5000));
+    }
+
+    SpentTokenStore store(path_);
+
+    ASSERT_TRUE(store.IsValid());
+    EXPECT_EQ(5000, store.Size());
+
+    for (std::size_t i = 0; i < 5000; ++i) {
+        EXPECT_TRUE(store.Contains(token(i)));
+    }
+
+    EXPECT_FALSE(store.Contains(token(5000)));
+}
+
+TEST_F(SpentTokenStoreTest, torn_tail)
+{
+    {
+        SpentTokenStore store(path_);
+        store.Insert(purse(0, 10));
+    }
+
+    {
+        std::ofstream file(path_, std::ios::binary | std::ios::app);
+        file.write("torn", 4);
+    }
+
+    SpentTokenStore store(path_);
+
+    ASSERT_TRUE(store.IsValid());
+    EXPECT_EQ(10, store.Size());
+    EXPECT_EQ(
+        HEADER_SIZE + 10 * RECORD_SIZE, boost::filesystem::file_size(path_));
+    EXPECT_TRUE(store.Insert(token(10)));
+    EXPECT_TRUE(store.Contains(token(10)));
+}
+
+TEST_F(SpentTokenStoreTest, compact)
+{
+    {
+        SpentTokenStore store(path_);
+        store.Insert(purse(0, 10));
+    }
+
+    {
+        // Damage the checksum of the third record
+        std::fstream file(
+            path_, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(HEADER_SIZE + 3 * RECORD_SIZE - 1);
+        file.put('\xff');
+    }
+
+    SpentTokenStore store(path_);
+
+    ASSERT_TRUE(store.IsValid());
+    EXPECT_EQ(9, store.Size());
+    EXPECT_FALSE(store.Contains(token(2)));
+    EXPECT_TRUE(store.Compact());
+    EXPECT_EQ(
+        HEADER_SIZE + 9 * RECORD_SIZE, boost::filesystem::file_size(path_));
+    EXPECT_TRUE(store.Contains(token(9)));
+    EXPECT_TRUE(store.Insert(token(2)));
+
+    SpentTokenStore reopened(path_);
+
+    EXPECT_EQ(10, reopened.Size());
+    EXPECT_TRUE(reopened.Contains(token(2)));
+}
+
+TEST_F(SpentTokenStoreTest, fail_closed)
+{
+    SpentTokenStore store(path_);
+    Identifier wrongSize;
+    const std::uint8_t bytes[8]{};
+    wrongSize.Assign(bytes, sizeof(bytes));
+
+    EXPECT_TRUE(store.Contains(wrongSize));
+    EXPECT_FALSE(store.Insert(wrongSize));
+
+    SpentTokenStore invalid((folder_ / "missing" / "spent.log").string());
+
+    ASSERT_FALSE(invalid.IsValid());
+    EXPECT_TRUE(invalid.Contains(token(1)));
+    EXPECT_FALSE(invalid.Insert(token(1)));
+}
+
+TEST_F(SpentTokenStoreTest, remove)
+{
+    {
+        SpentTokenStore store(path_);
+        store.Insert(purse(0, 3000));
+
+        EXPECT_TRUE(store.Remove(purse(1000, 1000)));
+        EXPECT_EQ(2000, store.Size());
+
+        for (std::size_t i = 0; i < 3000; ++i) {
+            EXPECT_EQ((1000 > i) || (2000 <= i), store.Contains(token(i)));
+        }
+
+        // Removing a token which is not in the store writes nothing
+        const auto size = boost::filesystem::file_size(path_);
+
+        EXPECT_TRUE(store.Remove({token(1500), token(5000)}));
+        EXPECT_EQ(size, boost::filesystem::file_size(path_));
+        EXPECT_TRUE(store.Insert(token(1500)));
+    }
+
+    // Tombstones are replayed when the log is opened
+    SpentTokenStore store(path_);
+
+    ASSERT_TRUE(store.IsValid());
+    EXPECT_EQ(2001, store.Size());
+    EXPECT_TRUE(store.Contains(token(999)));
+    EXPECT_FALSE(store.Contains(token(1000)));
+    EXPECT_TRUE(store.Contains(token(1500)));
+    EXPECT_TRUE(store.Contains(token(2000)));
+
+    // and dropped by compaction
+    EXPECT_TRUE(store.Compact());
+    EXPECT_EQ(
+        HEADER_SIZE + 2001 * RECORD_SIZE, boost::filesystem::file_size(path_));
+
+    SpentTokenStore compacted(path_);
+
+    EXPECT_EQ(2001, compacted.Size());
+    EXPECT_FALSE(compacted.Contains(token(1000)));
+    EXPECT_TRUE(compacted.Contains(token(1500)));
+}
+
+// Writes about 240 MB. Run with --gtest_also_run_disabled_tests.
+TEST_F(SpentTokenStoreTest, DISABLED_benchmark)
+{
+    // Per token cost of the one file per token layout, on a sample
+    const auto legacyStart = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i < LEGACY_SAMPLE; ++i) {
+        const auto path = folder_ / std::to_string(i);
+
+        if (false == boost::filesystem::exists(path)) {
+            std::ofstream(path.string()) << "token";
+        }
+    }
+
+    const auto legacy = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::high_resolution_clock::now() -
+                            legacyStart)
+                            .count() /
+                        LEGACY_SAMPLE;
+
+    // Durability is left to the operating system so that the benchmark
+    // measures the index rather than the disk.
+    SpentTokenStore store(path_, false);
+    const auto insertStart = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i < BENCHMARK_TOKENS; i += PURSE_SIZE) {
+        store.Insert(purse(i, PURSE_SIZE));
+    }
+
+    const auto insertEnd = std::chrono::high_resolution_clock::now();
+    std::size_t found{0};
+
+    for (std::size_t i = 0; i < BENCHMARK_TOKENS; ++i) {
+        found += store.Contains(token(BENCHMARK_TOKENS + i)) ? 1 : 0;
+    }
+
+    const auto missEnd = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i < BENCHMARK_TOKENS; i += 10) {
+        found += store.Contains(token(i)) ? 1 : 0;
+    }
+
+    const auto hitEnd = std::chrono::high_resolution_clock::now();
+    const auto insert = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            insertEnd - insertStart)
+                            .count() /
+                        BENCHMARK_TOKENS;
+    const auto miss = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          missEnd - insertEnd)
+                          .count() /
+                      BENCHMARK_TOKENS;
+    const auto hit = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         hitEnd - missEnd)
+                         .count() /
+                     (BENCHMARK_TOKENS / 10);
+
+    std::cout << "Legacy spent token file: " << legacy << " ns per token\n"
+              << "Spent token log (" << BENCHMARK_TOKENS << " tokens): insert "
+              << insert << " ns, unspent lookup " << miss
+              << " ns, spent lookup " << hit << " ns per token" << std::endl;
+
+    EXPECT_EQ(BENCHMARK_TOKENS, store.Size());
+    EXPECT_EQ(BENCHMARK_TOKENS / 10, found);
+}
+#endif  // OT_CASH
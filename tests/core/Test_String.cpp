@@ -0,0 +1,248 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+const int LINES{5000};
+const std::string LINE(
+    "<transaction type=\"pending\" number=\"1234567890\" "
+    "inReferenceTo=\"9\"/>");
+
+// What Concatenate used to do: copy both pieces into a temporary, then copy
+// that into a new buffer.
+void old_concatenate(String& output, const String& input)
+{
+    std::string temp;
+
+    if (output.Exists()) temp += output.Get();
+
+    if (input.Exists()) temp += input.Get();
+
+    output.Set(temp.c_str());
+}
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+TEST(String, concatenate)
+{
+    String output;
+    std::string expected;
+
+    for (int i = 0; i < 1000; ++i) {
+        const std::string piece = std::to_string(i) + ",";
+        output.Concatenate(String(piece));
+        expected += piece;
+        ASSERT_EQ(expected.size(), output.GetLength());
+    }
+
+    EXPECT_STREQ(expected.c_str(), output.Get());
+
+    output.Concatenate("%d:%s", 7, "end");
+    expected += "7:end";
+    EXPECT_STREQ(expected.c_str(), output.Get());
+
+    output.Concatenate(std::string("!"));
+    expected += "!";
+    EXPECT_STREQ(expected.c_str(), output.Get());
+}
+
+TEST(String, concatenate_self)
+{
+    String small("abc");
+    small.Concatenate(small);
+    EXPECT_STREQ("abcabc", small.Get());
+
+    String large(LINE.c_str());
+    large.Concatenate(large);
+    EXPECT_EQ(2 * LINE.size(), large.GetLength());
+    EXPECT_STREQ((LINE + LINE).c_str(), large.Get());
+}
+
+TEST(String, empty)
+{
+    String empty;
+    EXPECT_FALSE(empty.Exists());
+
+    empty.Concatenate(String(""));
+    EXPECT_FALSE(empty.Exists());
+    EXPECT_STREQ("", empty.Get());
+
+    String set("");
+    EXPECT_FALSE(set.Exists());
+}
+
+TEST(String, memset)
+{
+    const char data[] = {'a', 'b', '\0', 'c'};
+    String output;
+
+    EXPECT_TRUE(output.MemSet(data, sizeof(data)));
+    EXPECT_EQ(2, output.GetLength());
+    EXPECT_STREQ("ab", output.Get());
+}
+
+TEST(String, move)
+{
+    String small("small");
+    String moved(std::move(small));
+    EXPECT_STREQ("small", moved.Get());
+    EXPECT_FALSE(small.Exists());
+
+    String large(LINE.c_str());
+    const char* buffer = large.Get();
+    String movedLarge(std::move(large));
+    // The heap buffer changes owner without being copied.
+    EXPECT_EQ(buffer, movedLarge.Get());
+    EXPECT_FALSE(large.Exists());
+}
+
+TEST(String, swap)
+{
+    String small("small");
+    String large(LINE.c_str());
+
+    small.swap(large);
+    EXPECT_STREQ(LINE.c_str(), small.Get());
+    EXPECT_STREQ("small", large.Get());
+
+    large.swap(small);
+    EXPECT_STREQ("small", small.Get());
+    EXPECT_STREQ(LINE.c_str(), large.Get());
+
+    String other("other");
+    small.swap(other);
+    EXPECT_STREQ("other", small.Get());
+    EXPECT_STREQ("small", other.Get());
+
+    small.Concatenate(String(" and more, enough to leave small storage"));
+    EXPECT_STREQ(
+        "other and more, enough to leave small storage", small.Get());
+    EXPECT_STREQ("small", other.Get());
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(String, DISABLED_append_benchmark)
+{
+    const String line(LINE.c_str());
+    String before;
+    String after;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < LINES; ++i) { old_concatenate(before, line); }
+
+    const auto beforeTime = elapsed(start);
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < LINES; ++i) { after.Concatenate(line); }
+
+    const auto afterTime = elapsed(start);
+
+    std::cout << LINES << " appends: " << beforeTime << " ms copying, "
+              << afterTime << " ms in place.\n";
+
+    ASSERT_EQ(before.GetLength(), after.GetLength());
+    EXPECT_TRUE(before.Compare(after));
+}
+
+// Contract::ParseRawFile and Contract::AddBookendsAroundContent build the
+// signed form of a contract one formatted piece at a time. Run with
+// --gtest_also_run_disabled_tests.
+TEST(String, DISABLED_contract_benchmark)
+{
+    auto build = [](bool inPlace) -> String {
+        String output;
+        auto add = [&output, inPlace](const String& piece) -> void {
+            if (inPlace) {
+                output.Concatenate(piece);
+            } else {
+                old_concatenate(output, piece);
+            }
+        };
+        String piece;
+        piece.Format("-----BEGIN SIGNED %s-----\nHash: %s\n\n", "LEDGER", "");
+        add(piece);
+
+        for (int i = 0; i < LINES; ++i) {
+            piece.Format("%s\n", LINE.c_str());
+            add(piece);
+        }
+
+        piece.Format(
+            "-----BEGIN %s SIGNATURE-----\nVersion: Open Transactions %s\n",
+            "LEDGER",
+            "test");
+        add(piece);
+        piece.Format("%s\n-----END %s SIGNATURE-----\n\n", "sig", "LEDGER");
+        add(piece);
+
+        return output;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    const String before = build(false);
+    const auto beforeTime = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    const String after = build(true);
+    const auto afterTime = elapsed(start);
+
+    std::cout << "Contract of " << after.GetLength()
+              << " bytes: " << beforeTime << " ms copying, " << afterTime
+              << " ms in place.\n";
+
+    EXPECT_TRUE(before.Compare(after));
+}
+}  // namespace
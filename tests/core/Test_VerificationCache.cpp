@@ -0,0 +1,130 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/crypto/VerificationCache.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+TEST(VerificationCache, check_and_add)
+{
+    VerificationCache cache(8);
+
+    EXPECT_EQ(8, cache.Capacity());
+    EXPECT_FALSE(cache.Check("signature"));
+    EXPECT_EQ(0, cache.Hits());
+    EXPECT_EQ(1, cache.Misses());
+
+    cache.Add("signature");
+    cache.Add("signature");
+
+    EXPECT_EQ(1, cache.Size());
+    EXPECT_TRUE(cache.Check("signature"));
+    EXPECT_FALSE(cache.Check("other signature"));
+    EXPECT_EQ(1, cache.Hits());
+    EXPECT_EQ(2, cache.Misses());
+
+    cache.Clear();
+
+    EXPECT_EQ(0, cache.Size());
+    EXPECT_FALSE(cache.Check("signature"));
+}
+
+TEST(VerificationCache, evicts_oldest)
+{
+    VerificationCache cache(100);
+
+    for (int i = 0; i < 250; ++i) { cache.Add(std::to_string(i)); }
+
+    EXPECT_EQ(100, cache.Size());
+
+    for (int i = 0; i < 150; ++i) {
+        EXPECT_FALSE(cache.Check(std::to_string(i)));
+    }
+
+    for (int i = 150; i < 250; ++i) {
+        EXPECT_TRUE(cache.Check(std::to_string(i)));
+    }
+}
+
+TEST(VerificationCache, zero_capacity)
+{
+    VerificationCache cache(0);
+    cache.Add("signature");
+
+    EXPECT_EQ(0, cache.Size());
+    EXPECT_FALSE(cache.Check("signature"));
+}
+
+TEST(VerificationCache, concurrent)
+{
+    const int threads = 4;
+    const int entries = 5000;
+    VerificationCache cache(threads * entries);
+    std::atomic<int> found{0};
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&cache, &found, t, entries]() {
+            for (int i = 0; i < entries; ++i) {
+                const auto key = std::to_string(t) + ":" + std::to_string(i);
+                cache.Add(key);
+
+                if (cache.Check(key)) { ++found; }
+            }
+        });
+    }
+
+    for (auto& worker : workers) { worker.join(); }
+
+    EXPECT_EQ(threads * entries, found.load());
+    EXPECT_EQ(threads * entries, cache.Size());
+    EXPECT_EQ(threads * entries, cache.Hits());
+    EXPECT_EQ(0, cache.Misses());
+}
+}  // namespace
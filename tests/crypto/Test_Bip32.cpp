@@ -0,0 +1,194 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/crypto/AsymmetricKeyEC.hpp"
+#include "opentxs/core/crypto/Bip32.hpp"
+#include "opentxs/core/crypto/Bip39.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Proto.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace opentxs;
+
+#define ADDRESS_COUNT 20
+
+namespace
+{
+const std::uint32_t HARDENED{static_cast<std::uint32_t>(Bip32Child::HARDENED)};
+
+// Test vector 1 from BIP-32
+const std::uint8_t VECTOR_SEED[]{0x00,
+                                 0x01,
+                                 0x02,
+                                 0x03,
+                                 0x04,
+                                 0x05,
+                                 0x06,
+                                 0x07,
+                                 0x08,
+                                 0x09,
+                                 0x0a,
+                                 0x0b,
+                                 0x0c,
+                                 0x0d,
+                                 0x0e,
+                                 0x0f};
+
+const Bip32& bip32() { return OT::App().Crypto().BIP32(); }
+
+// The key AccountChildKey() produces, read back the way Blockchain used to
+std::string private_path_key(
+    const proto::HDPath& path,
+    const BIP44Chain chain,
+    const std::uint32_t index)
+{
+    const auto serialized = bip32().AccountChildKey(path, chain, index);
+
+    if (false == bool(serialized)) { return {}; }
+
+    std::unique_ptr<OTAsymmetricKey> key(
+        OTAsymmetricKey::KeyFactory(*serialized));
+    const auto* ecKey = dynamic_cast<const AsymmetricKeyEC*>(key.get());
+
+    if (nullptr == ecKey) { return {}; }
+
+    auto output = Data::Factory();
+
+    if (false == ecKey->GetPublicKey(output)) { return {}; }
+
+    return output->asHex();
+}
+
+// The key Blockchain derives from the cached chain key
+std::string public_path_key(
+    const Data& chainKey,
+    const Data& chainCode,
+    const std::uint32_t index)
+{
+    auto output = Data::Factory();
+
+    if (false == bip32().PublicChild(
+                     EcdsaCurve::SECP256K1,
+                     chainKey,
+                     chainCode,
+                     index,
+                     output)) {
+        return {};
+    }
+
+    return output->asHex();
+}
+
+TEST(Test_Bip32, public_child_matches_test_vector)
+{
+    const OTPassword seed(VECTOR_SEED, sizeof(VECTOR_SEED));
+    auto key = Data::Factory();
+    auto code = Data::Factory();
+    proto::HDPath path{};
+    path.add_child(0 | HARDENED);
+
+    ASSERT_TRUE(bip32().GetPublicNode(
+        EcdsaCurve::SECP256K1, seed, path, key, code));
+    EXPECT_EQ(
+        "035A784662A4A20A65BF6AAB9AE98A6C068A81C52E4B032C0FB5400C706CFCCC56",
+        key->asHex());
+    EXPECT_EQ(
+        "47FDACBD0F1097043B78C63C20C34EF4ED9A111D980047AD16282C7AE6236141",
+        code->asHex());
+    // m/0H/1
+    EXPECT_EQ(
+        "03501E454BF00751F24B1B489AA925215D66AF2234E3891C3B21A52BEDB3CD711C",
+        public_path_key(key, code, 1));
+
+    path.add_child(1);
+    path.add_child(2 | HARDENED);
+    path.add_child(2);
+
+    ASSERT_TRUE(bip32().GetPublicNode(
+        EcdsaCurve::SECP256K1, seed, path, key, code));
+    EXPECT_EQ(
+        "02E8445082A72F29B75CA48748A914DF60622A609CACFCE8ED0E35804560741D29",
+        key->asHex());
+    EXPECT_EQ(
+        "CFB71883F01676F587D023CC53A35BC7F88F724B1F8C2892AC1275AC822A3EDD",
+        code->asHex());
+    // m/0H/1/2H/2/1000000000
+    EXPECT_EQ(
+        "022A471424DA5E657499D1FF51CB43C47481A03B1E77F951FE64CEC9F5A48F7011",
+        public_path_key(key, code, 1000000000));
+}
+
+TEST(Test_Bip32, public_child_matches_account_child_key)
+{
+    const auto fingerprint = OT::App().Crypto().BIP39().NewSeed();
+
+    ASSERT_FALSE(fingerprint.empty());
+
+    proto::HDPath path{};
+    path.set_root(fingerprint);
+    path.add_child(
+        static_cast<std::uint32_t>(Bip43Purpose::HDWALLET) | HARDENED);
+    path.add_child(static_cast<std::uint32_t>(Bip44Type::BITCOIN) | HARDENED);
+    path.add_child(0 | HARDENED);
+
+    for (const auto chain : {EXTERNAL_CHAIN, INTERNAL_CHAIN}) {
+        auto key = Data::Factory();
+        auto code = Data::Factory();
+
+        ASSERT_TRUE(bip32().AccountChainKey(path, chain, key, code));
+
+        for (std::uint32_t index = 0; index < ADDRESS_COUNT; ++index) {
+            const auto expected = private_path_key(path, chain, index);
+
+            ASSERT_FALSE(expected.empty());
+            EXPECT_EQ(expected, public_path_key(key, code, index));
+        }
+    }
+}
+}  // namespace
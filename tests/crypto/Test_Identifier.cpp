@@ -0,0 +1,207 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Encode.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+
+const std::size_t ID_COUNT{10000};
+const std::size_t LOOKUPS{100000};
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// What operator< used to do: base58check encode both operands, then compare
+// the strings
+struct OldLess {
+    std::string encode(const Identifier& id) const
+    {
+        const auto type = id.Type();
+        auto data = Data::Factory(&type, sizeof(type));
+        data->Concatenate(id.GetPointer(), id.GetSize());
+
+        return "ot" + OT::App().Crypto().Encode().IdentifierEncode(data);
+    }
+
+    bool operator()(const Identifier& lhs, const Identifier& rhs) const
+    {
+        return encode(lhs) < encode(rhs);
+    }
+};
+
+Identifier make_id(const std::size_t i, const ID type = ID::BLAKE2B)
+{
+    Identifier output;
+    output.CalculateDigest(String(std::to_string(i)), type);
+
+    return output;
+}
+
+TEST(Identifier, string_round_trip)
+{
+    const auto id = make_id(1);
+    const String first(id);
+    const String second(id);
+
+    ASSERT_TRUE(first.Exists());
+    EXPECT_STREQ(first.Get(), second.Get());
+
+    const Identifier parsed(first);
+
+    EXPECT_EQ(id, parsed);
+    EXPECT_EQ(id.Type(), parsed.Type());
+    EXPECT_EQ(std::hash<Identifier>()(id), std::hash<Identifier>()(parsed));
+
+    Identifier changed(id);
+    changed.CalculateDigest(String("changed"));
+
+    EXPECT_STRNE(first.Get(), String(changed).Get());
+}
+
+TEST(Identifier, comparison)
+{
+    const auto a = make_id(1);
+    const auto b = make_id(2);
+    const auto sha = make_id(1, ID::SHA256);
+
+    EXPECT_NE(a, b);
+    EXPECT_NE(a, sha);
+    EXPECT_NE(a < b, b < a);
+    EXPECT_TRUE(a <= Identifier(a));
+    EXPECT_TRUE(a >= Identifier(a));
+    EXPECT_FALSE(a < Identifier(a));
+
+    // Empty identifiers always had empty string forms, so they compare
+    // equal whatever their type
+    Identifier empty;
+    Identifier invalid(std::string("not an identifier"));
+
+    EXPECT_EQ(empty, invalid);
+    EXPECT_TRUE(empty < a);
+}
+
+TEST(Identifier, data_interop)
+{
+    const auto id = make_id(3);
+    auto data = Data::Factory(id);
+
+    EXPECT_TRUE(id == data.get());
+    EXPECT_TRUE(data.get() == id);
+
+    Identifier copy;
+    copy.Assign(data);
+
+    EXPECT_EQ(id, copy);
+
+    std::vector<std::uint8_t> tooBig(Identifier::MaxSize + 1, 0x1);
+    copy.Assign(tooBig.data(), tooBig.size());
+
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST(Identifier, map_benchmark)
+{
+    std::vector<Identifier> ids;
+    std::map<Identifier, std::size_t, OldLess> before;
+    std::map<Identifier, std::size_t> after;
+    std::unordered_map<Identifier, std::size_t> hashed;
+
+    for (std::size_t i = 0; i < ID_COUNT; ++i) {
+        ids.emplace_back(make_id(i));
+        before.emplace(ids.back(), i);
+        after.emplace(ids.back(), i);
+        hashed.emplace(ids.back(), i);
+    }
+
+    ASSERT_EQ(ID_COUNT, after.size());
+    ASSERT_EQ(ID_COUNT, hashed.size());
+
+    std::size_t found{0};
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < LOOKUPS; ++i) {
+        found += before.count(ids[(i * 7919) % ID_COUNT]);
+    }
+
+    const auto beforeTime = elapsed(start);
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < LOOKUPS; ++i) {
+        found += after.count(ids[(i * 7919) % ID_COUNT]);
+    }
+
+    const auto afterTime = elapsed(start);
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < LOOKUPS; ++i) {
+        found += hashed.count(ids[(i * 7919) % ID_COUNT]);
+    }
+
+    const auto hashedTime = elapsed(start);
+
+    std::cout << LOOKUPS << " lookups in " << ID_COUNT
+              << " identifiers: " << beforeTime << " ms comparing strings, "
+              << afterTime << " ms comparing bytes, " << hashedTime
+              << " ms hashed.\n";
+
+    EXPECT_EQ(3 * LOOKUPS, found);
+}
+}  // namespace
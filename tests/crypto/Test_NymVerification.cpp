@@ -0,0 +1,129 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/VerificationCache.hpp"
+#include "opentxs/core/Nym.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+using namespace opentxs;
+
+namespace
+{
+
+const int LOAD_COUNT{100};
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Loads the public nym from its serialized credential index and verifies all
+// of its credentials, the same work Wallet::Nym does for a nym not in memory.
+bool load_nym(const serializedCredentialIndex& serialized)
+{
+    Nym nym;
+
+    if (false == nym.LoadCredentialIndex(serialized)) { return false; }
+
+    return nym.VerifyPseudonym();
+}
+
+TEST(Test_NymVerification, RepeatedNymLoads)
+{
+    NymParameters parameters;
+    const Nym source(parameters);
+    const auto serialized = source.asPublicNym();
+    auto& cache = CryptoAsymmetric::SignatureCache();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < LOAD_COUNT; ++i) {
+        cache.Clear();
+
+        ASSERT_TRUE(load_nym(serialized));
+    }
+
+    const auto uncachedTime = elapsed(start);
+    const auto hits = cache.Hits();
+    const auto misses = cache.Misses();
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < LOAD_COUNT; ++i) {
+        ASSERT_TRUE(load_nym(serialized));
+    }
+
+    const auto cachedTime = elapsed(start);
+    const auto cachedMisses = cache.Misses() - misses;
+
+    std::cout << "Loaded a nym " << LOAD_COUNT << " times in " << uncachedTime
+              << " us without the verification cache, " << cachedTime
+              << " us with it (" << (cache.Hits() - hits) << " hits, "
+              << cachedMisses << " misses)" << std::endl;
+
+    // Only the first load after the final Clear() should have missed.
+    EXPECT_EQ(0u, cachedMisses);
+    EXPECT_LT(hits, cache.Hits());
+}
+
+TEST(Test_NymVerification, AlteredNymFails)
+{
+    NymParameters parameters;
+    const Nym source(parameters);
+    auto serialized = source.asPublicNym();
+
+    ASSERT_TRUE(load_nym(serialized));
+    ASSERT_LT(0, serialized.activecredentials_size());
+
+    auto& master = *serialized.mutable_activecredentials(0)
+                        ->mutable_mastercredential();
+    auto& signature = *master.mutable_signature(0)->mutable_signature();
+    signature[0] = signature[0] ^ 0x01;
+
+    // A cached result for the original signature must not be reused.
+    EXPECT_FALSE(load_nym(serialized));
+}
+}  // namespace
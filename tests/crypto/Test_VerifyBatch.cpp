@@ -0,0 +1,179 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/VerificationCache.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Nym.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+
+const std::size_t SIGNATURE_COUNT{10000};
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+class Test_VerifyBatch : public ::testing::Test
+{
+public:
+    NymParameters parameters_;
+    const Nym nym_;
+    std::vector<OTData> plaintext_;
+    std::vector<OTData> signature_;
+
+    Test_VerifyBatch()
+        : parameters_()
+        , nym_(parameters_)
+        , plaintext_()
+        , signature_()
+    {
+    }
+
+    void SetUp() override
+    {
+        const auto& key = nym_.GetPrivateSignKey();
+
+        for (std::size_t i = 0; i < SIGNATURE_COUNT; ++i) {
+            const std::string message =
+                "Test_VerifyBatch message " + std::to_string(i);
+            plaintext_.emplace_back(
+                Data::Factory(message.c_str(), message.size()));
+            signature_.emplace_back(Data::Factory());
+
+            ASSERT_TRUE(key.engine().Sign(
+                plaintext_.back(),
+                key,
+                proto::HASHTYPE_SHA256,
+                signature_.back()));
+        }
+    }
+
+    SignatureBatch Batch()
+    {
+        SignatureBatch output;
+        const auto& key = nym_.GetPublicSignKey();
+
+        for (std::size_t i = 0; i < SIGNATURE_COUNT; ++i) {
+            output.push_back({plaintext_[i].get(),
+                              key,
+                              signature_[i].get(),
+                              proto::HASHTYPE_SHA256});
+        }
+
+        return output;
+    }
+};
+
+TEST_F(Test_VerifyBatch, Throughput)
+{
+    const auto& key = nym_.GetPublicSignKey();
+    const auto batch = Batch();
+    auto& cache = CryptoAsymmetric::SignatureCache();
+
+    cache.Clear();
+    auto start = std::chrono::steady_clock::now();
+
+    for (const auto& item : batch) {
+        ASSERT_TRUE(key.engine().Verify(
+            item.plaintext_, item.key_, item.signature_, item.hashType_));
+    }
+
+    const auto serialTime = elapsed(start);
+    cache.Clear();
+    start = std::chrono::steady_clock::now();
+    const auto results = CryptoAsymmetric::VerifyBatch(batch);
+    const auto batchedTime = elapsed(start);
+
+    ASSERT_EQ(SIGNATURE_COUNT, results.size());
+
+    for (const auto result : results) { EXPECT_TRUE(result); }
+
+    std::cout << "Verified " << SIGNATURE_COUNT << " signatures in "
+              << serialTime << " ms one at a time, " << batchedTime
+              << " ms as a batch" << std::endl;
+}
+
+TEST_F(Test_VerifyBatch, PerItemResults)
+{
+    auto batch = Batch();
+    auto& cache = CryptoAsymmetric::SignatureCache();
+    cache.Clear();
+
+    // Pair every tenth message with the signature of the next one.
+    SignatureBatch mixed;
+
+    for (std::size_t i = 0; i < SIGNATURE_COUNT; ++i) {
+        if (0 == i % 10) {
+            const auto& wrong = batch[(i + 1) % SIGNATURE_COUNT];
+            mixed.push_back({batch[i].plaintext_,
+                             batch[i].key_,
+                             wrong.signature_,
+                             batch[i].hashType_});
+        } else {
+            mixed.push_back(batch[i]);
+        }
+    }
+
+    const auto results = CryptoAsymmetric::VerifyBatch(mixed);
+
+    ASSERT_EQ(SIGNATURE_COUNT, results.size());
+
+    for (std::size_t i = 0; i < SIGNATURE_COUNT; ++i) {
+        EXPECT_EQ(0 != i % 10, results[i]);
+    }
+
+    EXPECT_TRUE(CryptoAsymmetric::VerifyBatch(SignatureBatch()).empty());
+}
+}  // namespace
@@ -0,0 +1,189 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace opentxs;
+
+namespace
+{
+
+const std::int32_t TRANSACTION_COUNT{50000};
+
+class Test_LedgerIndex : public ::testing::Test
+{
+public:
+    Identifier nym_;
+    Identifier account_;
+    Identifier notary_;
+    std::unique_ptr<Ledger> ledger_;
+
+    Test_LedgerIndex()
+    {
+        nym_.CalculateDigest(String("Test_LedgerIndex nym"));
+        account_.CalculateDigest(String("Test_LedgerIndex account"));
+        notary_.CalculateDigest(String("Test_LedgerIndex notary"));
+    }
+
+    // Every tenth transaction is a replyNotice for request number i, and
+    // every other transaction is a finalReceipt in reference to i / 2.
+    static OTTransaction::transactionType type(std::int64_t i)
+    {
+        if (0 == i % 10) { return OTTransaction::replyNotice; }
+
+        return (0 == i % 2) ? OTTransaction::finalReceipt
+                            : OTTransaction::pending;
+    }
+
+    void SetUp() override
+    {
+        ledger_.reset(Ledger::GenerateLedger(
+            nym_, account_, notary_, Ledger::message, false));
+        ASSERT_TRUE(ledger_);
+
+        // Added in reverse order, so the positional index can't be built by
+        // appending.
+        for (std::int64_t i = TRANSACTION_COUNT; i > 0; --i) {
+            OTTransaction* transaction = OTTransaction::GenerateTransaction(
+                *ledger_, type(i), originType::not_applicable, i);
+            ASSERT_NE(nullptr, transaction);
+            transaction->SetReferenceToNum(i / 2);
+            transaction->SetRequestNum(i);
+            ASSERT_TRUE(ledger_->AddTransaction(*transaction));
+        }
+    }
+};
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+TEST_F(Test_LedgerIndex, Positions)
+{
+    ASSERT_EQ(TRANSACTION_COUNT, ledger_->GetTransactionCount());
+    EXPECT_EQ(nullptr, ledger_->GetTransactionByIndex(-1));
+    EXPECT_EQ(nullptr, ledger_->GetTransactionByIndex(TRANSACTION_COUNT));
+    EXPECT_EQ(-1, ledger_->GetTransactionIndex(TRANSACTION_COUNT + 1));
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::int32_t i = 0; i < TRANSACTION_COUNT; ++i) {
+        OTTransaction* transaction = ledger_->GetTransactionByIndex(i);
+        ASSERT_NE(nullptr, transaction);
+        ASSERT_EQ(i + 1, transaction->GetTransactionNum());
+        ASSERT_EQ(i, ledger_->GetTransactionIndex(i + 1));
+    }
+
+    std::cout << "Walked " << TRANSACTION_COUNT << " transactions by index in "
+              << elapsed(start) << " ms.\n";
+
+    ASSERT_TRUE(ledger_->RemoveTransaction(1));
+    ASSERT_TRUE(ledger_->RemoveTransaction(TRANSACTION_COUNT / 2));
+
+    EXPECT_EQ(2, ledger_->GetTransactionByIndex(0)->GetTransactionNum());
+    EXPECT_EQ(
+        TRANSACTION_COUNT / 2 + 1,
+        ledger_->GetTransactionByIndex(TRANSACTION_COUNT / 2 - 2)
+            ->GetTransactionNum());
+    EXPECT_EQ(-1, ledger_->GetTransactionIndex(TRANSACTION_COUNT / 2));
+
+    const std::set<std::int32_t> indices{0, 1, TRANSACTION_COUNT};
+    const std::set<std::int64_t> expected{2, 3};
+    EXPECT_EQ(expected, ledger_->GetTransactionNums(&indices));
+}
+
+TEST_F(Test_LedgerIndex, Lookups)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::int64_t i = 1; i <= TRANSACTION_COUNT; ++i) {
+        OTTransaction* notice = ledger_->GetReplyNotice(i);
+
+        if (OTTransaction::replyNotice == type(i)) {
+            ASSERT_NE(nullptr, notice);
+            ASSERT_EQ(i, notice->GetTransactionNum());
+        } else {
+            ASSERT_EQ(nullptr, notice);
+        }
+    }
+
+    for (std::int64_t i = 0; i <= TRANSACTION_COUNT / 2; ++i) {
+        const auto count = ledger_->GetTransactionCountInRefTo(i);
+        ASSERT_EQ((0 == i) ? 1 : (TRANSACTION_COUNT / 2 == i) ? 1 : 2, count);
+
+        // Only 2 * i can be a finalReceipt in reference to i.
+        OTTransaction* receipt = ledger_->GetFinalReceipt(i);
+
+        if ((0 < i) && (OTTransaction::finalReceipt == type(2 * i))) {
+            ASSERT_NE(nullptr, receipt);
+            ASSERT_EQ(2 * i, receipt->GetTransactionNum());
+        } else {
+            ASSERT_EQ(nullptr, receipt);
+        }
+    }
+
+    std::cout << "Looked up " << TRANSACTION_COUNT
+              << " reply notices and final receipts in " << elapsed(start)
+              << " ms.\n";
+
+    OTTransaction* first = ledger_->GetTransaction(OTTransaction::pending);
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(1, first->GetTransactionNum());
+
+    // Removed transactions must drop out of every index.
+    ASSERT_TRUE(ledger_->RemoveTransaction(10));
+    EXPECT_EQ(nullptr, ledger_->GetReplyNotice(10));
+    EXPECT_EQ(1, ledger_->GetTransactionCountInRefTo(5));
+    ASSERT_TRUE(ledger_->RemoveTransaction(1));
+    EXPECT_EQ(3, ledger_->GetTransaction(OTTransaction::pending)
+                     ->GetTransactionNum());
+}
+}  // namespace
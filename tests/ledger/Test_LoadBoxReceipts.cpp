@@ -0,0 +1,214 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <thread>
+
+using namespace opentxs;
+
+namespace
+{
+
+const std::int64_t RECEIPT_COUNT{100};
+const std::int64_t BENCHMARK_RECEIPT_COUNT{10000};
+
+class Test_LoadBoxReceipts : public ::testing::Test
+{
+public:
+    Identifier nym_;
+    Identifier account_;
+    Identifier notary_;
+    String inbox_;
+
+    Test_LoadBoxReceipts()
+    {
+        nym_.CalculateDigest(String("Test_LoadBoxReceipts nym"));
+        account_.CalculateDigest(String("Test_LoadBoxReceipts account"));
+        notary_.CalculateDigest(String("Test_LoadBoxReceipts notary"));
+    }
+
+    void SetUp() override { write(RECEIPT_COUNT); }
+
+    // Writes a box receipt for every transaction, and keeps the inbox itself
+    // (which only contains the abbreviated versions) in inbox_.
+    void write(const std::int64_t count)
+    {
+        std::unique_ptr<Ledger> inbox(Ledger::GenerateLedger(
+            nym_, account_, notary_, Ledger::inbox, false));
+        ASSERT_TRUE(inbox);
+
+        for (std::int64_t i = 1; i <= count; ++i) {
+            OTTransaction* receipt = OTTransaction::GenerateTransaction(
+                *inbox, OTTransaction::pending, originType::not_applicable, i);
+            ASSERT_NE(nullptr, receipt);
+            ASSERT_TRUE(receipt->SaveContract());
+            ASSERT_TRUE(receipt->SaveBoxReceipt(*inbox));
+            inbox->AddTransaction(*receipt);
+        }
+
+        ASSERT_TRUE(inbox->SaveContract());
+        ASSERT_TRUE(inbox->SaveContractRaw(inbox_));
+    }
+
+    std::unique_ptr<Ledger> load() const
+    {
+        std::unique_ptr<Ledger> inbox(new Ledger(nym_, account_, notary_));
+        EXPECT_TRUE(inbox->LoadInboxFromString(inbox_));
+
+        return inbox;
+    }
+};
+
+std::int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST_F(Test_LoadBoxReceipts, DISABLED_Benchmark)
+{
+    write(BENCHMARK_RECEIPT_COUNT);
+
+    if (HasFatalFailure()) { return; }
+
+    auto serial = load();
+    auto batched = load();
+    ASSERT_EQ(BENCHMARK_RECEIPT_COUNT, serial->GetTransactionCount());
+    ASSERT_EQ(BENCHMARK_RECEIPT_COUNT, batched->GetTransactionCount());
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::int64_t i = 1; i <= BENCHMARK_RECEIPT_COUNT; ++i) {
+        ASSERT_TRUE(serial->LoadBoxReceipt(i));
+    }
+
+    const auto serialTime = elapsed(start);
+    std::set<std::int64_t> unloaded;
+    start = std::chrono::steady_clock::now();
+
+    ASSERT_TRUE(batched->LoadBoxReceipts(&unloaded));
+
+    const auto batchedTime = elapsed(start);
+    std::cout << "Loaded " << BENCHMARK_RECEIPT_COUNT << " box receipts in "
+              << serialTime << " ms one at a time, " << batchedTime
+              << " ms batched on " << std::thread::hardware_concurrency()
+              << " threads.\n";
+
+    EXPECT_TRUE(unloaded.empty());
+    ASSERT_EQ(BENCHMARK_RECEIPT_COUNT, batched->GetTransactionCount());
+
+    for (std::int64_t i = 1; i <= BENCHMARK_RECEIPT_COUNT; ++i) {
+        OTTransaction* expected = serial->GetTransaction(i);
+        OTTransaction* actual = batched->GetTransaction(i);
+        ASSERT_NE(nullptr, expected);
+        ASSERT_NE(nullptr, actual);
+        EXPECT_FALSE(actual->IsAbbreviated());
+        EXPECT_EQ(expected->GetType(), actual->GetType());
+    }
+}
+
+TEST_F(Test_LoadBoxReceipts, Batched)
+{
+    auto inbox = load();
+    ASSERT_EQ(RECEIPT_COUNT, inbox->GetTransactionCount());
+
+    std::set<std::int64_t> unloaded;
+    ASSERT_TRUE(inbox->LoadBoxReceipts(&unloaded));
+    EXPECT_TRUE(unloaded.empty());
+    ASSERT_EQ(RECEIPT_COUNT, inbox->GetTransactionCount());
+
+    for (std::int64_t i = 1; i <= RECEIPT_COUNT; ++i) {
+        OTTransaction* receipt = inbox->GetTransaction(i);
+        ASSERT_NE(nullptr, receipt);
+        EXPECT_FALSE(receipt->IsAbbreviated());
+        EXPECT_EQ(OTTransaction::pending, receipt->GetType());
+    }
+}
+
+TEST_F(Test_LoadBoxReceipts, Unloaded)
+{
+    auto inbox = load();
+    // Abbreviated receipts with no box receipt on disk, numbered past anything
+    // the benchmark may have written.
+    const std::set<std::int64_t> missing{BENCHMARK_RECEIPT_COUNT + 1,
+                                         BENCHMARK_RECEIPT_COUNT + 2,
+                                         BENCHMARK_RECEIPT_COUNT + 3};
+
+    for (const auto& number : missing) {
+        OTTransaction* receipt = OTTransaction::GenerateTransaction(
+            *inbox, OTTransaction::pending, originType::not_applicable, number);
+        ASSERT_NE(nullptr, receipt);
+        ASSERT_TRUE(receipt->SaveContract());
+        inbox->AddTransaction(*receipt);
+    }
+
+    String strInbox;
+    ASSERT_TRUE(inbox->SaveContract());
+    ASSERT_TRUE(inbox->SaveContractRaw(strInbox));
+
+    Ledger reloaded(nym_, account_, notary_);
+    ASSERT_TRUE(reloaded.LoadInboxFromString(strInbox));
+
+    std::set<std::int64_t> unloaded;
+    EXPECT_FALSE(reloaded.LoadBoxReceipts(&unloaded));
+    EXPECT_EQ(missing, unloaded);
+
+    for (const auto& number : missing) {
+        OTTransaction* receipt = reloaded.GetTransaction(number);
+        ASSERT_NE(nullptr, receipt);
+        EXPECT_TRUE(receipt->IsAbbreviated());
+    }
+
+    OTTransaction* loaded = reloaded.GetTransaction(1);
+    ASSERT_NE(nullptr, loaded);
+    EXPECT_FALSE(loaded->IsAbbreviated());
+}
+}  // namespace
@@ -0,0 +1,315 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/cash/Mint.hpp"
+#include "opentxs/cash/MintLucre.hpp"
+#include "opentxs/cash/Purse.hpp"
+#include "opentxs/cash/Token.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/crypto/SecureArena.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if OT_CASH_USING_LUCRE && OT_CRYPTO_USING_OPENSSL
+#define MINT_PRIME_LENGTH 512
+#define TOKENS_PER_DENOMINATION 4
+
+namespace opentxs
+{
+const std::vector<std::int64_t> DENOMINATIONS{1, 10, 100};
+
+class MintLucreTest : public ::testing::Test
+{
+public:
+    const NymParameters parameters_;
+    const Nym nym_;
+    Identifier notary_;
+    Identifier unit_;
+    std::unique_ptr<MintLucre> mint_;
+    std::unique_ptr<Purse> purse_;
+
+    MintLucreTest()
+        : parameters_()
+        , nym_(parameters_)
+        , notary_()
+        , unit_()
+        , mint_()
+        , purse_()
+    {
+        notary_.CalculateDigest(String("MintLucreTest notary"));
+        unit_.CalculateDigest(String("MintLucreTest unit"));
+    }
+
+    void SetUp() override
+    {
+        mint_.reset(dynamic_cast<MintLucre*>(Mint::MintFactory(
+            String(notary_), String(nym_.ID()), String(unit_))));
+
+        ASSERT_TRUE(mint_);
+
+        const auto now = OTTimeGetCurrentTime();
+        mint_->GenerateNewMint(
+            0,
+            now,
+            OTTimeAddTimeInterval(now, OT_TIME_DAY_IN_SECONDS),
+            OTTimeAddTimeInterval(now, OT_TIME_HOUR_IN_SECONDS),
+            unit_,
+            notary_,
+            nym_);
+
+        for (const auto& denomination : DENOMINATIONS) {
+            ASSERT_TRUE(
+                mint_->AddDenomination(nym_, denomination, MINT_PRIME_LENGTH));
+        }
+
+        purse_.reset(new Purse(notary_, unit_, nym_.ID()));
+    }
+
+    std::size_t cached() const
+    {
+        Lock lock(mint_->bank_lock_);
+
+        return mint_->banks_.size();
+    }
+
+    bool cached(const std::int64_t denomination) const
+    {
+        Lock lock(mint_->bank_lock_);
+
+        return 0 < mint_->banks_.count(denomination);
+    }
+
+    void expire() { mint_->m_VALID_TO = OTTimeGetCurrentTime() - 1; }
+
+    // A stale entry for a denomination the mint does not have yet
+    void poison(const std::int64_t denomination)
+    {
+        Lock lock(mint_->bank_lock_);
+        mint_->banks_[denomination] = {
+            String(nym_.ID()).Get(), std::make_shared<SecureBuffer>(1)};
+    }
+
+    // A withdrawal request as the client sends it, plus the client's copy
+    // which keeps the private prototoken for unblinding
+    std::pair<std::unique_ptr<Token>, std::unique_ptr<Token>> request(
+        const std::int64_t denomination)
+    {
+        std::unique_ptr<Token> original(
+            Token::InstantiateAndGenerateTokenRequest(
+                *purse_, nym_, *mint_, denomination));
+
+        if (false == bool(original)) { return {}; }
+
+        original->SignContract(nym_);
+        original->SaveContract();
+        String serialized;
+        original->SaveContractRaw(serialized);
+        std::unique_ptr<Token> sent(Token::TokenFactory(serialized, *purse_));
+
+        return {std::move(original), std::move(sent)};
+    }
+
+    // Unblinds a signed request and returns the coin as the notary sees it
+    // on deposit
+    String coin(Token& original, Token& sent, const String& signature)
+    {
+        sent.ReleaseSignatures();
+        sent.SetSignature(OTASCIIArmor(signature), 0);
+        String output;
+
+        if (false == sent.ProcessToken(nym_, *mint_, original)) {
+            return output;
+        }
+
+        sent.GetSpendableString(nym_, output);
+
+        return output;
+    }
+};
+
+TEST_F(MintLucreTest, batch_matches_single_token)
+{
+    std::vector<std::unique_ptr<Token>> originals;
+    std::vector<std::unique_ptr<Token>> requests;
+
+    // Interleaved, so each batch mixes every denomination
+    for (int i = 0; i < TOKENS_PER_DENOMINATION; ++i) {
+        for (const auto& denomination : DENOMINATIONS) {
+            auto pair = request(denomination);
+
+            ASSERT_TRUE(pair.first);
+            ASSERT_TRUE(pair.second);
+
+            originals.emplace_back(std::move(pair.first));
+            requests.emplace_back(std::move(pair.second));
+        }
+    }
+
+    std::vector<Token*> batch;
+
+    for (auto& token : requests) { batch.push_back(token.get()); }
+
+    std::vector<String> single(batch.size());
+    std::vector<bool> singleSigned(batch.size(), false);
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        singleSigned[i] = mint_->SignToken(nym_, *batch[i], single[i], 0);
+    }
+
+    std::vector<String> batched;
+    const auto batchSigned = mint_->SignTokens(nym_, batch, batched, 0);
+
+    ASSERT_EQ(batch.size(), batched.size());
+    EXPECT_EQ(singleSigned, batchSigned);
+
+    // Lucre's blind signature is deterministic
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_TRUE(singleSigned[i]);
+        EXPECT_STREQ(single[i].Get(), batched[i].Get());
+    }
+
+    // Every valid coin, then every coin again under the wrong denomination
+    std::vector<std::pair<String, std::int64_t>> coins;
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto denomination = requests[i]->GetDenomination();
+        const auto cleartext = coin(*originals[i], *requests[i], batched[i]);
+
+        ASSERT_TRUE(cleartext.Exists());
+
+        coins.emplace_back(cleartext, denomination);
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const auto& valid = coins[i];
+        const auto wrong = (DENOMINATIONS.front() == valid.second)
+                               ? DENOMINATIONS.back()
+                               : DENOMINATIONS.front();
+        coins.emplace_back(valid.first, wrong);
+    }
+
+    std::vector<bool> singleVerified;
+
+    for (auto& item : coins) {
+        singleVerified.push_back(
+            mint_->VerifyToken(nym_, item.first, item.second));
+    }
+
+    const auto batchVerified = mint_->VerifyTokens(nym_, coins);
+
+    EXPECT_EQ(singleVerified, batchVerified);
+
+    for (std::size_t i = 0; i < coins.size(); ++i) {
+        EXPECT_EQ(i < batch.size(), batchVerified[i]);
+    }
+}
+
+TEST_F(MintLucreTest, release_drops_cache)
+{
+    auto pair = request(DENOMINATIONS.front());
+
+    ASSERT_TRUE(pair.second);
+
+    String signature;
+
+    ASSERT_TRUE(mint_->SignToken(nym_, *pair.second, signature, 0));
+    EXPECT_EQ(1u, cached());
+
+    mint_->Release();
+
+    EXPECT_EQ(0u, cached());
+}
+
+TEST_F(MintLucreTest, add_denomination_drops_cache)
+{
+    const std::int64_t added{1000};
+    auto pair = request(DENOMINATIONS.front());
+
+    ASSERT_TRUE(pair.second);
+
+    String signature;
+
+    ASSERT_TRUE(mint_->SignToken(nym_, *pair.second, signature, 0));
+
+    poison(added);
+
+    ASSERT_TRUE(cached(added));
+    ASSERT_TRUE(mint_->AddDenomination(nym_, added, MINT_PRIME_LENGTH));
+    EXPECT_FALSE(cached(added));
+    EXPECT_TRUE(cached(DENOMINATIONS.front()));
+}
+
+TEST_F(MintLucreTest, expiry_drops_cache)
+{
+    std::vector<std::unique_ptr<Token>> requests;
+    std::vector<Token*> batch;
+
+    for (const auto& denomination : DENOMINATIONS) {
+        auto pair = request(denomination);
+
+        ASSERT_TRUE(pair.second);
+
+        batch.push_back(pair.second.get());
+        requests.emplace_back(std::move(pair.second));
+    }
+
+    std::vector<String> signatures;
+    mint_->SignTokens(nym_, batch, signatures, 0);
+
+    EXPECT_EQ(DENOMINATIONS.size(), cached());
+
+    expire();
+    String signature;
+    mint_->SignToken(nym_, *batch.front(), signature, 0);
+
+    EXPECT_EQ(0u, cached());
+}
+}  // namespace opentxs
+#endif  // OT_CASH_USING_LUCRE && OT_CRYPTO_USING_OPENSSL
@@ -0,0 +1,189 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/cash/SpentTokenStore.hpp"
+#include "opentxs/core/util/OTDataFolder.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/OTPaths.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if OT_CASH
+using namespace opentxs;
+
+namespace
+{
+
+const std::size_t TOKEN_COUNT{100};
+
+class Test_SpentTokenMigration : public ::testing::Test
+{
+public:
+    const boost::filesystem::path folder_;
+    Identifier unit_;
+
+    Test_SpentTokenMigration()
+        : folder_(
+              boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path())
+    {
+        unit_.CalculateDigest(String("Test_SpentTokenMigration unit"));
+        boost::filesystem::create_directories(folder_);
+    }
+
+    ~Test_SpentTokenMigration() { boost::filesystem::remove_all(folder_); }
+
+    static Identifier token(const std::string& name, const std::size_t i)
+    {
+        Identifier output;
+        output.CalculateDigest(String((name + std::to_string(i)).c_str()));
+
+        return output;
+    }
+
+    // The old layout: one empty file per spent token, named after the hash
+    static void write_legacy(
+        const boost::filesystem::path& folder,
+        const std::string& name)
+    {
+        boost::filesystem::create_directories(folder);
+
+        for (std::size_t i = 0; i < TOKEN_COUNT; ++i) {
+            std::ofstream((folder / String(token(name, i)).Get()).string());
+        }
+    }
+
+    static void expect_tokens(
+        const SpentTokenStore& store,
+        const std::string& name)
+    {
+        EXPECT_EQ(TOKEN_COUNT, store.Size());
+
+        for (std::size_t i = 0; i < TOKEN_COUNT; ++i) {
+            EXPECT_TRUE(store.Contains(token(name, i)));
+        }
+
+        EXPECT_FALSE(store.Contains(token(name, TOKEN_COUNT)));
+    }
+};
+
+TEST_F(Test_SpentTokenMigration, Import)
+{
+    const auto legacy = folder_ / "legacy";
+    write_legacy(legacy, "import");
+    std::ofstream((legacy / "abcd").string());
+    SpentTokenStore store((folder_ / "spent.log").string());
+    std::size_t imported{0};
+
+    ASSERT_TRUE(store.Import(legacy.string(), imported));
+    EXPECT_EQ(TOKEN_COUNT, imported);
+    expect_tokens(store, "import");
+
+    // Importing again finds every token already recorded
+    ASSERT_TRUE(store.Import(legacy.string(), imported));
+    EXPECT_EQ(0, imported);
+    EXPECT_EQ(TOKEN_COUNT, store.Size());
+
+    // The legacy folder is left alone
+    EXPECT_TRUE(boost::filesystem::exists(
+        legacy / String(token("import", 0)).Get()));
+    EXPECT_FALSE(store.Import((folder_ / "missing").string(), imported));
+}
+
+TEST_F(Test_SpentTokenMigration, Migrate)
+{
+    write_legacy(folder_ / "unit.1", "first");
+    write_legacy(folder_ / "unit.2", "second");
+    write_legacy(folder_ / "unit.3", "third");
+
+    // A folder which already has a log is not imported again
+    {
+        SpentTokenStore existing((folder_ / "unit.3.log").string());
+        ASSERT_TRUE(existing.Insert(token("existing", 0)));
+    }
+
+    EXPECT_EQ(0, SpentTokenStore::Migrate(folder_.string()));
+
+    expect_tokens(SpentTokenStore((folder_ / "unit.1.log").string()), "first");
+    expect_tokens(
+        SpentTokenStore((folder_ / "unit.2.log").string()), "second");
+
+    SpentTokenStore existing((folder_ / "unit.3.log").string());
+
+    EXPECT_EQ(1, existing.Size());
+    EXPECT_FALSE(existing.Contains(token("third", 0)));
+    EXPECT_FALSE(boost::filesystem::exists(folder_ / "unit.1.log.import"));
+    EXPECT_EQ(0, SpentTokenStore::Migrate(folder_.string()));
+    EXPECT_NE(0, SpentTokenStore::Migrate((folder_ / "missing").string()));
+}
+
+TEST_F(Test_SpentTokenMigration, Get)
+{
+    const std::int32_t series{7};
+    String spent;
+    ASSERT_TRUE(
+        OTPaths::AppendFolder(spent, OTDataFolder::Get(), OTFolders::Spent()));
+    const std::string name =
+        String(unit_).Get() + std::string(".") + std::to_string(series);
+    const auto legacy = boost::filesystem::path(spent.Get()) / name;
+    const auto log = boost::filesystem::path(legacy.string() + ".log");
+    boost::filesystem::remove_all(legacy);
+    boost::filesystem::remove(log);
+    write_legacy(legacy, "get");
+
+    auto store = SpentTokenStore::Get(unit_, series);
+
+    ASSERT_TRUE(bool(store));
+    expect_tokens(*store, "get");
+    EXPECT_TRUE(boost::filesystem::exists(log));
+    EXPECT_EQ(store, SpentTokenStore::Get(unit_, series));
+
+    boost::filesystem::remove_all(legacy);
+    boost::filesystem::remove(log);
+}
+}  // namespace
+#endif  // OT_CASH
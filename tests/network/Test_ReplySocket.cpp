@@ -0,0 +1,198 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/ReplyCallback.hpp"
+#include "opentxs/network/zeromq/ReplySocket.hpp"
+#include "opentxs/network/zeromq/RequestSocket.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+
+#include <zmq.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace opentxs;
+
+#define TEST_ENDPOINT "inproc://opentxs/test/reply"
+#define POLLING_ENDPOINT "inproc://opentxs/test/polling"
+#define ROUND_TRIPS 10000
+#define MESSAGE_CHECK_MICROSECONDS 1000
+
+namespace
+{
+struct Test_ReplySocket : public ::testing::Test {
+    OTZMQContext context_;
+    OTZMQReplyCallback callback_;
+
+    Test_ReplySocket()
+        : context_(network::zeromq::Context::Factory())
+        , callback_(network::zeromq::ReplyCallback::Factory(
+              [](const network::zeromq::Message& input) -> OTZMQMessage {
+                  return network::zeromq::Message::Factory(std::string(input));
+              }))
+    {
+    }
+};
+
+/** Echo server which receives the way ReplySocket did before the reactor
+ *
+ *  A thread checks the socket without blocking and sleeps between checks.
+ */
+class PollingServer
+{
+public:
+    explicit PollingServer(void* context)
+        : running_(true)
+        , socket_(zmq_socket(context, ZMQ_REP))
+        , thread_()
+    {
+        zmq_bind(socket_, POLLING_ENDPOINT);
+        thread_ = std::thread(&PollingServer::run, this);
+    }
+
+    ~PollingServer()
+    {
+        running_ = false;
+        thread_.join();
+        zmq_close(socket_);
+    }
+
+private:
+    std::atomic<bool> running_;
+    void* socket_;
+    std::thread thread_;
+
+    void run()
+    {
+        while (running_) {
+            zmq_msg_t message;
+            zmq_msg_init(&message);
+
+            if (-1 != zmq_msg_recv(&message, socket_, ZMQ_DONTWAIT)) {
+                zmq_msg_send(&message, socket_, 0);
+            }
+
+            zmq_msg_close(&message);
+            std::this_thread::sleep_for(
+                std::chrono::microseconds(MESSAGE_CHECK_MICROSECONDS));
+        }
+    }
+};
+
+// Returns the mean round trip time in microseconds
+double round_trips(
+    const network::zeromq::RequestSocket& client,
+    const int count)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < count; ++i) {
+        std::string request = std::to_string(i);
+        auto result = client.SendRequest(request);
+
+        EXPECT_EQ(SendResult::VALID_REPLY, result.first);
+        EXPECT_EQ(request, std::string(result.second.get()));
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    return elapsed.count() / double(count);
+}
+
+void report(const std::string& name, const double perMessage)
+{
+    const auto perSecond = (0.0 == perMessage) ? 0.0 : 1000000.0 / perMessage;
+    std::cout << name << ": " << perMessage << " us per message, "
+              << perSecond << " messages per second" << std::endl;
+}
+}  // namespace
+
+TEST_F(Test_ReplySocket, round_trip)
+{
+    auto server = context_->ReplySocket(callback_);
+
+    ASSERT_TRUE(server->Start(TEST_ENDPOINT));
+
+    auto client = context_->RequestSocket();
+
+    ASSERT_TRUE(client->Start(TEST_ENDPOINT));
+
+    round_trips(client, 100);
+}
+
+// Compares the reactor with the polling receiver it replaced. Run with
+// --gtest_also_run_disabled_tests.
+TEST_F(Test_ReplySocket, DISABLED_round_trip_latency)
+{
+    double polling{0.0};
+    double reactor{0.0};
+
+    {
+        PollingServer server(context_.get());
+        auto client = context_->RequestSocket();
+
+        ASSERT_TRUE(client->Start(POLLING_ENDPOINT));
+
+        polling = round_trips(client, ROUND_TRIPS);
+    }
+
+    {
+        auto server = context_->ReplySocket(callback_);
+
+        ASSERT_TRUE(server->Start(TEST_ENDPOINT));
+
+        auto client = context_->RequestSocket();
+
+        ASSERT_TRUE(client->Start(TEST_ENDPOINT));
+
+        reactor = round_trips(client, ROUND_TRIPS);
+    }
+
+    std::cout << ROUND_TRIPS << " round trips each" << std::endl;
+    report("polling receiver", polling);
+    report("reactor", reactor);
+}
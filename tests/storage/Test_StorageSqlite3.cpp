@@ -0,0 +1,393 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/api/storage/Storage.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/storage/drivers/StorageSqlite3.hpp"
+#include "opentxs/storage/StorageConfig.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Types.hpp"
+
+extern "C" {
+#include <sqlite3.h>
+}
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+namespace
+{
+const char* const DB_FILE{"Test_StorageSqlite3.sqlite"};
+const std::size_t VALUE_SIZE{256};
+const std::size_t BENCHMARK_OBJECTS{1000000};
+const std::size_t BENCHMARK_OPERATIONS{100000};
+const std::size_t BATCH_SIZE{100};
+
+std::string key(const std::size_t i)
+{
+    // Keys are hashes in the real database
+    char output[33]{};
+    std::snprintf(
+        output,
+        sizeof(output),
+        "%016llx%016llx",
+        static_cast<unsigned long long>(i * 0x9e3779b97f4a7c15ULL),
+        static_cast<unsigned long long>(i));
+
+    return output;
+}
+
+std::string value(const std::size_t i)
+{
+    std::string output(VALUE_SIZE, '\0');
+
+    for (std::size_t j = 0; j < VALUE_SIZE; ++j) {
+        output[j] = static_cast<char>((i * 31 + j) & 0xff);
+    }
+
+    return output;
+}
+
+std::size_t pick(std::uint64_t& state, const std::size_t count)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    return (state >> 33) % count;
+}
+
+double per_second(
+    const std::size_t count,
+    const std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return count / elapsed.count();
+}
+
+void remove_database()
+{
+    std::remove(DB_FILE);
+    std::remove((std::string(DB_FILE) + "-wal").c_str());
+    std::remove((std::string(DB_FILE) + "-shm").c_str());
+}
+}  // namespace
+
+class StorageSqlite3Test : public ::testing::Test
+{
+public:
+    StorageConfig config_{};
+    Digest digest_{};
+    Random random_{};
+    OTFlag bucket_{Flag::Factory(false)};
+    std::unique_ptr<StorageSqlite3> driver_{nullptr};
+
+    void SetUp() override
+    {
+        remove_database();
+        config_.path_ = ".";
+        config_.sqlite3_db_file_ = DB_FILE;
+        digest_ = [](const std::uint32_t type,
+                     const std::string& data,
+                     std::string& digest) -> bool {
+            return OT::App().Crypto().Hash().Digest(type, data, digest);
+        };
+        random_ = []() -> std::string { return "random"; };
+        driver_.reset(new StorageSqlite3(
+            OT::App().DB(), config_, digest_, random_, bucket_));
+
+        ASSERT_TRUE(driver_);
+    }
+
+    void TearDown() override
+    {
+        driver_.reset();
+        remove_database();
+    }
+
+    std::size_t cached(const std::string& table) const
+    {
+        Lock lock(driver_->statement_lock_);
+        std::size_t output{0};
+
+        for (const auto& it : driver_->statements_) {
+            if (table == it.first.first) { ++output; }
+        }
+
+        return output;
+    }
+
+    // Changes the schema behind the driver's back
+    bool exec(const std::string& sql) const
+    {
+        Lock lock(driver_->statement_lock_);
+
+        return driver_->exec(lock, sql);
+    }
+
+    bool load(const std::size_t i, const bool bucket) const
+    {
+        std::string loaded{};
+
+        return driver_->LoadFromBucket(key(i), loaded, bucket) &&
+               (value(i) == loaded);
+    }
+
+    // Queues writes for the driver's writer threads, which hand them to
+    // store_batch() in groups
+    bool store_async(
+        const std::size_t first,
+        const std::size_t count,
+        const bool isTransaction,
+        const bool bucket)
+    {
+        std::vector<std::promise<bool>> promises(count);
+        std::vector<std::future<bool>> futures{};
+
+        for (auto& promise : promises) {
+            futures.emplace_back(promise.get_future());
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            driver_->Store(
+                isTransaction,
+                key(first + i),
+                value(first + i),
+                bucket,
+                promises[i]);
+        }
+
+        bool output{true};
+
+        for (auto& future : futures) { output &= future.get(); }
+
+        return output;
+    }
+};
+
+TEST_F(StorageSqlite3Test, load_and_store)
+{
+    EXPECT_TRUE(driver_->Store(false, key(1), value(1), false));
+    EXPECT_TRUE(driver_->Store(false, key(2), value(2), true));
+
+    EXPECT_TRUE(load(1, false));
+    EXPECT_FALSE(load(1, true));
+    EXPECT_TRUE(load(2, true));
+    EXPECT_FALSE(load(3, false));
+
+    // Plugin::Load falls back to the other bucket
+    std::string loaded{};
+
+    EXPECT_TRUE(driver_->Load(key(2), false, loaded));
+    EXPECT_EQ(value(2), loaded);
+
+    std::string hash{};
+
+    ASSERT_TRUE(driver_->Store(false, value(4), hash));
+    EXPECT_FALSE(hash.empty());
+    EXPECT_TRUE(driver_->LoadFromBucket(hash, loaded, false));
+    EXPECT_EQ(value(4), loaded);
+
+    // Replacing a value
+    EXPECT_TRUE(driver_->Store(false, key(1), value(2), false));
+    EXPECT_TRUE(driver_->LoadFromBucket(key(1), loaded, false));
+    EXPECT_EQ(value(2), loaded);
+}
+
+TEST_F(StorageSqlite3Test, statement_cache)
+{
+    EXPECT_EQ(0u, cached("a"));
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        EXPECT_TRUE(driver_->Store(false, key(i), value(i), false));
+        EXPECT_TRUE(load(i, false));
+    }
+
+    // One select and one upsert, prepared once and reused
+    EXPECT_EQ(2u, cached("a"));
+    EXPECT_EQ(0u, cached("b"));
+
+    EXPECT_FALSE(load(0, true));
+    EXPECT_EQ(1u, cached("b"));
+}
+
+TEST_F(StorageSqlite3Test, purge)
+{
+    for (std::size_t i = 0; i < 10; ++i) {
+        ASSERT_TRUE(driver_->Store(false, key(i), value(i), false));
+        ASSERT_TRUE(driver_->Store(false, key(i), value(i), true));
+    }
+
+    ASSERT_TRUE(load(0, false));
+    ASSERT_TRUE(load(0, true));
+    ASSERT_EQ(2u, cached("a"));
+    ASSERT_EQ(2u, cached("b"));
+
+    EXPECT_TRUE(driver_->EmptyBucket(false));
+
+    // Statements prepared against the dropped table are finalized
+    EXPECT_EQ(0u, cached("a"));
+    EXPECT_EQ(2u, cached("b"));
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        EXPECT_FALSE(load(i, false));
+        EXPECT_TRUE(load(i, true));
+    }
+
+    // The recreated table can be written and read through new statements
+    EXPECT_TRUE(driver_->Store(false, key(20), value(20), false));
+    EXPECT_TRUE(load(20, false));
+    EXPECT_EQ(2u, cached("a"));
+}
+
+TEST_F(StorageSqlite3Test, transaction)
+{
+    EXPECT_EQ("", driver_->LoadRoot());
+    EXPECT_TRUE(driver_->StoreRoot(false, "root 1"));
+    EXPECT_EQ("root 1", driver_->LoadRoot());
+
+    // Transactional writes are held until the root is committed
+    EXPECT_TRUE(driver_->Store(true, key(1), value(1), true));
+    EXPECT_TRUE(driver_->Store(true, key(2), value(2), true));
+    EXPECT_FALSE(load(1, true));
+
+    EXPECT_TRUE(driver_->StoreRoot(true, "root 2"));
+    EXPECT_EQ("root 2", driver_->LoadRoot());
+    EXPECT_TRUE(load(1, true));
+    EXPECT_TRUE(load(2, true));
+}
+
+TEST_F(StorageSqlite3Test, rollback)
+{
+    ASSERT_TRUE(driver_->StoreRoot(false, "root 1"));
+    ASSERT_TRUE(driver_->Store(true, key(1), value(1), false));
+    ASSERT_TRUE(driver_->Store(true, key(2), value(2), false));
+
+    // Writing the root fails after the objects have been written
+    ASSERT_TRUE(exec("DROP TABLE `control`;"));
+
+    EXPECT_FALSE(driver_->StoreRoot(true, "root 2"));
+    EXPECT_FALSE(load(1, false));
+    EXPECT_FALSE(load(2, false));
+
+    // Failed writes are not retried by the next commit
+    ASSERT_TRUE(exec("CREATE TABLE `control` (k text PRIMARY KEY, v BLOB);"));
+
+    EXPECT_TRUE(driver_->StoreRoot(true, "root 3"));
+    EXPECT_EQ("root 3", driver_->LoadRoot());
+    EXPECT_FALSE(load(1, false));
+
+    // The driver is usable after a rollback
+    EXPECT_TRUE(driver_->Store(false, key(3), value(3), false));
+    EXPECT_TRUE(load(3, false));
+}
+
+TEST_F(StorageSqlite3Test, batch)
+{
+    EXPECT_TRUE(store_async(0, 500, false, false));
+    EXPECT_TRUE(store_async(500, 500, false, true));
+    EXPECT_TRUE(store_async(1000, 500, true, false));
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        EXPECT_TRUE(load(i, false));
+        EXPECT_TRUE(load(500 + i, true));
+        EXPECT_FALSE(load(1000 + i, false));
+    }
+
+    EXPECT_TRUE(driver_->StoreRoot(true, "root"));
+
+    for (std::size_t i = 1000; i < 1500; ++i) { EXPECT_TRUE(load(i, false)); }
+}
+
+// Builds a database of about 300 MB. Run with --gtest_also_run_disabled_tests.
+TEST_F(StorageSqlite3Test, DISABLED_Benchmark)
+{
+    for (std::size_t i = 0; i < BENCHMARK_OBJECTS; i += BATCH_SIZE) {
+        ASSERT_TRUE(store_async(i, BATCH_SIZE, false, false));
+    }
+
+    std::uint64_t state{1};
+    std::size_t found{0};
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < BENCHMARK_OPERATIONS; ++i) {
+        found += load(pick(state, BENCHMARK_OBJECTS), false);
+    }
+
+    const auto loads = per_second(BENCHMARK_OPERATIONS, start);
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < BENCHMARK_OPERATIONS; ++i) {
+        const auto row = pick(state, BENCHMARK_OBJECTS);
+        ASSERT_TRUE(driver_->Store(false, key(row), value(row), false));
+    }
+
+    const auto stores = per_second(BENCHMARK_OPERATIONS, start);
+    start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < BENCHMARK_OPERATIONS; i += BATCH_SIZE) {
+        ASSERT_TRUE(store_async(
+            pick(state, BENCHMARK_OBJECTS - BATCH_SIZE),
+            BATCH_SIZE,
+            false,
+            false));
+    }
+
+    const auto batched = per_second(BENCHMARK_OPERATIONS, start);
+
+    std::cout << BENCHMARK_OBJECTS << " objects, ops/sec"
+              << "\n  load:          " << loads
+              << "\n  store:         " << stores
+              << "\n  batched store: " << batched << std::endl;
+
+    EXPECT_EQ(BENCHMARK_OPERATIONS, found);
+}
+}  // namespace opentxs
@@ -0,0 +1,402 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/api/storage/Driver.hpp"
+#include "opentxs/api/storage/Storage.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/storage/tree/Mailbox.hpp"
+#include "opentxs/storage/tree/Thread.hpp"
+#include "opentxs/storage/Plugin.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Proto.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace opentxs
+{
+namespace storage
+{
+namespace
+{
+class MemoryDriver : public opentxs::api::storage::Driver
+{
+public:
+    bool EmptyBucket(const bool) const override { return true; }
+    bool Load(const std::string& key, const bool, std::string& value)
+        const override
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        const auto it = data_.find(key);
+
+        if (data_.end() == it) { return false; }
+
+        value = it->second;
+
+        return true;
+    }
+    bool LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool) const override
+    {
+        return Load(key, false, value);
+    }
+    bool Store(
+        const bool,
+        const std::string& key,
+        const std::string& value,
+        const bool) const override
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        data_[key] = value;
+
+        return true;
+    }
+    void Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise) const override
+    {
+        promise.set_value(Store(isTransaction, key, value, bucket));
+    }
+    bool Store(
+        const bool isTransaction,
+        const std::string& value,
+        std::string& key) const override
+    {
+        if (false == OT::App().Crypto().Hash().Digest(
+                         OT::App().DB().HashType(), value, key)) {
+            return false;
+        }
+
+        return Store(isTransaction, key, value, false);
+    }
+    bool Migrate(const std::string&, const Driver&) const override
+    {
+        return true;
+    }
+    std::string LoadRoot() const override { return {}; }
+    bool StoreRoot(const bool, const std::string&) const override
+    {
+        return true;
+    }
+
+private:
+    mutable std::mutex lock_;
+    mutable std::map<std::string, std::string> data_;
+};
+
+std::string make_id(const std::string& seed)
+{
+    Identifier id;
+    id.CalculateDigest(String(seed));
+
+    return String(id).Get();
+}
+}  // namespace
+
+class ThreadTest : public ::testing::Test
+{
+public:
+    MemoryDriver driver_;
+    Mailbox inbox_;
+    Mailbox outbox_;
+    const std::string nym_;
+    const std::string thread_;
+
+    ThreadTest()
+        : driver_()
+        , inbox_(driver_, "")
+        , outbox_(driver_, "")
+        , nym_(make_id("ThreadTest nym"))
+        , thread_(make_id("ThreadTest thread"))
+    {
+    }
+
+    std::unique_ptr<Thread> create()
+    {
+        return std::unique_ptr<Thread>(new Thread(
+            driver_, thread_, std::set<std::string>{nym_}, inbox_, outbox_));
+    }
+
+    std::unique_ptr<Thread> load(const std::string& hash)
+    {
+        return std::unique_ptr<Thread>(
+            new Thread(driver_, thread_, hash, "", inbox_, outbox_));
+    }
+
+    static std::string item(const std::size_t i)
+    {
+        return make_id("ThreadTest item " + std::to_string(i));
+    }
+
+    // Checks that the pages hold every item exactly once, in index order
+    static void check_pages(const Thread& thread, const int count)
+    {
+        const auto all = thread.Items();
+        ASSERT_EQ(count, all.item_size());
+
+        int position{0};
+
+        for (std::size_t i = 0; i < thread.Pages(); ++i) {
+            const auto page = thread.Items(i);
+
+            EXPECT_GE(64, page.item_size());
+
+            for (const auto& it : page.item()) {
+                ASSERT_GT(all.item_size(), position);
+                EXPECT_EQ(all.item(position).id(), it.id());
+                ++position;
+            }
+        }
+
+        EXPECT_EQ(count, position);
+
+        for (int i = 1; i < all.item_size(); ++i) {
+            EXPECT_LT(all.item(i - 1).index(), all.item(i).index());
+        }
+    }
+};
+
+TEST_F(ThreadTest, append)
+{
+    auto thread = create();
+
+    for (std::size_t i = 0; i < 200; ++i) {
+        ASSERT_TRUE(thread->Add(
+            item(i), i, StorageBox::MAILINBOX, "", "message " +
+            std::to_string(i)));
+    }
+
+    EXPECT_EQ(4u, thread->Pages());
+    EXPECT_EQ(64, thread->Items(0).item_size());
+    EXPECT_EQ(8, thread->Items(3).item_size());
+    check_pages(*thread, 200);
+
+    auto loaded = load(thread->Root());
+
+    EXPECT_EQ(thread->Pages(), loaded->Pages());
+    EXPECT_EQ(
+        thread->Items().SerializeAsString(),
+        loaded->Items().SerializeAsString());
+    check_pages(*loaded, 200);
+}
+
+TEST_F(ThreadTest, split_in_middle)
+{
+    auto thread = create();
+
+    for (std::size_t i = 1; i <= 130; ++i) {
+        ASSERT_TRUE(thread->Add(
+            item(i), i, StorageBox::INCOMINGBLOCKCHAIN, "", "", 2 * i));
+    }
+
+    ASSERT_EQ(3u, thread->Pages());
+    ASSERT_EQ(64, thread->Items(0).item_size());
+
+    // Belongs between the first two items of the full first page
+    ASSERT_TRUE(
+        thread->Add(item(0), 0, StorageBox::INCOMINGBLOCKCHAIN, "", "", 3));
+
+    EXPECT_EQ(4u, thread->Pages());
+    EXPECT_EQ(item(0), thread->Items(0).item(1).id());
+    check_pages(*thread, 131);
+
+    auto loaded = load(thread->Root());
+
+    EXPECT_EQ(4u, loaded->Pages());
+    check_pages(*loaded, 131);
+}
+
+TEST_F(ThreadTest, remove_to_empty)
+{
+    auto thread = create();
+
+    for (std::size_t i = 0; i < 70; ++i) {
+        ASSERT_TRUE(thread->Add(
+            item(i), i, StorageBox::MAILINBOX, "", "message " +
+            std::to_string(i)));
+    }
+
+    ASSERT_EQ(2u, thread->Pages());
+
+    for (std::size_t i = 0; i < 70; ++i) {
+        ASSERT_TRUE(thread->Remove(item(i)));
+    }
+
+    EXPECT_EQ(1u, thread->Pages());
+    EXPECT_EQ(0u, thread->UnreadCount());
+    EXPECT_EQ(0, thread->Items().item_size());
+    EXPECT_EQ(0, thread->Items(0).item_size());
+    // The participants are kept in the empty page
+    ASSERT_EQ(1, thread->Items().participant_size());
+    EXPECT_EQ(nym_, thread->Items().participant(0));
+
+    auto loaded = load(thread->Root());
+
+    EXPECT_EQ(1u, loaded->Pages());
+    EXPECT_EQ(0, loaded->Items().item_size());
+    ASSERT_EQ(1, loaded->Items().participant_size());
+}
+
+TEST_F(ThreadTest, unread_counts)
+{
+    auto thread = create();
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        const auto box =
+            (0 == i % 4) ? StorageBox::MAILOUTBOX : StorageBox::MAILINBOX;
+        ASSERT_TRUE(thread->Add(item(i), i, box, "", "message"));
+    }
+
+    EXPECT_EQ(75u, thread->UnreadCount());
+
+    ASSERT_TRUE(thread->Read(item(1), false));
+    EXPECT_EQ(74u, thread->UnreadCount());
+
+    // Setting the same state again does not change the count
+    ASSERT_TRUE(thread->Read(item(1), false));
+    EXPECT_EQ(74u, thread->UnreadCount());
+
+    ASSERT_TRUE(thread->Read(item(1), true));
+    EXPECT_EQ(75u, thread->UnreadCount());
+
+    ASSERT_TRUE(thread->Remove(item(2)));
+    EXPECT_EQ(74u, thread->UnreadCount());
+
+    // Outgoing items are never unread
+    ASSERT_TRUE(thread->Remove(item(4)));
+    EXPECT_EQ(74u, thread->UnreadCount());
+
+    auto loaded = load(thread->Root());
+
+    EXPECT_EQ(74u, loaded->UnreadCount());
+}
+
+TEST_F(ThreadTest, legacy_load_and_conversion)
+{
+    const int count{150};
+    proto::StorageThread legacy;
+    legacy.set_version(1);
+    legacy.set_id(thread_);
+    legacy.add_participant(nym_);
+    std::size_t unread{0};
+
+    // Newest first, so every item is inserted ahead of the ones before it
+    for (int i = count; i > 0; --i) {
+        auto& it = *legacy.add_item();
+        it.set_version(1);
+        it.set_id(item(i));
+        it.set_index(i);
+        it.set_time(i);
+        it.set_box(static_cast<std::uint32_t>(StorageBox::INCOMINGBLOCKCHAIN));
+        it.set_account("");
+        it.set_unread(0 == i % 3);
+
+        if (it.unread()) { ++unread; }
+    }
+
+    std::string hash{};
+    ASSERT_TRUE(driver_.StoreProto(legacy, hash));
+
+    auto thread = load(hash);
+
+    EXPECT_EQ(unread, thread->UnreadCount());
+    EXPECT_LT(2u, thread->Pages());
+    check_pages(*thread, count);
+
+    // Not converted until the thread changes
+    EXPECT_EQ(hash, thread->Root());
+
+    ASSERT_TRUE(thread->Read(item(1), true));
+    ++unread;
+
+    const auto root = thread->Root();
+    ASSERT_NE(hash, root);
+
+    std::shared_ptr<proto::StorageNymList> index;
+    ASSERT_TRUE(driver_.LoadProto(root, index));
+    ASSERT_EQ(thread->Pages(), std::size_t(index->nym_size()));
+
+    for (const auto& page : index->nym()) {
+        EXPECT_EQ(page.hash(), page.itemid());
+    }
+
+    auto loaded = load(root);
+
+    EXPECT_EQ(unread, loaded->UnreadCount());
+    EXPECT_EQ(thread->Pages(), loaded->Pages());
+    EXPECT_EQ(
+        thread->Items().SerializeAsString(),
+        loaded->Items().SerializeAsString());
+}
+
+TEST_F(ThreadTest, items_by_page)
+{
+    auto thread = create();
+
+    for (std::size_t i = 0; i < 130; ++i) {
+        ASSERT_TRUE(
+            thread->Add(item(i), i, StorageBox::INCOMINGBLOCKCHAIN, "", ""));
+    }
+
+    ASSERT_EQ(3u, thread->Pages());
+    EXPECT_EQ(64, thread->Items(0).item_size());
+    EXPECT_EQ(64, thread->Items(1).item_size());
+    EXPECT_EQ(2, thread->Items(2).item_size());
+    EXPECT_EQ(item(64), thread->Items(1).item(0).id());
+    EXPECT_EQ(thread_, thread->Items(2).id());
+    EXPECT_EQ(0, thread->Items(3).item_size());
+    check_pages(*thread, 130);
+}
+}  // namespace storage
+}  // namespace opentxs